@@ -0,0 +1,309 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// AppLatency.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.25 Mistyped histograms and versions read as empty instead of throwing
+// 10/19/2026 MS-24.01.08.25 created
+//-----------------------------------------------
+// Source code for per application latency statistics
+//
+// Defines functions for struct LatencyHistogram and class AppLatency. See AppLatency.h.
+
+#include "AppLatency.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <thread>
+
+typedef std::array<LatencyHistogram, (size_t)LatencyKind::Count> AppHistograms;
+
+std::mutex AppLatency::s_Mutex;
+std::map<std::string, AppHistograms> AppLatency::s_Apps;
+std::filesystem::path AppLatency::s_Path;
+bool AppLatency::s_Loaded = false;
+bool AppLatency::s_Dirty = false;
+
+static const char* KindNames[] = { "probe", "restore", "move" };
+
+void LatencyHistogram::Add(double ms) {
+    size_t bucket = 0;
+    if (ms >= 1.0) {
+        bucket = std::min((size_t)std::floor(std::log2(ms)) + 1, (size_t)APP_LATENCY_BUCKETS - 1);
+    }
+    buckets[bucket]++;
+    count++;
+    totalMs += ms;
+    maxMs = std::max(maxMs, ms);
+
+    if (count >= APP_LATENCY_DECAY_SAMPLES) { // Halve the history so recent samples outweigh old ones
+        unsigned int kept = 0;
+        for (unsigned int& samples : buckets) {
+            samples /= 2;
+            kept += samples;
+        }
+        totalMs = totalMs * kept / count;
+        count = kept;
+    }
+}
+
+double LatencyHistogram::Percentile(double fraction) const {
+    if (count == 0) {
+        return 0.0;
+    }
+    double target = fraction * count;
+    unsigned int below = 0;
+    for (size_t bucket = 0; bucket < APP_LATENCY_BUCKETS; bucket++) {
+        if (buckets[bucket] == 0 || below + buckets[bucket] < target) {
+            below += buckets[bucket];
+            continue;
+        }
+        double lower = (bucket == 0 ? 0.0 : std::ldexp(1.0, (int)bucket - 1));
+        double upper = (bucket == APP_LATENCY_BUCKETS - 1 ? maxMs : std::ldexp(1.0, (int)bucket));
+        double position = (target - below) / buckets[bucket];
+        return std::min(lower + (upper - lower) * position, maxMs);
+    }
+    return maxMs;
+}
+
+nlohmann::ordered_json LatencyHistogram::ToJson() const {
+    return { {"count", count}, {"totalMs", totalMs}, {"maxMs", maxMs}, {"buckets", buckets} };
+}
+
+LatencyHistogram LatencyHistogram::FromJson(const nlohmann::json& j) {
+    LatencyHistogram histogram;
+    if (!j.is_object() || !j.contains("buckets") || !j["buckets"].is_array() || j["buckets"].size() != APP_LATENCY_BUCKETS) {
+        return histogram; // Written with a different bucket layout, start over
+    }
+    for (const char* field : { "totalMs", "maxMs" }) {
+        if (j.contains(field) && !j[field].is_number()) {
+            return LatencyHistogram(); // Edited by hand or damaged, start over rather than throw
+        }
+    }
+    for (size_t bucket = 0; bucket < APP_LATENCY_BUCKETS; bucket++) {
+        const nlohmann::json& samples = j["buckets"][bucket];
+        if (!samples.is_number_integer() || samples.get<long long>() < 0 || samples.get<long long>() > APP_LATENCY_DECAY_SAMPLES) { // Never more than a decay's worth
+            return LatencyHistogram();
+        }
+        histogram.buckets[bucket] = samples.get<unsigned int>();
+        histogram.count += histogram.buckets[bucket];
+    }
+    histogram.totalMs = j.value("totalMs", 0.0);
+    histogram.maxMs = j.value("maxMs", 0.0);
+    return histogram;
+}
+
+// Highest median of the kinds with enough samples to go by
+static double WorstMedian(const AppHistograms& Histograms) {
+    double worst = 0.0;
+    for (const LatencyHistogram& histogram : Histograms) {
+        if (histogram.count >= APP_LATENCY_MIN_SAMPLES) {
+            worst = std::max(worst, histogram.Percentile(0.5));
+        }
+    }
+    return worst;
+}
+
+double AppLatencyRecord::WorstMedian() const {
+    return ::WorstMedian(kinds);
+}
+
+
+///   APP LATENCY   ///
+
+void AppLatency::Open(const std::filesystem::path& path) {
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    s_Path = path;
+    s_Loaded = false;
+    s_Dirty = false;
+    s_Apps.clear();
+}
+
+void AppLatency::Load() {
+    if (s_Loaded) {
+        return;
+    }
+    s_Loaded = true;
+    if (s_Path.empty() || !std::filesystem::exists(s_Path)) {
+        return;
+    }
+    std::ifstream LatencyFile(s_Path);
+    nlohmann::json Doc = nlohmann::json::parse(LatencyFile, nullptr, false);
+    if (Doc.is_discarded() || !Doc.is_object() || !Doc.contains("version") || !Doc["version"].is_number_integer() || Doc["version"].get<int>() != APP_LATENCY_VERSION
+        || !Doc.contains("apps") || !Doc["apps"].is_object()) {
+        return; // Unreadable statistics only cost their history, they're rebuilt as windows are moved
+    }
+    for (auto& [app, kinds] : Doc["apps"].items()) {
+        if (!kinds.is_object()) {
+            continue;
+        }
+        AppHistograms& Histograms = s_Apps[app];
+        for (size_t kind = 0; kind < (size_t)LatencyKind::Count; kind++) {
+            if (kinds.contains(KindNames[kind])) {
+                Histograms[kind] = LatencyHistogram::FromJson(kinds[KindNames[kind]]);
+            }
+        }
+    }
+}
+
+void AppLatency::Record(const std::string& app, LatencyKind kind, double ms) {
+    if (app.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    Load();
+    s_Apps[app][(size_t)kind].Add(ms);
+    s_Dirty = true;
+}
+
+bool AppLatency::IsSlow(const std::string& app) {
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    Load();
+    auto found = s_Apps.find(app);
+    return found != s_Apps.end() && WorstMedian(found->second) >= APP_LATENCY_SLOW_MS;
+}
+
+int AppLatency::Dispatch(const std::vector<std::string>& apps, const std::function<void(size_t index, bool slow)>& Place, bool parallel,
+    const std::function<void()>& Finish) {
+    std::vector<bool> Slow(apps.size(), false);
+    int slowCount = 0;
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex); // Decided up front, the samples Place records don't change the schedule halfway
+        Load();
+        for (size_t i = 0; i < apps.size(); i++) {
+            auto found = s_Apps.find(apps[i]);
+            if (found != s_Apps.end() && WorstMedian(found->second) >= APP_LATENCY_SLOW_MS) {
+                Slow[i] = true;
+                slowCount++;
+            }
+        }
+    }
+
+    std::vector<std::thread> Workers;
+    if (parallel) {
+        Workers.reserve(slowCount);
+        for (size_t i = 0; i < apps.size(); i++) {
+            if (Slow[i]) {
+                Workers.emplace_back([&Place, i] { Place(i, true); }); // Started first so they wait on their applications while the rest are placed
+            }
+        }
+    }
+    for (size_t i = 0; i < apps.size(); i++) {
+        if (!Slow[i]) {
+            Place(i, false);
+        }
+    }
+    if (Finish) {
+        Finish();
+    }
+    if (!parallel) {
+        for (size_t i = 0; i < apps.size(); i++) {
+            if (Slow[i]) {
+                Place(i, true);
+            }
+        }
+    }
+    for (std::thread& worker : Workers) {
+        worker.join();
+    }
+    return slowCount;
+}
+
+bool AppLatency::Flush() {
+    nlohmann::ordered_json Doc;
+    std::filesystem::path path;
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        if (!s_Dirty || s_Path.empty()) {
+            return true;
+        }
+        s_Dirty = false;
+        path = s_Path;
+    }
+    Doc = ToJson(); // Takes the lock itself
+    std::ofstream LatencyFile(path, std::ios::trunc);
+    LatencyFile << Doc.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+    return (bool)LatencyFile;
+}
+
+std::vector<AppLatencyRecord> AppLatency::Worst(size_t count) {
+    std::vector<AppLatencyRecord> Records;
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        Load();
+        for (const auto& [app, Histograms] : s_Apps) {
+            if (WorstMedian(Histograms) <= 0.0) {
+                continue; // Too few samples to rank
+            }
+            AppLatencyRecord record;
+            record.app = app;
+            record.kinds = Histograms;
+            record.slow = WorstMedian(Histograms) >= APP_LATENCY_SLOW_MS;
+            Records.push_back(record);
+        }
+    }
+    std::sort(Records.begin(), Records.end(), [](const AppLatencyRecord& a, const AppLatencyRecord& b) {
+        return a.WorstMedian() > b.WorstMedian();
+    });
+    if (Records.size() > count) {
+        Records.resize(count);
+    }
+    return Records;
+}
+
+void AppLatency::Report(size_t count, bool json, std::ostream& out) {
+    std::vector<AppLatencyRecord> Records = Worst(count);
+    if (json) {
+        nlohmann::ordered_json Apps = nlohmann::ordered_json::array();
+        for (const AppLatencyRecord& record : Records) {
+            nlohmann::ordered_json app = { {"app", record.app}, {"slow", record.slow} };
+            for (size_t kind = 0; kind < (size_t)LatencyKind::Count; kind++) {
+                const LatencyHistogram& histogram = record.kinds[kind];
+                app[KindNames[kind]] = { {"count", histogram.count}, {"medianMs", histogram.Percentile(0.5)}, {"p90Ms", histogram.Percentile(0.9)},
+                    {"maxMs", histogram.maxMs} };
+            }
+            Apps.push_back(app);
+        }
+        out << nlohmann::ordered_json{ {"command", "stats"}, {"slowMs", APP_LATENCY_SLOW_MS}, {"apps", Apps} }.dump(-1, ' ', false,
+            nlohmann::json::error_handler_t::replace) << "\n";
+        return;
+    }
+    if (Records.empty()) {
+        out << "No application latencies recorded yet\n";
+        return;
+    }
+    for (const AppLatencyRecord& record : Records) {
+        out << record.app << (record.slow ? " (slow, scheduled apart)" : "") << "\n";
+        for (size_t kind = 0; kind < (size_t)LatencyKind::Count; kind++) {
+            const LatencyHistogram& histogram = record.kinds[kind];
+            if (histogram.count == 0) {
+                continue;
+            }
+            out << "  " << KindNames[kind] << ": " << histogram.count << " samples, median " << histogram.Percentile(0.5) << " ms, p90 "
+                << histogram.Percentile(0.9) << " ms, max " << histogram.maxMs << " ms\n";
+        }
+    }
+}
+
+std::string AppLatency::AppName(const std::string& processPath) {
+    std::string::size_type pos = processPath.find_last_of("\\/");
+    std::string name = (pos == std::string::npos ? processPath : processPath.substr(pos + 1));
+    std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+    return name;
+}
+
+nlohmann::ordered_json AppLatency::ToJson() {
+    std::lock_guard<std::mutex> lock(s_Mutex);
+    Load();
+    nlohmann::ordered_json Apps = nlohmann::ordered_json::object();
+    for (const auto& [app, Histograms] : s_Apps) {
+        nlohmann::ordered_json kinds;
+        for (size_t kind = 0; kind < (size_t)LatencyKind::Count; kind++) {
+            kinds[KindNames[kind]] = Histograms[kind].ToJson();
+        }
+        Apps[app] = kinds;
+    }
+    return { {"version", APP_LATENCY_VERSION}, {"apps", Apps} };
+}
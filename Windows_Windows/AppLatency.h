@@ -0,0 +1,211 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// AppLatency.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.25 created
+//-----------------------------------------------
+// Header file for per application latency statistics
+//
+// Contains class AppLatency, which keeps a latency histogram per executable (acad.exe, mstsc.exe...) for each thing WinWin waits on
+// a window for - the hung window probe, restoring it (SC_RESTORE, SetWindowPlacement) and moving it (SetWindowPos) - and class
+// LatencyTimer, which records the time of a scope into it.
+// Some applications take hundreds of milliseconds to answer each of these, and the window operations used to wait on them one by
+// one, so one slow application held up every window after it. An application whose median restore, move or probe time is at least
+// APP_LATENCY_SLOW_MS is slow, and Dispatch schedules its windows apart from the rest: each on its own thread while the others are
+// placed, or after all of them when the order matters (cascade, where later windows cover earlier ones).
+// Histograms have log2 millisecond buckets (under 1 ms, 1-2 ms, 2-4 ms... 16 s and over). Once a histogram holds APP_LATENCY_DECAY_SAMPLES
+// samples its buckets are halved, so an application that gets faster stops being treated as slow.
+// The statistics are kept in AppLatency.json next to the executable. It's read the first time it's needed and written by Flush when
+// something changed. Two WinWin processes flushing at the same time lose one set of samples, which only costs some history.
+// `WinWin stats [N]` prints the N slowest applications.
+// Like WindowListModel.h, it has no Windows dependencies.
+//
+// Statistics file:
+//   {"version": 1, "apps": {"acad.exe": {"probe": <histogram>, "restore": <histogram>, "move": <histogram>}}}
+// where <histogram> is {"count", "totalMs", "maxMs", "buckets": [...]}.
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+// Version written by AppLatency::ToJson
+#define APP_LATENCY_VERSION 1
+
+// File the statistics are kept in, in the executable's directory
+#define APP_LATENCY_FILE_NAME L"AppLatency.json"
+
+// Buckets per histogram, the last one holds everything from 2^(APP_LATENCY_BUCKETS - 2) ms up
+#define APP_LATENCY_BUCKETS 16
+
+// Median milliseconds at which an application counts as slow
+#define APP_LATENCY_SLOW_MS 50.0
+
+// Samples a histogram needs before its median is trusted
+#define APP_LATENCY_MIN_SAMPLES 3
+
+// Samples at which a histogram's buckets are halved
+#define APP_LATENCY_DECAY_SAMPLES 256
+
+// Applications `stats` lists when it isn't given a count
+#define APP_LATENCY_DEFAULT_REPORT 10
+
+/**
+ * @brief What WinWin was waiting on a window for
+ */
+enum class LatencyKind {
+	Probe,      // The WM_NULL probe in GetActiveWindows
+	Restore,    // SC_RESTORE, ShowWindow or SetWindowPlacement
+	Move,       // SetWindowPos
+	Count
+};
+
+struct LatencyHistogram {
+	unsigned int count = 0;
+	double totalMs = 0.0;
+	double maxMs = 0.0;
+	std::array<unsigned int, APP_LATENCY_BUCKETS> buckets = {};
+
+	void Add(double ms);
+
+	/**
+	 * @brief Estimate a percentile, interpolating inside its bucket
+	 * @param fraction 0.5 for the median, 0.9 for the 90th percentile
+	 * @return Milliseconds, 0 for an empty histogram
+	 */
+	double Percentile(double fraction) const;
+
+	nlohmann::ordered_json ToJson() const;
+	static LatencyHistogram FromJson(const nlohmann::json& j);
+};
+
+/**
+ * @brief One application's histograms, as reported by Worst
+ */
+struct AppLatencyRecord {
+	std::string app;
+	std::array<LatencyHistogram, (size_t)LatencyKind::Count> kinds;
+	bool slow = false;
+
+	/**
+	 * @brief Highest median of the kinds with enough samples, what the applications are ranked by
+	 */
+	double WorstMedian() const;
+};
+
+class AppLatency {
+public:
+
+	/**
+	 * @brief Set the statistics file. It isn't read until the statistics are first needed.
+	 */
+	static void Open(const std::filesystem::path& path);
+
+	/**
+	 * @brief Add a sample. Safe to call from any thread.
+	 * @param app Application name from AppName, ignored if empty
+	 */
+	static void Record(const std::string& app, LatencyKind kind, double ms);
+
+	/**
+	 * @brief Check whether an application's median restore, move or probe time is at least APP_LATENCY_SLOW_MS
+	 */
+	static bool IsSlow(const std::string& app);
+
+	/**
+	 * @brief Call Place for every index, scheduling the windows of slow applications apart from the others
+	 *
+	 * Windows of fast applications are placed on this thread in index order. With parallel, each slow window is placed on a thread of
+	 * its own, started before the fast ones so they overlap; without it, the slow windows are placed after the fast ones, in index
+	 * order. Returns once every window has been placed.
+	 *
+	 * @param apps Application of each window, from AppName
+	 * @param Place Places the window at an index, told whether it was scheduled as slow. Must be safe to call from another thread
+	 *        when parallel is set.
+	 * @param parallel Place slow windows on their own threads rather than last
+	 * @param Finish Optional, called on this thread once the fast windows are placed, while slow ones may still be in flight - for
+	 *        callers that batch the fast windows up and move them together
+	 * @return Number of windows that were scheduled as slow
+	 */
+	static int Dispatch(const std::vector<std::string>& apps, const std::function<void(size_t index, bool slow)>& Place, bool parallel,
+		const std::function<void()>& Finish = nullptr);
+
+	/**
+	 * @brief Write the statistics file if anything was recorded since it was last read or written
+	 * @return False if the file couldn't be written
+	 */
+	static bool Flush();
+
+	/**
+	 * @brief Get the slowest applications, slowest first
+	 * @param count Maximum number of applications
+	 */
+	static std::vector<AppLatencyRecord> Worst(size_t count);
+
+	/**
+	 * @brief Print the slowest applications, for `WinWin stats`
+	 *
+	 * Each application gets a line per kind with its sample count, median, 90th percentile and maximum, and is marked when it's slow.
+	 *
+	 * @param count Maximum number of applications
+	 * @param json Print one line of JSON instead, {"command": "stats", "slowMs": 50, "apps": [{"app", "slow", "probe": {"count",
+	 *        "medianMs", "p90Ms", "maxMs"}, "restore", "move"}]}
+	 * @param out Receives the report
+	 */
+	static void Report(size_t count, bool json, std::ostream& out);
+
+	/**
+	 * @brief Application name of a process path - its file name in lower case, so the same application matches wherever it's installed
+	 * @param processPath Full path of the executable, UTF-8
+	 * @return "" for an empty path
+	 */
+	static std::string AppName(const std::string& processPath);
+
+	/**
+	 * @brief Build the statistics file document
+	 */
+	static nlohmann::ordered_json ToJson();
+
+private:
+
+	/**
+	 * @brief Read the file the first time the statistics are needed. Called with s_Mutex held.
+	 */
+	static void Load();
+
+	static std::mutex s_Mutex;
+	static std::map<std::string, std::array<LatencyHistogram, (size_t)LatencyKind::Count>> s_Apps;
+	static std::filesystem::path s_Path;
+	static bool s_Loaded;
+	static bool s_Dirty;
+};
+
+/**
+ * @brief Records the time until it's destroyed as a sample for an application
+ */
+class LatencyTimer {
+public:
+	LatencyTimer(const std::string& app, LatencyKind kind) : m_app(app), m_kind(kind), m_start(std::chrono::steady_clock::now()) {}
+
+	~LatencyTimer() {
+		AppLatency::Record(m_app, m_kind, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count());
+	}
+
+	LatencyTimer(const LatencyTimer&) = delete;
+	LatencyTimer& operator=(const LatencyTimer&) = delete;
+
+private:
+	const std::string& m_app;    // Outlives the timer, it's the caller's
+	LatencyKind m_kind;
+	std::chrono::steady_clock::time_point m_start;
+};
@@ -0,0 +1,408 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// CommandChannel.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.19 created
+//-----------------------------------------------
+// Source code for the command line's IPC channel
+//
+// Defines functions for class CommandChannel. See CommandChannel.h for the frame layout.
+// The transport (named pipe or Unix socket) is picked here, everything above ReadFrame/WriteFrame is shared.
+
+#include "CommandChannel.h"
+#include <cstdint>
+#include <exception>
+#include <chrono>
+
+#ifdef _WIN32
+#include <Windows.h>
+typedef HANDLE ChannelHandle;
+static const ChannelHandle NO_CHANNEL = INVALID_HANDLE_VALUE;
+#else
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+typedef int ChannelHandle;
+static const ChannelHandle NO_CHANNEL = -1;
+#endif
+
+// Largest frame either side accepts, a command's output is the only thing that gets anywhere near it
+#define CHANNEL_MAX_FRAME (16 * 1024 * 1024)
+
+// How long a client waits for a service that's busy with another client's command before running the command itself
+#define CHANNEL_BUSY_WAIT_MS 30000
+
+std::atomic<bool> CommandChannel::s_Stopping(false);
+
+static ChannelHandle s_Listener = NO_CHANNEL;
+
+
+///   FRAMING   ///
+
+static void AppendU32(std::string& out, uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        out.push_back((char)((value >> shift) & 0xFF));
+    }
+}
+
+static bool ReadU32(const std::string& in, size_t& pos, uint32_t& value) {
+    if (in.size() - pos < 4) {
+        return false;
+    }
+    value = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        value |= (uint32_t)(unsigned char)in[pos++] << shift;
+    }
+    return true;
+}
+
+static bool ReadString(const std::string& in, size_t& pos, std::string& value) {
+    uint32_t length;
+    if (!ReadU32(in, pos, length) || in.size() - pos < length) {
+        return false;
+    }
+    value.assign(in, pos, length);
+    pos += length;
+    return true;
+}
+
+std::string CommandChannel::EncodeRequest(const std::vector<std::string>& args) {
+    std::string frame;
+    AppendU32(frame, (uint32_t)args.size());
+    for (const std::string& arg : args) {
+        AppendU32(frame, (uint32_t)arg.size());
+        frame += arg;
+    }
+    return frame;
+}
+
+bool CommandChannel::DecodeRequest(const std::string& frame, std::vector<std::string>& args) {
+    size_t pos = 0;
+    uint32_t count;
+    if (!ReadU32(frame, pos, count) || count > (frame.size() - pos) / 4) { // Every argument takes at least its length
+        return false;
+    }
+    args.assign(count, std::string());
+    for (std::string& arg : args) {
+        if (!ReadString(frame, pos, arg)) {
+            return false;
+        }
+    }
+    return pos == frame.size();
+}
+
+std::string CommandChannel::EncodeReply(const CommandReply& reply) {
+    std::string frame;
+    AppendU32(frame, (uint32_t)reply.status);
+    AppendU32(frame, (uint32_t)reply.output.size());
+    frame += reply.output;
+    return frame;
+}
+
+bool CommandChannel::DecodeReply(const std::string& frame, CommandReply& reply) {
+    size_t pos = 0;
+    uint32_t status;
+    if (!ReadU32(frame, pos, status) || !ReadString(frame, pos, reply.output)) {
+        return false;
+    }
+    reply.status = (int)status;
+    return pos == frame.size();
+}
+
+
+///   TRANSPORT   ///
+
+#ifdef _WIN32
+
+static std::wstring PipeName() {
+    std::string name = CommandChannel::Endpoint();
+    return std::wstring(name.begin(), name.end()); // Plain ASCII
+}
+
+std::string CommandChannel::Endpoint() {
+    DWORD session = 0;
+    ProcessIdToSessionId(GetCurrentProcessId(), &session); // Windows belong to a session, so each session gets its own service
+    return "\\\\.\\pipe\\WinWin-" + std::to_string(session);
+}
+
+static ChannelHandle Connect(DWORD busyWait) {
+    std::wstring name = PipeName();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(busyWait);
+    for (;;) {
+        HANDLE pipe = CreateFileW(name.c_str(), GENERIC_READ | GENERIC_WRITE, 0, NULL, OPEN_EXISTING, 0, NULL);
+        if (pipe != INVALID_HANDLE_VALUE) {
+            return pipe;
+        }
+        if (GetLastError() != ERROR_PIPE_BUSY) {
+            return NO_CHANNEL; // No service
+        }
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count();
+        if (left <= 0 || !WaitNamedPipeW(name.c_str(), (DWORD)left)) { // Another client's command is running, wait for the instance to free up
+            return NO_CHANNEL;
+        }
+    }
+}
+
+static void CloseChannel(ChannelHandle channel) {
+    CloseHandle(channel);
+}
+
+static bool WriteAll(ChannelHandle channel, const char* data, size_t size) {
+    while (size > 0) {
+        DWORD written = 0;
+        if (!WriteFile(channel, data, (DWORD)min(size, (size_t)65536), &written, NULL) || written == 0) {
+            return false;
+        }
+        data += written;
+        size -= written;
+    }
+    return true;
+}
+
+static bool ReadAll(ChannelHandle channel, char* data, size_t size) {
+    while (size > 0) {
+        DWORD read = 0;
+        if (!ReadFile(channel, data, (DWORD)min(size, (size_t)65536), &read, NULL) || read == 0) {
+            return false;
+        }
+        data += read;
+        size -= read;
+    }
+    return true;
+}
+
+bool CommandChannel::Listen() {
+    if (s_Listener != NO_CHANNEL) {
+        return true;
+    }
+    // One instance, reused for every client. FILE_FLAG_FIRST_PIPE_INSTANCE fails if another service already created the pipe, and the
+    // default security only lets the creating user (and administrators) write to it.
+    s_Listener = CreateNamedPipeW(PipeName().c_str(), PIPE_ACCESS_DUPLEX | FILE_FLAG_FIRST_PIPE_INSTANCE,
+        PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT | PIPE_REJECT_REMOTE_CLIENTS, 1, 65536, 65536, 0, NULL);
+    s_Stopping = false;
+    return s_Listener != NO_CHANNEL;
+}
+
+#else
+
+std::string CommandChannel::Endpoint() {
+    const char* runtime = getenv("XDG_RUNTIME_DIR");
+    if (runtime != nullptr && *runtime != '\0') {
+        return std::string(runtime) + "/winwin.sock";
+    }
+    return "/tmp/winwin-" + std::to_string(getuid()) + ".sock";
+}
+
+static bool SocketAddress(sockaddr_un& address) {
+    std::string path = CommandChannel::Endpoint();
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+static ChannelHandle Connect(int busyWait) {
+    (void)busyWait; // Connections queue in the listen backlog until the service gets to them
+    sockaddr_un address;
+    if (!SocketAddress(address)) {
+        return NO_CHANNEL;
+    }
+    int channel = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (channel == -1) {
+        return NO_CHANNEL;
+    }
+    if (connect(channel, (sockaddr*)&address, sizeof(address)) != 0) {
+        close(channel);
+        return NO_CHANNEL;
+    }
+    return channel;
+}
+
+static void CloseChannel(ChannelHandle channel) {
+    close(channel);
+}
+
+static bool WriteAll(ChannelHandle channel, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = send(channel, data, size, MSG_NOSIGNAL); // A client that went away is an error, not a SIGPIPE
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            return false;
+        }
+        data += written;
+        size -= (size_t)written;
+    }
+    return true;
+}
+
+static bool ReadAll(ChannelHandle channel, char* data, size_t size) {
+    while (size > 0) {
+        ssize_t read = recv(channel, data, size, 0);
+        if (read < 0 && errno == EINTR) {
+            continue;
+        }
+        if (read <= 0) {
+            return false;
+        }
+        data += read;
+        size -= (size_t)read;
+    }
+    return true;
+}
+
+bool CommandChannel::Listen() {
+    if (s_Listener != NO_CHANNEL) {
+        return true;
+    }
+    sockaddr_un address;
+    if (!SocketAddress(address)) {
+        return false;
+    }
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener == -1) {
+        return false;
+    }
+    if (bind(listener, (sockaddr*)&address, sizeof(address)) != 0) {
+        int probe = (errno == EADDRINUSE ? Connect(0) : NO_CHANNEL);
+        if (probe != NO_CHANNEL || errno != ECONNREFUSED) { // Someone is listening, or the path can't be used at all
+            if (probe != NO_CHANNEL) {
+                close(probe);
+            }
+            close(listener);
+            return false;
+        }
+        unlink(address.sun_path); // Left behind by a service that didn't shut down cleanly
+        if (bind(listener, (sockaddr*)&address, sizeof(address)) != 0) {
+            close(listener);
+            return false;
+        }
+    }
+    chmod(address.sun_path, S_IRUSR | S_IWUSR); // Only the user who started the service can send it commands
+    if (listen(listener, 16) != 0) {
+        close(listener);
+        unlink(address.sun_path);
+        return false;
+    }
+    s_Listener = listener;
+    s_Stopping = false;
+    return true;
+}
+
+#endif
+
+static bool WriteFrame(ChannelHandle channel, const std::string& frame) {
+    std::string header;
+    AppendU32(header, (uint32_t)frame.size());
+    return WriteAll(channel, header.data(), header.size()) && WriteAll(channel, frame.data(), frame.size());
+}
+
+static bool ReadFrame(ChannelHandle channel, std::string& frame) {
+    std::string header(4, '\0');
+    size_t pos = 0;
+    uint32_t length;
+    if (!ReadAll(channel, &header[0], header.size()) || !ReadU32(header, pos, length) || length > CHANNEL_MAX_FRAME) {
+        return false;
+    }
+    frame.assign(length, '\0');
+    return length == 0 || ReadAll(channel, &frame[0], length);
+}
+
+// Read one request, run it, and write the reply. A malformed request is dropped without a reply.
+static void HandleConnection(ChannelHandle channel, CommandChannel::Handler& handler) {
+    std::string frame;
+    std::vector<std::string> args;
+    if (!ReadFrame(channel, frame) || !CommandChannel::DecodeRequest(frame, args)) {
+        return;
+    }
+    CommandReply reply;
+    try {
+        reply = handler(args);
+    }
+    catch (const std::exception& e) { // One bad command doesn't take the service down
+        reply.status = 1;
+        reply.output = std::string("WinWin service: ") + e.what() + "\n";
+    }
+    WriteFrame(channel, CommandChannel::EncodeReply(reply));
+}
+
+
+///   CLIENT AND SERVER   ///
+
+bool CommandChannel::Send(const std::vector<std::string>& args, CommandReply& reply) {
+    ChannelHandle channel = Connect(CHANNEL_BUSY_WAIT_MS);
+    if (channel == NO_CHANNEL) {
+        return false;
+    }
+    if (!WriteFrame(channel, EncodeRequest(args))) { // The service never saw the whole command, so it's safe to run it here instead
+        CloseChannel(channel);
+        return false;
+    }
+    std::string frame;
+    if (!ReadFrame(channel, frame) || !DecodeReply(frame, reply)) {
+        reply.status = 1;
+        reply.output = "The WinWin service closed the connection before replying\n";
+    }
+    CloseChannel(channel);
+    return true;
+}
+
+void CommandChannel::Serve(Handler handler) {
+    if (s_Listener == NO_CHANNEL) {
+        return;
+    }
+#ifdef _WIN32
+    while (!s_Stopping) {
+        bool connected = ConnectNamedPipe(s_Listener, NULL) || GetLastError() == ERROR_PIPE_CONNECTED;
+        if (connected && !s_Stopping) {
+            HandleConnection(s_Listener, handler);
+            FlushFileBuffers(s_Listener); // Let the client read the reply before the instance is disconnected
+        }
+        DisconnectNamedPipe(s_Listener);
+    }
+    CloseHandle(s_Listener);
+#else
+    while (!s_Stopping) {
+        int channel = accept(s_Listener, NULL, NULL);
+        if (channel == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break; // Stop shut the listener down
+        }
+        HandleConnection(channel, handler);
+        close(channel);
+    }
+    close(s_Listener);
+    sockaddr_un address;
+    if (SocketAddress(address)) {
+        unlink(address.sun_path);
+    }
+#endif
+    s_Listener = NO_CHANNEL;
+}
+
+void CommandChannel::Stop() {
+    s_Stopping = true;
+    if (s_Listener == NO_CHANNEL) {
+        return;
+    }
+#ifdef _WIN32
+    ChannelHandle wake = Connect(1000); // Wakes ConnectNamedPipe. Fails harmlessly if Stop was called by the handler, the loop ends after it anyway.
+    if (wake != NO_CHANNEL) {
+        CloseChannel(wake);
+    }
+#else
+    shutdown(s_Listener, SHUT_RDWR); // Wakes accept
+#endif
+}
@@ -0,0 +1,108 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// CommandChannel.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.19 created
+//-----------------------------------------------
+// Header file for the command line's IPC channel
+//
+// Contains class CommandChannel, which carries WinWin commands from a command line client to the resident service (see
+// WinWinService.h) and the service's reply back.
+// On Windows the channel is a named pipe that's local to the current logon session, everywhere else it's a Unix domain socket in the
+// user's runtime directory, so the framing and the client/server handshake can be exercised on Linux.
+// A connection carries exactly one command:
+//   request - the argument count, then each argument as a length and its bytes
+//   reply   - the exit status, then the command's output as a length and its bytes
+// Lengths and counts are 32 bit little endian. The service handles one connection at a time, so commands from several clients run in
+// the order they connected and never overlap.
+// Like WindowListModel.h, it has no Windows dependencies in the header.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <atomic>
+
+/**
+ * @brief What the service hands back for one command
+ */
+struct CommandReply {
+	int status = 0;         // Exit status for the client to return
+	std::string output;     // Everything the command printed
+};
+
+class CommandChannel {
+public:
+
+	// Runs one command on the service's listener thread
+	typedef std::function<CommandReply(const std::vector<std::string>& args)> Handler;
+
+	/**
+	 * @brief Name of the pipe or path of the socket
+	 */
+	static std::string Endpoint();
+
+	/**
+	 * @brief Send a command to the service and wait for its reply
+	 *
+	 * If the service accepts the command but the connection breaks before the reply arrives, reply has a non zero status and an
+	 * explanation, and the command is not run again in process.
+	 *
+	 * @param args Command and parameters, as typed after WinWin
+	 * @param reply Receives the service's reply
+	 * @return False if no service is listening, so the caller should run the command itself
+	 */
+	static bool Send(const std::vector<std::string>& args, CommandReply& reply);
+
+	/**
+	 * @brief Create the endpoint
+	 * @return False if it couldn't be created, usually because another service already owns it
+	 */
+	static bool Listen();
+
+	/**
+	 * @brief Accept connections and run their commands until Stop is called
+	 *
+	 * Closes the endpoint before returning.
+	 *
+	 * @param handler Runs each command
+	 */
+	static void Serve(Handler handler);
+
+	/**
+	 * @brief Make Serve return once the command it's running (if any) has replied
+	 *
+	 * Safe to call from the handler or from another thread.
+	 */
+	static void Stop();
+
+	/**
+	 * @brief Encode a request frame
+	 */
+	static std::string EncodeRequest(const std::vector<std::string>& args);
+
+	/**
+	 * @brief Decode a request frame
+	 * @return False if the frame is truncated or malformed
+	 */
+	static bool DecodeRequest(const std::string& frame, std::vector<std::string>& args);
+
+	/**
+	 * @brief Encode a reply frame
+	 */
+	static std::string EncodeReply(const CommandReply& reply);
+
+	/**
+	 * @brief Decode a reply frame
+	 * @return False if the frame is truncated or malformed
+	 */
+	static bool DecodeReply(const std::string& frame, CommandReply& reply);
+
+private:
+
+	// Set by Stop()
+	static std::atomic<bool> s_Stopping;
+};
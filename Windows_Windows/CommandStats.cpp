@@ -0,0 +1,86 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// CommandStats.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.21 created
+//-----------------------------------------------
+// Source code for per command results and timings
+//
+// Defines functions for struct CommandStats and classes StatsScope and PhaseTimer. See CommandStats.h.
+
+#include "CommandStats.h"
+
+static thread_local CommandStats* s_Current = nullptr;
+static thread_local PhaseTimer* s_Innermost = nullptr;
+
+CommandStats* CommandStats::Current() {
+    return s_Current;
+}
+
+const char* CommandStats::PhaseName(CommandPhase phase) {
+    switch (phase) {
+    case CommandPhase::Enumerate: return "enumerate";
+    case CommandPhase::Probe:     return "probe";
+    case CommandPhase::Match:     return "match";
+    case CommandPhase::Apply:     return "apply";
+    case CommandPhase::Io:        return "io";
+    default:                      return "";
+    }
+}
+
+nlohmann::ordered_json CommandStats::ToJson(const std::vector<std::string>& args, int status, double totalMicroseconds, const std::string& output) const {
+    nlohmann::ordered_json record; // Keeps the fields in the order they are written
+    record["command"] = args.empty() ? std::string() : args[0];
+    record["args"] = args.size() > 1 ? std::vector<std::string>(args.begin() + 1, args.end()) : std::vector<std::string>();
+    record["status"] = status;
+    record["windows"] = windows;
+    record["matched"] = matched;
+    record["moved"] = moved;
+    record["skipped"] = skipped;
+    record["timedOut"] = timedOut;
+    nlohmann::ordered_json ms = nlohmann::ordered_json::object(); // Milliseconds, to the microsecond
+    for (int phase = 0; phase < (int)CommandPhase::Count; phase++) {
+        ms[PhaseName((CommandPhase)phase)] = phaseMicroseconds[phase] / 1000.0;
+    }
+    ms["total"] = totalMicroseconds / 1000.0;
+    record["ms"] = ms;
+    record["output"] = output;
+    return record;
+}
+
+
+///   STATS SCOPE   ///
+
+StatsScope::StatsScope(CommandStats& stats) : m_previous(s_Current) {
+    s_Current = &stats;
+}
+
+StatsScope::~StatsScope() {
+    s_Current = m_previous;
+}
+
+
+///   PHASE TIMER   ///
+
+PhaseTimer::PhaseTimer(CommandPhase phase) : m_stats(s_Current), m_phase(phase), m_outer(nullptr), m_nested(0.0) {
+    if (m_stats == nullptr) {
+        return; // Not collecting, don't touch the clock
+    }
+    m_outer = s_Innermost;
+    s_Innermost = this;
+    m_start = std::chrono::steady_clock::now();
+}
+
+PhaseTimer::~PhaseTimer() {
+    if (m_stats == nullptr) {
+        return;
+    }
+    double elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_start).count();
+    m_stats->phaseMicroseconds[(int)m_phase] += elapsed - m_nested;
+    if (m_outer != nullptr) {
+        m_outer->m_nested += elapsed;
+    }
+    s_Innermost = m_outer;
+}
@@ -0,0 +1,102 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// CommandStats.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.21 created
+//-----------------------------------------------
+// Header file for per command results and timings
+//
+// Contains struct CommandStats, which collects what one command did (windows matched, moved, skipped, and timed out in the hung
+// window probe) and how long it spent in each phase, and class PhaseTimer, which charges the time of a scope to a phase.
+// WinWinCommands::Execute installs a CommandStats for the thread running a command when --json is passed, and the window operations
+// charge their phases and bump their counters through Current(). When nothing is installed Current() is NULL and a PhaseTimer doesn't
+// read the clock, so the instrumentation costs one thread local read per scope.
+// Phase times are exclusive - a probe inside the enumeration is charged to probe, not to both - so they add up to no more than the
+// total.
+// Like WindowListModel.h, it has no Windows dependencies.
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+/**
+ * @brief Where a command's time goes
+ */
+enum class CommandPhase {
+	Enumerate,    // Listing the open windows or desktop icons
+	Probe,        // Checking that each window responds to messages
+	Match,        // Pairing saved windows or icons with open ones, and working out where they go
+	Apply,        // Moving windows or icons
+	Io,           // Reading and writing layout files
+	Count
+};
+
+struct CommandStats {
+	int windows = 0;     // Windows or icons the command worked on
+	int matched = 0;     // Saved windows paired with an open window, or windows an arrangement was worked out for
+	int moved = 0;       // Windows or icons actually moved
+	int skipped = 0;     // Saved windows with no open match, or open windows the command left alone
+	int timedOut = 0;    // Windows left out because they didn't answer the probe in time
+	double phaseMicroseconds[(int)CommandPhase::Count] = {};
+
+	/**
+	 * @brief Get the stats being collected on this thread
+	 * @return The installed stats, NULL if the command isn't being reported on
+	 */
+	static CommandStats* Current();
+
+	/**
+	 * @brief Build the JSON record for one command, one line of the --json stream
+	 * @param args Command and parameters, options removed
+	 * @param status Exit status
+	 * @param totalMicroseconds Time the whole command took
+	 * @param output Everything the command printed
+	 */
+	nlohmann::ordered_json ToJson(const std::vector<std::string>& args, int status, double totalMicroseconds, const std::string& output) const;
+
+	/**
+	 * @brief Name of a phase, as it appears in the JSON record
+	 */
+	static const char* PhaseName(CommandPhase phase);
+};
+
+/**
+ * @brief Installs a CommandStats as Current() for its lifetime
+ */
+class StatsScope {
+public:
+	explicit StatsScope(CommandStats& stats);
+	~StatsScope();
+
+	StatsScope(const StatsScope&) = delete;
+	StatsScope& operator=(const StatsScope&) = delete;
+
+private:
+	CommandStats* m_previous;
+};
+
+/**
+ * @brief Charges the time until it's destroyed to a phase of Current()
+ *
+ * Timers nest. The inner timer's time is subtracted from the outer one, so each phase only gets the time it spent itself.
+ */
+class PhaseTimer {
+public:
+	explicit PhaseTimer(CommandPhase phase);
+	~PhaseTimer();
+
+	PhaseTimer(const PhaseTimer&) = delete;
+	PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+private:
+	CommandStats* m_stats;    // NULL when nothing is being collected
+	CommandPhase m_phase;
+	PhaseTimer* m_outer;      // Timer this one is nested in
+	std::chrono::steady_clock::time_point m_start;
+	double m_nested;          // Microseconds charged to timers nested in this one
+};
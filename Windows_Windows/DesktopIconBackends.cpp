@@ -0,0 +1,55 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// DesktopIconBackends.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.09 created
+//-----------------------------------------------
+// Source code for desktop icon backend selection
+//
+// Defines functions for static class DesktopIconBackends. See DesktopIconBackends.h for the order backends are tried in.
+
+#include "DesktopIconBackends.h"
+#ifdef _WIN32
+#include "ShellFolderViewIcons.h"
+#include "SysListViewIcons.h"
+#endif
+
+std::unique_ptr<IconListView> DesktopIconBackends::Open(Backend backend) {
+#ifdef _WIN32
+    if (backend == Backend::Auto || backend == Backend::FolderView) {
+        std::unique_ptr<IconListView> Desktop = ShellFolderViewIcons::Open();
+        if (Desktop->IsOpen() || backend == Backend::FolderView) {
+            return Desktop;
+        }
+    }
+    return SysListViewIcons::Open();
+#else
+    (void)backend; // Every backend needs a desktop
+    return SimulatedIconListView::Generate(0); // No desktop to open, an empty simulated one keeps callers working
+#endif
+}
+
+#ifdef _WIN32
+
+// Collects the work area of every monitor for AddWorkAreas
+static BOOL CALLBACK WorkAreaProc(HMONITOR hMonitor, HDC hdc, LPRECT lprcMonitor, LPARAM lParam) {
+    MONITORINFO info;
+    info.cbSize = sizeof(MONITORINFO);
+    if (GetMonitorInfo(hMonitor, &info)) {
+        reinterpret_cast<std::vector<RECT>*>(lParam)->push_back(info.rcWork);
+    }
+    return TRUE;
+}
+
+void DesktopIconBackends::AddWorkAreas(HWND view, IconGrid& grid) {
+    std::vector<RECT> WorkAreas;
+    EnumDisplayMonitors(NULL, NULL, WorkAreaProc, reinterpret_cast<LPARAM>(&WorkAreas));
+    for (RECT& rect : WorkAreas) {
+        MapWindowPoints(HWND_DESKTOP, view, reinterpret_cast<POINT*>(&rect), 2); // Screen to the view's client coordinates
+        grid.areas.push_back({ rect.left, rect.top, rect.right, rect.bottom });
+    }
+}
+
+#endif
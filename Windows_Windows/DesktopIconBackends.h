@@ -0,0 +1,55 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// DesktopIconBackends.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.09 created
+//-----------------------------------------------
+// Header file for desktop icon backend selection
+//
+// Contains static class DesktopIconBackends which opens the best available IconListView for the desktop:
+//   FolderView - ShellFolderViewIcons, the desktop's IFolderView over COM. Bulk reads and a single call to move every icon.
+//   ListView   - SysListViewIcons, list view messages into memory allocated inside Explorer. Needs VM rights on Explorer.
+// The folder view is tried first because it needs no remote memory and moves icons in one call; the list view is the fallback.
+
+#pragma once
+
+#include <memory>
+#include "IconListView.h"
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+class DesktopIconBackends {
+public:
+
+	/**
+	 * @brief Desktop icon backends
+	 */
+	enum class Backend {
+		Auto,        // FolderView, falling back to ListView
+		FolderView,
+		ListView
+	};
+
+	/**
+	 * @brief Open the desktop through a backend
+	 * @param backend Backend to use, Auto picks the first one that opens
+	 * @return The backend. Check IsOpen() - if every backend failed, the last one tried is returned closed.
+	 */
+	static std::unique_ptr<IconListView> Open(Backend backend = Backend::Auto);
+
+#ifdef _WIN32
+	/**
+	 * @brief Fill grid.areas with the work area of every monitor, for the backends' GetGrid
+	 *
+	 * The desktop view spans the bounding box of every monitor, so its client rect includes the parts no monitor shows when the
+	 * monitors differ in size or are offset, and the taskbars. Icons packed there are lost.
+	 *
+	 * @param view Desktop view window. Icon positions are in its client coordinates, so the work areas are converted to them.
+	 * @param grid Grid to add the areas to
+	 */
+	static void AddWorkAreas(HWND view, IconGrid& grid);
+#endif
+};
@@ -0,0 +1,144 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// GdiCache.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.17 created
+//-----------------------------------------------
+// Source code for the UI's GDI resources
+//
+// Defines functions for classes GdiCache and PaintBuffer. See GdiCache.h.
+
+#include "GdiCache.h"
+
+std::unordered_map<COLORREF, HBRUSH> GdiCache::s_Brushes;
+std::unordered_map<int, HFONT> GdiCache::s_Fonts;
+HDC GdiCache::s_BufferDC = NULL;
+HBITMAP GdiCache::s_BufferBitmap = NULL;
+HGDIOBJ GdiCache::s_BufferOldBitmap = NULL;
+SIZE GdiCache::s_BufferSize = { 0, 0 };
+size_t GdiCache::s_Created = 0;
+size_t GdiCache::s_Hits = 0;
+
+HBRUSH GdiCache::Brush(COLORREF color) {
+    auto found = s_Brushes.find(color);
+    if (found != s_Brushes.end()) {
+        s_Hits++;
+        return found->second;
+    }
+    HBRUSH brush = CreateSolidBrush(color);
+    if (brush == NULL) {
+        return (HBRUSH)GetStockObject(WHITE_BRUSH); // Out of GDI objects, paint with something rather than nothing
+    }
+    s_Created++;
+    s_Brushes.emplace(color, brush);
+    return brush;
+}
+
+HFONT GdiCache::Font(int weight) {
+    auto found = s_Fonts.find(weight);
+    if (found != s_Fonts.end()) {
+        s_Hits++;
+        return found->second;
+    }
+    NONCLIENTMETRICSW metrics = { sizeof(metrics) };
+    HFONT font = NULL;
+    if (SystemParametersInfoW(SPI_GETNONCLIENTMETRICS, sizeof(metrics), &metrics, 0)) {
+        metrics.lfMessageFont.lfWeight = weight;
+        font = CreateFontIndirectW(&metrics.lfMessageFont);
+    }
+    if (font == NULL) {
+        return (HFONT)GetStockObject(DEFAULT_GUI_FONT);
+    }
+    s_Created++;
+    s_Fonts.emplace(weight, font);
+    return font;
+}
+
+HDC GdiCache::BackBuffer(HDC compatible, int width, int height) {
+    if (s_BufferDC == NULL) {
+        s_BufferDC = CreateCompatibleDC(compatible);
+        if (s_BufferDC == NULL) {
+            return NULL;
+        }
+        s_Created++;
+    }
+    if (width > s_BufferSize.cx || height > s_BufferSize.cy) { // Grow to the larger of each side so alternating shapes don't reallocate
+        SIZE size = { max(width, s_BufferSize.cx), max(height, s_BufferSize.cy) };
+        HBITMAP bitmap = CreateCompatibleBitmap(compatible, size.cx, size.cy);
+        if (bitmap == NULL) {
+            return NULL;
+        }
+        s_Created++;
+        HGDIOBJ previous = SelectObject(s_BufferDC, bitmap);
+        if (s_BufferBitmap == NULL) {
+            s_BufferOldBitmap = previous;
+        }
+        else {
+            DeleteObject(s_BufferBitmap);
+        }
+        s_BufferBitmap = bitmap;
+        s_BufferSize = size;
+    }
+    return s_BufferDC;
+}
+
+GdiCounters GdiCache::Counters() {
+    GdiCounters counters;
+    counters.brushes = s_Brushes.size();
+    counters.fonts = s_Fonts.size();
+    counters.created = s_Created;
+    counters.hits = s_Hits;
+    counters.gdiObjects = GetGuiResources(GetCurrentProcess(), GR_GDIOBJECTS);
+    counters.peakGdiObjects = GetGuiResources(GetCurrentProcess(), GR_GDIOBJECTS_PEAK);
+    return counters;
+}
+
+void GdiCache::Reset() {
+    for (auto& [color, brush] : s_Brushes) {
+        DeleteObject(brush);
+    }
+    s_Brushes.clear();
+    for (auto& [weight, font] : s_Fonts) {
+        DeleteObject(font);
+    }
+    s_Fonts.clear();
+    if (s_BufferDC != NULL) {
+        if (s_BufferBitmap != NULL) {
+            SelectObject(s_BufferDC, s_BufferOldBitmap); // A bitmap can't be deleted while it's selected
+            DeleteObject(s_BufferBitmap);
+        }
+        DeleteDC(s_BufferDC);
+    }
+    s_BufferDC = NULL;
+    s_BufferBitmap = NULL;
+    s_BufferOldBitmap = NULL;
+    s_BufferSize = { 0, 0 };
+}
+
+
+///   PAINT BUFFER   ///
+
+PaintBuffer::PaintBuffer(HDC target, const RECT& area) : m_target(target), m_dc(target), m_area(area), m_saved(0) {
+    int width = area.right - area.left;
+    int height = area.bottom - area.top;
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    HDC buffer = GdiCache::BackBuffer(target, width, height);
+    if (buffer == NULL) {
+        return;
+    }
+    m_saved = SaveDC(buffer);
+    SetWindowOrgEx(buffer, area.left, area.top, NULL); // The area's top left corner lands on the buffer's origin
+    m_dc = buffer;
+}
+
+PaintBuffer::~PaintBuffer() {
+    if (m_dc == m_target) {
+        return;
+    }
+    BitBlt(m_target, m_area.left, m_area.top, m_area.right - m_area.left, m_area.bottom - m_area.top, m_dc, m_area.left, m_area.top, SRCCOPY);
+    RestoreDC(m_dc, m_saved);
+}
@@ -0,0 +1,70 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// IconDiff.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.12 created
+//-----------------------------------------------
+// Source code for desktop icon snapshot diffing
+//
+// Defines functions for struct IconDiff. See IconDiff.h.
+
+#include "IconDiff.h"
+#include <unordered_map>
+
+IconDiff IconDiff::Compute(const std::vector<IconRecord>& Before, const std::vector<IconRecord>& After) {
+    IconDiff Diff;
+    std::unordered_map<std::string, std::vector<size_t>> byName; // Name -> indices into Before
+    byName.reserve(Before.size());
+    for (size_t i = 0; i < Before.size(); i++) {
+        byName[Before[i].name].push_back(i);
+    }
+    std::vector<bool> beforeUsed(Before.size(), false);
+    std::vector<bool> afterUsed(After.size(), false);
+
+    // 1. Unchanged icons
+    for (size_t i = 0; i < After.size(); i++) {
+        auto found = byName.find(After[i].name);
+        if (found == byName.end()) {
+            continue;
+        }
+        for (size_t candidate : found->second) {
+            if (!beforeUsed[candidate] && Before[candidate].x == After[i].x && Before[candidate].y == After[i].y) {
+                beforeUsed[candidate] = true;
+                afterUsed[i] = true;
+                break;
+            }
+        }
+    }
+
+    // 2. Moved icons, then added ones
+    for (size_t i = 0; i < After.size(); i++) {
+        if (afterUsed[i]) {
+            continue;
+        }
+        auto found = byName.find(After[i].name);
+        bool paired = false;
+        if (found != byName.end()) {
+            for (size_t candidate : found->second) {
+                if (!beforeUsed[candidate]) {
+                    beforeUsed[candidate] = true;
+                    Diff.moved.push_back({ After[i], Before[candidate].x, Before[candidate].y });
+                    paired = true;
+                    break;
+                }
+            }
+        }
+        if (!paired) {
+            Diff.added.push_back(After[i]);
+        }
+    }
+
+    // 3. Removed icons
+    for (size_t i = 0; i < Before.size(); i++) {
+        if (!beforeUsed[i]) {
+            Diff.removed.push_back(Before[i]);
+        }
+    }
+    return Diff;
+}
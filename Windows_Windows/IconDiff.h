@@ -0,0 +1,50 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// IconDiff.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.12 created
+//-----------------------------------------------
+// Header file for desktop icon snapshot diffing
+//
+// Contains struct IconDiff, the icons added, removed and moved between two icon snapshots. Saving a desktop layout over an existing
+// one only writes the diff (see IconLayoutSchema::SaveIncremental), and the DiffDesktop command prints it.
+// Like IconListView.h, it has no Windows dependencies.
+
+#pragma once
+
+#include <vector>
+#include "IconLayoutSchema.h"
+
+struct IconDiff {
+
+	/**
+	 * @brief An icon that is in both snapshots at different positions
+	 */
+	struct Move {
+		IconRecord icon;  // Name and new position
+		int fromX;
+		int fromY;
+	};
+
+	std::vector<IconRecord> added;
+	std::vector<IconRecord> removed;
+	std::vector<Move> moved;
+
+	bool Empty() const { return added.empty() && removed.empty() && moved.empty(); }
+	size_t Size() const { return added.size() + removed.size() + moved.size(); }
+
+	/**
+	 * @brief Compare two icon snapshots
+	 *
+	 * Icons are paired by name. Pairs at the same position are settled first so an unchanged icon is never reported as moved just because
+	 * it shares its name with one that did move. The remaining same-name icons are paired in snapshot order and reported as moved, and
+	 * whatever is left over is added or removed.
+	 *
+	 * @param Before Older snapshot, e.g. the saved layout
+	 * @param After Newer snapshot, e.g. the desktop right now
+	 * @return The changes that turn Before into After
+	 */
+	static IconDiff Compute(const std::vector<IconRecord>& Before, const std::vector<IconRecord>& After);
+};
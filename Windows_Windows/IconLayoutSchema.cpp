@@ -0,0 +1,272 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// IconLayoutSchema.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.12 SaveIncremental leaves a layout it can't load alone instead of overwriting it
+// 10/19/2026 MS-24.01.08.24 Trace spans around Load, Save and SaveIncremental
+// 10/19/2026 MS-24.01.08.21 Loads and saves are charged to the io phase, see CommandStats.h
+// 10/19/2026 MS-24.01.08.12 Added the change journal and SaveIncremental
+// 10/19/2026 MS-24.01.08.10 created
+//-----------------------------------------------
+// Source code for the saved desktop icon layout file format
+//
+// Defines functions for class IconLayoutSchema and the IconRecord JSON conversions. See IconLayoutSchema.h for the version history.
+
+#include "IconLayoutSchema.h"
+#include "IconDiff.h"
+#include "CommandStats.h"
+#include "Trace.h"
+#include <fstream>
+#include <filesystem>
+#include <cstdlib>
+#include <unordered_map>
+
+std::mutex IconLayoutSchema::s_Lock;
+IconLayoutSchema::SavedState IconLayoutSchema::s_LastSaved;
+
+void to_json(nlohmann::json& j, const IconRecord& icon) {
+    j = { {"name", icon.name}, {"x", icon.x}, {"y", icon.y} };
+}
+
+void from_json(const nlohmann::json& j, IconRecord& icon) {
+    auto name = j.find("name");
+    auto x = j.find("x");
+    auto y = j.find("y");
+    icon.name = (name != j.end() && name->is_string() ? name->get<std::string>() : std::string());
+    icon.x = (x != j.end() && x->is_number() ? x->get<int>() : 0);
+    icon.y = (y != j.end() && y->is_number() ? y->get<int>() : 0);
+}
+
+std::vector<IconRecord> IconLayoutSchema::Load(const std::wstring& path) {
+    return TryLoad(path).value_or(std::vector<IconRecord>());
+}
+
+std::optional<std::vector<IconRecord>> IconLayoutSchema::TryLoad(const std::wstring& path) {
+    PhaseTimer timer(CommandPhase::Io);
+    TraceSpan span("LoadIconLayout", "io");
+    std::error_code error;
+    if (!std::filesystem::exists(path, error)) {
+        return std::vector<IconRecord>();
+    }
+    if (std::filesystem::file_size(path, error) == 0 && !error) {
+        return std::vector<IconRecord>(); // Nothing was saved in it, a save cut short before it wrote anything
+    }
+    std::ifstream LayFile{ std::filesystem::path(path) }; // Through path so wide names open on every standard library, not just MSVC's
+    nlohmann::json Doc = nlohmann::json::parse(LayFile, nullptr, false);
+    if (Doc.is_discarded() || Migrate(Doc) == 0) {
+        return std::nullopt;
+    }
+    if (!Doc.is_object() || !Doc.contains("icons") || !Doc["icons"].is_array()) {
+        return std::nullopt;
+    }
+    std::vector<IconRecord> Icons = Doc["icons"].get<std::vector<IconRecord>>();
+    ReplayChanges(ChangesPath(path), Icons);
+    return Icons;
+}
+
+void IconLayoutSchema::Save(const std::wstring& path, const std::vector<IconRecord>& Icons) {
+    PhaseTimer timer(CommandPhase::Io);
+    TraceSpan span("SaveIconLayout", "io");
+    std::ofstream LayFile(std::filesystem::path(path), std::ios::trunc);
+    LayFile << nlohmann::json{ {"version", ICON_LAYOUT_SCHEMA_VERSION}, {"icons", Icons} };
+    LayFile.close();
+    std::error_code error;
+    std::filesystem::remove(ChangesPath(path), error); // Everything in the journal is in the file now
+}
+
+std::optional<IconDiff> IconLayoutSchema::SaveIncremental(const std::wstring& path, const std::vector<IconRecord>& Icons) {
+    PhaseTimer timer(CommandPhase::Io);
+    TraceSpan span("SaveIconLayoutIncremental", "io");
+    std::lock_guard<std::mutex> lock(s_Lock);
+    SavedState current;
+    current.path = path;
+    bool stamped = StampFiles(path, current);
+    if (stamped && s_LastSaved.path == path && s_LastSaved.written == current.written && s_LastSaved.journalSize == current.journalSize) {
+        current.Icons = std::move(s_LastSaved.Icons); // Nothing else wrote to it since the last save, skip the load and the replay
+    }
+    else {
+        std::optional<std::vector<IconRecord>> Loaded = TryLoad(path);
+        if (!Loaded) {
+            return std::nullopt; // Newer or damaged, overwriting it would lose whatever it holds
+        }
+        current.Icons = std::move(*Loaded);
+    }
+    s_LastSaved = SavedState();
+    IconDiff Diff = IconDiff::Compute(current.Icons, Icons);
+    if (Diff.Empty()) {
+        s_LastSaved = std::move(current);
+        return Diff;
+    }
+
+    std::error_code error;
+    std::wstring changesPath = ChangesPath(path);
+    uintmax_t layoutSize = std::filesystem::file_size(path, error);
+    if (current.Icons.empty() || !stamped || layoutSize == (uintmax_t)-1 || current.journalSize > layoutSize) {
+        Save(path, Icons); // New, empty or journal outgrew the layout - write it all and start a fresh journal
+        current.Icons = Icons;
+        if (StampFiles(path, current)) {
+            s_LastSaved = std::move(current);
+        }
+        return Diff;
+    }
+
+    std::ofstream Changes(std::filesystem::path(changesPath), std::ios::app);
+    for (const IconRecord& icon : Diff.added) {
+        nlohmann::json change = icon;
+        change["op"] = "add";
+        Changes << change << "\n";
+    }
+    for (const IconRecord& icon : Diff.removed) {
+        nlohmann::json change = icon;
+        change["op"] = "remove";
+        Changes << change << "\n";
+    }
+    for (const IconDiff::Move& move : Diff.moved) {
+        nlohmann::json change = move.icon;
+        change["op"] = "move";
+        change["fromX"] = move.fromX;
+        change["fromY"] = move.fromY;
+        Changes << change << "\n";
+    }
+    Changes.close();
+    current.Icons = Icons;
+    if (Changes && StampFiles(path, current)) {
+        s_LastSaved = std::move(current);
+    }
+    return Diff;
+}
+
+bool IconLayoutSchema::StampFiles(const std::wstring& path, SavedState& state) {
+    std::error_code error;
+    state.written = std::filesystem::last_write_time(path, error);
+    if (error) {
+        return false;
+    }
+    uintmax_t journalSize = std::filesystem::file_size(ChangesPath(path), error);
+    state.journalSize = (error ? 0 : journalSize);
+    return true;
+}
+
+std::wstring IconLayoutSchema::ChangesPath(const std::wstring& path) {
+    return path + L".changes";
+}
+
+void IconLayoutSchema::ReplayChanges(const std::wstring& path, std::vector<IconRecord>& Icons) {
+    if (!std::filesystem::exists(path)) {
+        return;
+    }
+    std::unordered_map<std::string, std::vector<size_t>> byName; // Name -> indices into Icons, so each change is one lookup
+    for (size_t i = 0; i < Icons.size(); i++) {
+        byName[Icons[i].name].push_back(i);
+    }
+    std::vector<bool> removed(Icons.size(), false);
+
+    // Index of the icon with a name at a position that hasn't been removed, or Icons.size() if there isn't one
+    auto find = [&](const std::string& name, int x, int y) {
+        auto found = byName.find(name);
+        if (found != byName.end()) {
+            for (size_t i : found->second) {
+                if (!removed[i] && Icons[i].x == x && Icons[i].y == y) {
+                    return i;
+                }
+            }
+        }
+        return Icons.size();
+    };
+
+    std::ifstream Changes{ std::filesystem::path(path) };
+    std::string line;
+    while (std::getline(Changes, line)) {
+        nlohmann::json change = nlohmann::json::parse(line, nullptr, false);
+        if (change.is_discarded() || !change.is_object()) {
+            continue;
+        }
+        auto opField = change.find("op");
+        if (opField == change.end() || !opField->is_string()) {
+            continue;
+        }
+        IconRecord icon = change.get<IconRecord>();
+        const std::string& op = opField->get_ref<const std::string&>();
+        if (op == "add") {
+            byName[icon.name].push_back(Icons.size());
+            Icons.push_back(icon);
+            removed.push_back(false);
+        }
+        else if (op == "remove") {
+            size_t i = find(icon.name, icon.x, icon.y);
+            if (i < Icons.size()) {
+                removed[i] = true;
+            }
+        }
+        else if (op == "move") {
+            auto fromX = change.find("fromX");
+            auto fromY = change.find("fromY");
+            if (fromX == change.end() || !fromX->is_number() || fromY == change.end() || !fromY->is_number()) {
+                continue;
+            }
+            size_t i = find(icon.name, fromX->get<int>(), fromY->get<int>());
+            if (i < Icons.size()) {
+                Icons[i].x = icon.x;
+                Icons[i].y = icon.y;
+            }
+        }
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < Icons.size(); i++) {
+        if (!removed[i]) {
+            if (kept != i) {
+                Icons[kept] = std::move(Icons[i]);
+            }
+            kept++;
+        }
+    }
+    Icons.resize(kept);
+}
+
+int IconLayoutSchema::Migrate(nlohmann::json& Doc) {
+    long long savedVersion = 1; // Anything without a version field predates versioning
+    if (Doc.is_object() && Doc.contains("version")) {
+        savedVersion = (Doc["version"].is_number_integer() ? Doc["version"].get<long long>() : 0);
+    }
+    if (savedVersion < 1 || savedVersion > ICON_LAYOUT_SCHEMA_VERSION) {
+        return 0; // Mistyped, or written by a newer WinWin whose fields would be lost by reading it as this version
+    }
+    if (savedVersion == 1) {
+        MigrateV1ToV2(Doc);
+    }
+    // Add the next migration here as "if (savedVersion <= 2) { MigrateV2ToV3(Doc); }"
+    return (int)savedVersion;
+}
+
+void IconLayoutSchema::MigrateV1ToV2(nlohmann::json& Doc) {
+    nlohmann::json icons = nlohmann::json::array();
+    if (Doc.is_array()) { // Empty version 1 layouts were written as null
+        for (const auto& legacy : Doc) {
+            IconRecord icon;
+            auto name = legacy.find("icon");
+            if (name != legacy.end() && name->is_string()) {
+                icon.name = name->get<std::string>();
+            }
+            auto position = legacy.find("position");
+            if (position != legacy.end() && position->is_object()) {
+                icon.x = ParseLegacyCoordinate(position->value("x", nlohmann::json()));
+                icon.y = ParseLegacyCoordinate(position->value("y", nlohmann::json()));
+            }
+            icons.push_back(icon);
+        }
+    }
+    Doc = { {"version", 2}, {"icons", std::move(icons)} };
+}
+
+int IconLayoutSchema::ParseLegacyCoordinate(const nlohmann::json& value) {
+    if (value.is_number()) {
+        return value.get<int>();
+    }
+    if (value.is_string()) {
+        return (int)std::strtol(value.get_ref<const std::string&>().c_str(), nullptr, 10); // strtol doesn't throw, unlike std::stoi
+    }
+    return 0;
+}
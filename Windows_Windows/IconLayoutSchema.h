@@ -0,0 +1,134 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// IconLayoutSchema.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.12 Added TryLoad, SaveIncremental refuses to overwrite a layout it can't read
+// 10/19/2026 MS-24.01.08.12 Added the change journal and SaveIncremental
+// 10/19/2026 MS-24.01.08.10 created
+//-----------------------------------------------
+// Header file for the saved desktop icon layout file format
+//
+// Contains the typed IconRecord and class IconLayoutSchema which reads and writes versioned desktop layout files, the icon
+// counterpart of LayoutSchema.h:
+//   Version 1 - A bare JSON array of {"icon": <name>, "position": {"x": "<int as string>", "y": "<int as string>"}}
+//   Version 2 - {"version": 2, "icons": [ {"name": <UTF-8 name>, "x": <int>, "y": <int>} ]}
+// Loading a file migrates it to IconLayoutSchema::Version in memory, so the coordinates are parsed once during migration rather
+// than on every restore. Like IconListView.h, it has no Windows dependencies.
+//
+// Saving over an existing layout only appends the changes to a journal next to it (<layout>.json.changes), one JSON object per line:
+//   {"op": "add", "name": n, "x": x, "y": y}
+//   {"op": "remove", "name": n, "x": x, "y": y}
+//   {"op": "move", "name": n, "x": x, "y": y, "fromX": x, "fromY": y}
+// Load replays the journal on top of the layout. Once the journal is bigger than the layout itself, the next save rewrites the layout
+// in full and deletes the journal. SaveIncremental keeps the state it last saved, so saving the same layout again only reloads and
+// replays it if something else wrote to it in between.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <nlohmann/json.hpp>
+
+// Version written by IconLayoutSchema::Save
+#define ICON_LAYOUT_SCHEMA_VERSION 2
+
+struct IconDiff;
+
+/**
+ * @brief One saved desktop icon
+ */
+struct IconRecord {
+	std::string name;   // UTF-8
+	int x = 0;
+	int y = 0;
+};
+
+void to_json(nlohmann::json& j, const IconRecord& icon);
+
+// Missing or mistyped fields fall back to the defaults above instead of throwing
+void from_json(const nlohmann::json& j, IconRecord& icon);
+
+class IconLayoutSchema {
+public:
+
+	/**
+	 * @brief Load a desktop layout file, migrate it to the current version and replay its change journal
+	 * @param path Full or relative path of the layout file
+	 * @return The saved icons in file order, empty if the file doesn't exist, isn't valid JSON or has an unsupported version
+	 */
+	static std::vector<IconRecord> Load(const std::wstring& path);
+
+	/**
+	 * @brief Load a desktop layout file like Load, telling a layout that isn't there from one that can't be read
+	 * @param path Full or relative path of the layout file
+	 * @return The saved icons, empty if the file doesn't exist or is empty. Nothing if it exists but isn't valid JSON or has an
+	 *         unsupported version, such as one written by a newer WinWin.
+	 */
+	static std::optional<std::vector<IconRecord>> TryLoad(const std::wstring& path);
+
+	/**
+	 * @brief Write icons as a current version desktop layout file
+	 * @param path Path of the layout file, overwritten if it exists. Its change journal is deleted.
+	 * @param Icons Icons to save
+	 */
+	static void Save(const std::wstring& path, const std::vector<IconRecord>& Icons);
+
+	/**
+	 * @brief Save icons over a layout by writing only what changed
+	 *
+	 * Diffs Icons against the layout and appends the diff to the change journal. Nothing is written if nothing changed.
+	 * The layout is written in full instead if it doesn't exist yet or its journal has outgrown it. A layout that exists but can't be
+	 * loaded (see TryLoad) is left untouched rather than overwritten, since it may have been written by a newer version.
+	 * The layout is only loaded (and its journal replayed) if it isn't the one the last call saved, or its files changed since.
+	 *
+	 * @param path Path of the layout file
+	 * @param Icons Icons to save
+	 * @return What changed since the layout was last saved, everything counts as added for a new layout. Nothing if the layout
+	 *         couldn't be loaded and so wasn't saved.
+	 */
+	static std::optional<IconDiff> SaveIncremental(const std::wstring& path, const std::vector<IconRecord>& Icons);
+
+	// Path of the change journal of a layout file
+	static std::wstring ChangesPath(const std::wstring& path);
+
+	/**
+	 * @brief Bring a parsed desktop layout document up to ICON_LAYOUT_SCHEMA_VERSION
+	 * @param Doc Parsed document, migrated in place
+	 * @return The version the document was saved with, or 0 if its version isn't an integer or is newer than ICON_LAYOUT_SCHEMA_VERSION.
+	 *         Doc is left as it was in that case and Load treats the file as unreadable.
+	 */
+	static int Migrate(nlohmann::json& Doc);
+
+private:
+
+	// Version 1 -> 2: convert the string coordinates to numbers and wrap the array in an object with a version field
+	static void MigrateV1ToV2(nlohmann::json& Doc);
+
+	// Apply every change in a layout's change journal to its icons. Unreadable lines (a save cut short) are skipped.
+	static void ReplayChanges(const std::wstring& path, std::vector<IconRecord>& Icons);
+
+	// Parse a version 1 coordinate, which is a number written as a string. Anything unparseable is 0.
+	static int ParseLegacyCoordinate(const nlohmann::json& value);
+
+	// A layout as SaveIncremental last left it, with what its files looked like right after
+	struct SavedState {
+		std::wstring path;
+		std::filesystem::file_time_type written;  // Last write time of the layout file
+		uintmax_t journalSize = 0;                // Size of the change journal, 0 if there is none
+		std::vector<IconRecord> Icons;
+	};
+
+	// Fill in the written time and journal size of path as they are on disk. False if the layout file can't be read.
+	static bool StampFiles(const std::wstring& path, SavedState& state);
+
+	// Guards s_LastSaved, held for the whole of SaveIncremental
+	static std::mutex s_Lock;
+
+	// The last layout SaveIncremental saved
+	static SavedState s_LastSaved;
+};
@@ -0,0 +1,100 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// IconListView.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.11 Added ReadIconDetails and GetGrid
+// 10/19/2026 MS-24.01.08.08 Added batched SetIconPositions
+// 10/19/2026 MS-24.01.08.06 created
+//-----------------------------------------------
+// Source code for the simulated desktop icon list view
+//
+// Defines the default IconListView::SetIconPositions and the functions for class SimulatedIconListView. See IconListView.h.
+
+#include "IconListView.h"
+#include <chrono>
+
+// Grid of the simulated desktop, the Windows defaults at 100% scaling on a 1920x1080 monitor
+#define SIMULATED_CELL_SIZE 75
+#define SIMULATED_ROWS 14
+#define SIMULATED_COLUMNS 25
+
+void IconListView::SetIconPositions(const std::vector<IconMove>& Moves) {
+    for (const IconMove& move : Moves) {
+        SetIconPosition(move.index, move.x, move.y);
+    }
+}
+
+void IconListView::ReadIconDetails(std::vector<DesktopIcon>& Icons) {
+    for (DesktopIcon& icon : Icons) {
+        size_t dot = icon.name.find_last_of(L'.');
+        icon.type = (dot == std::wstring::npos ? std::wstring() : icon.name.substr(dot + 1));
+    }
+}
+
+SimulatedIconListView::SimulatedIconListView(std::vector<DesktopIcon> icons, unsigned roundTripMicroseconds)
+    : m_icons(std::move(icons)), m_roundTripMicroseconds(roundTripMicroseconds), m_roundTrips(0), m_repaints(0), m_batching(false) {
+    for (size_t i = 0; i < m_icons.size(); i++) {
+        m_icons[i].index = (int)i;
+    }
+}
+
+std::unique_ptr<SimulatedIconListView> SimulatedIconListView::Generate(int count, unsigned roundTripMicroseconds) {
+    std::vector<DesktopIcon> icons;
+    icons.reserve(count);
+    for (int i = 0; i < count; i++) {
+        icons.push_back({ i, L"Icon " + std::to_wstring(i), (i / SIMULATED_ROWS) * SIMULATED_CELL_SIZE, (i % SIMULATED_ROWS) * SIMULATED_CELL_SIZE });
+    }
+    return std::make_unique<SimulatedIconListView>(std::move(icons), roundTripMicroseconds);
+}
+
+std::vector<DesktopIcon> SimulatedIconListView::ReadIcons() {
+    for (size_t i = 0; i < m_icons.size(); i++) {
+        RoundTrip(); // Position message
+        RoundTrip(); // Text message
+    }
+    RoundTrip();     // Bulk read of every slot
+    return m_icons;
+}
+
+void SimulatedIconListView::SetIconPosition(int index, int x, int y) {
+    RoundTrip();
+    if (!m_batching) {
+        m_repaints++;
+    }
+    if (index >= 0 && index < (int)m_icons.size()) {
+        m_icons[index].x = x;
+        m_icons[index].y = y;
+    }
+}
+
+void SimulatedIconListView::SetIconPositions(const std::vector<IconMove>& Moves) {
+    if (Moves.empty()) {
+        return;
+    }
+    m_batching = true;
+    IconListView::SetIconPositions(Moves);
+    m_batching = false;
+    m_repaints++;
+}
+
+bool SimulatedIconListView::GetGrid(IconGrid& grid) {
+    int columns = SIMULATED_COLUMNS;
+    int needed = ((int)m_icons.size() + SIMULATED_ROWS - 1) / SIMULATED_ROWS;
+    if (needed > columns) {
+        columns = needed; // Benchmarks with thousands of icons get a desktop wide enough to hold them
+    }
+    grid = { 0, 0, SIMULATED_CELL_SIZE, SIMULATED_CELL_SIZE, columns, SIMULATED_ROWS };
+    return true;
+}
+
+void SimulatedIconListView::RoundTrip() {
+    m_roundTrips++;
+    if (m_roundTripMicroseconds == 0) {
+        return;
+    }
+    // Spin rather than sleep, sleeping rounds up to the scheduler tick and would swamp microsecond latencies
+    auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(m_roundTripMicroseconds);
+    while (std::chrono::steady_clock::now() < end) {}
+}
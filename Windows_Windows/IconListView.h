@@ -0,0 +1,171 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// IconListView.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.11 Added icon type/date details and IconGrid for IconPlacer
+// 10/19/2026 MS-24.01.08.08 Added IconMove and batched SetIconPositions
+// 10/19/2026 MS-24.01.08.06 created
+//-----------------------------------------------
+// Header file for the desktop icon list view interface
+//
+// Contains the DesktopIcon record, the abstract class IconListView which every desktop icon backend implements, and
+// SimulatedIconListView, an in-memory list view used to benchmark the icon code without a desktop.
+//
+// Nothing in this file depends on Windows headers, so the simulated list view and everything built on the interface compiles
+// and runs on Linux. The Windows backends live in their own files (see SysListViewIcons.h).
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+
+/**
+ * @brief One icon on the desktop as read from a list view
+ */
+struct DesktopIcon {
+	int index;          // Item index in the list view, only valid until the desktop changes
+	std::wstring name;  // Icon text as shown on the desktop
+	int x;
+	int y;
+	std::wstring type = L"";  // Item type, only filled by ReadIconDetails
+	long long modified = 0;   // Last modified time as a FILETIME value, only filled by ReadIconDetails. 0 if unknown.
+};
+
+/**
+ * @brief A rectangle in desktop coordinates, right and bottom exclusive
+ */
+struct IconArea {
+	int left;
+	int top;
+	int right;
+	int bottom;
+};
+
+/**
+ * @brief The desktop's icon grid in desktop coordinates
+ */
+struct IconGrid {
+	int left;
+	int top;
+	int cellWidth;
+	int cellHeight;
+	int columns;
+	int rows;
+	std::vector<IconArea> areas = {};  // Parts of the grid that are on screen (the monitor work areas), empty if all of it is
+};
+
+/**
+ * @brief An icon that has to be moved to restore a layout
+ */
+struct IconMove {
+	int index;  // List view index of the icon
+	int x;
+	int y;
+};
+
+class IconListView {
+public:
+	virtual ~IconListView() = default;
+
+	/**
+	 * @brief Check that the backend found the desktop and can read it
+	 */
+	virtual bool IsOpen() const = 0;
+
+	/**
+	 * @brief Read the name and position of every icon on the desktop
+	 * @return Icons in list view order
+	 */
+	virtual std::vector<DesktopIcon> ReadIcons() = 0;
+
+	/**
+	 * @brief Move one icon
+	 * @param index List view index of the icon, see DesktopIcon::index
+	 * @param x New x position in desktop coordinates
+	 * @param y New y position in desktop coordinates
+	 */
+	virtual void SetIconPosition(int index, int x, int y) = 0;
+
+	/**
+	 * @brief Move several icons as one batch
+	 *
+	 * The default implementation calls SetIconPosition for each move. Backends that can suspend drawing override it so the desktop is
+	 * repainted once for the whole batch.
+	 *
+	 * @param Moves Icons to move, see IconMatcher::MoveSet
+	 */
+	virtual void SetIconPositions(const std::vector<IconMove>& Moves);
+
+	/**
+	 * @brief Fill in the type and modified time of icons read by ReadIcons
+	 *
+	 * Only needed to sort icons by type or date, so it's kept out of ReadIcons. The default implementation takes the type from the
+	 * extension in the icon name and leaves the modified time unknown.
+	 *
+	 * @param Icons Icons from the last ReadIcons
+	 */
+	virtual void ReadIconDetails(std::vector<DesktopIcon>& Icons);
+
+	/**
+	 * @brief Get the grid the desktop lays icons out on
+	 * @param grid Receives the grid
+	 * @return False if the backend can't tell
+	 */
+	virtual bool GetGrid(IconGrid& grid) = 0;
+};
+
+/**
+ * @brief In-memory list view for benchmarks
+ *
+ * Holds a vector of icons and charges a configurable delay for every call that would be a cross-process round trip on a real
+ * desktop: one per icon for the position message, one per icon for the text message, and one for the bulk memory read.
+ * RoundTrips() counts them so a benchmark can compare backends by round trips as well as by time.
+ */
+class SimulatedIconListView : public IconListView {
+public:
+
+	/**
+	 * @brief Create a simulated desktop
+	 * @param icons Icons on the desktop. index is overwritten with each icon's position in the vector.
+	 * @param roundTripMicroseconds Time each simulated round trip takes
+	 */
+	SimulatedIconListView(std::vector<DesktopIcon> icons, unsigned roundTripMicroseconds = 0);
+
+	/**
+	 * @brief Create a simulated desktop with generated icons named "Icon 0", "Icon 1" ... laid out in columns
+	 * @param count Number of icons
+	 * @param roundTripMicroseconds Time each simulated round trip takes
+	 */
+	static std::unique_ptr<SimulatedIconListView> Generate(int count, unsigned roundTripMicroseconds = 0);
+
+	bool IsOpen() const override { return true; }
+	bool GetGrid(IconGrid& grid) override;
+	std::vector<DesktopIcon> ReadIcons() override;
+	void SetIconPosition(int index, int x, int y) override;
+
+	// Moves every icon and counts a single repaint for the batch
+	void SetIconPositions(const std::vector<IconMove>& Moves) override;
+
+	// Icons as they currently are, including every SetIconPosition
+	const std::vector<DesktopIcon>& Icons() const { return m_icons; }
+
+	// Number of simulated cross-process round trips so far
+	unsigned long long RoundTrips() const { return m_roundTrips; }
+
+	// Number of times the simulated desktop would have repainted: once per single move, once per batch
+	unsigned long long Repaints() const { return m_repaints; }
+
+private:
+
+	// Count a round trip and wait for its simulated latency
+	void RoundTrip();
+
+	std::vector<DesktopIcon> m_icons;
+	unsigned m_roundTripMicroseconds;
+	unsigned long long m_roundTrips;
+	unsigned long long m_repaints;
+	bool m_batching;
+};
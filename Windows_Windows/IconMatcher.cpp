@@ -0,0 +1,64 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// IconMatcher.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.08 Added MoveSet
+// 10/19/2026 MS-24.01.08.07 created
+//-----------------------------------------------
+// Source code for matching desktop icons to a saved icon layout
+//
+// Defines functions for class IconMatcher. See IconMatcher.h.
+
+#include "IconMatcher.h"
+
+IconMatcher::IconMatcher(std::vector<DesktopIcon> Saved) : m_saved(std::move(Saved)), m_claimed(m_saved.size(), false) {
+    m_byName.reserve(m_saved.size());
+    for (size_t i = 0; i < m_saved.size(); i++) {
+        m_byName[m_saved[i].name].push_back(i);
+    }
+}
+
+const DesktopIcon* IconMatcher::Match(const DesktopIcon& live) {
+    auto found = m_byName.find(live.name);
+    if (found == m_byName.end()) {
+        return nullptr;
+    }
+
+    size_t best = m_saved.size();
+    long long bestDistance = -1;
+    for (size_t candidate : found->second) { // Almost always a single candidate
+        if (m_claimed[candidate]) {
+            continue;
+        }
+        const DesktopIcon& saved = m_saved[candidate];
+        if (saved.index == live.index) { // Same slot in the list view, nothing is a better match than that
+            best = candidate;
+            break;
+        }
+        long long dx = saved.x - live.x;
+        long long dy = saved.y - live.y;
+        long long distance = dx * dx + dy * dy;
+        if (bestDistance < 0 || distance < bestDistance) {
+            best = candidate;
+            bestDistance = distance;
+        }
+    }
+    if (best == m_saved.size()) {
+        return nullptr;
+    }
+    m_claimed[best] = true;
+    return &m_saved[best];
+}
+
+std::vector<IconMove> IconMatcher::MoveSet(const std::vector<DesktopIcon>& Live) {
+    std::vector<IconMove> Moves;
+    for (const DesktopIcon& live : Live) {
+        const DesktopIcon* saved = Match(live);
+        if (saved != nullptr && (saved->x != live.x || saved->y != live.y)) { // Icons already in place cost nothing
+            Moves.push_back({ live.index, saved->x, saved->y });
+        }
+    }
+    return Moves;
+}
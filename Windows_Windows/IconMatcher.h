@@ -0,0 +1,58 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// IconMatcher.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.08 Added MoveSet
+// 10/19/2026 MS-24.01.08.07 created
+//-----------------------------------------------
+// Header file for matching desktop icons to a saved icon layout
+//
+// Contains class IconMatcher which indexes the icons of a saved desktop layout by name so each live icon is matched with a single
+// hash lookup instead of a scan over every saved icon. Like IconListView.h, it has no Windows dependencies.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "IconListView.h"
+
+class IconMatcher {
+public:
+
+	/**
+	 * @brief Index the icons of a saved layout
+	 * @param Saved Saved icons with names already converted to wide strings. index must be the icon's position in the saved file.
+	 */
+	explicit IconMatcher(std::vector<DesktopIcon> Saved);
+
+	/**
+	 * @brief Find the saved icon for a live icon and claim it
+	 *
+	 * Names are unique on most desktops, so this is one hash lookup. When several saved icons share the name (shortcuts with the same
+	 * label in different folders), the one saved at the same list view index wins, otherwise the unclaimed one closest to the live
+	 * icon's current position. A claimed saved icon is never returned again, so duplicates are spread over duplicates instead of
+	 * stacking on one spot.
+	 *
+	 * @param live Icon read from the desktop
+	 * @return The saved icon, or nullptr if there is no unclaimed saved icon with that name
+	 */
+	const DesktopIcon* Match(const DesktopIcon& live);
+
+	/**
+	 * @brief Match every live icon and keep only the ones that aren't already where they were saved
+	 * @param Live Icons read from the desktop
+	 * @return Icons that have to move, in list view order
+	 */
+	std::vector<IconMove> MoveSet(const std::vector<DesktopIcon>& Live);
+
+	// Number of saved icons
+	size_t Size() const { return m_saved.size(); }
+
+private:
+	std::vector<DesktopIcon> m_saved;
+	std::vector<bool> m_claimed;
+	std::unordered_map<std::wstring, std::vector<size_t>> m_byName; // Saved icon name -> indices into m_saved, in file order
+};
@@ -0,0 +1,149 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// IconPlacer.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.11 ParseSortRule returns nothing for an unknown rule instead of Name
+// 10/19/2026 MS-24.01.08.11 created
+//-----------------------------------------------
+// Source code for the desktop icon placement engine
+//
+// Defines functions for class IconPlacer. See IconPlacer.h.
+
+#include "IconPlacer.h"
+#include <algorithm>
+#include <cwctype>
+
+// Case insensitive name comparison for the Name rule and as the tie breaker of the other rules
+static bool NameLess(const DesktopIcon* a, const DesktopIcon* b) {
+    return std::lexicographical_compare(a->name.begin(), a->name.end(), b->name.begin(), b->name.end(),
+        [](wchar_t l, wchar_t r) { return std::towlower(l) < std::towlower(r); });
+}
+
+IconPlacer::IconPlacer(const IconGrid& grid, bool snap) : m_grid(grid), m_snap(snap) {
+    if (m_grid.columns < 0) m_grid.columns = 0;
+    if (m_grid.rows < 0) m_grid.rows = 0;
+    m_occupied.assign(((size_t)m_grid.columns * m_grid.rows + 63) / 64, 0);
+    if (!m_grid.areas.empty()) {
+        const int cellCount = m_grid.columns * m_grid.rows;
+        for (int cell = 0; cell < cellCount; cell++) {
+            if (!CellOnScreen(cell)) {
+                Occupy(cell); // Off every monitor, packing must skip it
+            }
+        }
+    }
+}
+
+bool IconPlacer::CellOnScreen(int cell) const {
+    int x, y;
+    CellPosition(cell, x, y);
+    for (const IconArea& area : m_grid.areas) {
+        if (x >= area.left && y >= area.top && x + m_grid.cellWidth <= area.right && y + m_grid.cellHeight <= area.bottom) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int IconPlacer::CellAt(int x, int y) const {
+    if (m_grid.cellWidth <= 0 || m_grid.cellHeight <= 0) {
+        return -1;
+    }
+    int column = (x - m_grid.left + m_grid.cellWidth / 2) / m_grid.cellWidth;   // Round to the nearest cell
+    int row = (y - m_grid.top + m_grid.cellHeight / 2) / m_grid.cellHeight;
+    if (x < m_grid.left - m_grid.cellWidth / 2 || y < m_grid.top - m_grid.cellHeight / 2 || column >= m_grid.columns || row >= m_grid.rows) {
+        return -1;
+    }
+    return column * m_grid.rows + row;
+}
+
+void IconPlacer::CellPosition(int cell, int& x, int& y) const {
+    x = m_grid.left + (cell / m_grid.rows) * m_grid.cellWidth;
+    y = m_grid.top + (cell % m_grid.rows) * m_grid.cellHeight;
+}
+
+std::vector<const DesktopIcon*> IconPlacer::RestoreSaved(const std::vector<DesktopIcon>& Live, IconMatcher& Matcher, std::vector<IconMove>& Moves) {
+    std::vector<const DesktopIcon*> NewIcons;
+    for (const DesktopIcon& live : Live) {
+        const DesktopIcon* saved = Matcher.Match(live);
+        if (saved == nullptr) {
+            NewIcons.push_back(&live);
+            continue;
+        }
+        int x = saved->x;
+        int y = saved->y;
+        int cell = CellAt(x, y);
+        if (cell >= 0) {
+            if (m_snap) {
+                CellPosition(cell, x, y);
+            }
+            Occupy(cell);
+        }
+        if (x != live.x || y != live.y) {
+            Moves.push_back({ live.index, x, y });
+        }
+    }
+    return NewIcons;
+}
+
+std::vector<IconMove> IconPlacer::Restore(const std::vector<DesktopIcon>& Live, IconMatcher& Matcher) {
+    std::vector<IconMove> Moves;
+    RestoreSaved(Live, Matcher, Moves);
+    return Moves;
+}
+
+std::vector<IconMove> IconPlacer::Arrange(const std::vector<DesktopIcon>& Live, IconMatcher& Matcher, IconSortRule rule) {
+    // 1. Saved icons go back where they were and claim their cells
+    std::vector<IconMove> Moves;
+    std::vector<const DesktopIcon*> NewIcons = RestoreSaved(Live, Matcher, Moves);
+
+    // 2. Sort the new icons
+    switch (rule) {
+    case IconSortRule::Name:
+        std::sort(NewIcons.begin(), NewIcons.end(), NameLess);
+        break;
+    case IconSortRule::Type:
+        std::sort(NewIcons.begin(), NewIcons.end(), [](const DesktopIcon* a, const DesktopIcon* b) {
+            return (a->type != b->type ? a->type < b->type : NameLess(a, b));
+        });
+        break;
+    case IconSortRule::Date:
+        std::sort(NewIcons.begin(), NewIcons.end(), [](const DesktopIcon* a, const DesktopIcon* b) {
+            return (a->modified != b->modified ? a->modified > b->modified : NameLess(a, b));
+        });
+        break;
+    }
+
+    // 3. Pack them into free cells. The cursor never moves back, so the whole pass touches each cell at most once.
+    const int cellCount = m_grid.columns * m_grid.rows;
+    int cursor = 0;
+    for (const DesktopIcon* icon : NewIcons) {
+        while (cursor < cellCount && Occupied(cursor)) {
+            cursor++;
+        }
+        if (cursor >= cellCount) {
+            break; // Grid is full, leave the rest where Explorer put them
+        }
+        Occupy(cursor);
+        int x, y;
+        CellPosition(cursor, x, y);
+        if (x != icon->x || y != icon->y) {
+            Moves.push_back({ icon->index, x, y });
+        }
+    }
+    return Moves;
+}
+
+std::optional<IconSortRule> IconPlacer::ParseSortRule(const std::string& rule) {
+    if (rule == "name") {
+        return IconSortRule::Name;
+    }
+    if (rule == "type") {
+        return IconSortRule::Type;
+    }
+    if (rule == "date") {
+        return IconSortRule::Date;
+    }
+    return std::nullopt; // A typo mustn't turn a plain restore into a repack of the whole desktop
+}
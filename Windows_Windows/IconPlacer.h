@@ -0,0 +1,100 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// IconPlacer.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.11 ParseSortRule rejects rules it doesn't know
+// 10/19/2026 MS-24.01.08.11 created
+//-----------------------------------------------
+// Header file for the desktop icon placement engine
+//
+// Contains class IconPlacer which plans where every icon on the desktop goes when a layout is restored. Saved icons go back to
+// their saved positions and, when asked to, icons that aren't in the layout are packed into the free grid cells closest to the grid
+// origin, in the order Explorer fills them (top to bottom, then left to right). Cells are tracked in an occupancy bitmap and filled
+// with a single cursor that only ever moves forward, so packing costs one pass over the grid no matter how many icons there are.
+// On a desktop spanning several monitors the grid covers their bounding box, so cells that aren't inside one of the grid's areas
+// (the gaps next to a smaller monitor, the taskbar) are marked occupied up front and never packed into.
+// Like IconListView.h, it has no Windows dependencies.
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include "IconListView.h"
+#include "IconMatcher.h"
+
+/**
+ * @brief Order icons that aren't in the saved layout are packed in
+ */
+enum class IconSortRule {
+	Name,   // Alphabetical, ignoring case
+	Type,   // By item type, then name
+	Date    // Most recently modified first, then name
+};
+
+class IconPlacer {
+public:
+
+	/**
+	 * @brief Create a placer for a desktop grid
+	 * @param grid Grid from IconListView::GetGrid. Cells outside grid.areas are never packed into.
+	 * @param snap Also snap restored icons to the nearest cell instead of their exact saved pixels
+	 */
+	IconPlacer(const IconGrid& grid, bool snap = false);
+
+	/**
+	 * @brief Plan the moves that restore a layout and pack every other icon
+	 *
+	 * 1. Match every live icon against the saved layout. Matched icons are assigned their saved position and its cell is marked used.
+	 * 2. Sort the unmatched icons by the sort rule
+	 * 3. Give each unmatched icon the next free cell in fill order
+	 * Icons that end up where they already are aren't part of the result. If the grid fills up, the rest of the new icons stay put.
+	 *
+	 * @param Live Icons read from the desktop. For the Type and Date rules, call IconListView::ReadIconDetails on them first.
+	 * @param Matcher Saved layout
+	 * @param rule Order to pack new icons in
+	 * @return Icons to move
+	 */
+	std::vector<IconMove> Arrange(const std::vector<DesktopIcon>& Live, IconMatcher& Matcher, IconSortRule rule);
+
+	/**
+	 * @brief Plan the moves that restore a layout, leaving icons that aren't in it where they are
+	 *
+	 * Step 1 of Arrange only. Without snap this is the same move set as IconMatcher::MoveSet.
+	 *
+	 * @param Live Icons read from the desktop
+	 * @param Matcher Saved layout
+	 * @return Icons to move
+	 */
+	std::vector<IconMove> Restore(const std::vector<DesktopIcon>& Live, IconMatcher& Matcher);
+
+	/**
+	 * @brief Parse a sort rule from the command line
+	 * @param rule "name", "type" or "date"
+	 * @return The rule, empty if it isn't recognized
+	 */
+	static std::optional<IconSortRule> ParseSortRule(const std::string& rule);
+
+private:
+
+	// Send every matched icon back to its saved position and claim its cell. Returns the icons that aren't in the layout.
+	std::vector<const DesktopIcon*> RestoreSaved(const std::vector<DesktopIcon>& Live, IconMatcher& Matcher, std::vector<IconMove>& Moves);
+
+	// True if the whole cell is inside one of the grid's areas
+	bool CellOnScreen(int cell) const;
+
+	// Cell index of a position, in fill order (column major). -1 if it's off the grid.
+	int CellAt(int x, int y) const;
+
+	// Top left corner of a cell
+	void CellPosition(int cell, int& x, int& y) const;
+
+	bool Occupied(int cell) const { return (m_occupied[cell >> 6] >> (cell & 63)) & 1; }
+	void Occupy(int cell) { m_occupied[cell >> 6] |= (1ULL << (cell & 63)); }
+
+	IconGrid m_grid;
+	bool m_snap;
+	std::vector<uint64_t> m_occupied;  // One bit per cell
+};
@@ -0,0 +1,220 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// LayoutHistory.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.01 Windows saved with any minimized show state are restored minimized, a failed batch falls back to SetWindowPos
+// 10/19/2026 MS-24.01.08.25 The DeferWindowPos batch records each window's share of its time as a move latency
+// 10/19/2026 MS-24.01.08.25 ApplyPlacements moves windows of slow applications on their own threads instead of in the batch, see AppLatency.h
+// 10/19/2026 MS-24.01.08.24 Trace spans around captures and both ApplyPlacements passes
+// 10/19/2026 MS-24.01.08.21 ApplyPlacements counts the windows it moves, see CommandStats.h
+// 10/19/2026 MS-24.01.08.15 Undo/redo counts are atomic
+// 10/19/2026 MS-24.01.08.01 created
+//-----------------------------------------------
+// Source code for the arrangement undo/redo history
+//
+// Defines functions for class LayoutHistory. See LayoutHistory.h for an overview of the ring buffer.
+
+#include "LayoutHistory.h"
+#include "CommandStats.h"
+#include "Trace.h"
+#include "AppLatency.h"
+#include "WinWinFunctions.h"
+#include <string>
+#include <chrono>
+
+std::array<std::vector<LayoutHistory::CapturedPlacement>, HISTORY_CAPACITY> LayoutHistory::s_Ring;
+size_t LayoutHistory::s_Cursor = 0;
+std::atomic<size_t> LayoutHistory::s_UndoCount = 0;
+std::atomic<size_t> LayoutHistory::s_RedoCount = 0;
+double LayoutHistory::s_LastCaptureUs = 0.0;
+
+void LayoutHistory::CaptureInto(std::vector<CapturedPlacement>& Slot, const std::vector<HWND>& WindowVect) {
+    Slot.clear(); // clear() keeps the capacity, so a slot that has been used before doesn't allocate again
+    Slot.reserve(WindowVect.size());
+    CapturedPlacement captured;
+    for (HWND ctrl : WindowVect) {
+        captured.hwnd = ctrl;
+        captured.placement.length = sizeof(WINDOWPLACEMENT);
+        if (!GetWindowPlacement(ctrl, &captured.placement) || !GetWindowRect(ctrl, &captured.windowRect)) {
+            continue; // Window closed between enumeration and capture
+        }
+        Slot.push_back(captured);
+    }
+}
+
+void LayoutHistory::Capture(const std::vector<HWND>& WindowVect) {
+    TraceSpan span("CaptureHistory", "history");
+    span.SetValue((long long)WindowVect.size());
+    LARGE_INTEGER frequency, start, end;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&start);
+
+    CaptureInto(s_Ring[s_Cursor], WindowVect);
+    s_Cursor = (s_Cursor + 1) % HISTORY_CAPACITY;
+    if (s_UndoCount < HISTORY_CAPACITY) { s_UndoCount++; } // Once full, the oldest record is overwritten
+    s_RedoCount = 0;
+
+    QueryPerformanceCounter(&end);
+    s_LastCaptureUs = double(end.QuadPart - start.QuadPart) * 1000000.0 / double(frequency.QuadPart);
+}
+
+bool LayoutHistory::Undo() {
+    if (s_UndoCount == 0) {
+        return false;
+    }
+    s_Cursor = (s_Cursor + HISTORY_CAPACITY - 1) % HISTORY_CAPACITY;
+    std::vector<CapturedPlacement>& slot = s_Ring[s_Cursor];
+
+    // Swap the slot with the current placement of the same windows so Redo can take them back to where they are now
+    std::vector<HWND> windows;
+    windows.reserve(slot.size());
+    for (const CapturedPlacement& captured : slot) {
+        windows.push_back(captured.hwnd);
+    }
+    std::vector<CapturedPlacement> previous;
+    previous.swap(slot);
+    CaptureInto(slot, windows);
+    ApplyPlacements(previous);
+
+    s_UndoCount--;
+    s_RedoCount++;
+    return true;
+}
+
+bool LayoutHistory::Redo() {
+    if (s_RedoCount == 0) {
+        return false;
+    }
+    std::vector<CapturedPlacement>& slot = s_Ring[s_Cursor];
+
+    std::vector<HWND> windows;
+    windows.reserve(slot.size());
+    for (const CapturedPlacement& captured : slot) {
+        windows.push_back(captured.hwnd);
+    }
+    std::vector<CapturedPlacement> undone;
+    undone.swap(slot);
+    CaptureInto(slot, windows);
+    ApplyPlacements(undone);
+
+    s_Cursor = (s_Cursor + 1) % HISTORY_CAPACITY;
+    s_RedoCount--;
+    s_UndoCount++;
+    return true;
+}
+
+bool LayoutHistory::CanUndo() {
+    return s_UndoCount > 0;
+}
+
+bool LayoutHistory::CanRedo() {
+    return s_RedoCount > 0;
+}
+
+double LayoutHistory::LastCaptureMicroseconds() {
+    return s_LastCaptureUs;
+}
+
+// True if a saved show command leaves the window in the normal state, i.e. neither minimized (by any of the minimizing commands) nor maximized
+static bool IsNormalShowCmd(UINT showCmd) {
+    return showCmd != SW_SHOWMINIMIZED && showCmd != SW_MINIMIZE && showCmd != SW_SHOWMINNOACTIVE && showCmd != SW_FORCEMINIMIZE
+        && showCmd != SW_SHOWMAXIMIZED;
+}
+
+// Move one window to its captured rect with SetWindowPos, unless it has closed or isn't in the normal state
+static void MoveToCapturedRect(const LayoutHistory::CapturedPlacement& captured, const std::string& app) {
+    if (!IsWindow(captured.hwnd) || IsIconic(captured.hwnd) || IsZoomed(captured.hwnd)) {
+        return;
+    }
+    TraceSpan span("SetWindowPos", "apply");
+    span.SetValue((long long)(INT_PTR)captured.hwnd);
+    LatencyTimer move(app, LatencyKind::Move);
+    SetWindowPos(captured.hwnd, NULL,
+        captured.windowRect.left,
+        captured.windowRect.top,
+        captured.windowRect.right - captured.windowRect.left,
+        captured.windowRect.bottom - captured.windowRect.top,
+        SWP_NOZORDER | SWP_NOACTIVATE);
+}
+
+void LayoutHistory::ApplyPlacements(const std::vector<CapturedPlacement>& Placements) {
+    std::vector<std::string> Apps(Placements.size()); // Looked up before any window is placed, the process cache isn't shared between threads
+    int liveCount = 0;
+    for (size_t i = 0; i < Placements.size(); i++) {
+        if (IsWindow(Placements[i].hwnd)) {
+            Apps[i] = WinWinFunctions::AppName(Placements[i].hwnd);
+            liveCount++;
+        }
+    }
+    if (CommandStats* stats = CommandStats::Current()) {
+        stats->moved += liveCount;
+    }
+
+    std::vector<size_t> Batch; // Normal windows of fast applications, only touched on this thread
+    AppLatency::Dispatch(Apps, [&](size_t i, bool slow) {
+        const CapturedPlacement& captured = Placements[i];
+        if (!IsWindow(captured.hwnd)) {
+            return;
+        }
+        // First pass - windows whose show state changes can't go through DeferWindowPos, so restore their state with SetWindowPlacement
+        bool savedNormal = IsNormalShowCmd(captured.placement.showCmd);
+        bool currentlyNormal = !IsIconic(captured.hwnd) && !IsZoomed(captured.hwnd);
+        if (!savedNormal || !currentlyNormal) {
+            TraceSpan span("SetWindowPlacement", "apply");
+            span.SetValue((long long)(INT_PTR)captured.hwnd);
+            LatencyTimer restore(Apps[i], LatencyKind::Restore);
+            SetWindowPlacement(captured.hwnd, &captured.placement);
+        }
+        if (!savedNormal) {
+            return;
+        }
+        if (!slow) {
+            Batch.push_back(i);
+            return;
+        }
+        MoveToCapturedRect(captured, Apps[i]); // A slow application would hold up the whole batch, so its window is moved on its own
+    }, true, [&] {
+        if (Batch.empty()) {
+            return;
+        }
+
+        // Second pass - move every other normal window in one batch
+        TraceSpan batch("DeferWindowPos", "apply");
+        batch.SetValue((long long)Batch.size());
+        auto start = std::chrono::steady_clock::now();
+        std::vector<size_t> Deferred; // The windows actually in the batch, which share its time
+        Deferred.reserve(Batch.size());
+        HDWP hdwp = BeginDeferWindowPos((int)Batch.size());
+        for (size_t i : Batch) {
+            const CapturedPlacement& captured = Placements[i];
+            if (hdwp == NULL) {
+                break; // A failed DeferWindowPos destroys the batch along with every window already deferred into it
+            }
+            if (!IsWindow(captured.hwnd) || IsIconic(captured.hwnd) || IsZoomed(captured.hwnd)) {
+                continue;
+            }
+            hdwp = DeferWindowPos(hdwp, captured.hwnd, NULL,
+                captured.windowRect.left,
+                captured.windowRect.top,
+                captured.windowRect.right - captured.windowRect.left,
+                captured.windowRect.bottom - captured.windowRect.top,
+                SWP_NOZORDER | SWP_NOACTIVATE);
+            Deferred.push_back(i);
+        }
+        if (hdwp == NULL) { // None of the batch was moved, the first pass left these windows alone, so move each one by itself
+            for (size_t i : Batch) {
+                MoveToCapturedRect(Placements[i], Apps[i]);
+            }
+            return;
+        }
+        EndDeferWindowPos(hdwp);
+        if (!Deferred.empty()) { // The windows are moved together, so each application is charged an equal share
+            double share = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / Deferred.size();
+            for (size_t i : Deferred) {
+                AppLatency::Record(Apps[i], LatencyKind::Move, share);
+            }
+        }
+    });
+}
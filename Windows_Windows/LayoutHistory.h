@@ -0,0 +1,113 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// LayoutHistory.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.01 Removed the capture budget warning, the duration is read through LastCaptureMicroseconds
+// 10/19/2026 MS-24.01.08.25 ApplyPlacements schedules windows of slow applications apart from the batch
+// 10/19/2026 MS-24.01.08.15 Undo/redo counts are atomic so the UI thread can read them while the worker arranges
+// 10/19/2026 MS-24.01.08.01 created
+//-----------------------------------------------
+// Header file for the arrangement undo/redo history
+//
+// Contains class LayoutHistory which records the placement of every window an arranging operation (Stack, Cascade, Squish, ExecuteWindowLayout)
+// is about to touch. The records live in a fixed size ring buffer so the history never grows past HISTORY_CAPACITY operations, and the
+// slot vectors are reused between captures so a warm history does not allocate. Undo and Redo re-apply a whole record in one batched pass.
+
+#pragma once
+
+#include <Windows.h>
+#include <vector>
+#include <array>
+#include <atomic>
+
+// Number of arranging operations that can be undone before the oldest one is overwritten
+#define HISTORY_CAPACITY 32
+
+class LayoutHistory {
+public:
+
+	/**
+	 * @brief Placement of a single window at the moment it was captured
+	 *
+	 * placement holds the full WINDOWPLACEMENT (used for minimized and maximized windows), windowRect holds the GetWindowRect result
+	 * which is the only reliable size for snapped windows (see SaveWindowLayout in WinWinFunctions.cpp for the same workaround)
+	 */
+	struct CapturedPlacement {
+		HWND hwnd;
+		WINDOWPLACEMENT placement;
+		RECT windowRect;
+	};
+
+	/**
+	 * @brief Record the current placement of every window in WindowVect
+	 *
+	 * Called at the start of every arranging operation. Writes the placement of each window into the next slot of the ring buffer,
+	 * overwriting the oldest record once HISTORY_CAPACITY is reached, and discards any redo records (a new operation starts a new branch).
+	 * The time taken is stored and can be read back through LastCaptureMicroseconds().
+	 *
+	 * @param WindowVect Vector of windows the operation is about to move
+	 */
+	static void Capture(const std::vector<HWND>& WindowVect);
+
+	/**
+	 * @brief Restore the placement recorded before the most recent operation
+	 *
+	 * Before re-applying, the current placement of the same windows is captured into the same slot so that Redo can move them back.
+	 *
+	 * @return True if there was something to undo
+	 */
+	static bool Undo();
+
+	/**
+	 * @brief Re-apply the most recently undone operation
+	 * @return True if there was something to redo
+	 */
+	static bool Redo();
+
+	// True if Undo() would do something
+	static bool CanUndo();
+
+	// True if Redo() would do something
+	static bool CanRedo();
+
+	/**
+	 * @brief Get the duration of the last Capture() call
+	 * @return Capture duration in microseconds
+	 */
+	static double LastCaptureMicroseconds();
+
+	/**
+	 * @brief Apply a set of captured placements as a single batch
+	 *
+	 * Windows that are minimized or maximized (either now or in the capture) are restored through SetWindowPlacement since their state can't be deferred.
+	 * Every window that ends up in the normal state is then moved with one BeginDeferWindowPos/EndDeferWindowPos batch, so the desktop is only
+	 * recomposed once no matter how many windows are involved. If the batch can't be built, those windows are moved one at a time with
+	 * SetWindowPos instead. Windows that have closed since the capture are skipped.
+	 * Windows of applications AppLatency knows to be slow are left out of the batch and placed on threads of their own while it runs.
+	 *
+	 * @param Placements Vector of placements to apply
+	 */
+	static void ApplyPlacements(const std::vector<CapturedPlacement>& Placements);
+
+private:
+
+	// Fill Slot with the current placement of every window in WindowVect. Slot keeps its capacity between calls.
+	static void CaptureInto(std::vector<CapturedPlacement>& Slot, const std::vector<HWND>& WindowVect);
+
+	// Ring buffer of captured operations
+	static std::array<std::vector<CapturedPlacement>, HISTORY_CAPACITY> s_Ring;
+
+	// Index of the slot the next capture is written to
+	static size_t s_Cursor;
+
+	// Number of records behind the cursor that can be undone. Written by the WindowWorker thread, read by the menu on the UI thread.
+	static std::atomic<size_t> s_UndoCount;
+
+	// Number of records in front of the cursor that can be redone
+	static std::atomic<size_t> s_RedoCount;
+
+	// Duration of the last capture in microseconds
+	static double s_LastCaptureUs;
+};
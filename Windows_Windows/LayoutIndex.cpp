@@ -0,0 +1,119 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// LayoutIndex.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.16 created
+//-----------------------------------------------
+// Source code for the saved layout search index
+//
+// Defines functions for class LayoutIndex. See LayoutIndex.h.
+
+#include "LayoutIndex.h"
+#include <algorithm>
+#include <numeric>
+#include <cwctype>
+
+std::wstring LayoutIndex::Fold(const std::wstring& text) {
+    std::wstring folded(text);
+    for (wchar_t& c : folded) {
+        c = (wchar_t)std::towlower(c);
+    }
+    return folded;
+}
+
+uint64_t LayoutIndex::TrigramKey(const wchar_t* text) {
+    return ((uint64_t)(text[0] & 0x1FFFFF) << 42) | ((uint64_t)(text[1] & 0x1FFFFF) << 21) | (uint64_t)(text[2] & 0x1FFFFF); // 21 bits covers every code point
+}
+
+void LayoutIndex::Build(std::vector<std::wstring> Names) {
+    std::vector<std::wstring> Folded;
+    Folded.reserve(Names.size());
+    for (const std::wstring& name : Names) {
+        Folded.push_back(Fold(name));
+    }
+
+    std::vector<uint32_t> Order(Names.size());
+    std::iota(Order.begin(), Order.end(), 0);
+    std::sort(Order.begin(), Order.end(), [&](uint32_t a, uint32_t b) { return Folded[a] < Folded[b]; });
+
+    m_names.clear();
+    m_folded.clear();
+    m_names.reserve(Names.size());
+    m_folded.reserve(Names.size());
+    for (uint32_t i : Order) {
+        m_names.push_back(std::move(Names[i]));
+        m_folded.push_back(std::move(Folded[i]));
+    }
+
+    m_trigrams.clear();
+    for (uint32_t i = 0; i < m_folded.size(); i++) {
+        const std::wstring& name = m_folded[i];
+        for (size_t j = 0; j + 3 <= name.size(); j++) {
+            std::vector<uint32_t>& Postings = m_trigrams[TrigramKey(name.c_str() + j)];
+            if (Postings.empty() || Postings.back() != i) { // A name that repeats a trigram is only listed once
+                Postings.push_back(i);
+            }
+        }
+    }
+
+    m_query.clear();
+    m_matches.resize(m_names.size());
+    std::iota(m_matches.begin(), m_matches.end(), 0);
+}
+
+const std::vector<uint32_t>& LayoutIndex::Filter(const std::wstring& query) {
+    std::wstring folded = Fold(query);
+    if (folded == m_query) {
+        return m_matches;
+    }
+
+    std::vector<uint32_t> Candidates;
+    const std::vector<uint32_t>* Source = &Candidates;
+    if (folded.empty()) {
+        Candidates.resize(m_names.size());
+        std::iota(Candidates.begin(), Candidates.end(), 0);
+    }
+    else if (!m_query.empty() && folded.find(m_query) != std::wstring::npos) { // Typing more only ever narrows the previous matches
+        Candidates.swap(m_matches);
+    }
+    else if (folded.size() >= 3) {
+        Source = nullptr;
+        for (size_t j = 0; j + 3 <= folded.size(); j++) { // The rarest trigram gives the fewest names to check
+            auto found = m_trigrams.find(TrigramKey(folded.c_str() + j));
+            if (found == m_trigrams.end()) {
+                Source = &Candidates; // No name has this trigram, so nothing matches
+                break;
+            }
+            if (Source == nullptr || found->second.size() < Source->size()) {
+                Source = &found->second;
+            }
+        }
+    }
+    else {
+        Candidates.resize(m_names.size());
+        std::iota(Candidates.begin(), Candidates.end(), 0);
+    }
+
+    std::vector<uint32_t> Matches;
+    if (folded.empty()) {
+        Matches.swap(Candidates);
+    }
+    else {
+        for (uint32_t i : *Source) {
+            if (m_folded[i].find(folded) != std::wstring::npos) {
+                Matches.push_back(i);
+            }
+        }
+        std::stable_sort(Matches.begin(), Matches.end(), [&](uint32_t a, uint32_t b) { // Prefix matches first, each group in name order
+            bool aPrefix = m_folded[a].compare(0, folded.size(), folded) == 0;
+            bool bPrefix = m_folded[b].compare(0, folded.size(), folded) == 0;
+            return aPrefix != bPrefix ? aPrefix : a < b;
+        });
+    }
+
+    m_query = std::move(folded);
+    m_matches = std::move(Matches);
+    return m_matches;
+}
@@ -0,0 +1,74 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// LayoutIndex.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.16 created
+//-----------------------------------------------
+// Header file for the saved layout search index
+//
+// Contains class LayoutIndex which filters the names of saved layouts as the user types. Names are case folded once when the index
+// is built, and every three character sequence (trigram) maps to the sorted list of names containing it. A filter is a case
+// insensitive substring match:
+//   - A query that contains the previous query can only match a subset of the previous matches, so only those are checked. This is
+//     the common case while typing.
+//   - Otherwise a query of three or more characters only checks the names in its rarest trigram's list.
+//   - Shorter queries check every name.
+// Matches that start with the query are listed first, then the rest, each in name order.
+// Like IconListView.h, it has no Windows dependencies.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+class LayoutIndex {
+public:
+
+	/**
+	 * @brief Index a set of layout names
+	 *
+	 * Sorts the names case insensitively, folds them, and builds the trigram lists. Resets the filter so every name matches.
+	 *
+	 * @param Names Layout names without the directory or .json
+	 */
+	void Build(std::vector<std::wstring> Names);
+
+	/**
+	 * @brief Filter the names
+	 * @param query Text to look for anywhere in a name, case insensitive. Empty matches every name.
+	 * @return Indices of the matching names (see Name)
+	 */
+	const std::vector<uint32_t>& Filter(const std::wstring& query);
+
+	// Matches of the last Filter
+	const std::vector<uint32_t>& Matches() const { return m_matches; }
+
+	// Number of indexed names
+	size_t Size() const { return m_names.size(); }
+
+	// Name at an index, as it was given to Build
+	const std::wstring& Name(uint32_t index) const { return m_names[index]; }
+
+private:
+
+	// Lower case copy of a string
+	static std::wstring Fold(const std::wstring& text);
+
+	// Key of the trigram starting at text
+	static uint64_t TrigramKey(const wchar_t* text);
+
+	// Names in sorted order, and their folded copies
+	std::vector<std::wstring> m_names;
+	std::vector<std::wstring> m_folded;
+
+	// Trigram key -> sorted indices of the names that contain it
+	std::unordered_map<uint64_t, std::vector<uint32_t>> m_trigrams;
+
+	// Folded query of the last Filter and its matches
+	std::wstring m_query;
+	std::vector<uint32_t> m_matches;
+};
@@ -0,0 +1,304 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// LayoutPicker.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.17 Double buffered painting with the cached UI font, ScrollWindowEx scrolling
+// 10/19/2026 MS-24.01.08.16 created
+//-----------------------------------------------
+// Source code for the saved layout picker
+//
+// Defines functions for class LayoutPicker. See LayoutPicker.h.
+
+#include "LayoutPicker.h"
+#include "GdiCache.h"
+#include <windowsx.h>
+#include <commctrl.h>
+
+#define LAYOUT_PICKER_CLASS L"WinWinLayoutPicker"
+
+bool LayoutPicker::s_Registered = false;
+WNDPROC LayoutPicker::s_EditProc = NULL;
+
+LayoutPicker::LayoutPicker() : m_hwnd(NULL), m_hFilter(NULL), m_hScrollBar(NULL), m_commandId(0), m_scroll(0), m_hot(-1) {}
+
+HWND LayoutPicker::Create(HWND parent, int x, int y, int width, int height, int commandId) {
+    HINSTANCE hInstance = reinterpret_cast<HINSTANCE>(GetWindowLongPtr(parent, GWLP_HINSTANCE));
+    if (!s_Registered) {
+        WNDCLASS wc = { 0 };
+        wc.lpfnWndProc = LayoutPickerProc;
+        wc.hInstance = hInstance;
+        wc.lpszClassName = LAYOUT_PICKER_CLASS;
+        wc.hCursor = LoadCursor(NULL, IDC_ARROW);
+        wc.hbrBackground = NULL; // WM_PAINT fills the background
+        s_Registered = RegisterClass(&wc) != 0 || GetLastError() == ERROR_CLASS_ALREADY_EXISTS;
+    }
+    m_commandId = commandId;
+
+    m_hwnd = CreateWindowExW(
+        0,
+        LAYOUT_PICKER_CLASS,
+        L"",
+        WS_CHILD | WS_BORDER | WS_CLIPCHILDREN | WS_CLIPSIBLINGS,
+        x, y, width, height,
+        parent,
+        NULL,
+        hInstance,
+        this);
+
+    RECT client;
+    GetClientRect(m_hwnd, &client);
+    m_hFilter = CreateWindowExW(
+        WS_EX_CLIENTEDGE,
+        L"EDIT",
+        L"",
+        WS_CHILD | WS_VISIBLE | WS_TABSTOP | ES_AUTOHSCROLL,
+        0, 0, client.right, LAYOUT_PICKER_FILTER_HEIGHT,
+        m_hwnd,
+        NULL,
+        hInstance,
+        NULL);
+    SendMessage(m_hFilter, WM_SETFONT, (WPARAM)GdiCache::Font(), FALSE);
+    SendMessage(m_hFilter, EM_SETCUEBANNER, TRUE, (LPARAM)L"Type to filter");
+    SetWindowLongPtr(m_hFilter, GWLP_USERDATA, (LONG_PTR)this);
+    s_EditProc = (WNDPROC)SetWindowLongPtr(m_hFilter, GWLP_WNDPROC, (LONG_PTR)FilterProc);
+
+    m_hScrollBar = CreateWindowExW(
+        0,
+        L"SCROLLBAR",
+        NULL,
+        WS_CHILD | WS_VISIBLE | SBS_VERT,
+        client.right - LAYOUT_PICKER_SCROLL_WIDTH, LAYOUT_PICKER_FILTER_HEIGHT, LAYOUT_PICKER_SCROLL_WIDTH, client.bottom - LAYOUT_PICKER_FILTER_HEIGHT,
+        m_hwnd,
+        NULL,
+        hInstance,
+        NULL);
+    UpdateScrollBar();
+    return m_hwnd;
+}
+
+void LayoutPicker::SetLayouts(std::vector<std::wstring> Names) {
+    m_Index.Build(std::move(Names));
+    m_hot = -1;
+    if (m_hFilter != NULL && GetWindowTextLength(m_hFilter) > 0) {
+        SetWindowText(m_hFilter, L""); // Sends EN_CHANGE, which re-filters
+    }
+    else {
+        ApplyFilter();
+    }
+}
+
+void LayoutPicker::Show() {
+    ShowWindow(m_hwnd, SW_SHOW);
+    SetFocus(m_hFilter);
+}
+
+void LayoutPicker::Hide() {
+    ShowWindow(m_hwnd, SW_HIDE);
+}
+
+void LayoutPicker::ApplyFilter() {
+    std::wstring query;
+    if (m_hFilter != NULL) {
+        query.resize(GetWindowTextLength(m_hFilter) + 1);
+        query.resize(GetWindowText(m_hFilter, &query[0], (int)query.size()));
+    }
+    m_Index.Filter(query);
+    m_scroll = 0;
+    m_hot = -1;
+    UpdateScrollBar();
+    if (m_hwnd != NULL) {
+        RECT list = ListRect();
+        InvalidateRect(m_hwnd, &list, FALSE);
+    }
+}
+
+void LayoutPicker::Pick(size_t match) {
+    const std::vector<uint32_t>& Matches = m_Index.Matches();
+    if (match >= Matches.size()) {
+        return;
+    }
+    m_selected = m_Index.Name(Matches[match]);
+    SendMessage(GetParent(m_hwnd), WM_COMMAND, MAKEWPARAM(m_commandId, BN_CLICKED), (LPARAM)m_hwnd);
+}
+
+RECT LayoutPicker::ListRect() const {
+    RECT client;
+    GetClientRect(m_hwnd, &client);
+    client.top = LAYOUT_PICKER_FILTER_HEIGHT;
+    client.right -= LAYOUT_PICKER_SCROLL_WIDTH;
+    return client;
+}
+
+int LayoutPicker::RowAt(int y) const {
+    if (y < LAYOUT_PICKER_FILTER_HEIGHT) {
+        return -1;
+    }
+    int row = (y - LAYOUT_PICKER_FILTER_HEIGHT + m_scroll) / LAYOUT_PICKER_ROW_HEIGHT;
+    return row < (int)m_Index.Matches().size() ? row : -1;
+}
+
+void LayoutPicker::SetScroll(int offset) {
+    RECT list = ListRect();
+    int maxScroll = max(0, (int)m_Index.Matches().size() * LAYOUT_PICKER_ROW_HEIGHT - (list.bottom - list.top));
+    offset = max(0, min(offset, maxScroll));
+    if (offset == m_scroll) {
+        return;
+    }
+    int previous = m_scroll;
+    m_scroll = offset;
+    UpdateScrollBar();
+    ScrollWindowEx(m_hwnd, 0, previous - m_scroll, &list, &list, NULL, NULL, SW_INVALIDATE); // Blit the rows still in view, only the strip scrolled in is painted
+    UpdateWindow(m_hwnd);
+}
+
+void LayoutPicker::UpdateScrollBar() {
+    if (m_hScrollBar == NULL) {
+        return;
+    }
+    RECT list = ListRect();
+    SCROLLINFO si;
+    si.cbSize = sizeof(si);
+    si.fMask = SIF_RANGE | SIF_PAGE | SIF_POS | SIF_DISABLENOSCROLL;
+    si.nMin = 0;
+    si.nMax = max(0, (int)m_Index.Matches().size() * LAYOUT_PICKER_ROW_HEIGHT - 1);
+    si.nPage = max(1, (int)(list.bottom - list.top));
+    si.nPos = m_scroll;
+    SetScrollInfo(m_hScrollBar, SB_CTL, &si, TRUE);
+}
+
+LRESULT CALLBACK LayoutPicker::FilterProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam) {
+    LayoutPicker* pThis = (LayoutPicker*)GetWindowLongPtr(hwnd, GWLP_USERDATA);
+    if (pThis != NULL) {
+        if (message == WM_KEYDOWN && wParam == VK_RETURN) {
+            pThis->Pick(pThis->m_hot >= 0 ? pThis->m_hot : 0); // Enter picks the highlighted row, or the best match
+            return 0;
+        }
+        if (message == WM_CHAR && (wParam == L'\r' || wParam == L'\n')) { // Single line edits beep on Enter
+            return 0;
+        }
+    }
+    return CallWindowProcW(s_EditProc, hwnd, message, wParam, lParam);
+}
+
+LRESULT CALLBACK LayoutPicker::LayoutPickerProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam) {
+    LayoutPicker* pThis;
+    if (message == WM_NCCREATE) {
+        pThis = (LayoutPicker*)((CREATESTRUCT*)lParam)->lpCreateParams;
+        SetWindowLongPtr(hwnd, GWLP_USERDATA, (LONG_PTR)pThis);
+        pThis->m_hwnd = hwnd;
+    }
+    else {
+        pThis = (LayoutPicker*)GetWindowLongPtr(hwnd, GWLP_USERDATA);
+    }
+    if (pThis == NULL) {
+        return DefWindowProc(hwnd, message, wParam, lParam);
+    }
+
+    switch (message) {
+    case WM_PAINT:
+    {
+        PAINTSTRUCT ps;
+        HDC target = BeginPaint(hwnd, &ps);
+        {
+            PaintBuffer buffer(target, ps.rcPaint); // Blits to the window when it goes out of scope, before EndPaint
+            HDC hdc = buffer.DC();
+            RECT list = pThis->ListRect();
+            FillRect(hdc, &ps.rcPaint, GetSysColorBrush(COLOR_WINDOW));
+            IntersectClipRect(hdc, list.left, list.top, list.right, list.bottom); // Rows scrolled under the filter box stay hidden
+
+            HGDIOBJ oldFont = SelectObject(hdc, GdiCache::Font());
+            SetBkMode(hdc, TRANSPARENT);
+            const std::vector<uint32_t>& Matches = pThis->m_Index.Matches();
+            int first = max(0, (int)(ps.rcPaint.top - list.top + pThis->m_scroll) / LAYOUT_PICKER_ROW_HEIGHT); // Only the rows in the update region
+            int last = min((int)Matches.size(), (int)(ps.rcPaint.bottom - list.top + pThis->m_scroll + LAYOUT_PICKER_ROW_HEIGHT - 1) / LAYOUT_PICKER_ROW_HEIGHT);
+            for (int row = first; row < last; row++) {
+                RECT rowRect = { list.left, list.top + row * LAYOUT_PICKER_ROW_HEIGHT - pThis->m_scroll, list.right, 0 };
+                rowRect.bottom = rowRect.top + LAYOUT_PICKER_ROW_HEIGHT;
+                bool hot = row == pThis->m_hot;
+                if (hot) {
+                    FillRect(hdc, &rowRect, GetSysColorBrush(COLOR_HIGHLIGHT));
+                }
+                SetTextColor(hdc, GetSysColor(hot ? COLOR_HIGHLIGHTTEXT : COLOR_WINDOWTEXT));
+                RECT textRect = rowRect;
+                textRect.left += 6;
+                const std::wstring& name = pThis->m_Index.Name(Matches[row]);
+                DrawTextW(hdc, name.c_str(), (int)name.length(), &textRect, DT_LEFT | DT_VCENTER | DT_SINGLELINE | DT_END_ELLIPSIS | DT_NOPREFIX);
+            }
+            SelectObject(hdc, oldFont);
+        }
+        EndPaint(hwnd, &ps);
+        return 0;
+    }
+    case WM_ERASEBKGND:
+        return 1;
+    case WM_COMMAND:
+        if ((HWND)lParam == pThis->m_hFilter && HIWORD(wParam) == EN_CHANGE) {
+            pThis->ApplyFilter();
+        }
+        return 0;
+    case WM_VSCROLL:
+    {
+        RECT list = pThis->ListRect();
+        int page = list.bottom - list.top;
+        int offset = pThis->m_scroll;
+        switch (LOWORD(wParam)) {
+        case SB_LINEUP: offset -= LAYOUT_PICKER_ROW_HEIGHT; break;
+        case SB_LINEDOWN: offset += LAYOUT_PICKER_ROW_HEIGHT; break;
+        case SB_PAGEUP: offset -= page; break;
+        case SB_PAGEDOWN: offset += page; break;
+        case SB_THUMBTRACK:
+        case SB_THUMBPOSITION:
+        {
+            SCROLLINFO si = { sizeof(si), SIF_TRACKPOS };
+            GetScrollInfo(pThis->m_hScrollBar, SB_CTL, &si); // The 32 bit position, HIWORD(wParam) is only 16
+            offset = si.nTrackPos;
+            break;
+        }
+        }
+        pThis->SetScroll(offset);
+        return 0;
+    }
+    case WM_MOUSEWHEEL:
+        pThis->SetScroll(pThis->m_scroll - GET_WHEEL_DELTA_WPARAM(wParam) * 3 * LAYOUT_PICKER_ROW_HEIGHT / WHEEL_DELTA);
+        return 0;
+    case WM_MOUSEMOVE:
+    {
+        int row = pThis->RowAt(GET_Y_LPARAM(lParam));
+        if (GET_X_LPARAM(lParam) >= pThis->ListRect().right) {
+            row = -1;
+        }
+        if (row != pThis->m_hot) {
+            RECT list = pThis->ListRect();
+            for (int changed : { pThis->m_hot, row }) { // Repaint only the old and new highlighted rows
+                if (changed >= 0) {
+                    RECT rowRect = { list.left, list.top + changed * LAYOUT_PICKER_ROW_HEIGHT - pThis->m_scroll, list.right, 0 };
+                    rowRect.bottom = rowRect.top + LAYOUT_PICKER_ROW_HEIGHT;
+                    InvalidateRect(hwnd, &rowRect, FALSE);
+                }
+            }
+            pThis->m_hot = row;
+            TRACKMOUSEEVENT tme = { sizeof(tme), TME_LEAVE, hwnd, 0 };
+            TrackMouseEvent(&tme);
+        }
+        return 0;
+    }
+    case WM_MOUSELEAVE:
+        if (pThis->m_hot >= 0) {
+            pThis->m_hot = -1;
+            RECT list = pThis->ListRect();
+            InvalidateRect(hwnd, &list, FALSE);
+        }
+        return 0;
+    case WM_LBUTTONUP:
+    {
+        int row = pThis->RowAt(GET_Y_LPARAM(lParam));
+        if (row >= 0 && GET_X_LPARAM(lParam) < pThis->ListRect().right) {
+            pThis->Pick(row);
+        }
+        return 0;
+    }
+    }
+    return DefWindowProc(hwnd, message, wParam, lParam);
+}
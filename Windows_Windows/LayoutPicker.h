@@ -0,0 +1,130 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// LayoutPicker.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.17 Paints through a PaintBuffer, scrolling blits the rows still in view
+// 10/19/2026 MS-24.01.08.16 created
+//-----------------------------------------------
+// Header file for the saved layout picker
+//
+// Contains class LayoutPicker, a fixed size child window with a filter box on top and an owner-drawn list of saved layouts below it.
+// Typing in the filter box narrows the list through a LayoutIndex, and only the rows that are scrolled into view are painted, so the
+// picker is the same size and opens and filters just as quickly with 5 layouts as with 1,000.
+// Clicking a layout (or pressing Enter in the filter box, which picks the first match) sends WM_COMMAND to the parent with the picker's
+// command ID and BN_CLICKED, like the per-layout buttons it replaces, and the parent reads the name with SelectedName().
+
+#pragma once
+
+#include <Windows.h>
+#include <string>
+#include <vector>
+#include "LayoutIndex.h"
+
+// Height of one layout row
+#define LAYOUT_PICKER_ROW_HEIGHT 24
+
+// Height of the filter box
+#define LAYOUT_PICKER_FILTER_HEIGHT 24
+
+// Height of the whole picker
+#define LAYOUT_PICKER_HEIGHT 200
+
+// Width of the list's scroll bar
+#define LAYOUT_PICKER_SCROLL_WIDTH 16
+
+class LayoutPicker {
+public:
+	LayoutPicker();
+
+	/**
+	 * @brief Register the picker class (once per process) and create the picker and its filter box, hidden
+	 *
+	 * @param parent Parent window, receives the WM_COMMAND when a layout is picked
+	 * @param x X position in the parent
+	 * @param y Y position in the parent
+	 * @param width Width of the picker
+	 * @param height Height of the picker, filter box included
+	 * @param commandId Command ID sent with the WM_COMMAND
+	 * @return The picker's window handle, NULL if it couldn't be created
+	 */
+	HWND Create(HWND parent, int x, int y, int width, int height, int commandId);
+
+	/**
+	 * @brief Get the picker's window handle
+	 */
+	HWND Handle() const { return m_hwnd; }
+
+	/**
+	 * @brief Replace the layouts, clear the filter and scroll to the top
+	 * @param Names Layout names without the directory or .json
+	 */
+	void SetLayouts(std::vector<std::wstring> Names);
+
+	/**
+	 * @brief Show the picker and put the keyboard focus in the filter box so the user can start typing
+	 */
+	void Show();
+
+	/**
+	 * @brief Hide the picker
+	 */
+	void Hide();
+
+	/**
+	 * @brief Get the name of the layout that was picked last
+	 */
+	const std::wstring& SelectedName() const { return m_selected; }
+
+private:
+
+	/**
+	 * @brief Window procedure for the picker
+	 *
+	 * WM_PAINT - Paints the rows that intersect the update region into a PaintBuffer
+	 * WM_ERASEBKGND - Does nothing, WM_PAINT fills the background itself
+	 * WM_COMMAND - EN_CHANGE from the filter box re-filters the list and scrolls it to the top
+	 * WM_VSCROLL - Scrolls the list from its scroll bar
+	 * WM_MOUSEWHEEL - Scrolls the list three rows per notch
+	 * WM_MOUSEMOVE and WM_MOUSELEAVE - Highlights the row under the mouse
+	 * WM_LBUTTONUP - Picks the row under the mouse
+	 */
+	static LRESULT CALLBACK LayoutPickerProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam);
+
+	// Subclass procedure of the filter box, picks the first match on Enter
+	static LRESULT CALLBACK FilterProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam);
+
+	// Re-run the filter with the filter box's text
+	void ApplyFilter();
+
+	// Pick a match and notify the parent
+	void Pick(size_t match);
+
+	// Index into the matches of the row at a client y, -1 if there's no row there
+	int RowAt(int y) const;
+
+	// Scroll the list, clamped to its content. Blits the rows still in view and repaints only the strip that scrolled in.
+	void SetScroll(int offset);
+
+	// Update the scroll bar's range, page and position
+	void UpdateScrollBar();
+
+	// Client rectangle of the list below the filter box, scroll bar excluded
+	RECT ListRect() const;
+
+	// Set once the window class is registered
+	static bool s_Registered;
+
+	// Original window procedure of EDIT controls
+	static WNDPROC s_EditProc;
+
+	HWND m_hwnd;
+	HWND m_hFilter;
+	HWND m_hScrollBar;
+	int m_commandId;
+	LayoutIndex m_Index;
+	int m_scroll;
+	int m_hot;               // Match under the mouse, -1 if none
+	std::wstring m_selected;
+};
@@ -0,0 +1,322 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// LayoutPlanner.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.22 created
+//-----------------------------------------------
+// Source code for dry run placement planning
+//
+// Defines functions for class LayoutPlanner and the scene and plan JSON conversions. See LayoutPlanner.h for the file formats.
+
+#include "LayoutPlanner.h"
+#include "CommandStats.h"
+#include <algorithm>
+#include <cmath>
+
+// Win32 show commands a saved layout can hold (WINDOWPLACEMENT::showCmd)
+#define PLAN_SW_SHOWNORMAL 1
+#define PLAN_SW_SHOWMINIMIZED 2
+#define PLAN_SW_SHOWMAXIMIZED 3
+#define PLAN_SW_MINIMIZE 6
+
+static nlohmann::ordered_json RectToJson(const PlanRect& rect) {
+    return { {"left", rect.left}, {"top", rect.top}, {"right", rect.right}, {"bottom", rect.bottom} };
+}
+
+static PlanRect RectFromJson(const nlohmann::json& j) {
+    PlanRect rect;
+    if (j.is_object()) {
+        rect.left = j.value("left", 0);
+        rect.top = j.value("top", 0);
+        rect.right = j.value("right", 0);
+        rect.bottom = j.value("bottom", 0);
+    }
+    return rect;
+}
+
+static PlanRect Sized(int x, int y, int width, int height) {
+    return { x, y, x + width, y + height };
+}
+
+
+///   SCENE AND PLAN   ///
+
+nlohmann::ordered_json WindowScene::ToJson() const {
+    nlohmann::ordered_json Doc;
+    Doc["version"] = WINDOW_SCENE_VERSION;
+    Doc["screen"] = { {"width", screenWidth}, {"height", screenHeight} };
+    Doc["monitors"] = nlohmann::ordered_json::array();
+    for (const PlanMonitor& monitor : monitors) {
+        Doc["monitors"].push_back({ {"bounds", RectToJson(monitor.bounds)}, {"workArea", RectToJson(monitor.workArea)} });
+    }
+    Doc["windows"] = nlohmann::ordered_json::array();
+    for (const PlanWindow& window : windows) {
+        Doc["windows"].push_back({ {"handle", window.handle}, {"title", window.title}, {"process", window.process},
+            {"rect", RectToJson(window.rect)}, {"minimized", window.minimized}, {"maximized", window.maximized} });
+    }
+    return Doc;
+}
+
+bool WindowScene::FromJson(const nlohmann::json& Doc, WindowScene& scene) {
+    if (!Doc.is_object() || !Doc.contains("windows") || !Doc["windows"].is_array()) {
+        return false;
+    }
+    scene = WindowScene();
+    if (Doc.contains("screen") && Doc["screen"].is_object()) {
+        scene.screenWidth = Doc["screen"].value("width", 0);
+        scene.screenHeight = Doc["screen"].value("height", 0);
+    }
+    if (Doc.contains("monitors") && Doc["monitors"].is_array()) {
+        for (const auto& monitor : Doc["monitors"]) {
+            if (monitor.is_object()) {
+                scene.monitors.push_back({ RectFromJson(monitor.value("bounds", nlohmann::json())), RectFromJson(monitor.value("workArea", nlohmann::json())) });
+            }
+        }
+    }
+    for (const auto& window : Doc["windows"]) {
+        if (!window.is_object()) {
+            continue;
+        }
+        PlanWindow open;
+        open.handle = window.value("handle", 0LL);
+        open.title = window.value("title", std::string());
+        open.process = window.value("process", std::string());
+        open.rect = RectFromJson(window.value("rect", nlohmann::json()));
+        open.minimized = window.value("minimized", false);
+        open.maximized = window.value("maximized", false);
+        scene.windows.push_back(open);
+    }
+    return true;
+}
+
+nlohmann::ordered_json LayoutPlan::ToJson() const {
+    nlohmann::ordered_json Doc;
+    Doc["command"] = command;
+    Doc["placements"] = nlohmann::ordered_json::array();
+    for (const PlannedPlacement& placement : placements) {
+        nlohmann::ordered_json entry = { {"handle", placement.handle}, {"title", placement.title}, {"action", placement.action},
+            {"from", RectToJson(placement.from)}, {"to", RectToJson(placement.to)} };
+        if (!placement.matchedBy.empty()) {
+            entry["matchedBy"] = placement.matchedBy;
+        }
+        Doc["placements"].push_back(entry);
+    }
+    Doc["unmatched"] = unmatched;
+    Doc["untouched"] = untouched;
+    return Doc;
+}
+
+
+///   PLANNING   ///
+
+bool LayoutPlanner::Plan(const std::vector<std::string>& args, const WindowScene& scene, const LayoutLoader& loadLayout, LayoutPlan& plan) {
+    if (args.empty()) {
+        return false;
+    }
+    PhaseTimer timer(CommandPhase::Match);
+    if (args[0] == "stack") {
+        plan = Stack(scene);
+    }
+    else if (args[0] == "cascade") {
+        plan = Cascade(scene);
+    }
+    else if (args[0] == "squish") {
+        plan = Squish(scene);
+    }
+    else if (args[0] == "ExecuteLayout") {
+        plan = ExecuteLayout(scene, loadLayout(args.size() > 1 ? args[1] : std::string()));
+    }
+    else {
+        return false;
+    }
+    if (CommandStats* stats = CommandStats::Current()) { // Counted like the real command, except nothing moves
+        stats->windows = (int)scene.windows.size();
+        stats->matched = (int)plan.placements.size();
+        stats->skipped = (plan.command == "ExecuteLayout" ? (int)plan.unmatched.size() : plan.untouched);
+    }
+    return true;
+}
+
+std::vector<PlanRect> LayoutPlanner::StackRects(size_t count, int screenWidth, int screenHeight) {
+    std::vector<PlanRect> Rects;
+    count = std::min<size_t>(count, 8); // Anything past 8 is left alone, the UI's multilayered stack handles more
+    if (count == 0) {
+        return Rects;
+    }
+    if (count <= 4) { // One full width column
+        int height = screenHeight / (int)count;
+        for (size_t i = 0; i < count; i++) {
+            Rects.push_back(Sized(0, (int)i * height, screenWidth, height));
+        }
+        return Rects;
+    }
+    int leftCount = (int)(count + 1) / 2; // Two half width columns, the left one gets the odd window
+    int rightCount = (int)count / 2;
+    int leftHeight = screenHeight / leftCount;
+    int rightHeight = screenHeight / rightCount;
+    for (int i = 0; i < leftCount; i++) {
+        Rects.push_back(Sized(0, i * leftHeight, screenWidth / 2, leftHeight));
+    }
+    for (int i = 0; i < rightCount; i++) {
+        Rects.push_back(Sized(screenWidth / 2, i * rightHeight, screenWidth / 2, rightHeight));
+    }
+    return Rects;
+}
+
+std::vector<PlanRect> LayoutPlanner::CascadeRects(size_t count, int screenHeight) {
+    std::vector<PlanRect> Rects;
+    if (count == 0) {
+        return Rects;
+    }
+    long long stepY = 50;
+    if ((long long)count * stepY + 760 > screenHeight) { // Shrink the step so the last window still fits
+        stepY = std::max((screenHeight - 760LL) / (long long)count, 10LL);
+    }
+    for (size_t i = 0; i < count; i++) {
+        Rects.push_back(Sized(10 + 65 * (int)i, 10 + (int)(stepY * (long long)i), 750, 750));
+    }
+    return Rects;
+}
+
+LayoutPlan LayoutPlanner::Stack(const WindowScene& scene) {
+    LayoutPlan plan;
+    plan.command = "stack";
+    std::vector<PlanRect> Rects = StackRects(scene.windows.size(), scene.screenWidth, scene.screenHeight);
+    for (size_t i = 0; i < Rects.size(); i++) {
+        const PlanWindow& window = scene.windows[i];
+        plan.placements.push_back({ window.handle, window.title, "move", window.rect, Rects[i], "" });
+    }
+    plan.untouched = (int)(scene.windows.size() - Rects.size());
+    return plan;
+}
+
+LayoutPlan LayoutPlanner::Cascade(const WindowScene& scene) {
+    LayoutPlan plan;
+    plan.command = "cascade";
+    std::vector<PlanRect> Rects = CascadeRects(scene.windows.size(), scene.screenHeight);
+    for (size_t i = 0; i < Rects.size(); i++) {
+        const PlanWindow& window = scene.windows[i];
+        plan.placements.push_back({ window.handle, window.title, "move", window.rect, Rects[i], "" });
+    }
+    return plan;
+}
+
+LayoutPlan LayoutPlanner::Squish(const WindowScene& scene) {
+    LayoutPlan plan;
+    plan.command = "squish";
+    std::vector<PlanRect> Rects = CascadeRects(scene.windows.size(), scene.screenHeight);
+    for (size_t i = 0; i < Rects.size(); i++) {
+        const PlanWindow& window = scene.windows[i];
+        if (window.rect.left == Rects[i].left && window.rect.top == Rects[i].top) { // Still where the cascade put it
+            plan.placements.push_back({ window.handle, window.title, "minimize", window.rect, window.rect, "" });
+        }
+        else {
+            plan.untouched++;
+        }
+    }
+    return plan;
+}
+
+LayoutPlan LayoutPlanner::ExecuteLayout(const WindowScene& scene, const nlohmann::json& Doc) {
+    LayoutPlan plan;
+    plan.command = "ExecuteLayout";
+    const nlohmann::json* Saved = &Doc; // Version 1 files are a bare array, version 2 wraps it
+    if (Doc.is_object()) {
+        auto windows = Doc.find("windows");
+        Saved = (windows != Doc.end() ? &*windows : nullptr);
+    }
+    if (Saved == nullptr || !Saved->is_array()) {
+        plan.untouched = (int)scene.windows.size();
+        return plan;
+    }
+
+    std::vector<bool> claimed(scene.windows.size(), false);
+    for (const auto& window : *Saved) {
+        if (!window.is_object()) {
+            continue;
+        }
+        long long handle = window.value("handle", 0LL);
+        std::string title = window.value("title", std::string());
+        auto rcNormal = window.find("rcNormalPosition");
+        if (rcNormal == window.end() || !rcNormal->is_object()) {
+            plan.unmatched.push_back(title); // Saved without a position, ApplySavedPlacement skips it too
+            continue;
+        }
+        std::string process = window.value("process", std::string());
+
+        int match = -1;
+        std::string matchedBy;
+        for (size_t i = 0; i < scene.windows.size() && match < 0; i++) { // 1. Match by handle
+            if (!claimed[i] && scene.windows[i].handle == handle) {
+                match = (int)i;
+                matchedBy = "handle";
+            }
+        }
+        for (size_t i = 0; i < scene.windows.size() && match < 0 && !title.empty(); i++) { // 2. Match by title
+            if (!claimed[i] && scene.windows[i].title == title) {
+                match = (int)i;
+                matchedBy = "title";
+            }
+        }
+        for (size_t i = 0; i < scene.windows.size() && match < 0 && !process.empty(); i++) { // 3. Match by process
+            if (!claimed[i] && scene.windows[i].process == process) {
+                match = (int)i;
+                matchedBy = "process";
+            }
+        }
+        if (match < 0) {
+            plan.unmatched.push_back(title);
+            continue;
+        }
+        claimed[match] = true;
+
+        PlanRect target = RectFromJson(*rcNormal);
+        auto normalized = window.find("normalized");
+        int monitor = NearestMonitor(scene, target);
+        if (normalized != window.end() && normalized->is_object() && monitor >= 0) { // Rescaled onto the work area, see NormalizedLayout::Rescale
+            const PlanRect& area = scene.monitors[monitor].workArea;
+            double width = area.right - area.left;
+            double height = area.bottom - area.top;
+            target.left = (int)std::floor(area.left + normalized->value("left", 0.0) * width + 0.5);
+            target.top = (int)std::floor(area.top + normalized->value("top", 0.0) * height + 0.5);
+            target.right = (int)std::floor(area.left + normalized->value("right", 0.0) * width + 0.5);
+            target.bottom = (int)std::floor(area.top + normalized->value("bottom", 0.0) * height + 0.5);
+        }
+
+        int showCmd = window.value("showCmd", PLAN_SW_SHOWNORMAL);
+        std::string action = "move";
+        if (showCmd == PLAN_SW_SHOWMINIMIZED || showCmd == PLAN_SW_MINIMIZE) {
+            action = "minimize";
+        }
+        else if (showCmd == PLAN_SW_SHOWMAXIMIZED) {
+            action = "maximize";
+        }
+        const PlanWindow& open = scene.windows[match];
+        plan.placements.push_back({ open.handle, open.title, action, open.rect, target, matchedBy });
+    }
+    plan.untouched = (int)std::count(claimed.begin(), claimed.end(), false);
+    return plan;
+}
+
+int LayoutPlanner::NearestMonitor(const WindowScene& scene, const PlanRect& rect) {
+    int best = -1;
+    long long bestOverlap = 0;
+    long long bestDistance = 0;
+    for (size_t i = 0; i < scene.monitors.size(); i++) {
+        const PlanRect& bounds = scene.monitors[i].bounds;
+        long long width = std::min(rect.right, bounds.right) - std::max(rect.left, bounds.left);
+        long long height = std::min(rect.bottom, bounds.bottom) - std::max(rect.top, bounds.top);
+        long long overlap = (width > 0 && height > 0 ? width * height : 0);
+        long long dx = std::max({ (long long)bounds.left - rect.right, (long long)rect.left - bounds.right, 0LL }); // Gap between the rects
+        long long dy = std::max({ (long long)bounds.top - rect.bottom, (long long)rect.top - bounds.bottom, 0LL });
+        long long distance = dx * dx + dy * dy;
+        if (best < 0 || overlap > bestOverlap || (overlap == 0 && bestOverlap == 0 && distance < bestDistance)) { // Most overlap, then nearest
+            best = (int)i;
+            bestOverlap = overlap;
+            bestDistance = distance;
+        }
+    }
+    return best;
+}
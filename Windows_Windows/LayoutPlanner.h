@@ -0,0 +1,156 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// LayoutPlanner.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.22 created
+//-----------------------------------------------
+// Header file for dry run placement planning
+//
+// Contains class LayoutPlanner, which works out where stack, cascade, squish and ExecuteLayout would put every window without moving
+// anything, and struct WindowScene, the recorded desktop it plans against.
+// A scene is the open windows (handle, title, process, rect, min/max state, in GetActiveWindows order), the monitors (bounds and
+// work area), and the primary screen size. `WinWin --plan` captures the live scene (see WinWinFunctions::CaptureScene), and
+// `WinWin RecordWindows` writes it to a file that `--windows <file>` plans against later, on any machine.
+// The arrangement geometry lives here and WinWinFunctions::Stack, Cascade and Squish use it too, so a plan and the real operation
+// can't disagree. The layout matcher follows WinWinFunctions::ApplyLayoutDocument pass for pass (handle, then title, then process,
+// each open window claimed once) and rescales work area relative rects the way NormalizedLayout does.
+// Like WindowListModel.h, it has no Windows dependencies, so plans can be generated and benchmarked without a desktop.
+//
+// Scene file:
+//   {"version": 1, "screen": {"width": 2560, "height": 1440},
+//    "monitors": [{"bounds": <rect>, "workArea": <rect>}],
+//    "windows": [{"handle": 132456, "title": "...", "process": "C:\\...\\app.exe", "rect": <rect>, "minimized": false, "maximized": false}]}
+// Plan:
+//   {"command": "ExecuteLayout", "placements": [{"handle": 132456, "title": "...", "action": "move", "from": <rect>, "to": <rect>,
+//    "matchedBy": "title"}], "unmatched": ["saved title", ...], "untouched": 3}
+// where <rect> is {"left", "top", "right", "bottom"} and action is move, minimize or maximize.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <nlohmann/json.hpp>
+
+// Version written by WindowScene::ToJson
+#define WINDOW_SCENE_VERSION 1
+
+/**
+ * @brief Rectangle in screen coordinates, laid out like a Win32 RECT
+ */
+struct PlanRect {
+	int left = 0;
+	int top = 0;
+	int right = 0;
+	int bottom = 0;
+};
+
+struct PlanMonitor {
+	PlanRect bounds;
+	PlanRect workArea;
+};
+
+/**
+ * @brief One open window of a scene
+ */
+struct PlanWindow {
+	long long handle = 0;
+	std::string title;       // UTF-8
+	std::string process;     // Path of the owning executable, UTF-8
+	PlanRect rect;           // GetWindowRect
+	bool minimized = false;
+	bool maximized = false;
+};
+
+/**
+ * @brief A desktop to plan against
+ */
+struct WindowScene {
+	int screenWidth = 0;                 // Primary monitor, what the arrangements size themselves to
+	int screenHeight = 0;
+	std::vector<PlanMonitor> monitors;
+	std::vector<PlanWindow> windows;     // In GetActiveWindows order
+
+	nlohmann::ordered_json ToJson() const;
+
+	/**
+	 * @brief Read a scene file's document
+	 * @return False if it isn't a scene. Missing window fields fall back to defaults like layout files do.
+	 */
+	static bool FromJson(const nlohmann::json& Doc, WindowScene& scene);
+};
+
+/**
+ * @brief One window's part of a plan
+ */
+struct PlannedPlacement {
+	long long handle = 0;
+	std::string title;
+	std::string action;       // "move", "minimize" or "maximize"
+	PlanRect from;            // Where the window is now
+	PlanRect to;              // Where it would go. For minimize and maximize, the rect it would be restored to.
+	std::string matchedBy;    // "handle", "title" or "process" for a layout, empty for an arrangement
+};
+
+struct LayoutPlan {
+	std::string command;
+	std::vector<PlannedPlacement> placements;
+	std::vector<std::string> unmatched;    // Titles of saved windows no open window matched
+	int untouched = 0;                     // Open windows the command would leave alone
+
+	nlohmann::ordered_json ToJson() const;
+};
+
+class LayoutPlanner {
+public:
+
+	// Loads a saved window layout by name, as environment.LoadLayout does for the real command
+	typedef std::function<nlohmann::json(const std::string& name)> LayoutLoader;
+
+	/**
+	 * @brief Plan a command line
+	 * @param args Command and parameters, options removed
+	 * @param scene Desktop to plan against
+	 * @param loadLayout Loads the layout ExecuteLayout names
+	 * @param plan Receives the plan
+	 * @return False if the command can't be planned (only stack, cascade, squish and ExecuteLayout can)
+	 */
+	static bool Plan(const std::vector<std::string>& args, const WindowScene& scene, const LayoutLoader& loadLayout, LayoutPlan& plan);
+
+	static LayoutPlan Stack(const WindowScene& scene);
+	static LayoutPlan Cascade(const WindowScene& scene);
+	static LayoutPlan Squish(const WindowScene& scene);
+
+	/**
+	 * @brief Plan a saved window layout
+	 * @param scene Desktop to plan against
+	 * @param Doc Layout document, either version (see LayoutSchema.h)
+	 */
+	static LayoutPlan ExecuteLayout(const WindowScene& scene, const nlohmann::json& Doc);
+
+	/**
+	 * @brief Rects STACK gives the first count windows (at most 8)
+	 *
+	 * Four or fewer windows are stacked full width, top to bottom. Five to eight are split into two half width columns, the left one
+	 * getting the extra window.
+	 */
+	static std::vector<PlanRect> StackRects(size_t count, int screenWidth, int screenHeight);
+
+	/**
+	 * @brief Rects CASCADE gives count windows
+	 *
+	 * 750 pixel squares, starting at (10, 10) and stepping 65 pixels right and 50 down, with the downward step shrunk (to no less
+	 * than 10) so the last window still fits on the screen.
+	 */
+	static std::vector<PlanRect> CascadeRects(size_t count, int screenHeight);
+
+private:
+
+	/**
+	 * @brief Pick the monitor a rect belongs to, like MonitorFromRect with MONITOR_DEFAULTTONEAREST
+	 * @return Index into scene.monitors, -1 if the scene has none
+	 */
+	static int NearestMonitor(const WindowScene& scene, const PlanRect& rect);
+};
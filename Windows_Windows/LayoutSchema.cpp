@@ -0,0 +1,148 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// LayoutSchema.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.24 Trace spans around Load and Save
+// 10/19/2026 MS-24.01.08.21 Loads and saves are charged to the io phase, see CommandStats.h
+// 10/19/2026 MS-24.01.08.05 Added LayoutRecord::GetNormalized
+// 10/19/2026 MS-24.01.08.03 created
+//-----------------------------------------------
+// Source code for the saved window layout file format
+//
+// Defines functions for classes LayoutSchema and LayoutRecord. See LayoutSchema.h for the version history.
+
+#include "LayoutSchema.h"
+#include <fstream>
+#include <filesystem>
+#include "CommandStats.h"
+#include "Trace.h"
+
+// Integer field of a JSON object, or fallback when the field is missing or isn't an integer - value() throws on a hand edited file
+static long long IntField(const nlohmann::json& node, const char* key, long long fallback) {
+    if (!node.is_object()) {
+        return fallback;
+    }
+    auto field = node.find(key);
+    return (field != node.end() && field->is_number_integer() ? field->get<long long>() : fallback);
+}
+
+// Number field of a JSON object, or fallback when the field is missing or isn't a number
+static double NumberField(const nlohmann::json& node, const char* key, double fallback) {
+    if (!node.is_object()) {
+        return fallback;
+    }
+    auto field = node.find(key);
+    return (field != node.end() && field->is_number() ? field->get<double>() : fallback);
+}
+
+nlohmann::json LayoutSchema::Load(const std::wstring& path) {
+    PhaseTimer timer(CommandPhase::Io);
+    TraceSpan span("LoadWindowLayouts", "io");
+    if (!std::filesystem::exists(path)) {
+        return nlohmann::json::object();
+    }
+    std::ifstream LayFile(path);
+    nlohmann::json Doc = nlohmann::json::parse(LayFile, nullptr, false);
+    if (Doc.is_discarded()) {
+        return nlohmann::json::object();
+    }
+    Migrate(Doc);
+    if (!Doc.contains("windows") || !Doc["windows"].is_array()) {
+        Doc["windows"] = nlohmann::json::array(); // Empty layouts are written as null, treat them as no windows
+    }
+    return Doc;
+}
+
+void LayoutSchema::Save(const std::wstring& path, const nlohmann::json& windows) {
+    PhaseTimer timer(CommandPhase::Io);
+    TraceSpan span("SaveWindowLayouts", "io");
+    std::ofstream LayFile(path, std::ios::trunc);
+    LayFile << Wrap(windows);
+    LayFile.close();
+}
+
+nlohmann::json LayoutSchema::Wrap(nlohmann::json windows) {
+    if (!windows.is_array()) {
+        windows = nlohmann::json::array();
+    }
+    return { {"version", LAYOUT_SCHEMA_VERSION}, {"windows", std::move(windows)} };
+}
+
+int LayoutSchema::Migrate(nlohmann::json& Doc) {
+    int savedVersion = (int)IntField(Doc, "version", 1); // Anything without a version field predates versioning
+    int version = savedVersion;
+    if (version == 1) {
+        MigrateV1ToV2(Doc);
+        version = 2;
+    }
+    // Add the next migration here as "if (version == 2) { MigrateV2ToV3(Doc); version = 3; }"
+    return savedVersion;
+}
+
+void LayoutSchema::MigrateV1ToV2(nlohmann::json& Doc) {
+    Doc = Wrap(std::move(Doc));
+}
+
+LayoutRecord::LayoutRecord(const nlohmann::json& node) : moved(FALSE), m_node(&node) {}
+
+long long LayoutRecord::Handle() {
+    if (!m_handle) {
+        auto field = m_node->find("handle");
+        m_handle = (field != m_node->end() && field->is_number() ? field->get<long long>() : 0);
+    }
+    return *m_handle;
+}
+
+const std::string& LayoutRecord::Title() {
+    if (!m_title) {
+        auto field = m_node->find("title");
+        m_title = (field != m_node->end() && field->is_string() ? field->get<std::string>() : std::string());
+    }
+    return *m_title;
+}
+
+const std::string& LayoutRecord::Process() {
+    if (!m_process) {
+        auto field = m_node->find("process");
+        m_process = (field != m_node->end() && field->is_string() ? field->get<std::string>() : std::string());
+    }
+    return *m_process;
+}
+
+bool LayoutRecord::GetPlacement(WINDOWPLACEMENT& placement) const {
+    auto rcNormal = m_node->find("rcNormalPosition");
+    if (rcNormal == m_node->end() || !rcNormal->is_object()) {
+        return false;
+    }
+    placement.length = sizeof(WINDOWPLACEMENT);
+    placement.flags = (UINT)IntField(*m_node, "flags", 0);
+    placement.showCmd = (UINT)IntField(*m_node, "showCmd", SW_SHOWNORMAL);
+
+    nlohmann::json noPosition = nlohmann::json::object();
+    const nlohmann::json& minPos = m_node->contains("ptMinPosition") ? (*m_node)["ptMinPosition"] : noPosition;
+    const nlohmann::json& maxPos = m_node->contains("ptMaxPosition") ? (*m_node)["ptMaxPosition"] : noPosition;
+    placement.ptMinPosition.x = (LONG)IntField(minPos, "x", -1);
+    placement.ptMinPosition.y = (LONG)IntField(minPos, "y", -1);
+    placement.ptMaxPosition.x = (LONG)IntField(maxPos, "x", -1);
+    placement.ptMaxPosition.y = (LONG)IntField(maxPos, "y", -1);
+
+    placement.rcNormalPosition.left = (LONG)IntField(*rcNormal, "left", 0);
+    placement.rcNormalPosition.top = (LONG)IntField(*rcNormal, "top", 0);
+    placement.rcNormalPosition.right = (LONG)IntField(*rcNormal, "right", 0);
+    placement.rcNormalPosition.bottom = (LONG)IntField(*rcNormal, "bottom", 0);
+    return true;
+}
+
+bool LayoutRecord::GetNormalized(NormalizedLayout::NormalizedRect& rect) const {
+    auto normalized = m_node->find("normalized");
+    if (normalized == m_node->end() || !normalized->is_object()) {
+        return false;
+    }
+    rect.left = NumberField(*normalized, "left", 0.0);
+    rect.top = NumberField(*normalized, "top", 0.0);
+    rect.right = NumberField(*normalized, "right", 0.0);
+    rect.bottom = NumberField(*normalized, "bottom", 0.0);
+    return rect.right > rect.left && rect.bottom > rect.top; // A collapsed rect would restore as an invisible window, use the absolute one instead
+}
@@ -0,0 +1,125 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// LayoutSchema.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.05 Added LayoutRecord::GetNormalized
+// 10/19/2026 MS-24.01.08.03 created
+//-----------------------------------------------
+// Header file for the saved window layout file format
+//
+// Contains class LayoutSchema which reads and writes versioned layout files, and class LayoutRecord which gives lazy, typed access
+// to a single saved window.
+//
+// Layout files are versioned so the format can change without breaking files that were already saved:
+//   Version 1 - A bare JSON array of window objects (everything saved before the version field existed)
+//   Version 2 - {"version": 2, "windows": [ <window objects> ]}
+// Loading a file runs every migration between its version and LAYOUT_SCHEMA_VERSION in memory; the file itself is never rewritten.
+//
+// Every field of a window object is optional. A missing field falls back to a default instead of throwing, and fields the
+// loader doesn't know about are ignored, so a file written by a newer build still loads in an older one.
+
+#pragma once
+
+#include <Windows.h>
+#include <string>
+#include <vector>
+#include <optional>
+#include <nlohmann/json.hpp>
+#include "NormalizedLayout.h"
+
+// Version written by LayoutSchema::Save
+#define LAYOUT_SCHEMA_VERSION 2
+
+class LayoutSchema {
+public:
+
+	/**
+	 * @brief Load a layout file and migrate it to the current version
+	 *
+	 * Parses the file without exceptions. A file that doesn't exist or isn't valid JSON returns an empty object.
+	 *
+	 * @param path Full path of the layout file
+	 * @return Layout document at LAYOUT_SCHEMA_VERSION, see the file format above
+	 */
+	static nlohmann::json Load(const std::wstring& path);
+
+	/**
+	 * @brief Write a list of window objects as a current version layout file
+	 * @param path Full path of the layout file, overwritten if it exists
+	 * @param windows JSON array of window objects (see WinWinFunctions::WindowToJson)
+	 */
+	static void Save(const std::wstring& path, const nlohmann::json& windows);
+
+	/**
+	 * @brief Wrap a list of window objects in a current version layout document
+	 * @param windows JSON array of window objects
+	 * @return Layout document at LAYOUT_SCHEMA_VERSION
+	 */
+	static nlohmann::json Wrap(nlohmann::json windows);
+
+	/**
+	 * @brief Bring a parsed layout document up to LAYOUT_SCHEMA_VERSION
+	 *
+	 * Runs each migration in order starting from the document's version. Versions newer than LAYOUT_SCHEMA_VERSION are left as they are.
+	 *
+	 * @param Doc Parsed layout document, migrated in place
+	 * @return The version the document was saved with
+	 */
+	static int Migrate(nlohmann::json& Doc);
+
+private:
+
+	// Version 1 -> 2: wrap the bare window array in an object with a version field
+	static void MigrateV1ToV2(nlohmann::json& Doc);
+};
+
+/**
+ * @brief Lazy view of one saved window in a layout document
+ *
+ * Holds a pointer into the layout document and only converts a field the first time it's asked for, so matching a saved window by
+ * handle never decodes its title, process or placement. The document must outlive the record.
+ */
+class LayoutRecord {
+public:
+	explicit LayoutRecord(const nlohmann::json& node);
+
+	// Saved window handle, 0 if missing
+	long long Handle();
+
+	// Saved window title as UTF-8, empty if missing
+	const std::string& Title();
+
+	// Saved process path as UTF-8, empty if missing
+	const std::string& Process();
+
+	/**
+	 * @brief Decode the saved WINDOWPLACEMENT
+	 *
+	 * flags, showCmd, ptMinPosition and ptMaxPosition fall back to a normal window with no min/max position when missing.
+	 *
+	 * @param placement Receives the placement
+	 * @return False if the record has no rcNormalPosition and can't be placed
+	 */
+	bool GetPlacement(WINDOWPLACEMENT& placement) const;
+
+	/**
+	 * @brief Decode the saved work area relative rect
+	 * @param rect Receives the rect
+	 * @return False if the window was saved before normalized rects existed, in which case only the absolute rect can be used
+	 */
+	bool GetNormalized(NormalizedLayout::NormalizedRect& rect) const;
+
+	// The underlying JSON object, for fields that don't have an accessor
+	const nlohmann::json& Node() const { return *m_node; }
+
+	// Set once the saved window has been applied to an open window
+	bool moved;
+
+private:
+	const nlohmann::json* m_node;
+	std::optional<long long> m_handle;
+	std::optional<std::string> m_title;
+	std::optional<std::string> m_process;
+};
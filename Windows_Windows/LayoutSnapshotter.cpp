@@ -0,0 +1,289 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// LayoutSnapshotter.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.02 Process paths go through a WinWinFunctions process cache, so a reused process ID isn't given the old path
+// 10/19/2026 MS-24.01.08.04 Snapshots also update the workspace profile of the current monitors
+// 10/19/2026 MS-24.01.08.03 Exported snapshots are written through LayoutSchema
+// 10/19/2026 MS-24.01.08.02 created
+//-----------------------------------------------
+// Source code for automatic layout snapshots
+//
+// Defines functions for class LayoutSnapshotter. See LayoutSnapshotter.h for the snapshot file format.
+
+#include "LayoutSnapshotter.h"
+#include "WinWinFunctions.h"
+#include "WorkspaceProfiles.h"
+#include <unordered_set>
+
+std::thread LayoutSnapshotter::s_Thread;
+std::mutex LayoutSnapshotter::s_Mutex;
+HANDLE LayoutSnapshotter::s_StopEvent = NULL;
+std::deque<LayoutSnapshotter::SnapshotFile> LayoutSnapshotter::s_Files;
+unsigned long long LayoutSnapshotter::s_LastHash = 0;
+std::unordered_map<long long, nlohmann::json> LayoutSnapshotter::s_LastWindows;
+ProcessPathCache LayoutSnapshotter::s_ProcessPaths;
+int LayoutSnapshotter::s_DeltasSinceKeyframe = 0;
+
+// FNV-1a, one byte at a time over a block of memory
+static void HashBytes(unsigned long long& hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+}
+
+// Cheap version of WinWinFunctions::EnumWindowsProc - same filter, but no hung window probe and no sort since it runs every tick
+static BOOL CALLBACK SnapshotEnumProc(HWND hwnd, LPARAM lParam) {
+    std::vector<HWND>* Windows = reinterpret_cast<std::vector<HWND>*>(lParam);
+    WCHAR windowTitle[256];
+    if (GetParent(hwnd) != NULL || !IsWindowVisible(hwnd)) {
+        return TRUE;
+    }
+    if (GetWindowText(hwnd, windowTitle, sizeof(windowTitle) / sizeof(windowTitle[0])) == 0) {
+        return TRUE;
+    }
+    std::wstring title(windowTitle);
+    if (title == L"Program Manager" || title == L"Windows Input Experience" || title == L"Windows Shell Experience Host" || title == L"Windows Window Extension Window") {
+        return TRUE;
+    }
+    Windows->push_back(hwnd);
+    return TRUE;
+}
+
+void LayoutSnapshotter::Start(DWORD intervalMs) {
+    if (s_Thread.joinable()) {
+        return;
+    }
+    std::filesystem::create_directories(WinWinFunctions::GetExeDirectory() + L"/SavedSnapshots");
+    {
+        std::lock_guard<std::mutex> lock(s_Mutex);
+        s_Files = IndexSnapshots();
+        s_DeltasSinceKeyframe = SNAPSHOT_KEYFRAME_INTERVAL; // Previous runs' deltas can't be continued, so the first snapshot is always a keyframe
+    }
+    s_StopEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+    s_Thread = std::thread(Run, intervalMs);
+}
+
+void LayoutSnapshotter::Stop() {
+    if (!s_Thread.joinable()) {
+        return;
+    }
+    SetEvent(s_StopEvent);
+    s_Thread.join();
+    CloseHandle(s_StopEvent);
+    s_StopEvent = NULL;
+}
+
+void LayoutSnapshotter::Run(DWORD intervalMs) {
+    TakeSnapshot(); // Snapshot the arrangement the session started with
+    while (WaitForSingleObject(s_StopEvent, intervalMs) == WAIT_TIMEOUT) {
+        TakeSnapshot();
+    }
+}
+
+unsigned long long LayoutSnapshotter::HashPlacementTable(std::vector<HWND>& Windows) {
+    Windows.clear();
+    EnumWindows(SnapshotEnumProc, reinterpret_cast<LPARAM>(&Windows));
+
+    unsigned long long hash = 14695981039346656037ULL;
+    WINDOWPLACEMENT placement;
+    placement.length = sizeof(WINDOWPLACEMENT);
+    RECT rect;
+    for (HWND ctrl : Windows) {
+        GetWindowPlacement(ctrl, &placement);
+        GetWindowRect(ctrl, &rect);
+        HashBytes(hash, &ctrl, sizeof(ctrl));
+        HashBytes(hash, &placement.showCmd, sizeof(placement.showCmd));
+        HashBytes(hash, &rect, sizeof(rect));
+    }
+    return hash;
+}
+
+bool LayoutSnapshotter::TakeSnapshot() {
+    std::lock_guard<std::mutex> lock(s_Mutex); // The background thread and a forced check would otherwise interleave on the statics
+    std::vector<HWND> Windows;
+    unsigned long long hash = HashPlacementTable(Windows);
+    if (hash == s_LastHash) {
+        return false; // Nothing moved, nothing to write
+    }
+
+    // Build the current table. Process paths only change when a process exits, so they come from a cache that notices the exit
+    std::unordered_map<long long, nlohmann::json> current;
+    current.reserve(Windows.size());
+    std::unordered_set<DWORD> Owners;
+    DWORD processId;
+    ProcessPathCache* previousCache = WinWinFunctions::SetProcessCache(&s_ProcessPaths); // Put back after, a forced check may come from a thread with its own
+    for (HWND ctrl : Windows) {
+        GetWindowThreadProcessId(ctrl, &processId);
+        Owners.insert(processId);
+        current.emplace((long long)(int(ctrl)), WinWinFunctions::WindowToJson(ctrl, WinWinFunctions::GetProcessPath(ctrl)));
+    }
+    WinWinFunctions::SetProcessCache(previousCache);
+
+    long long seq = s_Files.empty() ? 0 : s_Files.back().seq + 1;
+    bool keyframe = s_LastWindows.empty() || s_DeltasSinceKeyframe >= SNAPSHOT_KEYFRAME_INTERVAL;
+
+    nlohmann::json snapshot;
+    snapshot["seq"] = seq;
+    snapshot["time"] = (long long)time(NULL);
+    if (keyframe) {
+        snapshot["type"] = "full";
+        snapshot["windows"] = nlohmann::json::array();
+        for (auto& window : current) {
+            snapshot["windows"].push_back(window.second);
+        }
+    }
+    else {
+        snapshot["type"] = "delta";
+        snapshot["base"] = seq - 1;
+        snapshot["changed"] = nlohmann::json::array();
+        snapshot["removed"] = nlohmann::json::array();
+        for (auto& window : current) {
+            auto previous = s_LastWindows.find(window.first);
+            if (previous == s_LastWindows.end() || previous->second != window.second) {
+                snapshot["changed"].push_back(window.second);
+            }
+        }
+        for (auto& window : s_LastWindows) {
+            if (current.find(window.first) == current.end()) {
+                snapshot["removed"].push_back(window.first);
+            }
+        }
+    }
+
+    std::wstring path = SnapshotPath(seq);
+    std::ofstream SnapFile(path, std::ios::trunc);
+    SnapFile << snapshot;
+    SnapFile.close();
+
+    s_Files.push_back({ seq, std::filesystem::file_size(path), keyframe });
+    s_DeltasSinceKeyframe = keyframe ? 0 : s_DeltasSinceKeyframe + 1;
+    s_LastWindows.swap(current);
+    s_LastHash = hash;
+
+    // Keep the workspace profile for the current monitors in step with the arrangement
+    nlohmann::json windows = nlohmann::json::array();
+    for (auto& window : s_LastWindows) {
+        windows.push_back(window.second);
+    }
+    WorkspaceProfiles::UpdateProfile(windows);
+
+    // Processes that no longer own a snapshotted window are dropped from the cache so it can't grow forever
+    s_ProcessPaths.Retain(Owners);
+
+    TrimHistory();
+    return true;
+}
+
+std::wstring LayoutSnapshotter::SnapshotPath(long long seq) {
+    return WinWinFunctions::GetExeDirectory() + L"/SavedSnapshots/" + std::to_wstring(seq) + L".json";
+}
+
+std::deque<LayoutSnapshotter::SnapshotFile> LayoutSnapshotter::IndexSnapshots() {
+    std::deque<SnapshotFile> Files;
+    std::wstring folder = WinWinFunctions::GetExeDirectory() + L"/SavedSnapshots";
+    if (!std::filesystem::exists(folder)) {
+        return Files;
+    }
+    for (const auto& SnapFile : std::filesystem::directory_iterator(folder)) {
+        if (SnapFile.path().extension() != L".json") {
+            continue;
+        }
+        std::ifstream in(SnapFile.path());
+        nlohmann::json Doc = nlohmann::json::parse(in, nullptr, false);
+        if (Doc.is_discarded() || !Doc.is_object()) {
+            continue; // Partially written snapshot from a crash, skip it
+        }
+        Files.push_back({ Doc.value("seq", -1LL), SnapFile.file_size(), Doc.value("type", "") == "full" });
+    }
+    std::sort(Files.begin(), Files.end(), [](const SnapshotFile& a, const SnapshotFile& b) { return a.seq < b.seq; });
+    return Files;
+}
+
+void LayoutSnapshotter::TrimHistory() {
+    uintmax_t total = 0;
+    for (const SnapshotFile& SnapFile : s_Files) {
+        total += SnapFile.size;
+    }
+    // Always keep the newest snapshot even if it alone is over budget
+    while (s_Files.size() > 1 && (total > SNAPSHOT_HISTORY_BYTES || !s_Files.front().keyframe)) {
+        total -= s_Files.front().size;
+        std::filesystem::remove(SnapshotPath(s_Files.front().seq));
+        s_Files.pop_front();
+    }
+}
+
+nlohmann::json LayoutSnapshotter::Reconstruct(long long seq) {
+    std::deque<SnapshotFile> Files = IndexSnapshots();
+    if (Files.empty()) {
+        return nlohmann::json::array();
+    }
+    if (seq < 0) {
+        seq = Files.back().seq;
+    }
+
+    // Find the last keyframe at or before seq
+    long long keyframeSeq = -1;
+    for (const SnapshotFile& SnapFile : Files) {
+        if (SnapFile.seq > seq) {
+            break;
+        }
+        if (SnapFile.keyframe) {
+            keyframeSeq = SnapFile.seq;
+        }
+    }
+    if (keyframeSeq < 0) {
+        return nlohmann::json::array();
+    }
+
+    // Replay the keyframe and every delta after it
+    std::unordered_map<long long, nlohmann::json> windows;
+    for (const SnapshotFile& SnapFile : Files) {
+        if (SnapFile.seq < keyframeSeq || SnapFile.seq > seq) {
+            continue;
+        }
+        std::ifstream in(SnapshotPath(SnapFile.seq));
+        nlohmann::json Doc = nlohmann::json::parse(in, nullptr, false);
+        if (Doc.is_discarded()) {
+            break; // A broken link ends the chain, return what was rebuilt so far
+        }
+        if (SnapFile.keyframe) {
+            windows.clear();
+            for (auto& window : Doc["windows"]) {
+                windows[window.value("handle", 0LL)] = window;
+            }
+        }
+        else {
+            for (auto& window : Doc["changed"]) {
+                windows[window.value("handle", 0LL)] = window;
+            }
+            for (auto& handle : Doc["removed"]) {
+                windows.erase(handle.get<long long>());
+            }
+        }
+    }
+
+    nlohmann::json layout = nlohmann::json::array();
+    for (auto& window : windows) {
+        layout.push_back(window.second);
+    }
+    return layout;
+}
+
+bool LayoutSnapshotter::ExportSnapshot(std::wstring layoutName, long long seq) {
+    nlohmann::json layout = Reconstruct(seq);
+    if (layout.empty()) {
+        return false;
+    }
+    std::filesystem::create_directories(WinWinFunctions::GetExeDirectory() + L"/" + SNAPSHOT_EXPORT_FOLDER);
+    LayoutSchema::Save(ExportPath(layoutName), layout);
+    return true;
+}
+
+std::wstring LayoutSnapshotter::ExportPath(const std::wstring& layoutName) {
+    return WinWinFunctions::GetExeDirectory() + L"/" + SNAPSHOT_EXPORT_FOLDER + L"/" + layoutName + L".json";
+}
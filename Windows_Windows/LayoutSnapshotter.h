@@ -0,0 +1,160 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// LayoutSnapshotter.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.02 The process path cache is a ProcessPathCache
+// 10/19/2026 MS-24.01.08.02 created
+//-----------------------------------------------
+// Header file for automatic layout snapshots
+//
+// Contains class LayoutSnapshotter which runs a background thread that periodically hashes the placement of every top level window and,
+// only when the hash changes, writes a snapshot to the SavedSnapshots folder. Snapshots are delta encoded against the previous one
+// (with a full keyframe every SNAPSHOT_KEYFRAME_INTERVAL snapshots) and the folder is trimmed to SNAPSHOT_HISTORY_BYTES.
+// Between ticks the thread is blocked on an event, so an unchanged desktop costs one EnumWindows pass per interval.
+//
+// Snapshot file format (SavedSnapshots/<seq>.json):
+//   Keyframe - {"seq": n, "type": "full", "time": t, "windows": [ <WindowToJson objects> ]}
+//   Delta    - {"seq": n, "type": "delta", "base": n - 1, "time": t, "changed": [ <WindowToJson objects> ], "removed": [ <handles> ]}
+
+#pragma once
+
+#include <Windows.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <unordered_map>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include "WinWinFunctions.h"
+
+// Time between placement checks
+#define SNAPSHOT_INTERVAL_MS 30000
+
+// A full snapshot is written after this many deltas so restoring never replays a long chain
+#define SNAPSHOT_KEYFRAME_INTERVAL 16
+
+// Total size of the SavedSnapshots folder before the oldest snapshots are deleted
+#define SNAPSHOT_HISTORY_BYTES (2 * 1024 * 1024)
+
+// Folder next to the executable that ExportSnapshot writes rebuilt snapshots to, kept apart from SavedLayouts so they don't show up
+// in the layout list
+#define SNAPSHOT_EXPORT_FOLDER L"RestoredSnapshots"
+
+class LayoutSnapshotter {
+public:
+
+	/**
+	 * @brief Start the background snapshot thread
+	 *
+	 * Indexes the snapshots already in SavedSnapshots so the size budget covers previous runs, then starts the thread.
+	 * Does nothing if the thread is already running.
+	 *
+	 * @param intervalMs Time between placement checks in milliseconds
+	 */
+	static void Start(DWORD intervalMs = SNAPSHOT_INTERVAL_MS);
+
+	/**
+	 * @brief Signal the background thread to exit and wait for it
+	 */
+	static void Stop();
+
+	/**
+	 * @brief Check the current placement table and write a snapshot if it changed
+	 *
+	 * 1. Hash the placement of every top level window (see HashPlacementTable). If the hash matches the last snapshot, return.
+	 * 2. Convert every window to its layout JSON (see WinWinFunctions::WindowToJson), looking process paths up in a per-PID cache.
+	 * 3. Compare against the previous snapshot and write either a delta (changed and removed windows) or a keyframe.
+	 * 4. Hand the full window list to WorkspaceProfiles::UpdateProfile so the profile for the current monitors stays current.
+	 * 5. Delete the oldest snapshots until the folder fits in SNAPSHOT_HISTORY_BYTES. If the oldest remaining snapshot is a delta whose
+	 *    keyframe was deleted, it is deleted as well.
+	 *
+	 * Called by the background thread on every tick, but can be called directly to force a check. Calls are serialized on s_Mutex.
+	 *
+	 * @return True if a snapshot was written
+	 */
+	static bool TakeSnapshot();
+
+	/**
+	 * @brief Rebuild the full window list of a snapshot
+	 *
+	 * Loads the closest keyframe at or before seq and applies each delta up to seq. Works from the files alone, so it can be used
+	 * from the command line while the UI is running the snapshotter.
+	 *
+	 * @param seq Sequence number of the snapshot to rebuild, or -1 for the newest
+	 * @return Layout JSON array in the same format as SaveWindowLayout, empty if the snapshot can't be rebuilt
+	 */
+	static nlohmann::json Reconstruct(long long seq = -1);
+
+	/**
+	 * @brief Write a rebuilt snapshot to the SNAPSHOT_EXPORT_FOLDER so it can be executed like a saved layout
+	 *
+	 * @param layoutName Name of the layout file to write, without the directory or .json
+	 * @param seq Sequence number of the snapshot, or -1 for the newest
+	 * @return True if the layout was written
+	 */
+	static bool ExportSnapshot(std::wstring layoutName, long long seq = -1);
+
+	/**
+	 * @brief Full path of a layout written by ExportSnapshot
+	 */
+	static std::wstring ExportPath(const std::wstring& layoutName);
+
+private:
+
+	// One snapshot file in SavedSnapshots
+	struct SnapshotFile {
+		long long seq;
+		uintmax_t size;
+		bool keyframe;
+	};
+
+	// Thread procedure. Waits on s_StopEvent with the interval as the timeout and calls TakeSnapshot on every timeout.
+	static void Run(DWORD intervalMs);
+
+	/**
+	 * @brief Hash the placement of every top level window
+	 *
+	 * FNV-1a over the handle, show command and window rect of every visible, titled top level window. Titles aren't part of the hash
+	 * because they change constantly (browser tabs, editors) without the arrangement changing.
+	 *
+	 * @param Windows Receives the windows that were hashed
+	 * @return The hash
+	 */
+	static unsigned long long HashPlacementTable(std::vector<HWND>& Windows);
+
+	// Scan SavedSnapshots and return the snapshot files in sequence order
+	static std::deque<SnapshotFile> IndexSnapshots();
+
+	// Delete the oldest snapshots until the folder is under SNAPSHOT_HISTORY_BYTES
+	static void TrimHistory();
+
+	// Full path of the snapshot with the given sequence number
+	static std::wstring SnapshotPath(long long seq);
+
+	// Background thread
+	static std::thread s_Thread;
+
+	// Held by TakeSnapshot and Start, which share every static below with each other
+	static std::mutex s_Mutex;
+
+	// Set by Stop() to wake and end the background thread
+	static HANDLE s_StopEvent;
+
+	// Snapshots currently on disk, oldest first
+	static std::deque<SnapshotFile> s_Files;
+
+	// Hash of the last snapshot written
+	static unsigned long long s_LastHash;
+
+	// Windows of the last snapshot written keyed by handle, used to compute deltas
+	static std::unordered_map<long long, nlohmann::json> s_LastWindows;
+
+	// Process paths of the snapshotted windows, see WinWinFunctions::SetProcessCache
+	static ProcessPathCache s_ProcessPaths;
+
+	// Number of deltas written since the last keyframe
+	static int s_DeltasSinceKeyframe;
+};
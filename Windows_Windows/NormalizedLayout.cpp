@@ -0,0 +1,62 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// NormalizedLayout.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.05 created
+//-----------------------------------------------
+// Source code for resolution independent window coordinates
+//
+// Defines functions for class NormalizedLayout. See NormalizedLayout.h for the coordinate system.
+
+#include "NormalizedLayout.h"
+#include <cmath>
+
+void NormalizedLayout::RescaleBatch::Add(size_t i, const NormalizedRect& rect, const RECT& workArea) {
+    index.push_back(i);
+    left.push_back(rect.left);
+    top.push_back(rect.top);
+    right.push_back(rect.right);
+    bottom.push_back(rect.bottom);
+    areaLeft.push_back(workArea.left);
+    areaTop.push_back(workArea.top);
+    areaWidth.push_back(workArea.right - workArea.left);
+    areaHeight.push_back(workArea.bottom - workArea.top);
+}
+
+NormalizedLayout::NormalizedRect NormalizedLayout::Normalize(const RECT& rect, const RECT& workArea) {
+    double width = (workArea.right > workArea.left ? workArea.right - workArea.left : 1);   // Guard against an empty work area
+    double height = (workArea.bottom > workArea.top ? workArea.bottom - workArea.top : 1);
+    return { (rect.left - workArea.left) / width, (rect.top - workArea.top) / height,
+        (rect.right - workArea.left) / width, (rect.bottom - workArea.top) / height };
+}
+
+void NormalizedLayout::Rescale(RescaleBatch& batch) {
+    const size_t count = batch.Size();
+    batch.outLeft.resize(count);
+    batch.outTop.resize(count);
+    batch.outRight.resize(count);
+    batch.outBottom.resize(count);
+
+    // Raw pointers so the compiler can prove the arrays don't alias and vectorize the loop
+    const double* left = batch.left.data();
+    const double* top = batch.top.data();
+    const double* right = batch.right.data();
+    const double* bottom = batch.bottom.data();
+    const double* areaLeft = batch.areaLeft.data();
+    const double* areaTop = batch.areaTop.data();
+    const double* areaWidth = batch.areaWidth.data();
+    const double* areaHeight = batch.areaHeight.data();
+    int* outLeft = batch.outLeft.data();
+    int* outTop = batch.outTop.data();
+    int* outRight = batch.outRight.data();
+    int* outBottom = batch.outBottom.data();
+
+    for (size_t i = 0; i < count; i++) {
+        outLeft[i] = (int)std::floor(areaLeft[i] + left[i] * areaWidth[i] + 0.5);
+        outTop[i] = (int)std::floor(areaTop[i] + top[i] * areaHeight[i] + 0.5);
+        outRight[i] = (int)std::floor(areaLeft[i] + right[i] * areaWidth[i] + 0.5);
+        outBottom[i] = (int)std::floor(areaTop[i] + bottom[i] * areaHeight[i] + 0.5);
+    }
+}
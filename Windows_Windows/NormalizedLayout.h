@@ -0,0 +1,75 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// NormalizedLayout.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.05 created
+//-----------------------------------------------
+// Header file for resolution independent window coordinates
+//
+// Contains class NormalizedLayout which converts window rects to and from coordinates relative to a monitor's work area, where
+// (0, 0) is the top left corner of the work area and (1, 1) is the bottom right. Saved layouts store these next to the absolute
+// rcNormalPosition so a layout saved at one resolution is scaled onto the work area of whatever monitor the window lands on.
+//
+// Rescaling is done for every matched window at once over structure of arrays buffers (see RescaleBatch) so the compiler can
+// vectorize the loop instead of converting one RECT at a time.
+
+#pragma once
+
+#include <Windows.h>
+#include <vector>
+
+class NormalizedLayout {
+public:
+
+	/**
+	 * @brief Window rect as fractions of a monitor work area
+	 */
+	struct NormalizedRect {
+		double left;
+		double top;
+		double right;
+		double bottom;
+	};
+
+	/**
+	 * @brief Windows waiting to be rescaled, stored as one array per field
+	 *
+	 * Filled with Add() while matching a layout, then converted in one pass by Rescale(). The out arrays hold the result.
+	 */
+	struct RescaleBatch {
+		std::vector<size_t> index;   // Caller's index of each window, e.g. its position in the placement batch
+		std::vector<double> left, top, right, bottom;
+		std::vector<double> areaLeft, areaTop, areaWidth, areaHeight;
+		std::vector<int> outLeft, outTop, outRight, outBottom;
+
+		/**
+		 * @brief Queue a window for rescaling
+		 * @param i Caller's index of the window
+		 * @param rect Saved normalized rect
+		 * @param workArea Work area of the monitor the window is restored to
+		 */
+		void Add(size_t i, const NormalizedRect& rect, const RECT& workArea);
+
+		size_t Size() const { return index.size(); }
+	};
+
+	/**
+	 * @brief Convert an absolute rect to fractions of a work area
+	 * @param rect Absolute window rect
+	 * @param workArea Work area of the monitor the window is on
+	 * @return The normalized rect. Fractions can be below 0 or above 1 for windows hanging off the work area.
+	 */
+	static NormalizedRect Normalize(const RECT& rect, const RECT& workArea);
+
+	/**
+	 * @brief Scale every queued window onto its work area
+	 *
+	 * Fills outLeft, outTop, outRight and outBottom. Coordinates are rounded to the nearest pixel, so a window restored onto the
+	 * work area it was saved on gets exactly its saved rect back.
+	 *
+	 * @param batch Windows to rescale
+	 */
+	static void Rescale(RescaleBatch& batch);
+};
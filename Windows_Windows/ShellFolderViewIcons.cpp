@@ -0,0 +1,198 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// ShellFolderViewIcons.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.11 Added ReadIconDetails and GetGrid
+// 10/19/2026 MS-24.01.08.09 created
+//-----------------------------------------------
+// Source code for the shell folder view desktop icon backend
+//
+// Defines functions for class ShellFolderViewIcons. See ShellFolderViewIcons.h.
+
+#ifdef _WIN32
+
+#include "ShellFolderViewIcons.h"
+#include "DesktopIconBackends.h"
+#include <Shlwapi.h>
+#include <ExDisp.h>
+#include <propkey.h>
+
+#pragma comment(lib, "shlwapi.lib")
+
+using Microsoft::WRL::ComPtr;
+
+std::unique_ptr<ShellFolderViewIcons> ShellFolderViewIcons::Open() {
+    std::unique_ptr<ShellFolderViewIcons> Desktop = std::make_unique<ShellFolderViewIcons>();
+
+    ComPtr<IShellWindows> shellWindows;
+    if (FAILED(CoCreateInstance(CLSID_ShellWindows, NULL, CLSCTX_LOCAL_SERVER, IID_PPV_ARGS(&shellWindows)))) {
+        return Desktop;
+    }
+
+    VARIANT location;  // The desktop is the shell window at CSIDL_DESKTOP
+    VariantInit(&location);
+    location.vt = VT_I4;
+    location.lVal = CSIDL_DESKTOP;
+    VARIANT empty;
+    VariantInit(&empty);
+    long hwnd = 0;
+    ComPtr<IDispatch> dispatch;
+    if (shellWindows->FindWindowSW(&location, &empty, SWC_DESKTOP, &hwnd, SWFO_NEEDDISPATCH, &dispatch) != S_OK || !dispatch) {
+        return Desktop;
+    }
+
+    ComPtr<IServiceProvider> services;
+    ComPtr<IShellBrowser> browser;
+    ComPtr<IShellView> view;
+    if (FAILED(dispatch.As(&services))
+        || FAILED(services->QueryService(SID_STopLevelBrowser, IID_PPV_ARGS(&browser)))
+        || FAILED(browser->QueryActiveShellView(&view))
+        || FAILED(view->QueryInterface(IID_PPV_ARGS(&Desktop->m_view)))) {
+        Desktop->m_view.Reset();
+        return Desktop;
+    }
+    if (FAILED(Desktop->m_view->GetFolder(IID_PPV_ARGS(&Desktop->m_folder)))) {
+        Desktop->m_view.Reset(); // Positions without names can't be matched to a layout
+    }
+    view->GetWindow(&Desktop->m_viewWindow);
+    return Desktop;
+}
+
+ShellFolderViewIcons::ShellFolderViewIcons() : m_viewWindow(NULL) {
+    // S_FALSE means COM was already initialized on this thread, which still has to be balanced
+    HRESULT hr = CoInitializeEx(NULL, COINIT_APARTMENTTHREADED);
+    m_comInitialized = SUCCEEDED(hr);
+}
+
+ShellFolderViewIcons::~ShellFolderViewIcons() {
+    ClearItems();
+    m_folder.Reset();
+    m_view.Reset(); // Release before CoUninitialize
+    if (m_comInitialized) {
+        CoUninitialize();
+    }
+}
+
+void ShellFolderViewIcons::ClearItems() {
+    for (PITEMID_CHILD item : m_items) {
+        CoTaskMemFree(item);
+    }
+    m_items.clear();
+}
+
+std::vector<DesktopIcon> ShellFolderViewIcons::ReadIcons() {
+    std::vector<DesktopIcon> Icons;
+    ClearItems();
+    int itemCount = 0;
+    if (!IsOpen() || FAILED(m_view->ItemCount(SVGIO_ALLVIEW, &itemCount)) || itemCount <= 0) {
+        return Icons;
+    }
+    Icons.reserve(itemCount);
+    m_items.reserve(itemCount);
+
+    for (int i = 0; i < itemCount; ++i) {
+        PITEMID_CHILD item = NULL;
+        if (FAILED(m_view->Item(i, &item))) {
+            m_items.push_back(NULL); // Keep m_items indexed like the view
+            continue;
+        }
+        m_items.push_back(item);
+
+        POINT pt;
+        STRRET strret;
+        PWSTR name = NULL;
+        if (FAILED(m_view->GetItemPosition(item, &pt))
+            || FAILED(m_folder->GetDisplayNameOf(item, SHGDN_NORMAL, &strret))
+            || FAILED(StrRetToStrW(&strret, item, &name))) {
+            continue;
+        }
+        Icons.push_back({ i, std::wstring(name), pt.x, pt.y });
+        CoTaskMemFree(name);
+    }
+    return Icons;
+}
+
+PCUITEMID_CHILD ShellFolderViewIcons::Item(int index) {
+    if (index < 0) {
+        return NULL;
+    }
+    if (index >= (int)m_items.size()) {
+        m_items.resize(index + 1, NULL);
+    }
+    if (m_items[index] == NULL) {
+        m_view->Item(index, &m_items[index]);
+    }
+    return m_items[index];
+}
+
+void ShellFolderViewIcons::SetIconPosition(int index, int x, int y) {
+    SetIconPositions({ { index, x, y } });
+}
+
+void ShellFolderViewIcons::SetIconPositions(const std::vector<IconMove>& Moves) {
+    if (!IsOpen() || Moves.empty()) {
+        return;
+    }
+    std::vector<PCUITEMID_CHILD> items;
+    std::vector<POINT> points;
+    items.reserve(Moves.size());
+    points.reserve(Moves.size());
+    for (const IconMove& move : Moves) {
+        PCUITEMID_CHILD item = Item(move.index);
+        if (item != NULL) {
+            items.push_back(item);
+            points.push_back({ move.x, move.y });
+        }
+    }
+    if (!items.empty()) {
+        m_view->SelectAndPositionItems((UINT)items.size(), items.data(), points.data(), SVSI_POSITIONITEM); // Every icon in one call
+    }
+}
+
+void ShellFolderViewIcons::ReadIconDetails(std::vector<DesktopIcon>& Icons) {
+    ComPtr<IShellFolder2> details;
+    if (!IsOpen() || FAILED(m_folder.As(&details))) {
+        IconListView::ReadIconDetails(Icons);
+        return;
+    }
+    for (DesktopIcon& icon : Icons) {
+        PCUITEMID_CHILD item = Item(icon.index);
+        if (item != NULL) {
+            ReadItemDetails(details.Get(), item, icon);
+        }
+    }
+}
+
+void ShellFolderViewIcons::ReadItemDetails(IShellFolder2* details, PCUITEMID_CHILD item, DesktopIcon& icon) {
+    VARIANT value;
+    VariantInit(&value);
+    if (SUCCEEDED(details->GetDetailsEx(item, &PKEY_ItemTypeText, &value)) && value.vt == VT_BSTR) {
+        icon.type = value.bstrVal;
+    }
+    VariantClear(&value);
+    SYSTEMTIME time;
+    FILETIME fileTime;
+    if (SUCCEEDED(details->GetDetailsEx(item, &PKEY_DateModified, &value)) && value.vt == VT_DATE
+        && VariantTimeToSystemTime(value.date, &time) && SystemTimeToFileTime(&time, &fileTime)) {
+        icon.modified = ((long long)fileTime.dwHighDateTime << 32) | fileTime.dwLowDateTime;
+    }
+    VariantClear(&value);
+}
+
+bool ShellFolderViewIcons::GetGrid(IconGrid& grid) {
+    POINT spacing;
+    RECT client;
+    if (!IsOpen() || FAILED(m_view->GetSpacing(&spacing)) || m_viewWindow == NULL || !GetClientRect(m_viewWindow, &client)) {
+        return false;
+    }
+    if (spacing.x <= 0 || spacing.y <= 0) {
+        return false;
+    }
+    grid = { client.left, client.top, spacing.x, spacing.y, (client.right - client.left) / spacing.x, (client.bottom - client.top) / spacing.y };
+    DesktopIconBackends::AddWorkAreas(m_viewWindow, grid);
+    return grid.columns > 0 && grid.rows > 0;
+}
+
+#endif
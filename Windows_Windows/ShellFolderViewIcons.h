@@ -0,0 +1,87 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// ShellFolderViewIcons.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.11 Added ReadIconDetails and GetGrid
+// 10/19/2026 MS-24.01.08.09 created
+//-----------------------------------------------
+// Header file for the shell folder view desktop icon backend
+//
+// Contains class ShellFolderViewIcons which reads and moves desktop icons through the desktop's IFolderView, the same COM interface
+// Explorer uses for its own views. The calls are marshalled by COM instead of poking list view memory inside Explorer, so it needs no
+// VM rights and keeps working when the desktop is hosted by a WorkerW window instead of Progman (wallpaper slideshows, virtual desktops).
+// All positions are set in a single SelectAndPositionItems call.
+
+#pragma once
+
+#ifdef _WIN32
+
+#include <Windows.h>
+#include <ShlObj.h>
+#include <wrl/client.h>
+#include "IconListView.h"
+
+class ShellFolderViewIcons : public IconListView {
+public:
+
+	/**
+	 * @brief Find the desktop's folder view
+	 *
+	 * Asks IShellWindows for the desktop window, then walks IShellBrowser -> IShellView -> IFolderView. The returned backend reports
+	 * IsOpen() false if any step fails (Explorer not running, COM unavailable).
+	 */
+	static std::unique_ptr<ShellFolderViewIcons> Open();
+
+	ShellFolderViewIcons();
+	~ShellFolderViewIcons() override;
+
+	bool IsOpen() const override { return m_view != nullptr; }
+
+	/**
+	 * @brief Read every icon from the folder view
+	 *
+	 * Enumerates the view's items in view order, reading each item's position from IFolderView and its display name from the desktop's
+	 * IShellFolder. The item IDs are kept so later moves can refer to icons by index.
+	 */
+	std::vector<DesktopIcon> ReadIcons() override;
+
+	void SetIconPosition(int index, int x, int y) override;
+
+	// Moves every icon with one SelectAndPositionItems call
+	void SetIconPositions(const std::vector<IconMove>& Moves) override;
+
+	// Item type and date modified from IShellFolder2::GetDetailsEx
+	void ReadIconDetails(std::vector<DesktopIcon>& Icons) override;
+
+	// Cell size from IFolderView::GetSpacing, grid size from the view window's client rect and the monitor work areas
+	bool GetGrid(IconGrid& grid) override;
+
+	/**
+	 * @brief Fill in an icon's type and modified time from its shell item
+	 *
+	 * The type is the shell's type text ("Text Document", "Shortcut"), which is there even when the name shows no extension.
+	 *
+	 * @param details Folder holding the item
+	 * @param item Item ID of the icon in the folder
+	 * @param icon Receives the type and modified time, left as they are if the shell doesn't know them
+	 */
+	static void ReadItemDetails(IShellFolder2* details, PCUITEMID_CHILD item, DesktopIcon& icon);
+
+private:
+
+	// Free the item IDs from the last ReadIcons
+	void ClearItems();
+
+	// Item ID of the icon at a view index, read from the view if ReadIcons hasn't cached it. Owned by m_items.
+	PCUITEMID_CHILD Item(int index);
+
+	Microsoft::WRL::ComPtr<IFolderView> m_view;
+	Microsoft::WRL::ComPtr<IShellFolder> m_folder;
+	HWND m_viewWindow;                   // Window of the desktop's shell view
+	std::vector<PITEMID_CHILD> m_items;  // Indexed like DesktopIcon::index, freed with CoTaskMemFree
+	bool m_comInitialized;
+};
+
+#endif
@@ -0,0 +1,137 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// StartupBench.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.23 Launch reads the child's output on its own thread so the timeout applies to a child that never exits
+// 10/19/2026 MS-24.01.08.23 created
+//-----------------------------------------------
+// Source code for the cold start benchmark
+//
+// Defines functions for class StartupBench. See StartupBench.h.
+
+#include "StartupBench.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <nlohmann/json.hpp>
+
+static ULONGLONG FileTimeTicks(const FILETIME& time) {
+    ULARGE_INTEGER ticks;
+    ticks.LowPart = time.dwLowDateTime;
+    ticks.HighPart = time.dwHighDateTime;
+    return ticks.QuadPart; // 100 nanosecond units
+}
+
+double StartupBench::SinceProcessStart() {
+    FILETIME creation, exitTime, kernel, user, now;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exitTime, &kernel, &user)) {
+        return 0.0;
+    }
+    GetSystemTimePreciseAsFileTime(&now);
+    return (FileTimeTicks(now) - FileTimeTicks(creation)) / 10000.0;
+}
+
+int StartupBench::Run(int runs, bool json, std::ostream& out) {
+    int status = 0;
+    std::vector<double> FirstPaint;
+    std::vector<double> Command;
+    for (int i = 0; i < runs; i++) {
+        std::string output;
+        double elapsed;
+        if (!Launch(L"--first-paint", output, elapsed) || output.empty()) {
+            status = 1;
+            continue;
+        }
+        FirstPaint.push_back(std::atof(output.c_str())); // The UI prints its own measurement, from process creation to the first frame
+    }
+    for (int i = 0; i < runs; i++) {
+        std::string output;
+        double elapsed;
+        if (!Launch(L"stack --plan", output, elapsed)) {
+            status = 1;
+            continue;
+        }
+        Command.push_back(elapsed);
+    }
+
+    if (json) {
+        auto Summary = [](std::vector<double> Timings) {
+            std::sort(Timings.begin(), Timings.end());
+            if (Timings.empty()) {
+                return nlohmann::ordered_json();
+            }
+            return nlohmann::ordered_json{ {"min", Timings.front()}, {"median", Timings[Timings.size() / 2]}, {"max", Timings.back()} };
+        };
+        out << nlohmann::ordered_json{ {"command", "bench"}, {"status", status}, {"runs", runs},
+            {"ms", { {"firstPaint", Summary(FirstPaint)}, {"command", Summary(Command)} } } }.dump() << "\n";
+    }
+    else {
+        Report("first paint", FirstPaint, out);
+        Report("stack --plan", Command, out);
+    }
+    return status;
+}
+
+bool StartupBench::Launch(const std::wstring& arguments, std::string& output, double& milliseconds) {
+    WCHAR exePath[MAX_PATH];
+    GetModuleFileName(NULL, exePath, MAX_PATH);
+    std::wstring commandLine = L"\"" + std::wstring(exePath) + L"\" " + arguments;
+
+    SECURITY_ATTRIBUTES sa = { sizeof(SECURITY_ATTRIBUTES), NULL, TRUE };
+    HANDLE readPipe, writePipe;
+    if (!CreatePipe(&readPipe, &writePipe, &sa, 0)) {
+        return false;
+    }
+    SetHandleInformation(readPipe, HANDLE_FLAG_INHERIT, 0); // Only the child's end is inherited
+
+    STARTUPINFOW si = { sizeof(STARTUPINFOW) };
+    si.dwFlags = STARTF_USESTDHANDLES;
+    si.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+    si.hStdOutput = writePipe;
+    si.hStdError = writePipe;
+    PROCESS_INFORMATION pi;
+    auto start = std::chrono::steady_clock::now();
+    BOOL started = CreateProcessW(NULL, &commandLine[0], NULL, NULL, TRUE, 0, NULL, NULL, &si, &pi);
+    CloseHandle(writePipe); // Otherwise the read below never sees the end of the output
+    if (!started) {
+        CloseHandle(readPipe);
+        return false;
+    }
+
+    std::string collected;
+    std::thread reader([readPipe, &collected] { // Drains the pipe so a chatty child never blocks on a full buffer
+        char buffer[4096];
+        DWORD read;
+        while (ReadFile(readPipe, buffer, sizeof(buffer), &read, NULL) && read > 0) { // Ends when the child's end closes
+            collected.append(buffer, read);
+        }
+    });
+    bool exited = WaitForSingleObject(pi.hProcess, STARTUP_BENCH_TIMEOUT_MS) == WAIT_OBJECT_0;
+    milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (!exited) {
+        TerminateProcess(pi.hProcess, 1);
+        WaitForSingleObject(pi.hProcess, STARTUP_BENCH_DRAIN_MS);
+    }
+    while (WaitForSingleObject(reader.native_handle(), STARTUP_BENCH_DRAIN_MS) == WAIT_TIMEOUT) {
+        CancelSynchronousIo(reader.native_handle()); // Something the child started still holds the pipe open, stop waiting for it
+    }
+    reader.join();
+    output += collected;
+    CloseHandle(readPipe);
+    CloseHandle(pi.hThread);
+    CloseHandle(pi.hProcess);
+    return exited;
+}
+
+void StartupBench::Report(const char* name, std::vector<double> Timings, std::ostream& out) {
+    if (Timings.empty()) {
+        out << name << ": no run finished\n";
+        return;
+    }
+    std::sort(Timings.begin(), Timings.end());
+    out << name << ": min " << Timings.front() << " ms, median " << Timings[Timings.size() / 2] << " ms, max " << Timings.back() << " ms over "
+        << Timings.size() << " runs\n";
+}
@@ -0,0 +1,74 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// StartupBench.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.23 Launch waits on the process, not the pipe, and gives up after the timeout
+// 10/19/2026 MS-24.01.08.23 created
+//-----------------------------------------------
+// Header file for the cold start benchmark
+//
+// Contains class StartupBench, which times how long WinWin takes to get going from a cold process: how long the UI takes to
+// paint its first frame, and how long a command line call takes from process start to exit.
+// `WinWin bench [runs]` starts WinWin runs times with --first-paint, which makes the UI print the milliseconds between its process being
+// created and its first complete frame and close straight away, then runs `WinWin stack --plan` runs times and times each one end to
+// end. A --plan command doesn't move anything, so the benchmark can run on a desktop in use. With a service running the command is
+// forwarded to it, so the timing is what a hotkey or script would see.
+// The UI logs its first paint time to the debugger output on every start, not only under the benchmark.
+
+#pragma once
+
+#include <Windows.h>
+#include <string>
+#include <vector>
+#include <ostream>
+
+// Runs of each measurement when bench isn't given a count
+#define STARTUP_BENCH_DEFAULT_RUNS 5
+
+// Longest a benchmarked process may take before it's abandoned
+#define STARTUP_BENCH_TIMEOUT_MS 30000
+
+// How long the output of a process that has exited (or was terminated) may take to drain before the read is cancelled
+#define STARTUP_BENCH_DRAIN_MS 1000
+
+class StartupBench {
+public:
+
+	/**
+	 * @brief Milliseconds since this process was created
+	 *
+	 * Measured from the creation time the kernel records, so it includes loading the executable and static initialization.
+	 */
+	static double SinceProcessStart();
+
+	/**
+	 * @brief Time the first paint of the UI and the latency of a command
+	 * @param runs Number of times to run each measurement
+	 * @param json Print one line of JSON instead of a line per measurement
+	 * @param out Receives the results
+	 * @return 0 if every run finished, otherwise 1
+	 */
+	static int Run(int runs, bool json, std::ostream& out);
+
+private:
+
+	/**
+	 * @brief Start this executable with the given arguments and wait for it to exit
+	 *
+	 * The output is read on a separate thread while this one waits on the process, so a child that hangs is terminated after
+	 * STARTUP_BENCH_TIMEOUT_MS instead of blocking the read forever.
+	 *
+	 * @param arguments Command line after the executable name
+	 * @param output Receives everything the process printed
+	 * @param milliseconds Receives the time from CreateProcess to exit
+	 * @return False if the process couldn't be started or didn't exit in time
+	 */
+	static bool Launch(const std::wstring& arguments, std::string& output, double& milliseconds);
+
+	/**
+	 * @brief Write the min, median and max of a set of timings
+	 */
+	static void Report(const char* name, std::vector<double> Timings, std::ostream& out);
+};
@@ -0,0 +1,174 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// SysListViewIcons.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.11 Added GetGrid
+// 10/19/2026 MS-24.01.08.09 Find the desktop list view under WorkerW when Progman doesn't host it
+// 10/19/2026 MS-24.01.08.08 SetIconPositions suspends redraw for the whole batch
+// 10/19/2026 MS-24.01.08.06 created
+//-----------------------------------------------
+// Source code for the SysListView32 desktop icon backend
+//
+// Defines functions for class SysListViewIcons. See SysListViewIcons.h for the remote memory layout.
+
+#ifdef _WIN32
+
+#include "SysListViewIcons.h"
+#include "ShellFolderViewIcons.h"
+#include "DesktopIconBackends.h"
+#include <Shlwapi.h>
+#include <algorithm>
+#include <unordered_map>
+
+std::unique_ptr<SysListViewIcons> SysListViewIcons::Open() {
+    HWND hProgMan = FindWindow(L"Progman", NULL);
+    HWND hShellView = FindWindowEx(hProgMan, NULL, L"SHELLDLL_DefView", NULL);
+    HWND hWorker = NULL;
+    while (hShellView == NULL && (hWorker = FindWindowEx(NULL, hWorker, L"WorkerW", NULL)) != NULL) { // Wallpaper slideshows move the view under a WorkerW
+        hShellView = FindWindowEx(hWorker, NULL, L"SHELLDLL_DefView", NULL);
+    }
+    HWND hDesktopListView = FindWindowEx(hShellView, NULL, L"SysListView32", NULL); // Drill down into SysListView32
+    return std::make_unique<SysListViewIcons>(hDesktopListView);
+}
+
+SysListViewIcons::SysListViewIcons(HWND listView) : m_listView(listView), m_process(NULL) {
+    if (m_listView == NULL) {
+        return;
+    }
+    DWORD pid = 0;
+    GetWindowThreadProcessId(m_listView, &pid);
+    m_process = OpenProcess(PROCESS_VM_OPERATION | PROCESS_VM_READ | PROCESS_VM_WRITE, FALSE, pid);
+}
+
+SysListViewIcons::~SysListViewIcons() {
+    if (m_process != NULL) {
+        CloseHandle(m_process); // Only the handle, NOT Explorer itself
+    }
+}
+
+std::vector<DesktopIcon> SysListViewIcons::ReadIcons() {
+    std::vector<DesktopIcon> Icons;
+    int itemCount = (IsOpen() ? ListView_GetItemCount(m_listView) : 0);
+    if (itemCount <= 0) {
+        return Icons;
+    }
+
+    // One region for every icon: [LVITEM x itemCount][POINT x itemCount][WCHAR x ICON_TEXT_SLOT x itemCount]
+    SIZE_T itemsSize = itemCount * sizeof(LVITEMW);
+    SIZE_T pointsSize = itemCount * sizeof(POINT);
+    SIZE_T textSize = itemCount * ICON_TEXT_SLOT * sizeof(WCHAR);
+    BYTE* remote = (BYTE*)VirtualAllocEx(m_process, NULL, itemsSize + pointsSize + textSize, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    if (remote == NULL) {
+        return Icons;
+    }
+    LVITEMW* remoteItems = (LVITEMW*)remote;
+    POINT* remotePoints = (POINT*)(remote + itemsSize);
+    WCHAR* remoteText = (WCHAR*)(remote + itemsSize + pointsSize);
+
+    std::vector<LVITEMW> items(itemCount);
+    for (int i = 0; i < itemCount; ++i) {
+        items[i].iSubItem = 0;
+        items[i].cchTextMax = ICON_TEXT_SLOT;
+        items[i].pszText = remoteText + (SIZE_T)i * ICON_TEXT_SLOT; // Each LVITEM points at its own text slot
+    }
+    WriteProcessMemory(m_process, remoteItems, items.data(), itemsSize, NULL); // Every LVITEM in one write
+
+    std::vector<int> lengths(itemCount, -1); // -1 marks an icon whose position couldn't be read
+    for (int i = 0; i < itemCount; ++i) {
+        if (!ListView_GetItemPosition(m_listView, i, remotePoints + i)) {
+            continue;
+        }
+        lengths[i] = (int)SendMessage(m_listView, LVM_GETITEMTEXTW, (WPARAM)i, (LPARAM)(remoteItems + i));
+    }
+
+    std::vector<BYTE> local(pointsSize + textSize);
+    SIZE_T numRead = 0;
+    BOOL read = ReadProcessMemory(m_process, remotePoints, local.data(), local.size(), &numRead); // Every position and name in one read
+    VirtualFreeEx(m_process, remote, 0, MEM_RELEASE);
+    if (!read) {
+        return Icons;
+    }
+
+    const POINT* points = (const POINT*)local.data();
+    const WCHAR* text = (const WCHAR*)(local.data() + pointsSize);
+    Icons.reserve(itemCount);
+    for (int i = 0; i < itemCount; ++i) {
+        if (lengths[i] < 0) {
+            continue;
+        }
+        int length = std::min(lengths[i], ICON_TEXT_SLOT - 1);
+        Icons.push_back({ i, std::wstring(text + (SIZE_T)i * ICON_TEXT_SLOT, length), points[i].x, points[i].y });
+    }
+    return Icons;
+}
+
+void SysListViewIcons::SetIconPosition(int index, int x, int y) {
+    SendMessage(m_listView, LVM_SETITEMPOSITION, (WPARAM)index, MAKELPARAM(x, y));
+}
+
+void SysListViewIcons::SetIconPositions(const std::vector<IconMove>& Moves) {
+    if (Moves.empty()) {
+        return; // Nothing to move, don't cost Explorer a repaint
+    }
+    SendMessage(m_listView, WM_SETREDRAW, FALSE, 0);
+    IconListView::SetIconPositions(Moves);
+    SendMessage(m_listView, WM_SETREDRAW, TRUE, 0);
+    InvalidateRect(m_listView, NULL, TRUE); // WM_SETREDRAW doesn't repaint on its own
+}
+
+void SysListViewIcons::ReadIconDetails(std::vector<DesktopIcon>& Icons) {
+    HRESULT hr = CoInitializeEx(NULL, COINIT_APARTMENTTHREADED); // S_FALSE still has to be balanced
+    {
+        Microsoft::WRL::ComPtr<IShellFolder> desktop;
+        Microsoft::WRL::ComPtr<IShellFolder2> details;
+        Microsoft::WRL::ComPtr<IEnumIDList> items;
+        if (FAILED(SHGetDesktopFolder(&desktop)) || FAILED(desktop.As(&details))
+            || details->EnumObjects(NULL, SHCONTF_FOLDERS | SHCONTF_NONFOLDERS, &items) != S_OK) {
+            IconListView::ReadIconDetails(Icons);
+        }
+        else {
+            std::unordered_map<std::wstring, std::vector<DesktopIcon*>> byName; // Display name -> icons, so each item is one lookup
+            for (DesktopIcon& icon : Icons) {
+                byName[icon.name].push_back(&icon);
+            }
+            PITEMID_CHILD item = NULL;
+            while (items->Next(1, &item, NULL) == S_OK) {
+                STRRET strret;
+                PWSTR name = NULL;
+                if (SUCCEEDED(details->GetDisplayNameOf(item, SHGDN_NORMAL, &strret)) && SUCCEEDED(StrRetToStrW(&strret, item, &name))) {
+                    auto found = byName.find(name);
+                    if (found != byName.end()) {
+                        for (DesktopIcon* icon : found->second) {
+                            ShellFolderViewIcons::ReadItemDetails(details.Get(), item, *icon);
+                        }
+                    }
+                    CoTaskMemFree(name);
+                }
+                CoTaskMemFree(item);
+            }
+        }
+    } // Released before CoUninitialize
+    if (SUCCEEDED(hr)) {
+        CoUninitialize();
+    }
+}
+
+bool SysListViewIcons::GetGrid(IconGrid& grid) {
+    RECT client;
+    if (m_listView == NULL || !GetClientRect(m_listView, &client)) {
+        return false;
+    }
+    DWORD spacing = ListView_GetItemSpacing(m_listView, FALSE); // Spacing between large icons, LOWORD is the width
+    int cellWidth = LOWORD(spacing);
+    int cellHeight = HIWORD(spacing);
+    if (cellWidth <= 0 || cellHeight <= 0) {
+        return false;
+    }
+    grid = { client.left, client.top, cellWidth, cellHeight, (client.right - client.left) / cellWidth, (client.bottom - client.top) / cellHeight };
+    DesktopIconBackends::AddWorkAreas(m_listView, grid);
+    return grid.columns > 0 && grid.rows > 0;
+}
+
+#endif
@@ -0,0 +1,90 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// SysListViewIcons.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.11 Added GetGrid
+// 10/19/2026 MS-24.01.08.09 Open also looks under WorkerW
+// 10/19/2026 MS-24.01.08.08 SetIconPositions suspends redraw for the whole batch
+// 10/19/2026 MS-24.01.08.06 created
+//-----------------------------------------------
+// Header file for the SysListView32 desktop icon backend
+//
+// Contains class SysListViewIcons which reads and moves desktop icons by sending list view messages to Explorer's SysListView32
+// control. List view messages that return data need a buffer in Explorer's address space, so the backend allocates one remote
+// region big enough for every icon, gives each icon its own slot, and reads the whole region back in one ReadProcessMemory.
+
+#pragma once
+
+#ifdef _WIN32
+
+#include <Windows.h>
+#include <commctrl.h>
+#include "IconListView.h"
+
+// Characters reserved for each icon name in the remote region
+#define ICON_TEXT_SLOT 256
+
+class SysListViewIcons : public IconListView {
+public:
+
+	/**
+	 * @brief Find the desktop list view and open Explorer for reading and writing
+	 *
+	 * Drills down Progman -> SHELLDLL_DefView -> SysListView32, or WorkerW -> SHELLDLL_DefView -> SysListView32 when Explorer has moved
+	 * the desktop view out of Progman. The returned backend reports IsOpen() false if the list view can't be
+	 * found or Explorer can't be opened.
+	 */
+	static std::unique_ptr<SysListViewIcons> Open();
+
+	/**
+	 * @brief Wrap a list view in another process
+	 * @param listView Handle of the SysListView32 control
+	 */
+	explicit SysListViewIcons(HWND listView);
+	~SysListViewIcons() override;
+
+	bool IsOpen() const override { return m_process != NULL; }
+
+	/**
+	 * @brief Read every icon with one remote allocation, one write and one read
+	 *
+	 * 1. Allocate one region in Explorer laid out as [LVITEM per icon][POINT per icon][ICON_TEXT_SLOT characters per icon]
+	 * 2. Point every LVITEM at its icon's text slot and write all of them with one WriteProcessMemory
+	 * 3. For each icon, send LVM_GETITEMPOSITION into its POINT slot and LVM_GETITEMTEXT into its LVITEM. Both return straight away,
+	 *    and LVM_GETITEMTEXT returns the length of the name so only that much of the slot is used.
+	 * 4. Read the POINT and text slots of every icon back with one ReadProcessMemory and free the region
+	 *
+	 * The old per-icon loop made three memory calls per icon on top of the two messages; this makes three in total.
+	 */
+	std::vector<DesktopIcon> ReadIcons() override;
+
+	// Send LVM_SETITEMPOSITION for one icon
+	void SetIconPosition(int index, int x, int y) override;
+
+	/**
+	 * @brief Move every icon with drawing turned off
+	 *
+	 * Sends WM_SETREDRAW FALSE to the list view, moves the icons, then turns drawing back on and invalidates the list view once, so
+	 * Explorer repaints the desktop one time instead of after every icon.
+	 */
+	void SetIconPositions(const std::vector<IconMove>& Moves) override;
+
+	/**
+	 * @brief Look up each icon's type and modified time in the desktop's shell folder
+	 *
+	 * The list view only has the names as shown, usually without their extensions, so the desktop folder (SHGetDesktopFolder, the
+	 * user's and the public desktop merged) is enumerated once and its items matched to icons by display name.
+	 */
+	void ReadIconDetails(std::vector<DesktopIcon>& Icons) override;
+
+	// Cell size from LVM_GETITEMSPACING, grid size from the list view's client rect and the monitor work areas. None of it needs remote memory.
+	bool GetGrid(IconGrid& grid) override;
+
+private:
+	HWND m_listView;
+	HANDLE m_process;
+};
+
+#endif
@@ -0,0 +1,179 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// AppLatencyTests.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.25 created
+//-----------------------------------------------
+// Tests for the latency histograms, the statistics file and the slow window schedule
+
+#include "AppLatency.h"
+#include "Check.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+// Point AppLatency at a fresh statistics file in the temp folder, written with contents if they're given
+static std::filesystem::path OpenStatistics(const std::string& name, const std::string& contents = "") {
+    std::filesystem::path path = std::filesystem::temp_directory_path() / ("WinWinTests_" + name + ".json");
+    std::filesystem::remove(path);
+    if (!contents.empty()) {
+        std::ofstream LatencyFile(path, std::ios::trunc);
+        LatencyFile << contents;
+    }
+    AppLatency::Open(path);
+    return path;
+}
+
+static bool Near(double expected, double actual) {
+    return std::fabs(expected - actual) < 0.001;
+}
+
+static void PercentileInterpolates() {
+    LatencyHistogram histogram;
+    CHECK_EQUAL(0.0, histogram.Percentile(0.5));
+    for (double ms : { 0.5, 3.0, 3.0, 3.0 }) {
+        histogram.Add(ms);
+    }
+    CHECK_EQUAL(4u, histogram.count);
+    CHECK_EQUAL(1u, histogram.buckets[0]);  // Under 1 ms
+    CHECK_EQUAL(3u, histogram.buckets[2]);  // 2-4 ms
+    CHECK(Near(2.0 + 2.0 / 3.0, histogram.Percentile(0.5))); // A third of the way into the 2-4 ms bucket
+    CHECK_EQUAL(3.0, histogram.Percentile(0.9)); // Never past the largest sample
+    CHECK(Near(0.4, histogram.Percentile(0.1))); // Spread evenly over 0-1 ms
+
+    LatencyHistogram huge;
+    huge.Add(100000.0);
+    CHECK_EQUAL(1u, huge.buckets[APP_LATENCY_BUCKETS - 1]);
+}
+
+static void DecayHalvesHistory() {
+    LatencyHistogram histogram;
+    for (int i = 0; i < APP_LATENCY_DECAY_SAMPLES - 1; i++) {
+        histogram.Add(1.5);
+    }
+    CHECK_EQUAL((unsigned int)APP_LATENCY_DECAY_SAMPLES - 1, histogram.count);
+    histogram.Add(1.5);
+    CHECK_EQUAL((unsigned int)APP_LATENCY_DECAY_SAMPLES / 2, histogram.count);
+    CHECK_EQUAL((unsigned int)APP_LATENCY_DECAY_SAMPLES / 2, histogram.buckets[1]);
+    CHECK(Near(1.5 * APP_LATENCY_DECAY_SAMPLES / 2, histogram.totalMs)); // The mean is unchanged
+    CHECK_EQUAL(1.5, histogram.maxMs);
+}
+
+static void HistogramRoundTrip() {
+    LatencyHistogram histogram;
+    histogram.Add(70.0);
+    histogram.Add(5.0);
+    LatencyHistogram read = LatencyHistogram::FromJson(nlohmann::json::parse(histogram.ToJson().dump()));
+    CHECK_EQUAL(2u, read.count);
+    CHECK_EQUAL(75.0, read.totalMs);
+    CHECK_EQUAL(70.0, read.maxMs);
+    CHECK(read.buckets == histogram.buckets);
+}
+
+static void MistypedHistogramsAreEmpty() {
+    nlohmann::json good = LatencyHistogram().ToJson();
+    good["buckets"][3] = 2;
+    CHECK_EQUAL(2u, LatencyHistogram::FromJson(good).count);
+
+    for (nlohmann::json bad : { nlohmann::json("x"), nlohmann::json(-1), nlohmann::json(1.5), nlohmann::json(nullptr) }) {
+        nlohmann::json Doc = good;
+        Doc["buckets"][5] = bad;
+        CHECK_EQUAL(0u, LatencyHistogram::FromJson(Doc).count);
+    }
+    nlohmann::json Doc = good;
+    Doc["totalMs"] = "slow";
+    CHECK_EQUAL(0u, LatencyHistogram::FromJson(Doc).count);
+    Doc = good;
+    Doc["maxMs"] = nlohmann::json::array();
+    CHECK_EQUAL(0u, LatencyHistogram::FromJson(Doc).count);
+    Doc = good;
+    Doc.erase("totalMs"); // Missing is fine, it defaults
+    CHECK_EQUAL(2u, LatencyHistogram::FromJson(Doc).count);
+    CHECK_EQUAL(0u, LatencyHistogram::FromJson(nlohmann::json::array()).count);
+}
+
+static void DamagedFilesLoadEmpty() {
+    OpenStatistics("latency_version", R"({"version": "1", "apps": {}})");
+    CHECK(AppLatency::Worst(10).empty());
+    OpenStatistics("latency_newer", R"({"version": 2, "apps": {}})");
+    CHECK(AppLatency::Worst(10).empty());
+
+    std::string buckets = "[0, 0, 0, 0, 0, 0, 0, 5, 0, 0, 0, 0, 0, 0, 0, 0]"; // Five samples of 64-128 ms
+    OpenStatistics("latency_mixed", R"({"version": 1, "apps": {"text.exe": "bad", "list.exe": [1, 2],
+        "typed.exe": {"probe": {"count": 5, "totalMs": "x", "maxMs": 100, "buckets": )" + buckets + R"(}},
+        "acad.exe": {"restore": {"count": 5, "totalMs": 400, "maxMs": 100, "buckets": )" + buckets + R"(}}}})");
+    std::vector<AppLatencyRecord> Worst = AppLatency::Worst(10);
+    CHECK_EQUAL((size_t)1, Worst.size());
+    CHECK_EQUAL(std::string("acad.exe"), Worst[0].app);
+    CHECK(AppLatency::IsSlow("acad.exe"));
+    CHECK(!AppLatency::IsSlow("typed.exe"));
+}
+
+static void FlushWritesWhatLoads() {
+    std::filesystem::path path = OpenStatistics("latency_flush");
+    for (int i = 0; i < APP_LATENCY_MIN_SAMPLES; i++) {
+        AppLatency::Record("mstsc.exe", LatencyKind::Move, 200.0);
+    }
+    AppLatency::Record("", LatencyKind::Move, 200.0); // No application, not recorded
+    CHECK(AppLatency::Flush());
+    AppLatency::Open(path);
+    CHECK(AppLatency::IsSlow("mstsc.exe"));
+    CHECK_EQUAL((size_t)1, AppLatency::Worst(10).size());
+    std::filesystem::remove(path);
+}
+
+static void DispatchSchedulesSlowWindowsApart() {
+    OpenStatistics("latency_dispatch");
+    for (int i = 0; i < APP_LATENCY_MIN_SAMPLES; i++) {
+        AppLatency::Record("slow.exe", LatencyKind::Restore, 300.0);
+        AppLatency::Record("fast.exe", LatencyKind::Restore, 2.0);
+    }
+    std::vector<std::string> apps = { "slow.exe", "fast.exe", "new.exe", "slow.exe", "fast.exe" };
+
+    std::vector<std::string> Order; // Serial - fast windows in order, then Finish, then the slow ones in order
+    int slow = AppLatency::Dispatch(apps, [&](size_t i, bool isSlow) {
+        Order.push_back(std::to_string(i) + (isSlow ? "s" : ""));
+    }, false, [&] { Order.push_back("finish"); });
+    CHECK_EQUAL(2, slow);
+    CHECK(Order == std::vector<std::string>({ "1", "2", "4", "finish", "0s", "3s" }));
+
+    std::mutex lock; // Parallel - the fast windows and Finish run on this thread in order, the slow ones anywhere around them
+    std::vector<std::string> Fast, Slow;
+    std::thread::id caller = std::this_thread::get_id();
+    bool fastOnCaller = true;
+    AppLatency::Dispatch(apps, [&](size_t i, bool isSlow) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (isSlow) {
+            Slow.push_back(std::to_string(i));
+        }
+        else {
+            Fast.push_back(std::to_string(i));
+            fastOnCaller = fastOnCaller && std::this_thread::get_id() == caller;
+        }
+    }, true, [&] {
+        std::lock_guard<std::mutex> guard(lock);
+        Fast.push_back("finish");
+    });
+    CHECK(Fast == std::vector<std::string>({ "1", "2", "4", "finish" }));
+    CHECK(fastOnCaller);
+    std::sort(Slow.begin(), Slow.end());
+    CHECK(Slow == std::vector<std::string>({ "0", "3" })); // Every slow window placed before Dispatch returned
+
+    CHECK_EQUAL(0, AppLatency::Dispatch({}, [](size_t, bool) {}, true));
+}
+
+int main() {
+    PercentileInterpolates();
+    DecayHalvesHistory();
+    HistogramRoundTrip();
+    MistypedHistogramsAreEmpty();
+    DamagedFilesLoadEmpty();
+    FlushWritesWhatLoads();
+    DispatchSchedulesSlowWindowsApart();
+    AppLatency::Open(std::filesystem::path()); // Nothing left pointing at the temp folder
+    return CheckResult();
+}
@@ -0,0 +1,45 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// Check.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.06 created
+//-----------------------------------------------
+// Header file for the portable tests
+//
+// CHECK and CHECK_EQUAL report a failed condition with its file and line and carry on, so one run lists every failure. A test's main
+// calls its test functions and returns CheckResult(), which is what ctest goes by.
+
+#pragma once
+
+#include <iostream>
+
+inline int g_CheckFailures = 0;
+
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			std::cerr << __FILE__ << "(" << __LINE__ << "): CHECK(" #condition ") failed\n"; \
+			g_CheckFailures++; \
+		} \
+	} while (0)
+
+#define CHECK_EQUAL(expected, actual) \
+	do { \
+		auto checkExpected = (expected); \
+		auto checkActual = (actual); \
+		if (!(checkExpected == checkActual)) { \
+			std::cerr << __FILE__ << "(" << __LINE__ << "): CHECK_EQUAL(" #expected ", " #actual ") failed, got " << checkActual << "\n"; \
+			g_CheckFailures++; \
+		} \
+	} while (0)
+
+// Print the summary and return the exit code for ctest
+inline int CheckResult() {
+	if (g_CheckFailures > 0) {
+		std::cerr << g_CheckFailures << " check(s) failed\n";
+		return 1;
+	}
+	return 0;
+}
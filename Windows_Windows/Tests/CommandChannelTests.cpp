@@ -0,0 +1,112 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// CommandChannelTests.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.19 created
+//-----------------------------------------------
+// Tests for the command channel's frames, and a loopback through a real endpoint (a Unix socket off Windows)
+
+#include "CommandChannel.h"
+#include "Check.h"
+#include <filesystem>
+#include <thread>
+#include <cstdlib>
+#include <stdexcept>
+
+static void RequestRoundTrip() {
+    std::vector<std::string> args = { "ExecuteLayout", "", std::string("with\0nul", 8), std::string(70000, 'x') };
+    std::vector<std::string> decoded;
+    CHECK(CommandChannel::DecodeRequest(CommandChannel::EncodeRequest(args), decoded));
+    CHECK(decoded == args);
+
+    CHECK(CommandChannel::DecodeRequest(CommandChannel::EncodeRequest({}), decoded));
+    CHECK(decoded.empty());
+}
+
+static void ReplyRoundTrip() {
+    CommandReply reply = { 3, "moved 4 icons\n" };
+    CommandReply decoded;
+    CHECK(CommandChannel::DecodeReply(CommandChannel::EncodeReply(reply), decoded));
+    CHECK_EQUAL(3, decoded.status);
+    CHECK_EQUAL(reply.output, decoded.output);
+}
+
+static void MalformedFramesAreRejected() {
+    std::string frame = CommandChannel::EncodeRequest({ "Stack", "now" });
+    std::vector<std::string> args;
+    CHECK(!CommandChannel::DecodeRequest(frame.substr(0, frame.size() - 1), args)); // Truncated
+    CHECK(!CommandChannel::DecodeRequest(frame + "x", args));                      // Trailing bytes
+    CHECK(!CommandChannel::DecodeRequest(std::string("\xFF\xFF\xFF\x7F", 4), args)); // Count larger than the frame could hold
+    CHECK(!CommandChannel::DecodeRequest("", args));
+
+    std::string reply = CommandChannel::EncodeReply({ 0, "output" });
+    CommandReply decoded;
+    CHECK(!CommandChannel::DecodeReply(reply.substr(0, 6), decoded));
+    CHECK(!CommandChannel::DecodeReply(reply + "!", decoded));
+}
+
+static void LoopbackServesCommands() {
+#ifndef _WIN32
+    std::filesystem::path runtime = std::filesystem::temp_directory_path() / "WinWinTests_channel";
+    std::filesystem::create_directories(runtime);
+    setenv("XDG_RUNTIME_DIR", runtime.c_str(), 1); // Keep the test's socket away from a real service
+#endif
+    CommandReply reply;
+    CHECK(!CommandChannel::Send({ "Stack" }, reply)); // Nobody listening, the client runs the command itself
+
+    CHECK(CommandChannel::Listen());
+    int handled = 0;
+    std::thread service([&handled] {
+        CommandChannel::Serve([&handled](const std::vector<std::string>& args) {
+            handled++;
+            CommandReply result;
+            if (!args.empty() && args[0] == "Service") {
+                CommandChannel::Stop();
+                result.output = "stopped\n";
+            }
+            else if (!args.empty() && args[0] == "Throw") {
+                throw std::runtime_error("bad layout");
+            }
+            else {
+                result.status = (int)args.size();
+                for (const std::string& arg : args) {
+                    result.output += arg + "\n";
+                }
+            }
+            return result;
+        });
+    });
+
+    CHECK(CommandChannel::Send({ "ExecuteLayout", "Work" }, reply));
+    CHECK_EQUAL(2, reply.status);
+    CHECK_EQUAL(std::string("ExecuteLayout\nWork\n"), reply.output);
+
+    std::string large(1 << 20, 'w'); // Bigger than any socket buffer, so both sides have to loop
+    CHECK(CommandChannel::Send({ large }, reply));
+    CHECK_EQUAL(large.size() + 1, reply.output.size());
+
+    CHECK(CommandChannel::Send({ "Throw" }, reply)); // The service reports the exception and keeps serving
+    CHECK_EQUAL(1, reply.status);
+    CHECK_EQUAL(std::string("WinWin service: bad layout\n"), reply.output);
+
+    CHECK(CommandChannel::Send({ "Service", "stop" }, reply));
+    CHECK_EQUAL(std::string("stopped\n"), reply.output);
+    service.join();
+    CHECK_EQUAL(4, handled);
+
+    CHECK(!CommandChannel::Send({ "Stack" }, reply)); // The endpoint is gone with the service
+#ifndef _WIN32
+    CHECK(!std::filesystem::exists(CommandChannel::Endpoint()));
+    std::filesystem::remove_all(runtime);
+#endif
+}
+
+int main() {
+    RequestRoundTrip();
+    ReplyRoundTrip();
+    MalformedFramesAreRejected();
+    LoopbackServesCommands();
+    return CheckResult();
+}
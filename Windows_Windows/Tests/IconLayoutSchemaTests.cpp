@@ -0,0 +1,170 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// IconLayoutSchemaTests.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.12 Tests for TryLoad and saving over a layout that can't be loaded
+// 10/19/2026 MS-24.01.08.10 created
+//-----------------------------------------------
+// Tests for the desktop icon layout file format and its migrations
+
+#include "IconLayoutSchema.h"
+#include "IconDiff.h"
+#include "Check.h"
+#include <filesystem>
+#include <fstream>
+
+// Write a layout file into the temp folder and return its path
+static std::wstring WriteLayout(const std::string& name, const std::string& contents) {
+    std::filesystem::path path = std::filesystem::temp_directory_path() / ("WinWinTests_" + name + ".json");
+    std::ofstream LayFile(path, std::ios::trunc);
+    LayFile << contents;
+    std::filesystem::remove(path.wstring() + L".changes");
+    return path.wstring();
+}
+
+static void VersionOneIsMigrated() {
+    nlohmann::json Doc = nlohmann::json::parse(R"([{"icon": "Recycle Bin", "position": {"x": "75", "y": "150"}}, {"icon": "Bad", "position": {"x": "abc"}}])");
+    CHECK_EQUAL(1, IconLayoutSchema::Migrate(Doc));
+    CHECK_EQUAL(ICON_LAYOUT_SCHEMA_VERSION, Doc["version"].get<int>());
+    std::vector<IconRecord> Icons = Doc["icons"].get<std::vector<IconRecord>>();
+    CHECK_EQUAL((size_t)2, Icons.size());
+    CHECK_EQUAL(150, Icons[0].y);
+    CHECK_EQUAL(0, Icons[1].x);
+}
+
+static void CurrentVersionIsLeftAlone() {
+    nlohmann::json Doc = { {"version", 2}, {"icons", nlohmann::json::array()} };
+    nlohmann::json Before = Doc;
+    CHECK_EQUAL(2, IconLayoutSchema::Migrate(Doc));
+    CHECK(Doc == Before);
+}
+
+static void UnsupportedVersionsAreRejected() {
+    nlohmann::json Newer = { {"version", ICON_LAYOUT_SCHEMA_VERSION + 1}, {"icons", nlohmann::json::array()} };
+    CHECK_EQUAL(0, IconLayoutSchema::Migrate(Newer));
+    nlohmann::json Mistyped = { {"version", "2"}, {"icons", nlohmann::json::array()} };
+    CHECK_EQUAL(0, IconLayoutSchema::Migrate(Mistyped));
+
+    CHECK(IconLayoutSchema::Load(WriteLayout("Newer", R"({"version": 3, "icons": [{"name": "a", "x": 1, "y": 2}]})")).empty());
+    CHECK(IconLayoutSchema::Load(WriteLayout("Mistyped", R"({"version": "two", "icons": [{"name": "a", "x": 1, "y": 2}]})")).empty());
+}
+
+static void MistypedFieldsFallBack() {
+    std::vector<IconRecord> Icons = IconLayoutSchema::Load(WriteLayout("Fields", R"({"version": 2, "icons": [{"name": 5, "x": "1", "y": 2}, 7]})"));
+    CHECK_EQUAL((size_t)2, Icons.size());
+    CHECK(Icons[0].name.empty());
+    CHECK_EQUAL(0, Icons[0].x);
+    CHECK_EQUAL(2, Icons[0].y);
+}
+
+static void SaveRoundTrips() {
+    std::wstring path = WriteLayout("RoundTrip", "");
+    IconLayoutSchema::Save(path, { { "Recycle Bin", 0, 0 }, { "notes.txt", 75, 150 } });
+    std::vector<IconRecord> Icons = IconLayoutSchema::Load(path);
+    CHECK_EQUAL((size_t)2, Icons.size());
+    CHECK(Icons[1].name == "notes.txt");
+    CHECK_EQUAL(150, Icons[1].y);
+}
+
+static void IncrementalSavesAppendToTheJournal() {
+    std::wstring path = WriteLayout("Journal", "");
+    std::filesystem::remove(path);
+    std::vector<IconRecord> Icons = { { "a", 0, 0 }, { "b", 0, 75 }, { "c", 0, 150 } };
+    std::optional<IconDiff> First = IconLayoutSchema::SaveIncremental(path, Icons);
+    CHECK(First.has_value());
+    CHECK_EQUAL((size_t)3, First->added.size());
+    CHECK(!std::filesystem::exists(IconLayoutSchema::ChangesPath(path))); // A new layout is written in full
+
+    Icons[1].x = 75;
+    Icons.push_back({ "d", 0, 225 });
+    std::optional<IconDiff> Second = IconLayoutSchema::SaveIncremental(path, Icons);
+    CHECK(Second.has_value());
+    CHECK_EQUAL((size_t)1, Second->moved.size());
+    CHECK_EQUAL((size_t)1, Second->added.size());
+    CHECK(std::filesystem::exists(IconLayoutSchema::ChangesPath(path)));
+
+    CHECK(IconLayoutSchema::SaveIncremental(path, Icons)->Empty()); // Diffed against the state it just saved
+
+    std::vector<IconRecord> Loaded = IconLayoutSchema::Load(path);
+    CHECK_EQUAL((size_t)4, Loaded.size());
+    CHECK_EQUAL(75, Loaded[1].x);
+}
+
+static void OutsideWritesAreNoticed() {
+    std::wstring path = WriteLayout("Outside", "");
+    std::filesystem::remove(path);
+    IconLayoutSchema::SaveIncremental(path, { { "a", 0, 0 } });
+    IconLayoutSchema::Save(path, { { "a", 0, 0 }, { "b", 75, 0 } }); // Another save in between, e.g. from another WinWin
+    std::optional<IconDiff> Diff = IconLayoutSchema::SaveIncremental(path, { { "a", 0, 0 }, { "b", 75, 0 } });
+    CHECK(Diff && Diff->Empty());
+}
+
+static void MissingAndUnreadableAreToldApart() {
+    std::wstring path = WriteLayout("Absent", "");
+    std::filesystem::remove(path);
+    std::optional<std::vector<IconRecord>> Absent = IconLayoutSchema::TryLoad(path);
+    CHECK(Absent && Absent->empty());
+    std::optional<std::vector<IconRecord>> Empty = IconLayoutSchema::TryLoad(WriteLayout("EmptyFile", ""));
+    CHECK(Empty && Empty->empty());
+    CHECK(!IconLayoutSchema::TryLoad(WriteLayout("Garbage", "{ not json")));
+    CHECK(!IconLayoutSchema::TryLoad(WriteLayout("NewerTry", R"({"version": 3, "icons": []})")));
+    std::optional<std::vector<IconRecord>> Current = IconLayoutSchema::TryLoad(WriteLayout("CurrentTry", R"({"version": 2, "icons": [{"name": "a", "x": 1, "y": 2}]})"));
+    CHECK(Current && Current->size() == 1);
+}
+
+static void NewerLayoutsAreNotOverwritten() {
+    std::string newer = R"({"version": 3, "icons": [{"name": "a", "x": 1, "y": 2}], "groups": []})";
+    std::wstring path = WriteLayout("NewerSave", newer);
+    CHECK(!IconLayoutSchema::SaveIncremental(path, { { "a", 0, 0 }, { "b", 75, 0 } }));
+    std::ifstream LayFile{ std::filesystem::path(path) };
+    std::string contents((std::istreambuf_iterator<char>(LayFile)), std::istreambuf_iterator<char>());
+    CHECK(contents == newer);
+    CHECK(!std::filesystem::exists(IconLayoutSchema::ChangesPath(path)));
+}
+
+static void MistypedJournalLinesAreSkipped() {
+    std::wstring path = WriteLayout("BadJournal", R"({"version": 2, "icons": [{"name": "a", "x": 0, "y": 0}, {"name": "b", "x": 0, "y": 75}]})");
+    std::ofstream Changes(std::filesystem::path(IconLayoutSchema::ChangesPath(path)));
+    Changes << R"({"op": 5, "name": "a", "x": 300, "y": 300})" << "\n";
+    Changes << R"({"op": "move", "name": "a", "x": 300, "y": 300, "fromX": "0", "fromY": 0})" << "\n";
+    Changes << "not json\n";
+    Changes << R"({"op": "move", "name": "b", "x": 75, "y": 75, "fromX": 0, "fromY": 75})" << "\n";
+    Changes << R"({"op": "remove", "name": "missing", "x": 1, "y": 1})" << "\n";
+    Changes.close();
+    std::vector<IconRecord> Icons = IconLayoutSchema::Load(path);
+    CHECK_EQUAL((size_t)2, Icons.size());
+    CHECK_EQUAL(0, Icons[0].x);
+    CHECK_EQUAL(75, Icons[1].x);
+}
+
+static void OutgrownJournalIsCompacted() {
+    std::wstring path = WriteLayout("Compact", "");
+    std::filesystem::remove(path);
+    std::vector<IconRecord> Icons = { { "a", 0, 0 } };
+    IconLayoutSchema::SaveIncremental(path, Icons);
+    for (int i = 1; i < 20; i++) {
+        Icons[0].x = i * 75;
+        IconLayoutSchema::SaveIncremental(path, Icons);
+    }
+    std::error_code error;
+    uintmax_t journalSize = std::filesystem::file_size(IconLayoutSchema::ChangesPath(path), error);
+    CHECK(error || journalSize < std::filesystem::file_size(path) + 100); // Rewritten whenever it grew past the layout, so never far past it
+    CHECK_EQUAL(19 * 75, IconLayoutSchema::Load(path)[0].x);
+}
+
+int main() {
+    VersionOneIsMigrated();
+    CurrentVersionIsLeftAlone();
+    UnsupportedVersionsAreRejected();
+    MistypedFieldsFallBack();
+    SaveRoundTrips();
+    IncrementalSavesAppendToTheJournal();
+    OutsideWritesAreNoticed();
+    MissingAndUnreadableAreToldApart();
+    NewerLayoutsAreNotOverwritten();
+    MistypedJournalLinesAreSkipped();
+    OutgrownJournalIsCompacted();
+    return CheckResult();
+}
@@ -0,0 +1,93 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// IconListViewTests.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.06 created
+//-----------------------------------------------
+// Tests for the IconListView interface through the simulated list view and a minimal fake backend
+
+#include "IconListView.h"
+#include "DesktopIconBackends.h"
+#include "Check.h"
+
+// Backend that only implements the pure virtuals, so the interface's default SetIconPositions and ReadIconDetails are the ones used
+class FakeBackend : public IconListView {
+public:
+    std::vector<DesktopIcon> icons;
+    int singleMoves = 0;
+
+    bool IsOpen() const override { return true; }
+    std::vector<DesktopIcon> ReadIcons() override { return icons; }
+    void SetIconPosition(int index, int x, int y) override {
+        singleMoves++;
+        icons[index].x = x;
+        icons[index].y = y;
+    }
+    bool GetGrid(IconGrid&) override { return false; }
+};
+
+static void ReadIconsCountsRoundTrips() {
+    std::unique_ptr<SimulatedIconListView> Desktop = SimulatedIconListView::Generate(20);
+    std::vector<DesktopIcon> Icons = Desktop->ReadIcons();
+    CHECK_EQUAL((size_t)20, Icons.size());
+    CHECK_EQUAL(41ULL, Desktop->RoundTrips()); // Position and text per icon, one bulk read
+    for (size_t i = 0; i < Icons.size(); i++) {
+        CHECK_EQUAL((int)i, Icons[i].index);
+    }
+    CHECK(Icons[3].name == L"Icon 3");
+}
+
+static void SingleMovesRepaintEachTime() {
+    std::unique_ptr<SimulatedIconListView> Desktop = SimulatedIconListView::Generate(5);
+    Desktop->SetIconPosition(1, 300, 400);
+    Desktop->SetIconPosition(2, 300, 475);
+    Desktop->SetIconPosition(99, 0, 0); // Out of range indices are ignored like a list view ignores them
+    CHECK_EQUAL(3ULL, Desktop->Repaints());
+    CHECK_EQUAL(300, Desktop->Icons()[1].x);
+    CHECK_EQUAL(475, Desktop->Icons()[2].y);
+}
+
+static void DefaultBatchFallsBackToSingleMoves() {
+    FakeBackend Desktop;
+    Desktop.icons = { { 0, L"a.txt", 0, 0 }, { 1, L"b", 0, 75 } };
+    Desktop.SetIconPositions({ { 0, 150, 0 }, { 1, 150, 75 } });
+    CHECK_EQUAL(2, Desktop.singleMoves);
+    CHECK_EQUAL(150, Desktop.icons[1].x);
+}
+
+static void DefaultDetailsTakeTheExtension() {
+    FakeBackend Desktop;
+    std::vector<DesktopIcon> Icons = { { 0, L"report.final.docx", 0, 0 }, { 1, L"Recycle Bin", 0, 75 } };
+    Desktop.ReadIconDetails(Icons);
+    CHECK(Icons[0].type == L"docx");
+    CHECK(Icons[1].type.empty());
+    CHECK_EQUAL(0LL, Icons[0].modified);
+}
+
+static void SimulatedGridGrowsWithTheIcons() {
+    IconGrid grid;
+    CHECK(SimulatedIconListView::Generate(10)->GetGrid(grid));
+    CHECK_EQUAL(25, grid.columns);
+    CHECK(SimulatedIconListView::Generate(1000)->GetGrid(grid));
+    CHECK(grid.columns * grid.rows >= 1000);
+}
+
+static void BackendsOpenWithoutADesktop() {
+#ifndef _WIN32
+    std::unique_ptr<IconListView> Desktop = DesktopIconBackends::Open(DesktopIconBackends::Backend::ListView);
+    CHECK(Desktop->IsOpen());
+    CHECK(Desktop->ReadIcons().empty());
+#endif
+}
+
+int main() {
+    ReadIconsCountsRoundTrips();
+    SingleMovesRepaintEachTime();
+    DefaultBatchFallsBackToSingleMoves();
+    DefaultDetailsTakeTheExtension();
+    SimulatedGridGrowsWithTheIcons();
+    BackendsOpenWithoutADesktop();
+    return CheckResult();
+}
@@ -0,0 +1,68 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// IconMatcherTests.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.08 created
+//-----------------------------------------------
+// Tests for IconMatcher and the batched restore it feeds, on a simulated desktop
+
+#include "IconMatcher.h"
+#include "Check.h"
+
+static void UnchangedIconsAreSkipped() {
+    std::unique_ptr<SimulatedIconListView> Desktop = SimulatedIconListView::Generate(6);
+    std::vector<DesktopIcon> Saved = Desktop->Icons();
+    Saved[2].x = 600; // Two icons were moved since the layout was saved
+    Saved[4].y = 900;
+    IconMatcher Matcher(Saved);
+    std::vector<IconMove> Moves = Matcher.MoveSet(Desktop->ReadIcons());
+    CHECK_EQUAL((size_t)2, Moves.size());
+    CHECK_EQUAL(2, Moves[0].index);
+    CHECK_EQUAL(600, Moves[0].x);
+    CHECK_EQUAL(4, Moves[1].index);
+    CHECK_EQUAL(900, Moves[1].y);
+}
+
+static void BatchRepaintsOnce() {
+    std::unique_ptr<SimulatedIconListView> Desktop = SimulatedIconListView::Generate(50);
+    std::vector<DesktopIcon> Saved = Desktop->Icons();
+    for (DesktopIcon& icon : Saved) {
+        icon.x += 75;
+    }
+    IconMatcher Matcher(Saved);
+    std::vector<IconMove> Moves = Matcher.MoveSet(Desktop->ReadIcons());
+    CHECK_EQUAL((size_t)50, Moves.size());
+    Desktop->SetIconPositions(Moves);
+    CHECK_EQUAL(1ULL, Desktop->Repaints());
+    CHECK_EQUAL(Saved[49].x, Desktop->Icons()[49].x);
+
+    Desktop->SetIconPositions({}); // Nothing to move, nothing to repaint
+    CHECK_EQUAL(1ULL, Desktop->Repaints());
+}
+
+static void DuplicateNamesSpreadOverDuplicates() {
+    std::vector<DesktopIcon> Saved = { { 0, L"Shortcut", 0, 0 }, { 1, L"Shortcut", 0, 75 } };
+    IconMatcher Matcher(Saved);
+    std::vector<DesktopIcon> Live = { { 5, L"Shortcut", 10, 80 }, { 6, L"Shortcut", 10, 5 } };
+    const DesktopIcon* first = Matcher.Match(Live[0]);
+    const DesktopIcon* second = Matcher.Match(Live[1]);
+    CHECK(first != nullptr && first->y == 75); // Closest unclaimed saved icon
+    CHECK(second != nullptr && second->y == 0);
+    CHECK(Matcher.Match(Live[0]) == nullptr); // Both claimed
+}
+
+static void UnknownIconsAreLeftAlone() {
+    IconMatcher Matcher({ { 0, L"Known", 0, 0 } });
+    std::vector<IconMove> Moves = Matcher.MoveSet({ { 0, L"New folder", 300, 300 } });
+    CHECK(Moves.empty());
+}
+
+int main() {
+    UnchangedIconsAreSkipped();
+    BatchRepaintsOnce();
+    DuplicateNamesSpreadOverDuplicates();
+    UnknownIconsAreLeftAlone();
+    return CheckResult();
+}
@@ -0,0 +1,115 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// IconPlacerTests.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.11 created
+//-----------------------------------------------
+// Tests for the desktop icon placement engine's packing
+
+#include "IconPlacer.h"
+#include "Check.h"
+
+// 4 columns by 3 rows of 100 pixel cells
+static IconGrid SmallGrid() {
+    return { 0, 0, 100, 100, 4, 3 };
+}
+
+static void SavedIconsGoBackExactly() {
+    IconMatcher Matcher({ { 0, L"a", 130, 20 } });
+    std::vector<IconMove> Moves = IconPlacer(SmallGrid()).Arrange({ { 0, L"a", 0, 0 } }, Matcher, IconSortRule::Name);
+    CHECK_EQUAL((size_t)1, Moves.size());
+    CHECK_EQUAL(130, Moves[0].x);
+    CHECK_EQUAL(20, Moves[0].y);
+}
+
+static void SnapRoundsToTheNearestCell() {
+    IconMatcher Matcher({ { 0, L"a", 130, 20 } });
+    std::vector<IconMove> Moves = IconPlacer(SmallGrid(), true).Restore({ { 0, L"a", 0, 0 } }, Matcher);
+    CHECK_EQUAL((size_t)1, Moves.size());
+    CHECK_EQUAL(100, Moves[0].x);
+    CHECK_EQUAL(0, Moves[0].y);
+}
+
+static void RestoreLeavesNewIconsAlone() {
+    IconMatcher Matcher({ { 0, L"a", 0, 0 } });
+    std::vector<IconMove> Moves = IconPlacer(SmallGrid()).Restore({ { 0, L"a", 300, 200 }, { 1, L"new", 250, 250 } }, Matcher);
+    CHECK_EQUAL((size_t)1, Moves.size());
+    CHECK_EQUAL(0, Moves[0].index);
+}
+
+static void NewIconsFillColumnsAroundSavedOnes() {
+    IconMatcher Matcher({ { 0, L"saved", 0, 100 } }); // Claims the second cell of the first column
+    std::vector<DesktopIcon> Live = { { 0, L"saved", 0, 100 }, { 1, L"b", 300, 200 }, { 2, L"a", 300, 100 }, { 3, L"c", 300, 0 } };
+    std::vector<IconMove> Moves = IconPlacer(SmallGrid()).Arrange(Live, Matcher, IconSortRule::Name);
+    CHECK_EQUAL((size_t)3, Moves.size()); // "saved" is already in place
+    CHECK_EQUAL(2, Moves[0].index); // a -> (0, 0)
+    CHECK_EQUAL(0, Moves[0].y);
+    CHECK_EQUAL(1, Moves[1].index); // b -> (0, 200), skipping the saved icon's cell
+    CHECK_EQUAL(200, Moves[1].y);
+    CHECK_EQUAL(3, Moves[2].index); // c -> (100, 0), top of the next column
+    CHECK_EQUAL(100, Moves[2].x);
+}
+
+static void TypeAndDateRulesOrderThePacking() {
+    IconMatcher Matcher({});
+    std::vector<DesktopIcon> Live = { { 0, L"b", 300, 0 }, { 1, L"a", 300, 100 } };
+    Live[0].type = L"Shortcut";
+    Live[1].type = L"Text Document";
+    Live[0].modified = 10;
+    Live[1].modified = 20;
+    std::vector<IconMove> ByType = IconPlacer(SmallGrid()).Arrange(Live, Matcher, IconSortRule::Type);
+    CHECK_EQUAL(0, ByType[0].index);
+    IconMatcher Again({});
+    std::vector<IconMove> ByDate = IconPlacer(SmallGrid()).Arrange(Live, Again, IconSortRule::Date);
+    CHECK_EQUAL(1, ByDate[0].index); // Newest first
+}
+
+static void FullGridLeavesTheRestInPlace() {
+    IconMatcher Matcher({});
+    std::vector<DesktopIcon> Live;
+    for (int i = 0; i < 15; i++) {
+        Live.push_back({ i, L"Icon " + std::to_wstring(100 + i), 1000, 1000 });
+    }
+    std::vector<IconMove> Moves = IconPlacer(SmallGrid()).Arrange(Live, Matcher, IconSortRule::Name);
+    CHECK_EQUAL((size_t)12, Moves.size());
+}
+
+static void DeadZonesAreNeverPacked() {
+    // A 400x300 monitor next to a 200x200 one: the bottom of the second monitor's columns is off screen
+    IconGrid grid = SmallGrid();
+    grid.columns = 6;
+    grid.areas = { { 0, 0, 400, 300 }, { 400, 0, 600, 200 } };
+    IconMatcher Matcher({});
+    std::vector<DesktopIcon> Live;
+    for (int i = 0; i < 20; i++) {
+        Live.push_back({ i, L"Icon " + std::to_wstring(100 + i), 5000, 5000 });
+    }
+    std::vector<IconMove> Moves = IconPlacer(grid).Arrange(Live, Matcher, IconSortRule::Name);
+    CHECK_EQUAL((size_t)16, Moves.size()); // 12 cells on the first monitor, 4 on the second
+    for (const IconMove& move : Moves) {
+        CHECK(!(move.x >= 400 && move.y >= 200));
+    }
+}
+
+static void ParseSortRule() {
+    CHECK(IconPlacer::ParseSortRule("type") == IconSortRule::Type);
+    CHECK(IconPlacer::ParseSortRule("date") == IconSortRule::Date);
+    CHECK(IconPlacer::ParseSortRule("name") == IconSortRule::Name);
+    CHECK(!IconPlacer::ParseSortRule("snpa"));
+    CHECK(!IconPlacer::ParseSortRule(""));
+    CHECK(!IconPlacer::ParseSortRule("Type"));
+}
+
+int main() {
+    SavedIconsGoBackExactly();
+    SnapRoundsToTheNearestCell();
+    RestoreLeavesNewIconsAlone();
+    NewIconsFillColumnsAroundSavedOnes();
+    TypeAndDateRulesOrderThePacking();
+    FullGridLeavesTheRestInPlace();
+    DeadZonesAreNeverPacked();
+    ParseSortRule();
+    return CheckResult();
+}
@@ -0,0 +1,101 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// LayoutIndexTests.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.16 created
+//-----------------------------------------------
+// Tests for the saved layout filter: ordering, case folding, narrowing while typing and the trigram lookup
+
+#include "LayoutIndex.h"
+#include "Check.h"
+
+// Names of the current matches, in order
+static std::vector<std::wstring> Names(const LayoutIndex& Index) {
+    std::vector<std::wstring> Result;
+    for (uint32_t i : Index.Matches()) {
+        Result.push_back(Index.Name(i));
+    }
+    return Result;
+}
+
+static LayoutIndex MakeIndex() {
+    LayoutIndex Index;
+    Index.Build({ L"Work", L"coding", L"Gaming Setup", L"Home office", L"Code review", L"Streaming" });
+    return Index;
+}
+
+static void BuildSortsAndMatchesAll() {
+    LayoutIndex Index = MakeIndex();
+    CHECK_EQUAL((size_t)6, Index.Size());
+    CHECK_EQUAL((size_t)6, Index.Matches().size());
+    std::vector<std::wstring> Sorted = { L"Code review", L"coding", L"Gaming Setup", L"Home office", L"Streaming", L"Work" };
+    CHECK(Names(Index) == Sorted); // Case insensitive order, names kept as given
+}
+
+static void FilterIgnoresCase() {
+    LayoutIndex Index = MakeIndex();
+    Index.Filter(L"HOME");
+    CHECK(Names(Index) == std::vector<std::wstring>({ L"Home office" }));
+    Index.Filter(L"cOdE");
+    CHECK(Names(Index) == std::vector<std::wstring>({ L"Code review" }));
+}
+
+static void PrefixMatchesComeFirst() {
+    LayoutIndex Index = MakeIndex();
+    Index.Filter(L"ing");
+    CHECK(Names(Index) == std::vector<std::wstring>({ L"coding", L"Gaming Setup", L"Streaming" })); // None start with it, name order
+    Index.Filter(L"s");
+    CHECK(Names(Index) == std::vector<std::wstring>({ L"Streaming", L"Gaming Setup" }));
+    Index.Filter(L"co");
+    CHECK(Names(Index) == std::vector<std::wstring>({ L"Code review", L"coding" }));
+}
+
+static void TypingNarrowsAndBackspaceWidens() {
+    LayoutIndex Index = MakeIndex();
+    Index.Filter(L"i");
+    CHECK_EQUAL((size_t)5, Index.Matches().size()); // Every name but Work
+    Index.Filter(L"in");
+    CHECK(Names(Index) == std::vector<std::wstring>({ L"coding", L"Gaming Setup", L"Streaming" }));
+    Index.Filter(L"ing s");
+    CHECK(Names(Index) == std::vector<std::wstring>({ L"Gaming Setup" }));
+    Index.Filter(L"in"); // Backspacing can't reuse the narrower matches
+    CHECK_EQUAL((size_t)3, Index.Matches().size());
+    Index.Filter(L"");
+    CHECK_EQUAL((size_t)6, Index.Matches().size());
+}
+
+static void UnknownTrigramMatchesNothing() {
+    LayoutIndex Index = MakeIndex();
+    CHECK(Index.Filter(L"xyz").empty());
+    CHECK(Index.Filter(L"workx").empty());
+    CHECK_EQUAL((size_t)1, Index.Filter(L"ork").size());
+}
+
+static void RebuildResetsFilter() {
+    LayoutIndex Index = MakeIndex();
+    Index.Filter(L"work");
+    Index.Build({ L"Workshop", L"Network", L"Other" });
+    CHECK_EQUAL((size_t)3, Index.Matches().size());
+    Index.Filter(L"work"); // Same query as before the rebuild, still filtered against the new names
+    CHECK(Names(Index) == std::vector<std::wstring>({ L"Workshop", L"Network" }));
+}
+
+static void EmptyIndex() {
+    LayoutIndex Index;
+    Index.Build({});
+    CHECK(Index.Filter(L"").empty());
+    CHECK(Index.Filter(L"abc").empty());
+}
+
+int main() {
+    BuildSortsAndMatchesAll();
+    FilterIgnoresCase();
+    PrefixMatchesComeFirst();
+    TypingNarrowsAndBackspaceWidens();
+    UnknownTrigramMatchesNothing();
+    RebuildResetsFilter();
+    EmptyIndex();
+    return CheckResult();
+}
@@ -0,0 +1,111 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// LayoutPlannerTests.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.22 created
+//-----------------------------------------------
+// Tests for LayoutPlanner against a recorded scene (Scenes/TwoMonitors.json, in the format `WinWin RecordWindows` writes)
+
+#include "LayoutPlanner.h"
+#include "Check.h"
+#include <filesystem>
+#include <fstream>
+
+static WindowScene LoadScene() {
+    WindowScene scene;
+    std::ifstream file{ std::filesystem::path(WINWIN_TEST_SCENES) / "TwoMonitors.json" };
+    nlohmann::json Doc = nlohmann::json::parse(file, nullptr, false);
+    CHECK(!Doc.is_discarded() && WindowScene::FromJson(Doc, scene));
+    return scene;
+}
+
+static bool SameRect(const PlanRect& rect, int left, int top, int right, int bottom) {
+    return rect.left == left && rect.top == top && rect.right == right && rect.bottom == bottom;
+}
+
+static void SceneFileLoads() {
+    WindowScene scene = LoadScene();
+    CHECK_EQUAL(1920, scene.screenWidth);
+    CHECK_EQUAL((size_t)2, scene.monitors.size());
+    CHECK_EQUAL((size_t)6, scene.windows.size());
+    CHECK(scene.windows[3].minimized);
+    CHECK(scene.windows[4].maximized);
+
+    WindowScene reread; // What RecordWindows writes reads back the same
+    CHECK(WindowScene::FromJson(nlohmann::json::parse(scene.ToJson().dump()), reread));
+    CHECK_EQUAL(scene.windows[2].title, reread.windows[2].title);
+    CHECK(SameRect(reread.monitors[1].workArea, 1920, 0, 4480, 1400));
+
+    CHECK(!WindowScene::FromJson(nlohmann::json::array(), reread));
+    CHECK(!WindowScene::FromJson({ {"windows", "none"} }, reread));
+}
+
+static void StackSplitsIntoColumns() {
+    LayoutPlan plan = LayoutPlanner::Stack(LoadScene());
+    CHECK_EQUAL((size_t)6, plan.placements.size());
+    CHECK_EQUAL(0, plan.untouched);
+    CHECK(SameRect(plan.placements[0].to, 0, 0, 960, 360));
+    CHECK(SameRect(plan.placements[2].to, 0, 720, 960, 1080));
+    CHECK(SameRect(plan.placements[3].to, 960, 0, 1920, 360));
+    CHECK(SameRect(plan.placements[3].from, 2100, 200, 3000, 900));
+}
+
+static void CascadeAndSquish() {
+    WindowScene scene = LoadScene();
+    LayoutPlan cascade = LayoutPlanner::Cascade(scene);
+    CHECK_EQUAL((size_t)6, cascade.placements.size());
+    CHECK(SameRect(cascade.placements[5].to, 335, 260, 1085, 1010));
+
+    LayoutPlan squish = LayoutPlanner::Squish(scene); // Only the two windows still where a cascade put them
+    CHECK_EQUAL((size_t)2, squish.placements.size());
+    CHECK_EQUAL(1002LL, squish.placements[1].handle);
+    CHECK_EQUAL(std::string("minimize"), squish.placements[1].action);
+    CHECK_EQUAL(4, squish.untouched);
+}
+
+static void LayoutMatchesHandleTitleProcess() {
+    nlohmann::json Layout = nlohmann::json::parse(R"({"version": 2, "windows": [
+        {"handle": 1003, "title": "Renamed", "rcNormalPosition": {"left": 0, "top": 0, "right": 500, "bottom": 500}, "showCmd": 1},
+        {"handle": 9, "title": "Calculator", "rcNormalPosition": {"left": 0, "top": 0, "right": 300, "bottom": 400}, "showCmd": 3},
+        {"handle": 9, "title": "Old title", "process": "C:\\Apps\\Microsoft VS Code\\Code.exe", "rcNormalPosition": {"left": 0, "top": 0, "right": 10, "bottom": 10}, "showCmd": 2},
+        {"handle": 1004, "title": "Terminal", "rcNormalPosition": {"left": 2000, "top": 100, "right": 3000, "bottom": 600},
+         "normalized": {"left": 0.5, "top": 0.0, "right": 1.0, "bottom": 0.5}, "showCmd": 1},
+        {"handle": 9, "title": "Gone", "process": "C:\\gone.exe", "rcNormalPosition": {"left": 0, "top": 0, "right": 10, "bottom": 10}},
+        {"handle": 1005, "title": "Spotify"}]})");
+    LayoutPlan plan;
+    CHECK(LayoutPlanner::Plan({ "ExecuteLayout", "Work" }, LoadScene(), [&](const std::string& name) {
+        CHECK_EQUAL(std::string("Work"), name);
+        return Layout;
+    }, plan));
+    CHECK_EQUAL((size_t)4, plan.placements.size());
+    CHECK_EQUAL(std::string("handle"), plan.placements[0].matchedBy);
+    CHECK_EQUAL(std::string("title"), plan.placements[1].matchedBy);
+    CHECK_EQUAL(std::string("maximize"), plan.placements[1].action);
+    CHECK_EQUAL(std::string("process"), plan.placements[2].matchedBy);
+    CHECK_EQUAL(1001LL, plan.placements[2].handle);
+    CHECK_EQUAL(std::string("minimize"), plan.placements[2].action);
+    CHECK(SameRect(plan.placements[3].to, 3200, 0, 4480, 700)); // Rescaled onto the second monitor's work area
+    CHECK(plan.unmatched == std::vector<std::string>({ "Gone", "Spotify" })); // Spotify was saved without a position
+    CHECK_EQUAL(2, plan.untouched);
+}
+
+static void OnlyPlannableCommands() {
+    LayoutPlan plan;
+    auto NoLayout = [](const std::string&) { return nlohmann::json::object(); };
+    CHECK(!LayoutPlanner::Plan({ "ExecuteDesktop" }, LoadScene(), NoLayout, plan));
+    CHECK(!LayoutPlanner::Plan({}, LoadScene(), NoLayout, plan));
+    CHECK(LayoutPlanner::Plan({ "ExecuteLayout", "Missing" }, LoadScene(), NoLayout, plan));
+    CHECK(plan.placements.empty());
+    CHECK_EQUAL(6, plan.untouched);
+}
+
+int main() {
+    SceneFileLoads();
+    StackSplitsIntoColumns();
+    CascadeAndSquish();
+    LayoutMatchesHandleTitleProcess();
+    OnlyPlannableCommands();
+    return CheckResult();
+}
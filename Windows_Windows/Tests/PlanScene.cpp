@@ -0,0 +1,78 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// PlanScene.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.22 created
+//-----------------------------------------------
+// Portable driver for LayoutPlanner
+//
+// Plans a command against a scene file written by `WinWin RecordWindows` and prints the plan, the same line
+// `WinWin --windows <scene file> stack --plan` prints on Windows. Runs anywhere the tests build, so a scene recorded on one machine
+// can be planned and timed on another:
+//   PlanScene <scene file> stack|cascade|squish
+//   PlanScene <scene file> ExecuteLayout <layout file>
+// With --repeat <count> the plan is built count times and the average time is printed instead.
+
+#include "LayoutPlanner.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+// Read a JSON file, discarded if it's missing or malformed
+static nlohmann::json ReadJson(const std::string& path) {
+    std::ifstream file{ std::filesystem::path(path) };
+    return file.is_open() ? nlohmann::json::parse(file, nullptr, false) : nlohmann::json(nlohmann::json::value_t::discarded);
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    int repeat = 0;
+    for (size_t i = 0; i + 1 < args.size(); i++) {
+        if (args[i] == "--repeat") {
+            repeat = std::max(1, std::atoi(args[i + 1].c_str()));
+            args.erase(args.begin() + i, args.begin() + i + 2);
+            break;
+        }
+    }
+    if (args.size() < 2) {
+        std::cerr << "Usage: PlanScene <scene file> <command> [layout file] [--repeat <count>]\n";
+        return 2;
+    }
+
+    WindowScene scene;
+    nlohmann::json Doc = ReadJson(args[0]);
+    if (Doc.is_discarded() || !WindowScene::FromJson(Doc, scene)) {
+        std::cerr << "Can't read a window scene from " << args[0] << "\n";
+        return 1;
+    }
+    std::vector<std::string> command(args.begin() + 1, args.end());
+    auto LoadLayout = [](const std::string& path) { // The layout is named by path here, there's no SavedLayouts folder to look in
+        nlohmann::json Layout = ReadJson(path);
+        return Layout.is_discarded() ? nlohmann::json::object() : Layout;
+    };
+
+    LayoutPlan plan;
+    if (!LayoutPlanner::Plan(command, scene, LoadLayout, plan)) {
+        std::cerr << command[0] << " can't be planned, only stack, cascade, squish and ExecuteLayout can\n";
+        return 1;
+    }
+    if (repeat > 0) {
+        nlohmann::json Layout = (command[0] == "ExecuteLayout" && command.size() > 1 ? LoadLayout(command[1]) : nlohmann::json());
+        auto LoadOnce = [&Layout](const std::string&) { return Layout; }; // Time the planning, not the file reads
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repeat; i++) {
+            LayoutPlanner::Plan(command, scene, LoadOnce, plan);
+        }
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << scene.windows.size() << " windows, " << plan.placements.size() << " placements, "
+            << elapsed.count() / repeat << " us per plan\n";
+        return 0;
+    }
+    std::cout << plan.ToJson().dump(-1, ' ', false, nlohmann::json::error_handler_t::replace) << "\n";
+    return 0;
+}
@@ -0,0 +1,86 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// TraceTests.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.24 created
+//-----------------------------------------------
+// Tests for the trace ring buffer: spans recorded before and while it's enabled, overwriting, and the Chrome JSON
+
+#include "Trace.h"
+#include "Check.h"
+#include <thread>
+
+// The buffer is allocated once per process, so every test shares this capacity
+#define TEST_CAPACITY 64
+
+static void NothingBeforeEnable() {
+    CHECK(!Trace::Enabled());
+    CHECK_EQUAL(0ULL, Trace::Now());
+    Trace::Record({ "Early", "test" }); // No buffer yet, dropped without touching anything
+    { TraceSpan span("Off"); }
+    CHECK(Trace::Events().empty());
+    CHECK_EQUAL(0ULL, Trace::Dropped());
+}
+
+static void EnableWhileRecording() {
+    std::atomic<bool> go{ false };
+    std::vector<std::thread> Threads;
+    for (int t = 0; t < 4; t++) { // Race the first Enable, spans have to see the buffer whole or not at all
+        Threads.emplace_back([&go] {
+            while (!go.load()) {
+            }
+            for (int i = 0; i < 1000; i++) {
+                TraceSpan span("Probe", "test");
+                span.SetValue(i);
+            }
+        });
+    }
+    go = true;
+    Trace::Enable(TEST_CAPACITY);
+    for (std::thread& thread : Threads) {
+        thread.join();
+    }
+    std::vector<TraceEvent> Events = Trace::Events();
+    CHECK(Events.size() <= TEST_CAPACITY);
+    for (const TraceEvent& event : Events) {
+        CHECK_EQUAL(std::string("Probe"), std::string(event.name));
+        CHECK(event.hasValue && event.thread >= 1 && event.thread <= 4);
+    }
+}
+
+static void OldestAreOverwritten() {
+    unsigned long long before = Trace::Dropped() + Trace::Events().size();
+    for (int i = 0; i < TEST_CAPACITY + 10; i++) {
+        TraceEvent event;
+        event.name = "Ring";
+        event.value = i;
+        event.hasValue = true;
+        Trace::Record(event);
+    }
+    std::vector<TraceEvent> Events = Trace::Events();
+    CHECK_EQUAL((size_t)TEST_CAPACITY, Events.size());
+    CHECK_EQUAL(10LL, Events.front().value); // Oldest first, the first 10 were overwritten
+    CHECK_EQUAL((long long)TEST_CAPACITY + 9, Events.back().value);
+    CHECK_EQUAL(before + 10, Trace::Dropped());
+}
+
+static void DisableKeepsSpans() {
+    Trace::Disable();
+    size_t kept = Trace::Events().size();
+    { TraceSpan span("Ignored"); }
+    CHECK_EQUAL(kept, Trace::Events().size());
+    nlohmann::ordered_json Doc = Trace::ToChromeJson();
+    CHECK_EQUAL(kept, Doc["traceEvents"].size());
+    CHECK_EQUAL(std::string("X"), Doc["traceEvents"][0]["ph"].get<std::string>());
+    CHECK_EQUAL(Trace::Dropped(), Doc["otherData"]["dropped"].get<unsigned long long>());
+}
+
+int main() {
+    NothingBeforeEnable();
+    EnableWhileRecording();
+    OldestAreOverwritten();
+    DisableKeepsSpans();
+    return CheckResult();
+}
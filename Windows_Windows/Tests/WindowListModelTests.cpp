@@ -0,0 +1,134 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// WindowListModelTests.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.13 created
+//-----------------------------------------------
+// Tests for the geometry of the active window list: scrolling, visible rows, action rectangles and hit testing
+
+#include "WindowListModel.h"
+#include "Check.h"
+
+static WindowListModel MakeList(size_t rows, int width, int height) {
+    std::vector<WindowListRow> Rows;
+    for (size_t i = 0; i < rows; i++) {
+        Rows.push_back({ 0x1000 + i, L"Window " + std::to_wstring(i) });
+    }
+    WindowListModel Model;
+    Model.SetViewport(width, height);
+    Model.SetRows(std::move(Rows));
+    return Model;
+}
+
+static void ScrollIsClamped() {
+    WindowListModel Model = MakeList(10, 300, 250);
+    CHECK_EQUAL(1000, Model.ContentHeight());
+    CHECK(!Model.SetScroll(-20));
+    CHECK_EQUAL(0, Model.Scroll());
+    CHECK(Model.SetScroll(5000));
+    CHECK_EQUAL(750, Model.Scroll());
+    CHECK(!Model.SetScroll(750));
+
+    WindowListModel Short = MakeList(2, 300, 250); // Everything fits, nothing to scroll
+    CHECK(!Short.SetScroll(100));
+    CHECK_EQUAL(0, Short.Scroll());
+}
+
+static void ShrinkingClampsScroll() {
+    WindowListModel Model = MakeList(10, 300, 250);
+    Model.SetScroll(750);
+    Model.SetRows({ { 1, L"Only" }, { 2, L"Two" }, { 3, L"Three" } });
+    CHECK_EQUAL(50, Model.Scroll());
+    Model.SetViewport(300, 400); // A taller viewport leaves nothing to scroll
+    CHECK_EQUAL(0, Model.Scroll());
+}
+
+static void VisibleRowsFollowScroll() {
+    WindowListModel Model = MakeList(10, 300, 250);
+    size_t first, last;
+    Model.VisibleRows(first, last);
+    CHECK_EQUAL((size_t)0, first);
+    CHECK_EQUAL((size_t)3, last); // Rows 0 and 1 whole, row 2 half visible
+
+    Model.SetScroll(150);
+    Model.VisibleRows(first, last);
+    CHECK_EQUAL((size_t)1, first);
+    CHECK_EQUAL((size_t)4, last);
+
+    Model.SetScroll(750);
+    Model.VisibleRows(first, last);
+    CHECK_EQUAL((size_t)7, first);
+    CHECK_EQUAL((size_t)10, last);
+
+    WindowListModel Empty = MakeList(0, 300, 250);
+    Empty.VisibleRows(first, last);
+    CHECK_EQUAL(first, last);
+}
+
+static void RectsAreInViewportCoordinates() {
+    WindowListModel Model = MakeList(10, 300, 250);
+    Model.SetScroll(150);
+    ListRect row = Model.RowRect(2);
+    CHECK_EQUAL(50, row.top);
+    CHECK_EQUAL(150, row.bottom);
+    CHECK_EQUAL(300, row.right);
+
+    ListRect close = Model.ActionRect(2, WindowListAction::Close);
+    CHECK_EQUAL(160, close.left);
+    CHECK_EQUAL(100, close.top);
+    CHECK_EQUAL(230, close.right);
+    CHECK_EQUAL(130, close.bottom);
+    CHECK_EQUAL(row.top, Model.ActionRect(2, WindowListAction::Row).top);
+}
+
+static void NarrowListTruncatesTitle() {
+    WindowListModel Model = MakeList(1, 150, 250);
+    CHECK_EQUAL(140, Model.ActionRect(0, WindowListAction::Title).right);
+    Model.SetViewport(5, 250); // Narrower than the margin, the title is empty rather than inverted
+    ListRect title = Model.ActionRect(0, WindowListAction::Title);
+    CHECK_EQUAL(title.left, title.right);
+}
+
+static void HitTestFindsActions() {
+    WindowListModel Model = MakeList(10, 300, 250);
+    Model.SetScroll(150);
+
+    WindowListHit hit = Model.HitTest(20, 110); // Row 2's minimize button
+    CHECK_EQUAL(2, hit.row);
+    CHECK(hit.action == WindowListAction::Minimize);
+
+    hit = Model.HitTest(100, 60);
+    CHECK_EQUAL(2, hit.row);
+    CHECK(hit.action == WindowListAction::Row); // Above the buttons
+
+    hit = Model.HitTest(200, 10);
+    CHECK_EQUAL(1, hit.row);
+    CHECK(hit.action == WindowListAction::Close);
+
+    hit = Model.HitTest(120, 220);
+    CHECK_EQUAL(3, hit.row);
+    CHECK(hit.action == WindowListAction::Maximize);
+
+    CHECK(Model.HitTest(-1, 10) == WindowListHit());
+    CHECK(Model.HitTest(20, 250) == WindowListHit()); // Below the viewport
+    CHECK(Model.HitTest(300, 10) == WindowListHit());
+}
+
+static void HitTestPastLastRow() {
+    WindowListModel Model = MakeList(2, 300, 250);
+    CHECK_EQUAL(1, Model.HitTest(20, 199).row);
+    CHECK(Model.HitTest(20, 200) == WindowListHit());
+}
+
+int main() {
+    ScrollIsClamped();
+    ShrinkingClampsScroll();
+    VisibleRowsFollowScroll();
+    RectsAreInViewportCoordinates();
+    NarrowListTruncatesTitle();
+    HitTestFindsActions();
+    HitTestPastLastRow();
+    return CheckResult();
+}
@@ -0,0 +1,138 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// Trace.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.24 The buffer and epoch are published through an atomic pointer
+// 10/19/2026 MS-24.01.08.24 created
+//-----------------------------------------------
+// Source code for trace spans
+//
+// Defines functions for classes Trace and TraceSpan. See Trace.h.
+
+#include "Trace.h"
+#include <chrono>
+#include <fstream>
+#include <mutex>
+
+std::atomic<bool> Trace::s_Enabled = false;
+std::atomic<Trace::Buffer*> Trace::s_Buffer = nullptr;
+std::atomic<unsigned long long> Trace::s_Next = 0;
+
+static std::once_flag s_Allocated;
+static std::atomic<unsigned int> s_Threads = 0;
+
+void Trace::Enable(size_t capacity) {
+    std::call_once(s_Allocated, [capacity] { // Never reallocated, a span could be writing into it
+        Buffer* buffer = new Buffer;
+        buffer->capacity = (capacity > 0 ? capacity : TRACE_DEFAULT_CAPACITY);
+        buffer->slots.reset(new Slot[buffer->capacity]);
+        buffer->epoch = std::chrono::steady_clock::now();
+        s_Buffer.store(buffer, std::memory_order_release); // Record and Now on other threads don't go through call_once, they acquire this
+    });
+    s_Enabled.store(true, std::memory_order_release);
+}
+
+void Trace::Disable() {
+    s_Enabled.store(false, std::memory_order_release);
+}
+
+unsigned long long Trace::Now() {
+    Buffer* buffer = s_Buffer.load(std::memory_order_acquire);
+    if (buffer == nullptr) {
+        return 0;
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - buffer->epoch).count();
+}
+
+void Trace::Record(const TraceEvent& event) {
+    Buffer* buffer = s_Buffer.load(std::memory_order_acquire);
+    if (buffer == nullptr) {
+        return;
+    }
+    static thread_local unsigned int thread = ++s_Threads;
+    unsigned long long index = s_Next.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = buffer->slots[index % buffer->capacity];
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed); // Odd - readers skip the slot until it's published
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(event.name, std::memory_order_relaxed);
+    slot.category.store(event.category, std::memory_order_relaxed);
+    slot.start.store(event.start, std::memory_order_relaxed);
+    slot.duration.store(event.duration, std::memory_order_relaxed);
+    slot.thread.store(thread, std::memory_order_relaxed);
+    slot.value.store(event.value, std::memory_order_relaxed);
+    slot.hasValue.store(event.hasValue, std::memory_order_relaxed);
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+}
+
+std::vector<TraceEvent> Trace::Events() {
+    std::vector<TraceEvent> Events;
+    Buffer* buffer = s_Buffer.load(std::memory_order_acquire);
+    if (buffer == nullptr) {
+        return Events;
+    }
+    unsigned long long next = s_Next.load(std::memory_order_acquire);
+    unsigned long long first = (next > buffer->capacity ? next - buffer->capacity : 0);
+    Events.reserve((size_t)(next - first));
+    for (unsigned long long index = first; index < next; index++) {
+        Slot& slot = buffer->slots[index % buffer->capacity];
+        unsigned long long sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != 2 * index + 2) {
+            continue; // Still being written, or already overwritten by a newer span
+        }
+        TraceEvent event;
+        event.name = slot.name.load(std::memory_order_relaxed);
+        event.category = slot.category.load(std::memory_order_relaxed);
+        event.start = slot.start.load(std::memory_order_relaxed);
+        event.duration = slot.duration.load(std::memory_order_relaxed);
+        event.thread = slot.thread.load(std::memory_order_relaxed);
+        event.value = slot.value.load(std::memory_order_relaxed);
+        event.hasValue = slot.hasValue.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+            continue; // Overwritten while it was copied
+        }
+        Events.push_back(event);
+    }
+    return Events;
+}
+
+unsigned long long Trace::Dropped() {
+    Buffer* buffer = s_Buffer.load(std::memory_order_acquire);
+    unsigned long long next = s_Next.load(std::memory_order_acquire);
+    return (buffer != nullptr && next > buffer->capacity ? next - buffer->capacity : 0);
+}
+
+nlohmann::ordered_json Trace::ToChromeJson() {
+    nlohmann::ordered_json Doc;
+    Doc["traceEvents"] = nlohmann::ordered_json::array();
+    for (const TraceEvent& event : Events()) {
+        nlohmann::ordered_json record = { {"name", event.name}, {"cat", event.category}, {"ph", "X"}, {"ts", event.start}, {"dur", event.duration},
+            {"pid", 1}, {"tid", event.thread} }; // Complete events, each carries its own duration
+        if (event.hasValue) {
+            record["args"] = { {"value", event.value} };
+        }
+        Doc["traceEvents"].push_back(record);
+    }
+    Doc["displayTimeUnit"] = "ms";
+    Doc["otherData"] = { {"dropped", Dropped()} };
+    return Doc;
+}
+
+bool Trace::Write(const std::filesystem::path& file) {
+    std::ofstream TraceFile(file, std::ios::trunc);
+    if (!TraceFile) {
+        return false;
+    }
+    TraceFile << ToChromeJson().dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+    return (bool)TraceFile;
+}
+
+
+///   TRACE SPAN   ///
+
+void TraceSpan::End() {
+    m_event.duration = Trace::Now() - m_event.start;
+    Trace::Record(m_event);
+}
@@ -0,0 +1,167 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// Trace.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.24 The buffer and epoch are published through an atomic pointer
+// 10/19/2026 MS-24.01.08.24 created
+//-----------------------------------------------
+// Header file for trace spans
+//
+// Contains class Trace, a process wide ring buffer of timed spans, and class TraceSpan, which records the time of a scope into it.
+// Where CommandStats adds a command's time up by phase, a trace keeps every span on its own - each hung window probe, each OpenProcess,
+// each layout file parse, each SetWindowPlacement batch - with the thread it ran on, so one slow window or file stands out.
+// `--trace <file>` turns tracing on for a command (or a script, or the UI) and writes the spans to the file as Chrome trace event JSON
+// when it finishes. Open the file in chrome://tracing or https://ui.perfetto.dev.
+// Recording is lock free: a span claims the next slot with one atomic increment and publishes it with a sequence number, so threads
+// never wait on each other, and once the buffer is full the oldest spans are overwritten. When tracing is off a TraceSpan is one
+// atomic load and doesn't read the clock.
+// Span names and categories are stored as pointers, so they have to be string literals.
+// Like WindowListModel.h, it has no Windows dependencies.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+// Spans kept when Enable isn't given a capacity. Each slot is 64 bytes, so this is 4 MB.
+#define TRACE_DEFAULT_CAPACITY 65536
+
+/**
+ * @brief One finished span
+ */
+struct TraceEvent {
+	const char* name = "";
+	const char* category = "";
+	unsigned long long start = 0;       // Microseconds since tracing was enabled
+	unsigned long long duration = 0;    // Microseconds
+	unsigned int thread = 0;            // Small per thread number, 1 for the first thread that recorded a span
+	long long value = 0;                // Window handle, process ID or count, depending on the span
+	bool hasValue = false;
+};
+
+class Trace {
+public:
+
+	/**
+	 * @brief Start recording spans
+	 *
+	 * The buffer is allocated by the first call and kept for the life of the process, later calls only turn recording back on.
+	 *
+	 * @param capacity Spans kept before the oldest are overwritten
+	 */
+	static void Enable(size_t capacity = TRACE_DEFAULT_CAPACITY);
+
+	/**
+	 * @brief Stop recording spans. Spans already recorded are kept.
+	 */
+	static void Disable();
+
+	static bool Enabled() { return s_Enabled.load(std::memory_order_acquire); }
+
+	/**
+	 * @brief Microseconds since tracing was enabled
+	 */
+	static unsigned long long Now();
+
+	/**
+	 * @brief Add a finished span to the buffer. Safe to call from any thread.
+	 */
+	static void Record(const TraceEvent& event);
+
+	/**
+	 * @brief Copy the spans out of the buffer, oldest first
+	 *
+	 * Spans still being written, or overwritten while they're copied, are left out.
+	 */
+	static std::vector<TraceEvent> Events();
+
+	/**
+	 * @brief Number of spans overwritten because the buffer was full
+	 */
+	static unsigned long long Dropped();
+
+	/**
+	 * @brief Build the Chrome trace event document for the recorded spans
+	 * @return {"traceEvents": [{"name", "cat", "ph": "X", "ts", "dur", "pid", "tid", "args"}], "displayTimeUnit": "ms", "otherData": {"dropped"}}
+	 */
+	static nlohmann::ordered_json ToChromeJson();
+
+	/**
+	 * @brief Write ToChromeJson to a file
+	 * @return False if the file can't be written
+	 */
+	static bool Write(const std::filesystem::path& file);
+
+private:
+
+	// A slot is only read when its sequence is even and the same before and after the read
+	struct Slot {
+		std::atomic<unsigned long long> sequence{ 0 };    // 2 * index + 1 while index is being written, 2 * index + 2 once it's done
+		std::atomic<const char*> name{ nullptr };
+		std::atomic<const char*> category{ nullptr };
+		std::atomic<unsigned long long> start{ 0 };
+		std::atomic<unsigned long long> duration{ 0 };
+		std::atomic<unsigned int> thread{ 0 };
+		std::atomic<long long> value{ 0 };
+		std::atomic<bool> hasValue{ false };
+	};
+
+	// The slots and the time tracing was first enabled. Built once by Enable and published whole through s_Buffer (release store,
+	// acquire loads), and never freed, so a span on another thread never sees it half built or writes into it after it's gone.
+	struct Buffer {
+		std::unique_ptr<Slot[]> slots;
+		size_t capacity = 0;
+		std::chrono::steady_clock::time_point epoch;
+	};
+
+	static std::atomic<bool> s_Enabled;
+	static std::atomic<Buffer*> s_Buffer;             // NULL until the first Enable
+	static std::atomic<unsigned long long> s_Next;    // Index of the next span, counts every span ever recorded
+};
+
+/**
+ * @brief Records the time until it's destroyed as a span
+ */
+class TraceSpan {
+public:
+	/**
+	 * @param name Span name, a string literal
+	 * @param category Span category, a string literal
+	 */
+	explicit TraceSpan(const char* name, const char* category = "winwin") : m_active(Trace::Enabled()) {
+		if (m_active) {
+			m_event.name = name;
+			m_event.category = category;
+			m_event.start = Trace::Now();
+		}
+	}
+
+	~TraceSpan() {
+		if (m_active) {
+			End();
+		}
+	}
+
+	TraceSpan(const TraceSpan&) = delete;
+	TraceSpan& operator=(const TraceSpan&) = delete;
+
+	/**
+	 * @brief Attach a number to the span, shown as its "value" argument
+	 */
+	void SetValue(long long value) {
+		m_event.value = value;
+		m_event.hasValue = true;
+	}
+
+private:
+	void End();
+
+	bool m_active;    // Tracing was on when the span started
+	TraceEvent m_event;
+};
@@ -0,0 +1,30 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// UiState.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.18 created
+//-----------------------------------------------
+// Source code for the main window's UI state
+//
+// Defines functions for struct UiState. See UiState.h.
+
+#include "UiState.h"
+#include "WindowListModel.h"
+#include <algorithm>
+
+UiLayout UiState::Layout(int pickerHeight) const {
+    UiLayout layout;
+    layout.iconPanelHeight = desktopLayoutsOpen ? 100 + pickerHeight + 10 : ICON_WINDOW_CLOSED_Y; // The pickers sit 100 and 140 pixels down their panels
+    layout.windowsPanelY = layout.iconPanelHeight;
+    layout.windowsPanelHeight = windowLayoutsOpen ? 140 + pickerHeight + 10 : WINDOWS_CONTROL_CLOSED_Y;
+    layout.activePanelY = layout.windowsPanelY + layout.windowsPanelHeight;
+
+    int listGrowth = 0;
+    if (activeListOpen) {
+        listGrowth = (int)std::min<size_t>(listRows * WINDOW_LIST_ROW_HEIGHT, ACTIVE_WINDOWS_MAX_GROWTH);
+    }
+    layout.windowHeight = M_HWND_CLOSED_Y + (layout.activePanelY - SHOW_ACTIVE_WINDOWS_BUTTON_Y) + listGrowth;
+    return layout;
+}
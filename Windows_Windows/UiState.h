@@ -0,0 +1,63 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// UiState.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.18 created
+//-----------------------------------------------
+// Header file for the main window's UI state
+//
+// Contains struct UiState, which records what the main window is showing (which dropdowns are open, whether a multilayered stack is
+// running, whether SQUISH is available), and struct UiLayout, the panel geometry that follows from it.
+// Every button and panel is created once. The toggles only change a UiState and ask WindowsApp for a layout pass, and the pass sets
+// the buttons' text, command and enable state and moves the panels to match. Nothing is destroyed or recreated along the way.
+// Like WindowListModel.h, it has no Windows dependencies.
+
+#pragma once
+
+#include <cstddef>
+
+// Fixed window sizes
+#define SHOW_ACTIVE_WINDOWS_BUTTON_Y 250
+#define M_HWND_CLOSED_Y 355
+#define WINDOWS_CONTROL_CLOSED_Y 150
+#define ICON_WINDOW_CLOSED_Y 100
+
+// Height of the show/hide button at the top of the active windows panel
+#define ACTIVE_WINDOWS_BUTTON_HEIGHT 30
+
+// Most the main window grows by to show the active window list, the list scrolls past this
+#define ACTIVE_WINDOWS_MAX_GROWTH 300
+
+// Width of the icon and windows control panels
+#define CONTROL_PANEL_WIDTH 300
+
+/**
+ * @brief Positions and sizes of the main window's panels, in client coordinates
+ */
+struct UiLayout {
+	int iconPanelHeight;      // m_hIconControlPanel, at the top of the client area
+	int windowsPanelY;        // m_hWindowsControlPanel, below the icon panel
+	int windowsPanelHeight;
+	int activePanelY;         // m_hActiveWindowsControlPanel, below the windows panel. It fills the rest of the client area.
+	int windowHeight;         // Height of the main window, frame included
+};
+
+struct UiState {
+	bool activeListOpen = false;        // The active window list is showing
+	bool windowLayoutsOpen = false;     // The saved window layout picker is showing
+	bool desktopLayoutsOpen = false;    // The saved desktop icon layout picker is showing
+	bool squishAvailable = false;       // A cascade has run, so SQUISH has something to squish
+	bool layeredStack = false;          // A multilayered stack is running: EXIT STACK, < PREV and NEXT > replace STACK
+	bool stackHasPrev = false;          // The stack isn't on its first layer
+	bool stackHasNext = false;          // The stack isn't on its last layer
+	size_t listRows = 0;                // Rows in the active window list when it was opened
+
+	/**
+	 * @brief Lay out the panels for this state
+	 * @param pickerHeight Height of a LayoutPicker, the saved layout panels grow by it when they're open
+	 * @return The panel geometry
+	 */
+	UiLayout Layout(int pickerHeight) const;
+};
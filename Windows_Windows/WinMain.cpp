@@ -1,79 +1,88 @@
-//***********************************************
-// WindowsWindows
-// Copyright 2024 Michael Steuber
-//===============================================
-// WinMain.cpp
-// ----------------------------------------------
-// 09/03/2024 MS-24.01.07.02 Updated command line args to use WinWinFunctions functions rather than WindowsApp UI functions
-// 08/27/2024 MS-24.01.06.02 updated command line args to support executelayout parameters
-// 08/26/2024 MS-24.01.06.01 Added command line arguments
-// 07/25/2024 MS-24.01.02.0 Updated to be compatible with template window
-// 07/23/2024 MS-24.01.01.0 created
-//-----------------------------------------------
-// Windows entry point
-//
-// Win32 looks for the WinMain function to execute first. 
-// Starts by checking for command line parameters - if they are present, they call their corresponding function
-// If there are no command line paramters, a WindowsApp is created and the UI is initialized
-
-#include <windows.h>
-#include "WindowsApp.h"
-#include <shellapi.h>
-#include <stdio.h>
-
-int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR pCmdLine, int nCmdShow) {
-	HeapSetInformation(NULL, HeapEnableTerminationOnCorruption, NULL, 0);
-   std::string params;
-   std::string cmdLine(pCmdLine); 
-   std::wstring layout;
-   std::string command = cmdLine;
-   if (__argc > 2) {        // If there are more than 2 command line paramters, store the third in layout after converting it to a wide string
-       command = __argv[1]; // The first two command line parameters are Windows_Windows.exe and whatever command the user would like to execute. 
-       params = __argv[2];  // For example, if the user would like to execute cascade, they would call ./Windows_Windows.exe cascade
-       int size_needed = MultiByteToWideChar(CP_UTF8, 0, params.c_str(), -1, NULL, 0);
-       std::wstring wstr(size_needed, 0);
-       MultiByteToWideChar(CP_UTF8, 0, params.c_str(), -1, &wstr[0], size_needed);
-       layout = wstr;
-   }
-
-   WindowsApp app;
-                            // Match a user function call to a WinWin function
-	if (cmdLine == "stack") {
-		WinWinFunctions::Stack(WinWinFunctions::GetActiveWindows()); 
-		return 0;
-	}
-   else if (cmdLine == "cascade") {
-        WinWinFunctions::Cascade(WinWinFunctions::GetActiveWindows());
-       return 0;
-   }
-   else if (cmdLine == "squish") {
-        WinWinFunctions::Squish(WinWinFunctions::GetActiveWindows());
-       return 0;
-   }
-   else if (command == "SaveLayout") {
-        if (__argc > 2) {
-            WinWinFunctions::SaveWindowLayout(WinWinFunctions::GetActiveWindows(), layout);
-        }
-        else {
-            WinWinFunctions::SaveWindowLayout(WinWinFunctions::GetActiveWindows());
-        }
-       return 0;
-   }
-   else if (command == "ExecuteLayout") {
-       WinWinFunctions::ExecuteWindowLayout(layout, WinWinFunctions::GetActiveWindows());
-       return 0;
-   }
-   else if (cmdLine == "SaveDesktop") {
-       WinWinFunctions::SaveDesktopLayout();
-       return 0;
-   }
-   else if (command == "ExecuteDesktop") {
-       WinWinFunctions::ExecuteDesktopLayout(layout);
-       return 0;
-   }
-	if (SUCCEEDED(app.Initialize())) {
-		ShowWindow(app.Window(), nCmdShow);   // If there are no user provided parameters or if the parameters don't match any of the IDs above,                                  
-		app.RunMessageLoop();                 // initialize the app and start the UI 
-	}
-	return 0;
-}
\ No newline at end of file
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// WinMain.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.19 Commands attach to the parent console so their output shows up in the terminal that ran them
+// 10/19/2026 MS-24.01.08.25 Open the application latency statistics, the UI writes them when it exits
+// 10/19/2026 MS-24.01.08.24 --trace records the UI session and writes the trace when it exits
+// 10/19/2026 MS-24.01.08.23 --first-paint closes the UI after its first frame, for StartupBench
+// 10/19/2026 MS-24.01.08.19 Commands are matched by WinWinCommands and forwarded to the resident service when it is running, WindowsApp is only constructed for the UI
+// 10/19/2026 MS-24.01.08.17 Release the cached GDI objects when the UI exits
+// 10/19/2026 MS-24.01.08.12 SaveDesktop takes an optional layout name, added DiffDesktop command
+// 10/19/2026 MS-24.01.08.11 ExecuteDesktop takes an optional sort rule for new icons
+// 10/19/2026 MS-24.01.08.08 ExecuteDesktop prints the number of icons moved
+// 10/19/2026 MS-24.01.08.04 Added SaveProfile and ApplyProfile commands
+// 10/19/2026 MS-24.01.08.02 Added RestoreSnapshot command
+// 09/03/2024 MS-24.01.07.02 Updated command line args to use WinWinFunctions functions rather than WindowsApp UI functions
+// 08/27/2024 MS-24.01.06.02 updated command line args to support executelayout parameters
+// 08/26/2024 MS-24.01.06.01 Added command line arguments
+// 07/25/2024 MS-24.01.02.0 Updated to be compatible with template window
+// 07/23/2024 MS-24.01.01.0 created
+//-----------------------------------------------
+// Windows entry point
+//
+// Win32 looks for the WinMain function to execute first. 
+// Starts by checking for command line parameters - if they are present, WinWinCommands runs their corresponding function
+// If there are no command line paramters, a WindowsApp is created and the UI is initialized
+
+#include <windows.h>
+#include "WindowsApp.h"
+#include "WinWinCommands.h"
+#include "WinWinFunctions.h"
+#include "Trace.h"
+#include "AppLatency.h"
+#include <shellapi.h>
+#include <stdio.h>
+#include <algorithm>
+
+// A /SUBSYSTEM:WINDOWS exe starts without a console, so command output printed from a terminal would go nowhere. Write it to the
+// terminal that started us instead, unless stdout is already redirected to a file or pipe (scripts, StartupBench).
+static void AttachParentConsole() {
+	HANDLE out = GetStdHandle(STD_OUTPUT_HANDLE);
+	if (out != NULL && out != INVALID_HANDLE_VALUE) {
+		return;
+	}
+	if (AttachConsole(ATTACH_PARENT_PROCESS)) {
+		FILE* stream;
+		freopen_s(&stream, "CONOUT$", "w", stdout);
+		freopen_s(&stream, "CONOUT$", "w", stderr);
+	}
+}
+
+int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR pCmdLine, int nCmdShow) {
+	HeapSetInformation(NULL, HeapEnableTerminationOnCorruption, NULL, 0);
+   std::vector<std::string> args(__argv + 1, __argv + __argc); // Everything after Windows_Windows.exe, e.g. {"ExecuteLayout", "Work"}
+   if (!args.empty()) {
+       AttachParentConsole(); // Before any command prints
+   }
+   AppLatency::Open(std::filesystem::path(WinWinFunctions::GetExeDirectory()) / APP_LATENCY_FILE_NAME); // Read when first needed
+
+   int status = WinWinCommands::Run(args); // Forwarded to the WinWin service if one is running, otherwise run here
+   if (status != COMMAND_NOT_FOUND) {
+       return status;
+   }
+
+   std::vector<std::string> uiArgs = args;
+   CommandOptions options = WinWinCommands::TakeOptions(uiArgs);
+   if (!options.traceFile.empty()) {
+       Trace::Enable(); // From before the window is created until the UI exits, see Trace.h
+   }
+
+   WindowsApp app;          // If there are no user provided parameters or if the parameters don't match a command,
+   if (std::find(args.begin(), args.end(), "--first-paint") != args.end()) {
+       app.ExitAfterFirstPaint(); // Launched by `WinWin bench`, see StartupBench.h
+   }
+	if (SUCCEEDED(app.Initialize())) { // initialize the app and start the UI
+		ShowWindow(app.Window(), nCmdShow);
+		app.RunMessageLoop();
+		GdiCache::Reset();
+	}
+	AppLatency::Flush();
+	if (!options.traceFile.empty()) {
+		Trace::Disable();
+		Trace::Write(std::filesystem::path(WinWinFunctions::ConvertToWideString(options.traceFile)));
+	}
+	return 0;
+}
@@ -0,0 +1,531 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// WinWinCommands.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.25 Each command runs with a process cache, so its windows' applications are looked up once
+// 10/19/2026 MS-24.01.08.12 SaveDesktop and DiffDesktop print an error and fail when the layout or the desktop can't be opened
+// 10/19/2026 MS-24.01.08.11 ExecuteDesktop rejects options that aren't a sort rule or snap
+// 10/19/2026 MS-24.01.08.25 Added the stats command, Execute flushes the application latencies a command recorded
+// 10/19/2026 MS-24.01.08.24 Added --trace, each command runs in a trace span
+// 10/19/2026 MS-24.01.08.23 Added the bench command
+// 10/19/2026 MS-24.01.08.22 Added --plan and --windows dry runs through LayoutPlanner, and RecordWindows
+// 10/19/2026 MS-24.01.08.21 Added --json, which reports each command as one line of JSON with its counts and phase timings
+// 10/19/2026 MS-24.01.08.20 Added the run command for batch scripts
+// 10/19/2026 MS-24.01.08.19 created, command matching moved here from WinMain
+//-----------------------------------------------
+// Source code for the command line commands
+//
+// Defines functions for class WinWinCommands and struct CommandEnvironment. See WinWinCommands.h.
+
+#include "WinWinCommands.h"
+#include "WinWinFunctions.h"
+#include "LayoutSnapshotter.h"
+#include "WorkspaceProfiles.h"
+#include "CommandChannel.h"
+#include "WinWinService.h"
+#include "WindowSnapshot.h"
+#include "CommandStats.h"
+#include "LayoutPlanner.h"
+#include "StartupBench.h"
+#include "Trace.h"
+#include "AppLatency.h"
+#include <stdio.h>
+#include <sstream>
+#include <exception>
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cstdlib>
+#include <cerrno>
+
+// Every command IsCommand accepts. The names are string literals, so they can name a trace span.
+static const char* Commands[] = { "stack", "cascade", "squish", "SaveLayout", "ExecuteLayout", "SaveDesktop", "DiffDesktop",
+    "SaveProfile", "ApplyProfile", "RestoreSnapshot", "ExecuteDesktop", "RecordWindows" };
+
+CommandEnvironment CommandEnvironment::InProcess() {
+    CommandEnvironment environment;
+    environment.Windows = [] { return WinWinFunctions::GetActiveWindows(); };
+    environment.LoadLayout = [](const std::wstring& path) { return LayoutSchema::Load(path); };
+    environment.Invalidate = [] {}; // Every command enumerates anyway
+    return environment;
+}
+
+// Apply a layout file to the given windows, see WinWinFunctions::ExecuteWindowLayout
+static void ExecuteLayoutFile(const std::wstring& path, const CommandEnvironment& environment, const std::function<std::vector<HWND>()>& Windows) {
+    nlohmann::json Doc = environment.LoadLayout(path);
+    if (!Doc.empty()) {
+        WinWinFunctions::ApplyLayoutDocument(Doc, Windows());
+    }
+}
+
+// Apply a saved window layout to the given windows
+static void ExecuteLayout(const std::wstring& name, const CommandEnvironment& environment, const std::function<std::vector<HWND>()>& Windows) {
+    ExecuteLayoutFile(WinWinFunctions::WindowLayoutPath(name), environment, Windows);
+}
+
+static void Print(const std::string& output) {
+    fwrite(output.data(), 1, output.size(), stdout);
+    fflush(stdout); // A script's output shows up line by line rather than when it ends
+}
+
+// Run a command in this process and print its output
+static int RunHere(const std::vector<std::string>& args, const CommandEnvironment& environment) {
+    std::ostringstream out;
+    int status;
+    try {
+        status = WinWinCommands::Execute(args, out, environment);
+    }
+    catch (const std::exception& e) {
+        out << "WinWin: " << e.what() << "\n";
+        status = 1;
+    }
+    Print(out.str());
+    return status;
+}
+
+int WinWinCommands::Run(const std::vector<std::string>& commandLine) {
+    std::vector<std::string> args = commandLine;
+    CommandOptions options = TakeOptions(args);
+    if (options.traceFile.empty()) {
+        return RunCommandLine(commandLine);
+    }
+    Trace::Enable();
+    int status = RunCommandLine(commandLine);
+    Trace::Disable();
+    if (status == COMMAND_NOT_FOUND) {
+        return status; // WinMain starts the UI, which writes its own trace
+    }
+    if (!Trace::Write(std::filesystem::path(WinWinFunctions::ConvertToWideString(options.traceFile)))) {
+        Print("Can't write the trace to " + options.traceFile + "\n");
+        return 1;
+    }
+    return status;
+}
+
+int WinWinCommands::RunCommandLine(const std::vector<std::string>& commandLine) {
+    std::vector<std::string> args = commandLine;
+    CommandOptions options = TakeOptions(args); // The options stay on the command line that's forwarded, the service reads them itself
+    if (args.empty()) {
+        return COMMAND_NOT_FOUND;
+    }
+    CommandReply reply;
+    if (args[0] == "Service") {
+        if (args.size() < 2) {
+            return WinWinService::Run(); // Blocks until the service is stopped
+        }
+        if (args[1] == "stop") {
+            if (!CommandChannel::Send(args, reply)) {
+                Print("No WinWin service is running\n");
+                return 1;
+            }
+            Print(reply.output);
+            return reply.status;
+        }
+        return COMMAND_NOT_FOUND;
+    }
+    if (args[0] == "run") {
+        if (args.size() < 2 || args[1] == "-") {
+            return RunScript(std::cin, options);
+        }
+        std::ifstream script(std::filesystem::path(WinWinFunctions::ConvertToWideString(args[1])));
+        if (!script) {
+            Print("Can't open script " + args[1] + "\n");
+            return 1;
+        }
+        return RunScript(script, options);
+    }
+    if (args[0] == "bench") { // Starts WinWin itself, so it's never forwarded
+        int runs = (args.size() > 1 ? std::atoi(args[1].c_str()) : STARTUP_BENCH_DEFAULT_RUNS);
+        std::ostringstream out;
+        int status = StartupBench::Run(max(runs, 1), options.json, out);
+        Print(out.str());
+        return status;
+    }
+    if (args[0] == "stats") { // Read from the statistics file, which a running service keeps up to date
+        size_t count = (args.size() > 1 ? (size_t)max(std::atoi(args[1].c_str()), 1) : APP_LATENCY_DEFAULT_REPORT);
+        std::ostringstream out;
+        AppLatency::Report(count, options.json, out);
+        Print(out.str());
+        return 0;
+    }
+    if (!IsCommand(args)) {
+        return COMMAND_NOT_FOUND;
+    }
+    if (!Local(commandLine) && CommandChannel::Send(commandLine, reply)) { // The service's caches are warm, let it do the work
+        Print(reply.output);
+        return reply.status;
+    }
+    return RunHere(commandLine, CommandEnvironment::InProcess()); // No service, run it here
+}
+
+int WinWinCommands::RunScript(std::istream& script, const CommandOptions& options) {
+    auto start = std::chrono::steady_clock::now();
+    WindowSnapshot Snapshot; // Enumerated by the first command that needs the windows, and again only after an Invalidate or refresh
+    CommandEnvironment environment = CommandEnvironment::InProcess();
+    environment.Windows = [&Snapshot] { return Snapshot.Windows(); };
+    environment.Invalidate = [&Snapshot] { Snapshot.Invalidate(); };
+
+    bool forward = options.traceFile.empty(); // Cleared the first time no service answers, so a script without one only tries once
+    int status = 0;
+    int number = 0;
+    int commands = 0;
+    std::string line;
+    while (std::getline(script, line)) {
+        number++;
+        if (number == 1 && line.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+            line.erase(0, 3); // Notepad's UTF-8 byte order mark
+        }
+        std::vector<std::string> args = SplitLine(line);
+        if (args.empty()) {
+            continue;
+        }
+        if (args[0] == "refresh") {
+            Snapshot.Invalidate();
+            continue;
+        }
+        CommandOptions lineOptions = TakeOptions(args); // The script's options apply to every line, on top of the line's own
+        if (!IsCommand(args)) {
+            if (options.json) {
+                Print(nlohmann::ordered_json{ {"command", args[0]}, {"line", number}, {"status", 1}, {"error", "Unknown command"} }.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace) + "\n");
+            }
+            else {
+                Print("line " + std::to_string(number) + ": Unknown command " + args[0] + "\n");
+            }
+            status = 1;
+            continue;
+        }
+        lineOptions.json = options.json; // Either every line is JSON or none is, the summary depends on it
+        lineOptions.plan = lineOptions.plan || options.plan;
+        if (lineOptions.windowsFile.empty()) {
+            lineOptions.windowsFile = options.windowsFile;
+        }
+        AppendOptions(args, lineOptions);
+        commands++;
+
+        int lineStatus;
+        CommandReply reply;
+        bool sent = false;
+        if (forward && !Local(args)) {
+            sent = CommandChannel::Send(args, reply);
+            forward = sent;
+        }
+        if (sent) {
+            Print(reply.output);
+            lineStatus = reply.status;
+        }
+        else {
+            lineStatus = RunHere(args, environment);
+        }
+        if (lineStatus != 0) {
+            if (!options.json) { // The JSON record already carries the status
+                Print("line " + std::to_string(number) + ": " + args[0] + " failed\n");
+            }
+            status = 1;
+        }
+    }
+    if (options.json) { // Summary, the last line of the stream
+        double total = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        Print(nlohmann::ordered_json{ {"command", "run"}, {"status", status}, {"commands", commands}, {"enumerations", Snapshot.Enumerations()},
+            {"ms", { {"total", total} } } }.dump() + "\n");
+    }
+    return status;
+}
+
+std::vector<std::string> WinWinCommands::SplitLine(const std::string& line) {
+    std::vector<std::string> args;
+    size_t pos = line.find_first_not_of(" \t\r");
+    if (pos == std::string::npos || line[pos] == '#') {
+        return args;
+    }
+    std::string arg;
+    bool quoted = false;
+    bool pending = false; // Distinguishes "" (an empty argument) from no argument
+    for (; pos < line.size(); pos++) {
+        char c = line[pos];
+        if (c == '"') {
+            quoted = !quoted;
+            pending = true;
+        }
+        else if (!quoted && (c == ' ' || c == '\t' || c == '\r')) {
+            if (pending) {
+                args.push_back(arg);
+                arg.clear();
+                pending = false;
+            }
+        }
+        else {
+            arg += c;
+            pending = true;
+        }
+    }
+    if (pending) {
+        args.push_back(arg);
+    }
+    return args;
+}
+
+int WinWinCommands::Execute(const std::vector<std::string>& commandLine, std::ostream& out, const CommandEnvironment& environment) {
+    std::vector<std::string> args = commandLine;
+    CommandOptions options = TakeOptions(args);
+    if (!IsCommand(args)) {
+        return COMMAND_NOT_FOUND;
+    }
+    ScopedProcessCache processes; // Enumeration and the arrangement after it share one lookup per process
+    if (!options.json) {
+        int status = ExecuteCommand(args, options, out, environment);
+        AppLatency::Flush(); // Latencies the command recorded, for the next process to schedule by
+        return status;
+    }
+
+    // --json: collect the command's counts and phase times, and write everything it printed into one record
+    CommandStats stats;
+    std::ostringstream text;
+    int status;
+    auto start = std::chrono::steady_clock::now();
+    {
+        StatsScope scope(stats);
+        try {
+            status = ExecuteCommand(args, options, text, environment);
+        }
+        catch (const std::exception& e) {
+            text << "WinWin: " << e.what() << "\n";
+            status = 1;
+        }
+    }
+    double total = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    AppLatency::Flush();
+    out << stats.ToJson(args, status, total, text.str()).dump(-1, ' ', false, nlohmann::json::error_handler_t::replace) << "\n"; // Titles can hold invalid UTF-8
+    return status;
+}
+
+CommandOptions WinWinCommands::TakeOptions(std::vector<std::string>& args) {
+    CommandOptions options;
+    auto option = args.begin();
+    while (option != args.end()) {
+        if (*option == "--json") {
+            options.json = true;
+            option = args.erase(option);
+        }
+        else if (*option == "--plan") {
+            options.plan = true;
+            option = args.erase(option);
+        }
+        else if (*option == "--trace") {
+            option = args.erase(option);
+            if (option != args.end()) {
+                options.traceFile = *option;
+                option = args.erase(option);
+            }
+        }
+        else if (*option == "--windows") {
+            options.plan = true;
+            option = args.erase(option);
+            if (option != args.end()) {
+                options.windowsFile = *option;
+                option = args.erase(option);
+            }
+        }
+        else {
+            option++;
+        }
+    }
+    return options;
+}
+
+void WinWinCommands::AppendOptions(std::vector<std::string>& args, const CommandOptions& options) {
+    if (options.json) {
+        args.push_back("--json");
+    }
+    if (!options.windowsFile.empty()) {
+        args.push_back("--windows");
+        args.push_back(options.windowsFile);
+    }
+    else if (options.plan) {
+        args.push_back("--plan");
+    }
+}
+
+int WinWinCommands::ExecuteCommand(const std::vector<std::string>& args, const CommandOptions& options, std::ostream& out, const CommandEnvironment& environment) {
+    const std::string& command = args[0];
+    const char* const* name = std::find(std::begin(Commands), std::end(Commands), command);
+    TraceSpan span(name != std::end(Commands) ? *name : "command", "command");
+    auto Windows = [&environment] { // Open windows for this command, counted for --json
+        std::vector<HWND> open = environment.Windows();
+        if (CommandStats* stats = CommandStats::Current()) {
+            stats->windows = (int)open.size();
+        }
+        return open;
+    };
+    std::wstring layout = (args.size() > 1 ? WinWinFunctions::ConvertToWideString(args[1]) : std::wstring()); // Layout name, if the command takes one
+
+    if (options.plan) {
+        return PlanCommand(args, options, out, environment, Windows);
+    }
+    if (command == "stack") {
+        WinWinFunctions::Stack(Windows());
+    }
+    else if (command == "cascade") {
+        WinWinFunctions::Cascade(Windows());
+    }
+    else if (command == "squish") {
+        WinWinFunctions::Squish(Windows());
+    }
+    else if (command == "SaveLayout") {
+        if (args.size() > 1) {
+            WinWinFunctions::SaveWindowLayout(Windows(), layout);
+        }
+        else {
+            WinWinFunctions::SaveWindowLayout(Windows());
+            environment.Invalidate(); // The user could have done anything while the dialog was up
+        }
+    }
+    else if (command == "ExecuteLayout") {
+        ExecuteLayout(layout, environment, Windows);
+    }
+    else if (command == "SaveDesktop") {
+        bool saved;
+        if (args.size() > 1) {
+            saved = WinWinFunctions::SaveDesktopLayout(layout);
+        }
+        else {
+            saved = WinWinFunctions::SaveDesktopLayout();
+            environment.Invalidate();
+        }
+        if (!saved) {
+            out << "Couldn't save the desktop: the desktop couldn't be opened, or the saved layout couldn't be read and was left as it is\n";
+            return 1;
+        }
+    }
+    else if (command == "DiffDesktop") { // Print how the desktop has drifted from a saved layout without writing anything
+        if (!std::filesystem::exists(WinWinFunctions::DesktopLayoutPath(layout))) {
+            out << "No desktop layout named " << (args.size() > 1 ? args[1] : std::string()) << "\n";
+            return 1;
+        }
+        std::optional<IconDiff> Drift = WinWinFunctions::DiffDesktopLayout(layout);
+        if (!Drift) {
+            out << "Couldn't compare the desktop: the desktop couldn't be opened or the layout couldn't be read\n";
+            return 1;
+        }
+        const IconDiff& diff = *Drift;
+        for (const IconRecord& icon : diff.added) {
+            out << "+ " << icon.name << " (" << icon.x << ", " << icon.y << ")\n";
+        }
+        for (const IconRecord& icon : diff.removed) {
+            out << "- " << icon.name << " (" << icon.x << ", " << icon.y << ")\n";
+        }
+        for (const IconDiff::Move& move : diff.moved) {
+            out << "~ " << move.icon.name << " (" << move.fromX << ", " << move.fromY << ") -> (" << move.icon.x << ", " << move.icon.y << ")\n";
+        }
+        out << diff.added.size() << " added, " << diff.removed.size() << " removed, " << diff.moved.size() << " moved\n";
+    }
+    else if (command == "SaveProfile") {
+        WorkspaceProfiles::SaveProfile(Windows());
+    }
+    else if (command == "ApplyProfile") {
+        WorkspaceProfiles::ApplyCurrentProfile();
+    }
+    else if (command == "RestoreSnapshot") { // Rebuild an automatic snapshot into RestoredSnapshots/AutoSnapshot.json and execute it
+        long long seq = -1;
+        if (args.size() > 1) {
+            char* end = NULL;
+            errno = 0;
+            seq = std::strtoll(args[1].c_str(), &end, 10);
+            if (args[1].empty() || *end != '\0' || errno == ERANGE || seq < 0) {
+                out << "Usage: RestoreSnapshot [snapshot number]\n";
+                return 1;
+            }
+        }
+        if (!LayoutSnapshotter::ExportSnapshot(L"AutoSnapshot", seq)) {
+            out << "No snapshot to restore\n";
+            return 1;
+        }
+        ExecuteLayoutFile(LayoutSnapshotter::ExportPath(L"AutoSnapshot"), environment, Windows);
+    }
+    else if (command == "ExecuteDesktop") {
+        std::optional<IconSortRule> pack; // New icons are only packed when a sort rule is given
+        bool snap = false;
+        for (size_t i = 2; i < args.size(); i++) {
+            if (args[i] == "snap") {
+                snap = true;
+            }
+            else if (std::optional<IconSortRule> rule = IconPlacer::ParseSortRule(args[i])) {
+                pack = rule;
+            }
+            else {
+                out << "Unknown option " << args[i] << "\n";
+                out << "Usage: ExecuteDesktop [layout] [name|type|date] [snap]\n";
+                return 1;
+            }
+        }
+        int moved = WinWinFunctions::ExecuteDesktopLayout(layout, pack, snap);
+        out << moved << " icons moved\n";
+    }
+    else if (command == "RecordWindows") { // Write the scene a --plan would see, for planning later with --windows
+        WindowScene scene = WinWinFunctions::CaptureScene(Windows());
+        std::string text = scene.ToJson().dump(4, ' ', false, nlohmann::json::error_handler_t::replace);
+        if (args.size() < 2) {
+            out << text << "\n";
+            return 0;
+        }
+        PhaseTimer timer(CommandPhase::Io);
+        std::ofstream file(std::filesystem::path(layout));
+        if (!(file << text << "\n")) {
+            out << "Can't write " << args[1] << "\n";
+            return 1;
+        }
+        out << scene.windows.size() << " windows recorded to " << args[1] << "\n";
+    }
+    return 0;
+}
+
+int WinWinCommands::PlanCommand(const std::vector<std::string>& args, const CommandOptions& options, std::ostream& out, const CommandEnvironment& environment,
+    const std::function<std::vector<HWND>()>& Windows) {
+    WindowScene scene;
+    if (options.windowsFile.empty()) {
+        scene = WinWinFunctions::CaptureScene(Windows());
+    }
+    else {
+        PhaseTimer timer(CommandPhase::Io);
+        std::ifstream file(std::filesystem::path(WinWinFunctions::ConvertToWideString(options.windowsFile)));
+        nlohmann::json Doc = nlohmann::json::parse(file, nullptr, false);
+        if (!file.is_open() || Doc.is_discarded() || !WindowScene::FromJson(Doc, scene)) {
+            out << "Can't read a window scene from " << options.windowsFile << "\n";
+            return 1;
+        }
+    }
+
+    LayoutPlan plan;
+    auto LoadLayout = [&environment](const std::string& name) {
+        return environment.LoadLayout(WinWinFunctions::WindowLayoutPath(WinWinFunctions::ConvertToWideString(name)));
+    };
+    if (!LayoutPlanner::Plan(args, scene, LoadLayout, plan)) {
+        out << args[0] << " can't be planned, only stack, cascade, squish and ExecuteLayout can\n";
+        return 1;
+    }
+    out << plan.ToJson().dump(-1, ' ', false, nlohmann::json::error_handler_t::replace) << "\n";
+    return 0;
+}
+
+bool WinWinCommands::IsCommand(const std::vector<std::string>& args) {
+    if (args.empty()) {
+        return false;
+    }
+    for (const char* command : Commands) {
+        if (args[0] == command) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool WinWinCommands::Interactive(const std::vector<std::string>& args) {
+    return args.size() == 1 && (args[0] == "SaveLayout" || args[0] == "SaveDesktop");
+}
+
+bool WinWinCommands::Local(const std::vector<std::string>& commandLine) {
+    std::vector<std::string> args = commandLine;
+    CommandOptions options = TakeOptions(args);
+    return Interactive(args) || !options.windowsFile.empty() || !options.traceFile.empty() || (args.size() > 1 && args[0] == "RecordWindows");
+}
@@ -0,0 +1,174 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// WinWinCommands.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.25 Added stats
+// 10/19/2026 MS-24.01.08.24 Added --trace
+// 10/19/2026 MS-24.01.08.22 Added --plan, --windows and RecordWindows, and Local for commands that can't be forwarded
+// 10/19/2026 MS-24.01.08.21 Added CommandOptions and --json
+// 10/19/2026 MS-24.01.08.20 Added batch scripts (RunScript) and CommandEnvironment::Invalidate
+// 10/19/2026 MS-24.01.08.19 created
+//-----------------------------------------------
+// Header file for the command line commands
+//
+// Contains class WinWinCommands, which matches a command line (stack, ExecuteLayout, SaveDesktop...) to its WinWinFunctions call,
+// and struct CommandEnvironment, which supplies the open windows and saved layouts a command works on.
+// The same commands run in two places: in the WinWin process itself, where every command enumerates the windows and reads the layout
+// file fresh, and in the resident service (see WinWinService.h), whose environment answers from its warm caches. Run picks between
+// them - it forwards the command to the service if one is listening and falls back to running it in process otherwise.
+// Commands write what they print to a stream instead of stdout so the service can send it back to the client.
+// `WinWin run script.txt` (or `WinWin run` with the script on standard input) runs one command per line in a single process, sharing one
+// WindowSnapshot between them, so a script of five commands costs one enumeration instead of five process starts and five enumerations.
+// With --json anywhere on the command line, each command prints one line of JSON instead of its usual output (see CommandStats::ToJson):
+//   {"command":"ExecuteLayout","args":["Work"],"status":0,"windows":14,"matched":9,"moved":9,"skipped":2,"timedOut":1,
+//    "ms":{"enumerate":3.1,"probe":41.7,"match":0.4,"apply":18.2,"io":0.9,"total":64.5},"output":""}
+// Lines are flushed as each command finishes, so a script's stream can be read while it runs. A script ends with a summary line,
+// {"command":"run","status":0,"commands":5,"enumerations":1,"ms":{"total":...}}.
+// With --plan, stack, cascade, squish and ExecuteLayout enumerate and match as usual but only print the placement plan, one line of
+// JSON (see LayoutPlanner.h), and nothing moves. --windows <file> plans against a scene recorded by `WinWin RecordWindows <file>`
+// instead of the live desktop, and implies --plan.
+// --trace <file> records a span for the command and for each step inside it - every window probe, OpenProcess, layout file read and
+// placement batch - and writes them to the file as Chrome trace event JSON when the command finishes (see Trace.h). A traced command
+// always runs in process, the spans would otherwise be recorded in the service. On `run` the trace covers the whole script.
+// `WinWin stats [N]` prints the N applications that have been slowest to answer a probe, restore or move (see AppLatency.h). Every
+// command that runs here or in the service writes the latencies it recorded to the statistics file before it returns.
+
+#pragma once
+
+#include <Windows.h>
+#include <string>
+#include <vector>
+#include <ostream>
+#include <functional>
+#include <istream>
+#include <nlohmann/json.hpp>
+
+// Returned by Execute for a command line that isn't a command, WinMain starts the UI instead
+#define COMMAND_NOT_FOUND (-1)
+
+/**
+ * @brief Options that can appear anywhere on a command line
+ */
+struct CommandOptions {
+	bool json = false;          // --json, report each command as a line of JSON
+	bool plan = false;          // --plan, print where the windows would go instead of moving them
+	std::string windowsFile;    // --windows <file>, scene file to plan against instead of the open windows
+	std::string traceFile;      // --trace <file>, write a Chrome trace of the command to the file
+};
+
+/**
+ * @brief Where a command gets the open windows and saved layouts from
+ */
+struct CommandEnvironment {
+	std::function<std::vector<HWND>()> Windows;                          // Open windows, as GetActiveWindows returns them
+	std::function<nlohmann::json(const std::wstring& path)> LoadLayout;  // Saved window layout at the current schema version, see LayoutSchema::Load
+	std::function<void()> Invalidate;                                    // Called by a command that may have changed which windows are open
+
+	/**
+	 * @brief Environment that enumerates the windows and reads the layout file on every call
+	 */
+	static CommandEnvironment InProcess();
+};
+
+class WinWinCommands {
+public:
+
+	/**
+	 * @brief Run a command line through the service if one is listening, otherwise in process
+	 *
+	 * Prints the command's output to stdout. Commands that open a dialog or name a file always run in process, see Local.
+	 * With --trace, tracing is on while the command runs and the trace is written once it's done.
+	 *
+	 * @param args Command and parameters, as typed after WinWin
+	 * @return Exit status, COMMAND_NOT_FOUND if args isn't a command
+	 */
+	static int Run(const std::vector<std::string>& args);
+
+	/**
+	 * @brief Run a batch script, one command per line
+	 *
+	 * Each line is split like a command line (double quotes group words), blank lines and lines starting with # are skipped, and
+	 * `refresh` makes the next command enumerate the windows again. Every command is forwarded to the service while one is listening,
+	 * otherwise they all run here against one WindowSnapshot. A line that fails is reported with its line number and the script
+	 * carries on.
+	 *
+	 * @param script Script text
+	 * @param options Options given to run, applied to every line
+	 * @return 0 if every line succeeded, otherwise 1
+	 */
+	static int RunScript(std::istream& script, const CommandOptions& options);
+
+	/**
+	 * @brief Split a script line into arguments
+	 * @param line Line of a script
+	 * @return Arguments, empty for a blank line or a comment
+	 */
+	static std::vector<std::string> SplitLine(const std::string& line);
+
+	/**
+	 * @brief Run a command line in this process
+	 * @param args Command, parameters and options
+	 * @param out Receives everything the command prints, or its JSON record with --json
+	 * @param environment Supplies the windows and layouts
+	 * @return Exit status, COMMAND_NOT_FOUND if args isn't a command
+	 */
+	static int Execute(const std::vector<std::string>& args, std::ostream& out, const CommandEnvironment& environment);
+
+	/**
+	 * @brief Remove the options from a command line
+	 * @param args Command line, left with only the command and its parameters
+	 * @return The options that were removed
+	 */
+	static CommandOptions TakeOptions(std::vector<std::string>& args);
+
+	/**
+	 * @brief Put options back on a command line, the reverse of TakeOptions
+	 *
+	 * --trace isn't put back, whoever took it writes the trace.
+	 */
+	static void AppendOptions(std::vector<std::string>& args, const CommandOptions& options);
+
+	/**
+	 * @brief Check whether a command line is a command
+	 */
+	static bool IsCommand(const std::vector<std::string>& args);
+
+	/**
+	 * @brief Check whether a command asks the user for input
+	 *
+	 * SaveLayout and SaveDesktop without a name open a dialog for one. The dialog has to come from the process the user is
+	 * looking at, so these are never forwarded to the service.
+	 */
+	static bool Interactive(const std::vector<std::string>& args);
+
+	/**
+	 * @brief Check whether a command line has to run in the caller's process rather than the service
+	 *
+	 * True for Interactive commands, for command lines naming a file the service would resolve against the wrong working
+	 * directory (RecordWindows <file> and --windows <file>), and for traced command lines.
+	 *
+	 * @param commandLine Command, parameters and options
+	 */
+	static bool Local(const std::vector<std::string>& commandLine);
+
+private:
+
+	/**
+	 * @brief Run, without the tracing
+	 */
+	static int RunCommandLine(const std::vector<std::string>& commandLine);
+
+	/**
+	 * @brief Match a command line without options to its function and run it
+	 */
+	static int ExecuteCommand(const std::vector<std::string>& args, const CommandOptions& options, std::ostream& out, const CommandEnvironment& environment);
+
+	/**
+	 * @brief Print the placement plan for a command line instead of running it
+	 * @return 0 once the plan is printed, 1 if the command can't be planned or the scene file can't be read
+	 */
+	static int PlanCommand(const std::vector<std::string>& args, const CommandOptions& options, std::ostream& out, const CommandEnvironment& environment,
+		const std::function<std::vector<HWND>()>& Windows);
+};
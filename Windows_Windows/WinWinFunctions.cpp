@@ -1,611 +1,780 @@
-//***********************************************
-// WindowsWindows
-// Copyright 2024 Michael Steuber
-//===============================================
-// WinWinFunctions.cpp
-// ----------------------------------------------
-// 09/03/2024 MS-24.01.07.02 Moved all WinWin base functionality here for use with the command line and UI
-// 09/03/2024 MS-24.01.07.01 created
-//-----------------------------------------------
-// Source code for WinWin base functions
-// 
-// Defines functions for static class WinWinFunctions which performs all window operations independent of the UI.
-// These functions can be called from anywhere and provides a method GetActiveWindows that returns 
-// a vector of HWNDS for every active window. This can be passed to any of the WinWin functions allowing
-// any window operations to occur from this class.
-
-
-#include "WinWinFunctions.h"
-
-static std::wstring userInput;
-
-INT_PTR CALLBACK DialogProcWinFun(HWND hDlg, UINT message, WPARAM wParam, LPARAM lParam) {
-    switch (message) {
-    case WM_INITDIALOG:
-        return TRUE;
-
-    case WM_COMMAND:
-        switch (LOWORD(wParam)) {
-        case IDOK: {
-            WCHAR text[256];
-            GetDlgItemText(hDlg, IDC_EDIT_TEXT, text, 256);
-            userInput = text; // Store the input text in the global variable
-            EndDialog(hDlg, IDOK);
-            return TRUE;
-        }
-        case IDCANCEL:
-            EndDialog(hDlg, IDCANCEL);
-            return TRUE;
-        }
-        break;
-    }
-    return FALSE;
-}
-
-BOOL CALLBACK WinWinFunctions::EnumWindowsProc(HWND hwnd, LPARAM lParam) {
-    std::vector<HWND>* WindowHwndVector = reinterpret_cast<std::vector<HWND>*>(lParam);
-    WCHAR windowTitle[256];
-    if (GetParent(hwnd) == NULL && IsWindowVisible(hwnd)) {
-        LRESULT result = SendMessageTimeoutW(hwnd, WM_NULL, 0, 0, SMTO_ABORTIFHUNG, 1000, NULL);
-        if (result == 0 || !IsWindowEnabled(hwnd)) { // Check if the window is able to receive/respond to messages
-            return TRUE;
-        }
-        if (GetWindowText(hwnd, windowTitle, sizeof(windowTitle) / sizeof(windowTitle[0])) == 0) {
-            return TRUE;
-        }
-        if ((std::wstring(windowTitle) == L"Program Manager" || std::wstring(windowTitle) == L"Windows Input Experience" || std::wstring(windowTitle) == L"Windows Shell Experience Host")) {
-            return TRUE;
-        }
-        if (std::wstring(windowTitle) == L"Windows Window Extension Window" || std::wstring(windowTitle) == L"Windows_Windows (Running) - Microsoft Visual Studio") {
-            return TRUE;
-        }
-        // ^ Exclude Program Manager, Windows Input Experience, Windows Shell Experience Host, the Windows Windows UI, and the Visual Studio window running Windows Windows from the vector
-        WindowHwndVector->push_back(hwnd);
-    }
-    return TRUE;
-}
-
-bool compareHwnd(HWND a, HWND b) { // Sort windows by title alphabetically
-    char titleA[256], titleB[256];
-    GetWindowTextA(a, titleA, sizeof(titleA));
-    GetWindowTextA(b, titleB, sizeof(titleB));
-    return std::string(titleA) < std::string(titleB); // Reutrn True if a is first alphabetically, False if b is first 
-}
-
-std::vector<HWND> WinWinFunctions::GetActiveWindows()
-{
-    std::vector<HWND> WindowHwndVector;
-    EnumWindows(EnumWindowsProc, reinterpret_cast<LPARAM>(&WindowHwndVector)); // Enumerate through the windows with this callback function. 
-    if (!WindowHwndVector.empty()) {
-        std::sort(WindowHwndVector.begin(), WindowHwndVector.end(), compareHwnd);
-    }
-    return WindowHwndVector;
-}
-
-void WinWinFunctions::Stack(std::vector<HWND> WindowVect)
-{
-    int winFunStackIndex;
-
-    if (WindowVect.size() <= 4) {
-        StackFourOrLess(WindowVect);
-    }
-    else if (WindowVect.size() <= 8) {
-        StackFiveToEight(WindowVect);
-    }
-    else if (WindowVect.size() > 8) {
-
-        winFunStackIndex = 0;
-        StackWindowsCallback(WindowVect);
-    }
-}
-
-void WinWinFunctions::StackFourOrLess(std::vector<HWND> WindowVector) {
-    int stackFactorY;
-    int stackPosy = 0;
-    stackFactorY = GetSystemMetrics(SM_CYSCREEN) / WindowVector.size();
-    for (HWND ctrl : WindowVector) {
-        ShowWindow(ctrl, SW_RESTORE);
-        SendMessage(ctrl, WM_SYSCOMMAND, SC_RESTORE, 0);
-        SetWindowPos(ctrl, HWND_TOPMOST, 0, stackPosy, GetSystemMetrics(SM_CXSCREEN), stackFactorY, NULL);
-        SetWindowPos(ctrl, HWND_NOTOPMOST, 0, stackPosy, GetSystemMetrics(SM_CXSCREEN), stackFactorY, NULL);
-        stackPosy += stackFactorY;
-    }
-}
-
-void WinWinFunctions::StackFiveToEight(std::vector<HWND> WindowVector) {
-    int stackFactorYLeft;
-    int stackFactorYRight;
-    int stackPosy = 0;
-    int i = 0;
-    stackFactorYLeft = GetSystemMetrics(SM_CYSCREEN) / ceil(float(WindowVector.size()) / float(2));
-    stackFactorYRight = GetSystemMetrics(SM_CYSCREEN) / floor(float(WindowVector.size()) / float(2));
-    for (HWND ctrl : WindowVector) {
-        ShowWindow(ctrl, SW_RESTORE);
-        SendMessage(ctrl, WM_SYSCOMMAND, SC_RESTORE, 0);
-        if (i >= ceil(float(WindowVector.size()) / float(2))) {
-
-            SetWindowPos(ctrl, HWND_TOPMOST, GetSystemMetrics(SM_CXSCREEN) / 2, stackPosy, GetSystemMetrics(SM_CXSCREEN) / 2, stackFactorYRight, NULL);
-            SetWindowPos(ctrl, HWND_NOTOPMOST, GetSystemMetrics(SM_CXSCREEN) / 2, stackPosy, GetSystemMetrics(SM_CXSCREEN) / 2, stackFactorYRight, NULL);
-
-            stackPosy += stackFactorYRight;
-        }
-
-        else {
-            SetWindowPos(ctrl, HWND_TOPMOST, 0, stackPosy, GetSystemMetrics(SM_CXSCREEN) / 2, stackFactorYLeft, NULL);
-            SetWindowPos(ctrl, HWND_NOTOPMOST, 0, stackPosy, GetSystemMetrics(SM_CXSCREEN) / 2, stackFactorYLeft, NULL);
-
-            stackPosy += stackFactorYLeft;
-        }
-        i++;
-        if (i == ceil(float(WindowVector.size()) / float(2))) {
-            stackPosy = 0;
-        }
-    }
-}
-
-void WinWinFunctions::StackWindowsCallback(std::vector<HWND> WindowVect)
-{
-    int winFunStackIndex = 0;
-
-    int lastVector = WindowVect.size() % 8;
-    int subVectorCount = (floor(float(WindowVect.size()) / float(8))) + (lastVector == 0 ? 0 : 1);
-
-    std::vector<HWND> SubVector;
-    for (int i = 0; i < 8; i++) {
-        if (WindowVect.size() <= (winFunStackIndex * 8) + i) {
-            break;
-        }
-        SubVector.push_back(WindowVect[(winFunStackIndex * 8) + i]);
-    }
-    if (SubVector.size() <= 4) {
-        StackFourOrLess(SubVector);
-    }
-    else if (SubVector.size() <= 8) {
-        StackFiveToEight(SubVector);
-    }
-    SubVector.clear();
-}
-
-void WinWinFunctions::Cascade(std::vector<HWND> WindowVect) {
-    int stackPosX = 10;
-    int stackPosY = 10;
-    int stackFactorY = 50;
-    if (WindowVect.size() * stackFactorY + 760 > GetSystemMetrics(SM_CYSCREEN)) {
-        stackFactorY = (GetSystemMetrics(SM_CYSCREEN) - 760) / WindowVect.size();
-        if (stackFactorY < 10) { stackFactorY = 10; }
-    }
-    for (HWND ctrl : WindowVect) { //Iterate through all windows in WindowsVector (all open windows)
-        SendMessage(ctrl, WM_SYSCOMMAND, SC_RESTORE, 0);
-        ShowWindow(ctrl, SW_SHOWNORMAL);  // Set each window to normal mode (unmax/unmin)
-        SetWindowPos(ctrl, HWND_TOPMOST, stackPosX, stackPosY, 750, 750, NULL); // Bring current window to front
-        SetWindowPos(ctrl, HWND_NOTOPMOST, stackPosX, stackPosY, 750, 750, NULL); // Remove "TOPMOST" flag
-        stackPosX += 65;
-        stackPosY += stackFactorY;
-    }
-}
-
-void WinWinFunctions::Squish(std::vector<HWND> WindowVect) {
-    int stackPosX = 10;
-    int stackPosY = 10;
-    int stackFactorY = 50;
-    if (WindowVect.size() * stackFactorY + 760 > GetSystemMetrics(SM_CYSCREEN)) {
-        stackFactorY = (GetSystemMetrics(SM_CYSCREEN) - 760) / WindowVect.size();
-        if (stackFactorY < 10) { stackFactorY = 10; }
-    }
-    RECT windowRect;
-    for (HWND ctrl : WindowVect) { //Iterate through all windows in WindowsVector (all open windows)
-        GetWindowRect(ctrl, &windowRect);
-        if (windowRect.top == stackPosY && windowRect.left == stackPosX) { //&& windowRect.right - windowRect.left == 750 && windowRect.bottom - windowRect.top == 750
-            ShowWindow(ctrl, SW_MINIMIZE);
-        }
-        stackPosX += 65;
-        stackPosY += stackFactorY;
-    }
-}
-
-std::wstring WinWinFunctions::GetUserInput(HINSTANCE hInstance) {
-    userInput.clear(); // Clear previous input
-    if (DialogBox(hInstance, MAKEINTRESOURCE(IDD_SIMPLE_INPUT_DIALOG), NULL, DialogProcWinFun) == IDOK) {
-        return userInput;
-    }
-    return L"";
-}
-
-void WinWinFunctions::SaveWindowLayout(std::vector<HWND> WindowVect, std::wstring presetLayoutName)
-{
-    std::wstring layoutName;
-    if (presetLayoutName != L"Default") {
-        layoutName = presetLayoutName;
-    }
-    else {
-        layoutName = GetUserInput(GetModuleHandle(NULL));
-    }
-    if (layoutName == L"") { layoutName = L"NewLayout"; }
-    if (!layoutName.empty() && layoutName.back() == L'\0') layoutName.pop_back();
-
-
-    // Retrieve the path of the executable to ensure that the correct SavedLayouts directory is referenced
-    // Without this, it will attempt to find SavedLayouts in whatever dir the command was called in
-    // This is for command line support
-
-    wchar_t exeWcharPath[MAX_PATH];
-    GetModuleFileName(NULL, exeWcharPath, MAX_PATH);
-
-    std::wstring exePath(exeWcharPath);
-    std::wstring::size_type pos = exePath.find_last_of(L"\\/");
-    std::wstring exeDir = exePath.substr(0, pos);
-
-    SetCurrentDirectory(exeDir.c_str()); // Set the working directory to the executable's directory
-
-    std::wstring WinWinLayoutsFile = exeDir + L"/SavedLayouts/" + layoutName + L".json";   // Name of json file (in SavedLayouts folder)
-    
-    if (!std::filesystem::exists(WinWinLayoutsFile)) { // Check if it exists, create it if not
-        std::ofstream{ WinWinLayoutsFile };
-    }
-
-    if (std::filesystem::exists(WinWinLayoutsFile)) { // Check if it exists, delete contents if it does
-        std::ofstream file(WinWinLayoutsFile, std::ios::trunc);
-        file.close();
-    }
-
-    std::fstream LayFile;
-    LayFile.open(WinWinLayoutsFile);
-
-
-    WINDOWPLACEMENT pInstancePlacement;
-    pInstancePlacement.length = sizeof(WINDOWPLACEMENT);  // Instantiate WINDOWPLACEMENT object
-
-    nlohmann::json placeInfo; // Final json that is written to file
-    nlohmann::basic_json placeInfoTemp; // Temp json, cleared after each run of the loop
-
-    DWORD processId;
-    WCHAR path[MAX_PATH] = L"";
-    HANDLE hProcess;
-    RECT rect;
-    std::wstring processPath;
-    WCHAR instanceTitle[256];
-    for (HWND ctrl : WindowVect) {
-        GetWindowRect(ctrl, &rect);
-        GetWindowPlacement(ctrl, &pInstancePlacement); // Get the hwnd of the current handle and extract placement details. 
-                                                       // Put into WINDOWPLACEMENT object 
-        if (!IsIconic(ctrl)) { // If the window isn't minimized, set the window size to the dimensions from GetWindowRect. Without this, windows set with the 
-                               // Windows auto window placement magic won't be set correctly
-            pInstancePlacement.rcNormalPosition.left = rect.left;
-            pInstancePlacement.rcNormalPosition.right = rect.right;
-            pInstancePlacement.rcNormalPosition.top = rect.top;
-            pInstancePlacement.rcNormalPosition.bottom = rect.bottom;
-
-        }
-        GetWindowThreadProcessId(ctrl, &processId);
-        hProcess = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE, processId); // Get executable associated with window handle
-        GetModuleFileNameEx(hProcess, NULL, path, MAX_PATH);
-        CloseHandle(hProcess);
-
-        processPath = std::wstring(path);
-        GetWindowTextW(ctrl, instanceTitle, sizeof(instanceTitle));
-
-        placeInfoTemp = { {"process", ConvertToNarrowString(processPath)},// Translate WINDOWPLACEMENT to json, stick the process in the front
-            {"minimized", IsIconic(ctrl) },
-            {"handle", int(ctrl)},
-            {"title", ConvertToNarrowString(std::wstring(instanceTitle))},
-            {"length", pInstancePlacement.length},
-            {"flags", pInstancePlacement.flags},
-        {"showCmd", pInstancePlacement.showCmd },
-        {"ptMinPosition",
-            { {"x", pInstancePlacement.ptMinPosition.x },
-             { "y",  pInstancePlacement.ptMinPosition.y } } },
-        {"ptMaxPosition",
-             { { "x", pInstancePlacement.ptMaxPosition.x},
-               { "y", pInstancePlacement.ptMaxPosition.y} } },
-         {"rcNormalPosition",
-             { { "left", pInstancePlacement.rcNormalPosition.left },
-               { "right", pInstancePlacement.rcNormalPosition.right },
-               { "top", pInstancePlacement.rcNormalPosition.top },
-               { "bottom", pInstancePlacement.rcNormalPosition.bottom } } }
-        };
-
-        placeInfo.push_back(placeInfoTemp); //append to main json
-        placeInfoTemp.clear();// clear temp
-    }
-
-    LayFile << placeInfo; // add to json file
-
-    LayFile.close();
-}
-
-void WinWinFunctions::ExecuteWindowLayout(std::wstring json, std::vector<HWND> WindowVect) {
-
-    if (!json.empty() && json.back() == L'\0') json.pop_back(); // Remove null terminator from end of file name
-
-    // Retrieve the path of the executable to ensure that the correct SavedLayouts directory is referenced
-    // Without this, it will attempt to find SavedLayouts in whatever dir the command was called in
-    // This is for command line support
-
-    wchar_t exeWcharPath[MAX_PATH];
-    GetModuleFileName(NULL, exeWcharPath, MAX_PATH);
-
-    std::wstring exePath(exeWcharPath);
-    std::wstring::size_type pos = exePath.find_last_of(L"\\/");
-    std::wstring exeDir = exePath.substr(0, pos);
-
-    SetCurrentDirectory(exeDir.c_str()); // Set the working directory to the executable's directory
-
-    std::wstring jsonFile = exeDir + L"/SavedLayouts/" + json;
-    jsonFile.append(L".json");
-    if (!std::filesystem::exists(jsonFile)) { // Check if it exists
-        return;
-    }
-
-    // So here I want to get every layout from the json file, check which processess are open, put the matching ones in the right place, and minimize the others
-    // So from the json I need a vector of structs 
-    // And I have my vector of open windows
-    // Iterate over open windows and then iterate over vector of structs
-    std::vector<SavedWindow*> SavedWindows;
-
-    DWORD processId;
-    WCHAR path[MAX_PATH] = L"";
-    HANDLE hProcess;
-    WCHAR windowTitle[256];
-    bool foundWindow = FALSE;
-
-    std::fstream LayFile;
-    LayFile.open(jsonFile, std::ios::in);
-    nlohmann::json Doc{ nlohmann::json::parse(LayFile) };
-    int i = 0;
-    for (auto& window : Doc.items()) {
-        std::string process = Doc[i].at("process");
-        std::string title = Doc[i].at("title");
-        int handle = Doc[i].at("handle");
-        UINT flags = Doc[i].at("flags");
-        UINT length = Doc[i].at("length");
-        UINT showCmd = Doc[i].at("showCmd");
-        POINT minPos;
-        UINT minPosX = Doc[i].at("ptMinPosition").at("x");
-        UINT minPosY = Doc[i].at("ptMinPosition").at("y");
-        minPos.x = minPosX;
-        minPos.y = minPosY;
-        POINT maxPos;
-        UINT maxPosX = Doc[i].at("ptMaxPosition").at("x");
-        UINT maxPosY = Doc[i].at("ptMaxPosition").at("y");
-        maxPos.x = maxPosX;
-        maxPos.y = maxPosY;
-        RECT rcNormalPos;
-        rcNormalPos.left = Doc[i].at("rcNormalPosition").at("left");
-        rcNormalPos.right = Doc[i].at("rcNormalPosition").at("right");
-        rcNormalPos.top = Doc[i].at("rcNormalPosition").at("top");
-        rcNormalPos.bottom = Doc[i].at("rcNormalPosition").at("bottom");
-
-        SavedWindows.push_back(new SavedWindow(
-            process,
-            title,
-            HWND(handle),
-            flags,
-            showCmd,
-            minPos,
-            maxPos,
-            rcNormalPos));
-        i++;
-    }
-
-    for (SavedWindow* window : SavedWindows) {
-        for (HWND ctrl : WindowVect) {
-            if (ctrl == window->m_handle) {
-                WINDOWPLACEMENT placement;
-                placement.length = sizeof(WINDOWPLACEMENT);
-                placement.showCmd = window->m_showCmd;
-                placement.flags = window->m_flags;
-                placement.ptMaxPosition = window->m_ptMinPosition;
-                placement.ptMaxPosition = window->m_ptMaxPosition;
-                placement.rcNormalPosition = window->m_rcNormalPosition;
-
-                SetWindowPlacement(ctrl, &placement);
-                window->moved = TRUE;
-                foundWindow = TRUE;
-            }
-        }
-        if (!foundWindow) {
-            for (HWND ctrl : WindowVect) {
-                GetWindowThreadProcessId(ctrl, &processId);
-                hProcess = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE, processId); // Get executable associated with window handle
-                GetModuleFileNameEx(hProcess, NULL, path, MAX_PATH);
-                CloseHandle(hProcess);
-                GetWindowText(ctrl, windowTitle, sizeof(windowTitle));
-
-                std::string convertedWindowTitle = ConvertToNarrowString(windowTitle);
-                if (convertedWindowTitle == window->m_title && !window->moved) {
-                    WINDOWPLACEMENT placement;
-                    placement.length = sizeof(WINDOWPLACEMENT);
-                    placement.showCmd = window->m_showCmd;
-                    placement.flags = window->m_flags;
-                    placement.ptMaxPosition = window->m_ptMinPosition;
-                    placement.ptMaxPosition = window->m_ptMaxPosition;
-                    placement.rcNormalPosition = window->m_rcNormalPosition;
-
-                    SetWindowPlacement(ctrl, &placement);
-                    window->moved = TRUE;
-                    foundWindow = TRUE;
-                }
-            }
-        }
-        if (!foundWindow) {
-            for (HWND ctrl : WindowVect) {
-                int wideStrSize = MultiByteToWideChar(CP_UTF8, 0, window->m_process.c_str(), -1, nullptr, 0);
-                std::wstring convertedWideStr(wideStrSize, L'/0');
-                MultiByteToWideChar(CP_UTF8, 0, window->m_process.c_str(), -1, &convertedWideStr[0], wideStrSize);
-                convertedWideStr.erase(std::remove(convertedWideStr.begin(), convertedWideStr.end(), L'\0'), convertedWideStr.end());
-                std::wstring pathWstring(path);
-                if (pathWstring == convertedWideStr) {
-
-                    WINDOWPLACEMENT placement;
-                    placement.length = sizeof(WINDOWPLACEMENT);
-                    placement.showCmd = window->m_showCmd;
-                    placement.flags = window->m_flags;
-                    placement.ptMaxPosition = window->m_ptMinPosition;
-                    placement.ptMaxPosition = window->m_ptMaxPosition;
-                    placement.rcNormalPosition = window->m_rcNormalPosition;
-
-                    SetWindowPlacement(ctrl, &placement);
-                    window->moved = TRUE;
-                    foundWindow = TRUE;
-                }
-            }
-        }
-    foundWindow = FALSE;
-    }
-    for (SavedWindow* windStruct : SavedWindows) {
-        windStruct->moved = FALSE;
-    }
-}
-
-
-
- 
-void WinWinFunctions::SaveDesktopLayout()
-{
-    std::wstring layoutName = GetUserInput(GetModuleHandle(NULL));
-
-    std::wstring WinWinLayoutsFile = L"SavedDesktopLayouts/" + layoutName + L".json";   // Name of json file (in SavedLayouts folder)
-
-    if (!std::filesystem::exists(WinWinLayoutsFile)) { // Check if it exists, create it if not
-        std::ofstream{ WinWinLayoutsFile };
-    }
-
-    HWND hProgMan = FindWindow(L"Progman", NULL);
-    HWND hShellView = FindWindowExW(hProgMan, NULL, L"SHELLDLL_DefView", NULL);
-    FindWindowEx(hShellView, NULL, L"SysListView32", NULL);
-
-    HWND hDesktopListView = FindWindowEx(hShellView, NULL, L"SysListView32", NULL); // Drill down into SysListView32
-    int itemCount = ListView_GetItemCount(hDesktopListView);
-    DWORD pid = 0;
-    GetWindowThreadProcessId(hDesktopListView, &pid);
-    HANDLE hProcess = OpenProcess(PROCESS_VM_OPERATION | PROCESS_VM_READ | PROCESS_VM_WRITE, FALSE, pid);
-
-    // Allocate memory in SysListView32
-    LPPOINT pt = (LPPOINT)VirtualAllocEx(hProcess, NULL, sizeof(POINT), MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
-    LVITEMW* lvItem = (LVITEM*)VirtualAllocEx(hProcess, NULL, sizeof(LVITEM), MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
-    LPWSTR itemText = (LPWSTR)VirtualAllocEx(hProcess, NULL, 256 * sizeof(WCHAR), MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
-    WCHAR itemName[256] = L"";
-
-    POINT iconPos;
-    SIZE_T numRead;
-
-    std::fstream LayFile;
-    LayFile.open(WinWinLayoutsFile);
-
-    nlohmann::json placeInfo; // Final json that is written to file
-    nlohmann::basic_json placeInfoTemp; // Temp json, cleared after each run of the loop
-
-    for (int i = 0; i < itemCount; ++i) {
-        if (!ListView_GetItemPosition(hDesktopListView, i, pt)) {
-            wprintf(L"Failed to get position for item %d\n", i);
-            continue;
-        }
-        ReadProcessMemory(hProcess, pt, &iconPos, sizeof(POINT), &numRead); // Transfer the LPPOINT from SysListView32 memory to iconPos
-
-        LVITEM lvi = { 0 };
-        lvi.iSubItem = 0;
-        lvi.cchTextMax = 256;
-        lvi.pszText = itemText; // Set pszText to virtually allocated LPWSTR 
-
-        WriteProcessMemory(hProcess, lvItem, &lvi, sizeof(LVITEM), NULL); // Write LVITEM to the target process
-
-        SendMessage(hDesktopListView, LVM_GETITEMTEXT, (WPARAM)i, (LPARAM)lvItem); // Retrieve the item text
-
-        ReadProcessMemory(hProcess, itemText, itemName, 256 * sizeof(WCHAR), &numRead); // Read the item text from the target process
-        
-        placeInfoTemp = { {"icon", std::wstring(itemName).c_str()},// Translate WINDOWPLACEMENT to json, stick the process in the front
-            {"position", {{"x", std::to_string(iconPos.x)}, {"y",  std::to_string(iconPos.y)}}} };
-
-        placeInfo.push_back(placeInfoTemp); //append to main json
-        placeInfoTemp.clear();// clear temp
-    }
-    VirtualFreeEx(hProcess, pt, 0, MEM_RELEASE);
-    VirtualFreeEx(hProcess, lvItem, 0, MEM_RELEASE);
-    VirtualFreeEx(hProcess, itemText, 0, MEM_RELEASE);
-    CloseHandle(hProcess);
-    LayFile << placeInfo; // add to json file
-
-    LayFile.close();
-}
-
-void WinWinFunctions::ExecuteDesktopLayout(std::wstring json)
-{
-    std::wstring jsonFile = L"SavedDesktopLayouts/" + json + L".json";
-    if (!std::filesystem::exists(jsonFile)) { // Check if it exists
-        return;
-    }
-    std::vector<SavedIcon*> SavedIcons;
-
-    HWND hProgMan = FindWindow(L"Progman", NULL);
-    HWND hShellView = FindWindowEx(hProgMan, NULL, L"SHELLDLL_DefView", NULL);
-    FindWindowEx(hShellView, NULL, L"SysListView32", NULL);
-
-    HWND hDesktopListView = FindWindowEx(hShellView, NULL, L"SysListView32", NULL);
-    int itemCount = ListView_GetItemCount(hDesktopListView);
-    DWORD pid = 0;
-    GetWindowThreadProcessId(hDesktopListView, &pid);
-    HANDLE hProcess = OpenProcess(PROCESS_VM_OPERATION | PROCESS_VM_READ | PROCESS_VM_WRITE, FALSE, pid);
-
-    // Allocate memory in SysListView32
-    LPPOINT pt = (LPPOINT)VirtualAllocEx(hProcess, NULL, sizeof(POINT), MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
-    LVITEM* lvItem = (LVITEM*)VirtualAllocEx(hProcess, NULL, sizeof(LVITEM), MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
-    LPWSTR itemText = (LPWSTR)VirtualAllocEx(hProcess, NULL, 256 * sizeof(WCHAR), MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
-    WCHAR itemName[256] = L"";
-
-    POINT iconPos;
-    SIZE_T numRead;
-    POINT savedIconPos;
-
-    std::fstream LayFile;
-    LayFile.open(jsonFile, std::ios::in);
-    nlohmann::json Doc{ nlohmann::json::parse(LayFile) };
-    int i = 0;
-    for (auto& window : Doc.items()) {
-        std::string iconName = Doc[i].at("icon");
-        std::string iconPosXStr = Doc[i].at("position").at("x");
-        UINT iconPosX = std::stoi(iconPosXStr);
-        std::string iconPosYStr = Doc[i].at("position").at("y");
-        UINT iconPosY = std::stoi(iconPosYStr);
-        savedIconPos.x = iconPosX;
-        savedIconPos.y = iconPosY;
-
-        SavedIcons.push_back(new SavedIcon(iconName, savedIconPos));
-        i++;
-    }
-    for (int i = 0; i < itemCount; ++i) {
-        if (!ListView_GetItemPosition(hDesktopListView, i, pt)) {
-            wprintf(L"Failed to get position for item %d\n", i);
-        }
-        ReadProcessMemory(hProcess, pt, &iconPos, sizeof(POINT), &numRead);
-
-        LVITEM lvi = { 0 };
-        lvi.iSubItem = 0;
-        lvi.cchTextMax = 256;
-        lvi.pszText = itemText;
-
-        WriteProcessMemory(hProcess, lvItem, &lvi, sizeof(LVITEM), NULL); // Write LVITEM to the target process
-        
-        SendMessageW(hDesktopListView, LVM_GETITEMTEXT, (WPARAM)i, (LPARAM)lvItem);// Retrieve the item text
-
-        ReadProcessMemory(hProcess, itemText, itemName, 256 * sizeof(WCHAR), &numRead);// Read the item text from the target process
-
-        for (SavedIcon* icon : SavedIcons) {
-            int wideStrSize = MultiByteToWideChar(CP_UTF8, 0, icon->m_iconName.c_str(), -1, nullptr, 0);
-            std::wstring convertedWideStr(wideStrSize, L'/0');
-            MultiByteToWideChar(CP_UTF8, 0, icon->m_iconName.c_str(), -1, &convertedWideStr[0], wideStrSize);
-            convertedWideStr.erase(std::remove(convertedWideStr.begin(), convertedWideStr.end(), L'\0'), convertedWideStr.end());
-            std::wstring pathWstring(itemName);
-            if (pathWstring == convertedWideStr) {
-
-                int itemIndex = i;
-                SendMessage(hDesktopListView, LVM_SETITEMPOSITION, (WPARAM)itemIndex, MAKELPARAM(icon->m_iconPos.x, icon->m_iconPos.y));
-                break;
-                itemName[0] = L'\0';
-            }
-        }
-    }
-    VirtualFreeEx(hProcess, pt, 0, MEM_RELEASE);
-    VirtualFreeEx(hProcess, lvItem, 0, MEM_RELEASE);
-    VirtualFreeEx(hProcess, itemText, 0, MEM_RELEASE);
-    CloseHandle(hProcess);
-}
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// WinWinFunctions.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.25 Probes are only attributed to an application for windows that are kept or timed out, stacked windows are positioned in order after the restores
+// 10/19/2026 MS-24.01.08.12 SaveDesktopLayout and DiffDesktopLayout return failure for a layout or desktop they can't open
+// 10/19/2026 MS-24.01.08.19 A process cache hit waits on the handle it holds instead of opening the process, desktop layouts are found through DesktopLayoutPath
+// 10/19/2026 MS-24.01.08.25 The process cache pointer is thread local, so concurrent enumerations never share a stack map
+// 10/19/2026 MS-24.01.08.19 GetProcessPath keys its cache on the process ID and creation time
+// 10/19/2026 MS-24.01.08.15 The save functions only ask for a name when none is given, a cancelled desktop save is named NewLayout
+// 10/19/2026 MS-24.01.08.25 Probe, restore and move times are recorded per application, Stack and Cascade schedule slow applications through AppLatency::Dispatch
+// 10/19/2026 MS-24.01.08.24 Trace spans around enumeration, probes, OpenProcess, the arrangements, layouts and the desktop icon functions
+// 10/19/2026 MS-24.01.08.22 Stack, Cascade and Squish use the LayoutPlanner rects so a dry run matches the real thing, added CaptureScene
+// 10/19/2026 MS-24.01.08.21 Enumeration, matching, placement and the desktop icon functions charge their phases and counts to CommandStats
+// 10/19/2026 MS-24.01.08.19 Split WindowLayoutPath out of ExecuteWindowLayout, GetProcessPath reads through an optional process cache
+// 10/19/2026 MS-24.01.08.12 SaveDesktopLayout only writes changes, added DiffDesktopLayout
+// 10/19/2026 MS-24.01.08.11 ExecuteDesktopLayout plans moves with IconPlacer, packing icons that aren't in the layout
+// 10/19/2026 MS-24.01.08.10 Desktop layouts are read and written as typed IconRecords through IconLayoutSchema
+// 10/19/2026 MS-24.01.08.09 Desktop icon functions open the desktop through DesktopIconBackends
+// 10/19/2026 MS-24.01.08.08 ExecuteDesktopLayout only moves icons that changed, as one redraw-suspended batch, and returns the count
+// 10/19/2026 MS-24.01.08.07 ExecuteDesktopLayout matches icons through a name index instead of a nested loop
+// 10/19/2026 MS-24.01.08.06 Desktop icons are read in bulk through IconListView/SysListViewIcons
+// 10/19/2026 MS-24.01.08.05 Layouts store work area relative coordinates and are rescaled to the current resolution on restore
+// 10/19/2026 MS-24.01.08.04 Split ApplyLayoutDocument out of ExecuteWindowLayout, matched placements are applied as one batch
+// 10/19/2026 MS-24.01.08.03 Layouts are read and written through LayoutSchema, ExecuteWindowLayout decodes fields lazily
+// 10/19/2026 MS-24.01.08.02 Split per-window JSON conversion out of SaveWindowLayout for use by LayoutSnapshotter
+// 10/19/2026 MS-24.01.08.01 Arranging operations record the previous placement in LayoutHistory for undo/redo
+// 09/03/2024 MS-24.01.07.02 Moved all WinWin base functionality here for use with the command line and UI
+// 09/03/2024 MS-24.01.07.01 created
+//-----------------------------------------------
+// Source code for WinWin base functions
+// 
+// Defines functions for static class WinWinFunctions which performs all window operations independent of the UI.
+// These functions can be called from anywhere and provides a method GetActiveWindows that returns 
+// a vector of HWNDS for every active window. This can be passed to any of the WinWin functions allowing
+// any window operations to occur from this class.
+
+
+#include "WinWinFunctions.h"
+
+static std::wstring userInput;
+
+thread_local ProcessPathCache* WinWinFunctions::s_ProcessCache = NULL;
+
+INT_PTR CALLBACK DialogProcWinFun(HWND hDlg, UINT message, WPARAM wParam, LPARAM lParam) {
+    switch (message) {
+    case WM_INITDIALOG:
+        return TRUE;
+
+    case WM_COMMAND:
+        switch (LOWORD(wParam)) {
+        case IDOK: {
+            WCHAR text[256];
+            GetDlgItemText(hDlg, IDC_EDIT_TEXT, text, 256);
+            userInput = text; // Store the input text in the global variable
+            EndDialog(hDlg, IDOK);
+            return TRUE;
+        }
+        case IDCANCEL:
+            EndDialog(hDlg, IDCANCEL);
+            return TRUE;
+        }
+        break;
+    }
+    return FALSE;
+}
+
+BOOL CALLBACK WinWinFunctions::EnumWindowsProc(HWND hwnd, LPARAM lParam) {
+    std::vector<HWND>* WindowHwndVector = reinterpret_cast<std::vector<HWND>*>(lParam);
+    WCHAR windowTitle[256];
+    if (GetParent(hwnd) == NULL && IsWindowVisible(hwnd)) {
+        LRESULT result;
+        double probeMs;
+        {
+            PhaseTimer probe(CommandPhase::Probe);
+            TraceSpan span("Probe", "probe");
+            span.SetValue((long long)(INT_PTR)hwnd);
+            auto start = std::chrono::steady_clock::now();
+            result = SendMessageTimeoutW(hwnd, WM_NULL, 0, 0, SMTO_ABORTIFHUNG, 1000, NULL);
+            probeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+        if (result == 0 || !IsWindowEnabled(hwnd)) { // Check if the window is able to receive/respond to messages
+            CommandStats* stats = CommandStats::Current();
+            if (result == 0 && stats != NULL) {
+                stats->timedOut++;
+            }
+            if (result == 0) {
+                AppLatency::Record(AppName(hwnd), LatencyKind::Probe, probeMs); // A hung application is the one worth knowing about
+            }
+            return TRUE;
+        }
+        if (GetWindowText(hwnd, windowTitle, sizeof(windowTitle) / sizeof(windowTitle[0])) == 0) {
+            return TRUE;
+        }
+        if ((std::wstring(windowTitle) == L"Program Manager" || std::wstring(windowTitle) == L"Windows Input Experience" || std::wstring(windowTitle) == L"Windows Shell Experience Host")) {
+            return TRUE;
+        }
+        if (std::wstring(windowTitle) == L"Windows Window Extension Window" || std::wstring(windowTitle) == L"Windows_Windows (Running) - Microsoft Visual Studio") {
+            return TRUE;
+        }
+        // ^ Exclude Program Manager, Windows Input Experience, Windows Shell Experience Host, the Windows Windows UI, and the Visual Studio window running Windows Windows from the vector
+        WindowHwndVector->push_back(hwnd);
+        AppLatency::Record(AppName(hwnd), LatencyKind::Probe, probeMs); // Only looked up once kept, the arrangement reads the same entry
+    }
+    return TRUE;
+}
+
+bool compareHwnd(HWND a, HWND b) { // Sort windows by title alphabetically
+    char titleA[256], titleB[256];
+    GetWindowTextA(a, titleA, sizeof(titleA));
+    GetWindowTextA(b, titleB, sizeof(titleB));
+    return std::string(titleA) < std::string(titleB); // Reutrn True if a is first alphabetically, False if b is first 
+}
+
+std::vector<HWND> WinWinFunctions::GetActiveWindows()
+{
+    PhaseTimer timer(CommandPhase::Enumerate);
+    TraceSpan span("GetActiveWindows", "enumerate");
+    std::vector<HWND> WindowHwndVector;
+    ScopedProcessCache processes; // Each process is opened once for the probe latencies, unless this thread has a longer lived cache set
+    EnumWindows(EnumWindowsProc, reinterpret_cast<LPARAM>(&WindowHwndVector)); // Enumerate through the windows with this callback function. 
+    if (!WindowHwndVector.empty()) {
+        TraceSpan sort("SortWindows", "enumerate");
+        std::sort(WindowHwndVector.begin(), WindowHwndVector.end(), compareHwnd);
+    }
+    span.SetValue((long long)WindowHwndVector.size());
+    return WindowHwndVector;
+}
+
+void WinWinFunctions::Stack(std::vector<HWND> WindowVect)
+{
+    int winFunStackIndex;
+    TraceSpan span("Stack", "arrange");
+    span.SetValue((long long)WindowVect.size());
+
+    LayoutHistory::Capture(WindowVect); // Record the previous placement so the stack can be undone
+    PhaseTimer timer(CommandPhase::Apply);
+    if (CommandStats* stats = CommandStats::Current()) { // Only the first 8 windows are stacked from here, see StackWindowsCallback
+        stats->matched = stats->moved = (int)min(WindowVect.size(), (size_t)8);
+        stats->skipped = (int)WindowVect.size() - stats->moved;
+    }
+
+    if (WindowVect.size() <= 4) {
+        StackFourOrLess(WindowVect);
+    }
+    else if (WindowVect.size() <= 8) {
+        StackFiveToEight(WindowVect);
+    }
+    else if (WindowVect.size() > 8) {
+
+        winFunStackIndex = 0;
+        StackWindowsCallback(WindowVect);
+    }
+}
+
+// Restore each window, then move it to its stack rect and bring it to the front
+// Windows of slow applications are restored on their own threads alongside the rest. Every restore has finished before the first
+// window is moved, and the windows are moved in stack order, so the z-order doesn't depend on which restore came back first.
+static void MoveToStackRects(const std::vector<HWND>& WindowVector) {
+    std::vector<PlanRect> Rects = LayoutPlanner::StackRects(WindowVector.size(), GetSystemMetrics(SM_CXSCREEN), GetSystemMetrics(SM_CYSCREEN));
+    std::vector<std::string> Apps;
+    for (size_t i = 0; i < Rects.size(); i++) {
+        Apps.push_back(WinWinFunctions::AppName(WindowVector[i])); // Read from the enumeration's process cache entries
+    }
+    AppLatency::Dispatch(Apps, [&](size_t i, bool) {
+        LatencyTimer restore(Apps[i], LatencyKind::Restore);
+        ShowWindow(WindowVector[i], SW_RESTORE);
+        SendMessage(WindowVector[i], WM_SYSCOMMAND, SC_RESTORE, 0);
+    }, true);
+    for (size_t i = 0; i < Rects.size(); i++) {
+        const PlanRect& rect = Rects[i];
+        LatencyTimer move(Apps[i], LatencyKind::Move);
+        SetWindowPos(WindowVector[i], HWND_TOPMOST, rect.left, rect.top, rect.right - rect.left, rect.bottom - rect.top, NULL);
+        SetWindowPos(WindowVector[i], HWND_NOTOPMOST, rect.left, rect.top, rect.right - rect.left, rect.bottom - rect.top, NULL);
+    }
+}
+
+void WinWinFunctions::StackFourOrLess(std::vector<HWND> WindowVector) {
+    MoveToStackRects(WindowVector); // One full width column
+}
+
+void WinWinFunctions::StackFiveToEight(std::vector<HWND> WindowVector) {
+    MoveToStackRects(WindowVector); // Two half width columns, the left one gets the odd window
+}
+
+void WinWinFunctions::StackWindowsCallback(std::vector<HWND> WindowVect)
+{
+    int winFunStackIndex = 0;
+
+    int lastVector = WindowVect.size() % 8;
+    int subVectorCount = (floor(float(WindowVect.size()) / float(8))) + (lastVector == 0 ? 0 : 1);
+
+    std::vector<HWND> SubVector;
+    for (int i = 0; i < 8; i++) {
+        if (WindowVect.size() <= (winFunStackIndex * 8) + i) {
+            break;
+        }
+        SubVector.push_back(WindowVect[(winFunStackIndex * 8) + i]);
+    }
+    if (SubVector.size() <= 4) {
+        StackFourOrLess(SubVector);
+    }
+    else if (SubVector.size() <= 8) {
+        StackFiveToEight(SubVector);
+    }
+    SubVector.clear();
+}
+
+void WinWinFunctions::Cascade(std::vector<HWND> WindowVect) {
+    TraceSpan span("Cascade", "arrange");
+    span.SetValue((long long)WindowVect.size());
+    std::vector<PlanRect> Rects = LayoutPlanner::CascadeRects(WindowVect.size(), GetSystemMetrics(SM_CYSCREEN));
+    LayoutHistory::Capture(WindowVect); // Record the previous placement so the operation can be undone
+    PhaseTimer timer(CommandPhase::Apply);
+    if (CommandStats* stats = CommandStats::Current()) {
+        stats->matched = stats->moved = (int)WindowVect.size();
+    }
+    std::vector<std::string> Apps;
+    for (HWND ctrl : WindowVect) {
+        Apps.push_back(AppName(ctrl));
+    }
+    AppLatency::Dispatch(Apps, [&](size_t i, bool) { // Windows of slow applications are restored last rather than in parallel
+        LatencyTimer restore(Apps[i], LatencyKind::Restore);
+        SendMessage(WindowVect[i], WM_SYSCOMMAND, SC_RESTORE, 0);
+        ShowWindow(WindowVect[i], SW_SHOWNORMAL);  // Set each window to normal mode (unmax/unmin)
+    }, false);
+    for (size_t i = 0; i < WindowVect.size(); i++) { // In cascade order, each window covers the one before it
+        LatencyTimer move(Apps[i], LatencyKind::Move);
+        SetWindowPos(WindowVect[i], HWND_TOPMOST, Rects[i].left, Rects[i].top, 750, 750, NULL); // Bring current window to front
+        SetWindowPos(WindowVect[i], HWND_NOTOPMOST, Rects[i].left, Rects[i].top, 750, 750, NULL); // Remove "TOPMOST" flag
+    }
+}
+
+void WinWinFunctions::Squish(std::vector<HWND> WindowVect) {
+    TraceSpan span("Squish", "arrange");
+    span.SetValue((long long)WindowVect.size());
+    std::vector<PlanRect> Rects = LayoutPlanner::CascadeRects(WindowVect.size(), GetSystemMetrics(SM_CYSCREEN));
+    LayoutHistory::Capture(WindowVect); // Record the previous placement so the operation can be undone
+    PhaseTimer timer(CommandPhase::Apply);
+    CommandStats* stats = CommandStats::Current();
+    RECT windowRect;
+    for (size_t i = 0; i < WindowVect.size(); i++) { //Iterate through all windows in WindowsVector (all open windows)
+        HWND ctrl = WindowVect[i];
+        GetWindowRect(ctrl, &windowRect);
+        if (windowRect.top == Rects[i].top && windowRect.left == Rects[i].left) { //&& windowRect.right - windowRect.left == 750 && windowRect.bottom - windowRect.top == 750
+            ShowWindow(ctrl, SW_MINIMIZE);
+            if (stats != NULL) {
+                stats->moved++;
+            }
+        }
+        else if (stats != NULL) {
+            stats->skipped++; // Moved since the cascade, left alone
+        }
+    }
+}
+
+std::wstring WinWinFunctions::GetUserInput(HINSTANCE hInstance) {
+    userInput.clear(); // Clear previous input
+    if (DialogBox(hInstance, MAKEINTRESOURCE(IDD_SIMPLE_INPUT_DIALOG), NULL, DialogProcWinFun) == IDOK) {
+        return userInput;
+    }
+    return L"";
+}
+
+std::wstring WinWinFunctions::GetExeDirectory() {
+    wchar_t exeWcharPath[MAX_PATH];
+    GetModuleFileName(NULL, exeWcharPath, MAX_PATH);
+
+    std::wstring exePath(exeWcharPath);
+    std::wstring::size_type pos = exePath.find_last_of(L"\\/");
+    return exePath.substr(0, pos);
+}
+
+const std::wstring* ProcessPathCache::Find(DWORD processId) {
+    auto cached = m_Entries.find(processId);
+    if (cached == m_Entries.end()) {
+        return NULL;
+    }
+    if (WaitForSingleObject(cached->second.process, 0) == WAIT_TIMEOUT) {
+        return &cached->second.path;
+    }
+    CloseHandle(cached->second.process); // Exited, the ID is free to be reused once the handle is closed
+    m_Entries.erase(cached);
+    return NULL;
+}
+
+void ProcessPathCache::Add(DWORD processId, HANDLE process, const std::wstring& path) {
+    auto cached = m_Entries.find(processId);
+    if (cached != m_Entries.end()) {
+        CloseHandle(cached->second.process);
+        m_Entries.erase(cached);
+    }
+    m_Entries.emplace(processId, Entry{ process, path });
+}
+
+void ProcessPathCache::Retain(const std::unordered_set<DWORD>& Owners) {
+    for (auto cached = m_Entries.begin(); cached != m_Entries.end();) {
+        if (Owners.count(cached->first)) {
+            ++cached;
+            continue;
+        }
+        CloseHandle(cached->second.process);
+        cached = m_Entries.erase(cached);
+    }
+}
+
+void ProcessPathCache::Clear() {
+    for (auto& cached : m_Entries) {
+        CloseHandle(cached.second.process);
+    }
+    m_Entries.clear();
+}
+
+std::wstring WinWinFunctions::GetProcessPath(HWND ctrl) {
+    DWORD processId;
+    WCHAR path[MAX_PATH] = L"";
+    GetWindowThreadProcessId(ctrl, &processId);
+    if (s_ProcessCache != NULL) {
+        if (const std::wstring* cached = s_ProcessCache->Find(processId)) { // No process is opened for a hit
+            return *cached;
+        }
+    }
+    {
+        TraceSpan span("OpenProcess", "probe");
+        span.SetValue((long long)processId);
+        DWORD access = PROCESS_QUERY_INFORMATION | PROCESS_VM_READ;
+        HANDLE hProcess = NULL;
+        if (s_ProcessCache != NULL) {
+            hProcess = OpenProcess(access | SYNCHRONIZE, FALSE, processId); // The same handle is held by the cache to tell when the process exits
+        }
+        bool held = (hProcess != NULL);
+        if (!held) {
+            hProcess = OpenProcess(access, FALSE, processId); // Get executable associated with window handle
+        }
+        if (hProcess != NULL) {
+            GetModuleFileNameEx(hProcess, NULL, path, MAX_PATH);
+            if (held && path[0] != L'\0') {
+                s_ProcessCache->Add(processId, hProcess, path); // A failed lookup is retried next time, the process may have been starting up
+            }
+            else {
+                CloseHandle(hProcess);
+            }
+        }
+    }
+    return std::wstring(path);
+}
+
+ProcessPathCache* WinWinFunctions::SetProcessCache(ProcessPathCache* cache) {
+    ProcessPathCache* previous = s_ProcessCache;
+    s_ProcessCache = cache;
+    return previous;
+}
+
+ScopedProcessCache::ScopedProcessCache() {
+    m_Previous = WinWinFunctions::SetProcessCache(NULL);
+    WinWinFunctions::SetProcessCache(m_Previous != NULL ? m_Previous : &m_Cache);
+}
+
+ScopedProcessCache::~ScopedProcessCache() {
+    WinWinFunctions::SetProcessCache(m_Previous);
+}
+
+std::string WinWinFunctions::AppName(HWND ctrl) {
+    return AppLatency::AppName(ConvertToNarrowString(GetProcessPath(ctrl)));
+}
+
+// Collects the bounds and work area of every monitor for CaptureScene
+static BOOL CALLBACK CaptureMonitorProc(HMONITOR hMonitor, HDC hdc, LPRECT lprcMonitor, LPARAM lParam) {
+    std::vector<PlanMonitor>* Monitors = reinterpret_cast<std::vector<PlanMonitor>*>(lParam);
+    MONITORINFO info;
+    info.cbSize = sizeof(MONITORINFO);
+    if (GetMonitorInfo(hMonitor, &info)) {
+        Monitors->push_back({ { info.rcMonitor.left, info.rcMonitor.top, info.rcMonitor.right, info.rcMonitor.bottom },
+            { info.rcWork.left, info.rcWork.top, info.rcWork.right, info.rcWork.bottom } });
+    }
+    return TRUE;
+}
+
+WindowScene WinWinFunctions::CaptureScene(const std::vector<HWND>& WindowVect) {
+    PhaseTimer timer(CommandPhase::Enumerate);
+    TraceSpan span("CaptureScene", "enumerate");
+    WindowScene scene;
+    scene.screenWidth = GetSystemMetrics(SM_CXSCREEN);
+    scene.screenHeight = GetSystemMetrics(SM_CYSCREEN);
+    EnumDisplayMonitors(NULL, NULL, CaptureMonitorProc, reinterpret_cast<LPARAM>(&scene.monitors));
+
+    scene.windows.reserve(WindowVect.size());
+    for (HWND ctrl : WindowVect) {
+        PlanWindow window;
+        RECT rect;
+        WCHAR windowTitle[256] = L"";
+        GetWindowRect(ctrl, &rect);
+        GetWindowText(ctrl, windowTitle, sizeof(windowTitle) / sizeof(windowTitle[0]));
+        window.handle = (long long)(int(ctrl)); // The same value SaveWindowLayout stores, so handle matching works against a recorded scene
+        window.title = ConvertToNarrowString(windowTitle);
+        window.process = ConvertToNarrowString(GetProcessPath(ctrl));
+        window.rect = { rect.left, rect.top, rect.right, rect.bottom };
+        window.minimized = IsIconic(ctrl) != FALSE;
+        window.maximized = IsZoomed(ctrl) != FALSE;
+        scene.windows.push_back(window);
+    }
+    return scene;
+}
+
+// WINDOWPLACEMENT rects of top level windows are in workspace coordinates, which are screen coordinates less the offset of the work
+// area on its monitor (a taskbar docked on the left or top). Shift a rect by that offset, toScreen picks the direction.
+static RECT ConvertWorkspaceRect(RECT rect, const MONITORINFO& monitor, bool toScreen) {
+    int dx = monitor.rcWork.left - monitor.rcMonitor.left;
+    int dy = monitor.rcWork.top - monitor.rcMonitor.top;
+    OffsetRect(&rect, toScreen ? dx : -dx, toScreen ? dy : -dy);
+    return rect;
+}
+
+// A placement saved from a minimized window, whose rcNormalPosition was left in workspace coordinates by WindowToJson
+static bool SavedMinimized(const WINDOWPLACEMENT& placement) {
+    return placement.showCmd == SW_SHOWMINIMIZED || placement.showCmd == SW_MINIMIZE || placement.showCmd == SW_SHOWMINNOACTIVE;
+}
+
+nlohmann::json WinWinFunctions::WindowToJson(HWND ctrl, const std::wstring& processPath) {
+    WINDOWPLACEMENT pInstancePlacement;
+    pInstancePlacement.length = sizeof(WINDOWPLACEMENT);  // Instantiate WINDOWPLACEMENT object
+    RECT rect;
+    WCHAR instanceTitle[256];
+
+    GetWindowRect(ctrl, &rect);
+    GetWindowPlacement(ctrl, &pInstancePlacement); // Get the hwnd of the current handle and extract placement details. 
+                                                   // Put into WINDOWPLACEMENT object 
+    if (!IsIconic(ctrl)) { // If the window isn't minimized, set the window size to the dimensions from GetWindowRect. Without this, windows set with the 
+                           // Windows auto window placement magic won't be set correctly
+        pInstancePlacement.rcNormalPosition.left = rect.left;
+        pInstancePlacement.rcNormalPosition.right = rect.right;
+        pInstancePlacement.rcNormalPosition.top = rect.top;
+        pInstancePlacement.rcNormalPosition.bottom = rect.bottom;
+
+    }
+    GetWindowTextW(ctrl, instanceTitle, sizeof(instanceTitle) / sizeof(instanceTitle[0]));
+
+    MONITORINFO monitor;  // Work area of the monitor the window is on, for the resolution independent copy of the rect
+    monitor.cbSize = sizeof(MONITORINFO);
+    GetMonitorInfo(MonitorFromRect(&pInstancePlacement.rcNormalPosition, MONITOR_DEFAULTTONEAREST), &monitor);
+    RECT screenRect = pInstancePlacement.rcNormalPosition;
+    if (IsIconic(ctrl)) { // Only the workspace rect is known for a minimized window, the work area is in screen coordinates
+        screenRect = ConvertWorkspaceRect(screenRect, monitor, true);
+    }
+    NormalizedLayout::NormalizedRect normalized = NormalizedLayout::Normalize(screenRect, monitor.rcWork);
+
+    return { {"process", ConvertToNarrowString(processPath)},// Translate WINDOWPLACEMENT to json, stick the process in the front
+        {"minimized", IsIconic(ctrl) },
+        {"handle", int(ctrl)},
+        {"title", ConvertToNarrowString(std::wstring(instanceTitle))},
+        {"length", pInstancePlacement.length},
+        {"flags", pInstancePlacement.flags},
+    {"showCmd", pInstancePlacement.showCmd },
+    {"ptMinPosition",
+        { {"x", pInstancePlacement.ptMinPosition.x },
+         { "y",  pInstancePlacement.ptMinPosition.y } } },
+    {"ptMaxPosition",
+         { { "x", pInstancePlacement.ptMaxPosition.x},
+           { "y", pInstancePlacement.ptMaxPosition.y} } },
+     {"rcNormalPosition",
+         { { "left", pInstancePlacement.rcNormalPosition.left },
+           { "right", pInstancePlacement.rcNormalPosition.right },
+           { "top", pInstancePlacement.rcNormalPosition.top },
+           { "bottom", pInstancePlacement.rcNormalPosition.bottom } } },
+     {"normalized",
+         { { "left", normalized.left },
+           { "right", normalized.right },
+           { "top", normalized.top },
+           { "bottom", normalized.bottom } } }
+    };
+}
+
+void WinWinFunctions::SaveWindowLayout(std::vector<HWND> WindowVect, std::wstring presetLayoutName)
+{
+    TraceSpan span("SaveWindowLayout", "layout");
+    span.SetValue((long long)WindowVect.size());
+    std::wstring layoutName;
+    if (!presetLayoutName.empty()) {
+        layoutName = presetLayoutName;
+    }
+    else {
+        layoutName = GetUserInput(GetModuleHandle(NULL));
+    }
+    if (layoutName == L"") { layoutName = L"NewLayout"; }
+    if (!layoutName.empty() && layoutName.back() == L'\0') layoutName.pop_back();
+
+
+    // Retrieve the path of the executable to ensure that the correct SavedLayouts directory is referenced
+    // Without this, it will attempt to find SavedLayouts in whatever dir the command was called in
+    // This is for command line support
+
+    wchar_t exeWcharPath[MAX_PATH];
+    GetModuleFileName(NULL, exeWcharPath, MAX_PATH);
+
+    std::wstring exePath(exeWcharPath);
+    std::wstring::size_type pos = exePath.find_last_of(L"\\/");
+    std::wstring exeDir = exePath.substr(0, pos);
+
+    SetCurrentDirectory(exeDir.c_str()); // Set the working directory to the executable's directory
+
+    std::wstring WinWinLayoutsFile = exeDir + L"/SavedLayouts/" + layoutName + L".json";   // Name of json file (in SavedLayouts folder)
+
+    nlohmann::json placeInfo = nlohmann::json::array(); // Window list that is written to file
+
+    {
+        TraceSpan convert("WindowToJson", "layout");
+        for (HWND ctrl : WindowVect) {
+            placeInfo.push_back(WindowToJson(ctrl, GetProcessPath(ctrl))); //append to main json
+        }
+    }
+
+    LayoutSchema::Save(WinWinLayoutsFile, placeInfo); // Written as the current schema version, see LayoutSchema.h
+}
+
+std::wstring WinWinFunctions::WindowLayoutPath(std::wstring json) {
+    if (!json.empty() && json.back() == L'\0') json.pop_back(); // Remove null terminator from end of file name
+
+    // Relative to the executable rather than the working directory, otherwise the command line would look for SavedLayouts in
+    // whatever directory the command was called in
+    return GetExeDirectory() + L"/SavedLayouts/" + json + L".json";
+}
+
+std::wstring WinWinFunctions::DesktopLayoutPath(std::wstring json) {
+    if (!json.empty() && json.back() == L'\0') json.pop_back();
+    return GetExeDirectory() + L"/SavedDesktopLayouts/" + json + L".json"; // Same folder whether the service or the command line runs it
+}
+
+void WinWinFunctions::ExecuteWindowLayout(std::wstring json, std::vector<HWND> WindowVect) {
+    TraceSpan span("ExecuteWindowLayout", "layout");
+
+    SetCurrentDirectory(GetExeDirectory().c_str()); // Set the working directory to the executable's directory
+
+    std::wstring jsonFile = WindowLayoutPath(json);
+    if (!std::filesystem::exists(jsonFile)) { // Check if it exists
+        return;
+    }
+
+    // Load the file at the current schema version (older files are migrated in memory) and wrap each saved window in a lazy LayoutRecord.
+    // Nothing is decoded yet - each matching pass below only decodes the fields it compares, and the placement is only decoded for matched windows.
+    nlohmann::json Doc = LayoutSchema::Load(jsonFile);
+    if (Doc.empty()) {
+        return;
+    }
+    ApplyLayoutDocument(Doc, WindowVect);
+}
+
+void WinWinFunctions::ApplyLayoutDocument(const nlohmann::json& Doc, std::vector<HWND> WindowVect) {
+    if (!Doc.contains("windows") || !Doc["windows"].is_array()) {
+        return;
+    }
+    std::vector<LayoutRecord> SavedWindows;
+    SavedWindows.reserve(Doc["windows"].size());
+    for (const auto& window : Doc["windows"]) {
+        SavedWindows.emplace_back(window);
+    }
+
+    TraceSpan span("ApplyLayoutDocument", "layout");
+    span.SetValue((long long)SavedWindows.size());
+    LayoutHistory::Capture(WindowVect); // Record the previous placement so the layout can be undone
+    PhaseTimer timer(CommandPhase::Match); // Everything up to the apply below, which takes its own time out of this
+    TraceSpan match("MatchWindows", "match");
+
+    // The open windows get the same treatment - the title and process of each open window are looked up the first time a pass needs them
+    // and then reused, instead of calling OpenProcess for every open window for every saved window
+    std::vector<OpenWindow> OpenWindows;
+    OpenWindows.reserve(WindowVect.size());
+    for (HWND ctrl : WindowVect) {
+        OpenWindows.push_back({ ctrl });
+    }
+
+    std::vector<LayoutHistory::CapturedPlacement> Batch; // Every matched placement, applied together at the end
+    Batch.reserve(SavedWindows.size());
+    NormalizedLayout::RescaleBatch Rescale; // Matched windows that were saved with work area relative coordinates
+
+    for (LayoutRecord& window : SavedWindows) {
+        for (OpenWindow& open : OpenWindows) { // 1. Match by handle
+            if (!open.claimed && (long long)(int(open.hwnd)) == window.Handle()) {
+                ApplySavedPlacement(open, window, Batch, Rescale);
+                break;
+            }
+        }
+        if (!window.moved && !window.Title().empty()) { // 2. Match by title
+            for (OpenWindow& open : OpenWindows) {
+                if (!open.claimed && open.Title() == window.Title()) {
+                    ApplySavedPlacement(open, window, Batch, Rescale);
+                    break;
+                }
+            }
+        }
+        if (!window.moved && !window.Process().empty()) { // 3. Match by process
+            for (OpenWindow& open : OpenWindows) {
+                if (!open.claimed && open.Process() == window.Process()) {
+                    ApplySavedPlacement(open, window, Batch, Rescale);
+                    break;
+                }
+            }
+        }
+    }
+
+    NormalizedLayout::Rescale(Rescale); // Scale every matched window onto its monitor's current work area in one pass
+    for (size_t i = 0; i < Rescale.Size(); i++) {
+        LayoutHistory::CapturedPlacement& captured = Batch[Rescale.index[i]];
+        captured.windowRect = { Rescale.outLeft[i], Rescale.outTop[i], Rescale.outRight[i], Rescale.outBottom[i] };
+        captured.placement.rcNormalPosition = captured.windowRect;
+        MONITORINFO monitor;
+        monitor.cbSize = sizeof(MONITORINFO);
+        if (SavedMinimized(captured.placement) && GetMonitorInfo(MonitorFromRect(&captured.windowRect, MONITOR_DEFAULTTONEAREST), &monitor)) {
+            captured.placement.rcNormalPosition = ConvertWorkspaceRect(captured.windowRect, monitor, false); // SetWindowPlacement takes workspace coordinates
+        }
+    }
+    if (CommandStats* stats = CommandStats::Current()) {
+        stats->matched += (int)Batch.size();
+        stats->skipped += (int)(SavedWindows.size() - Batch.size());
+    }
+    match.SetValue((long long)Batch.size());
+    PhaseTimer apply(CommandPhase::Apply);
+    LayoutHistory::ApplyPlacements(Batch); // One deferred batch, so the desktop is recomposed once for the whole layout
+}
+
+const std::string& WinWinFunctions::OpenWindow::Title() {
+    if (!title) {
+        WCHAR windowTitle[256] = L"";
+        GetWindowText(hwnd, windowTitle, sizeof(windowTitle) / sizeof(windowTitle[0]));
+        title = ConvertToNarrowString(windowTitle);
+    }
+    return *title;
+}
+
+const std::string& WinWinFunctions::OpenWindow::Process() {
+    if (!process) {
+        process = ConvertToNarrowString(GetProcessPath(hwnd));
+    }
+    return *process;
+}
+
+void WinWinFunctions::ApplySavedPlacement(OpenWindow& open, LayoutRecord& window, std::vector<LayoutHistory::CapturedPlacement>& Batch, NormalizedLayout::RescaleBatch& Rescale) {
+    LayoutHistory::CapturedPlacement captured;
+    if (!window.GetPlacement(captured.placement)) {
+        return; // Saved without a position, nothing to apply
+    }
+    captured.hwnd = open.hwnd;
+    captured.windowRect = captured.placement.rcNormalPosition; // SaveWindowLayout stores the GetWindowRect result here for normal windows
+
+    NormalizedLayout::NormalizedRect normalized;
+    if (window.GetNormalized(normalized)) { // The saved rect is only a hint for which monitor the window belongs on, its size comes from the work area
+        MONITORINFO monitor;
+        monitor.cbSize = sizeof(MONITORINFO);
+        if (GetMonitorInfo(MonitorFromRect(&captured.placement.rcNormalPosition, MONITOR_DEFAULTTONEAREST), &monitor)) {
+            Rescale.Add(Batch.size(), normalized, monitor.rcWork); // Scaled into screen coordinates, ApplyLayoutDocument converts minimized windows back
+        }
+    }
+    Batch.push_back(captured);
+    window.moved = TRUE;
+    open.claimed = TRUE;
+}
+
+
+
+ 
+// Open the desktop's icon list, charged to the enumerate phase along with reading it
+static std::unique_ptr<IconListView> OpenDesktop() {
+    PhaseTimer timer(CommandPhase::Enumerate);
+    TraceSpan span("OpenDesktop", "desktop");
+    return DesktopIconBackends::Open();
+}
+
+std::vector<IconRecord> WinWinFunctions::ReadIconRecords(IconListView& Desktop) {
+    PhaseTimer timer(CommandPhase::Enumerate);
+    TraceSpan span("ReadIcons", "desktop");
+    std::vector<IconRecord> Icons;
+    for (const DesktopIcon& icon : Desktop.ReadIcons()) {
+        Icons.push_back({ ConvertToNarrowString(icon.name), icon.x, icon.y }); // Names are stored as UTF-8 so non-ASCII names survive
+    }
+    if (CommandStats* stats = CommandStats::Current()) {
+        stats->windows = (int)Icons.size();
+    }
+    span.SetValue((long long)Icons.size());
+    return Icons;
+}
+
+bool WinWinFunctions::SaveDesktopLayout(std::wstring presetLayoutName)
+{
+    TraceSpan span("SaveDesktopLayout", "desktop");
+    std::wstring layoutName;
+    if (!presetLayoutName.empty()) {
+        layoutName = presetLayoutName;
+    }
+    else {
+        layoutName = GetUserInput(GetModuleHandle(NULL));
+    }
+    if (!layoutName.empty() && layoutName.back() == L'\0') layoutName.pop_back();
+    if (layoutName.empty()) { layoutName = L"NewLayout"; } // A cancelled dialog would otherwise save to ".json"
+
+    std::wstring WinWinLayoutsFile = DesktopLayoutPath(layoutName);
+
+    std::unique_ptr<IconListView> Desktop = OpenDesktop(); // Shell folder view if available, otherwise the list view, see DesktopIconBackends.h
+    if (!Desktop->IsOpen()) {
+        return false;
+    }
+
+    // Only the icons that were added, removed or moved since the last save are written, see IconLayoutSchema.h
+    return IconLayoutSchema::SaveIncremental(WinWinLayoutsFile, ReadIconRecords(*Desktop)).has_value();
+}
+
+std::optional<IconDiff> WinWinFunctions::DiffDesktopLayout(std::wstring json)
+{
+    TraceSpan span("DiffDesktopLayout", "desktop");
+    std::wstring jsonFile = DesktopLayoutPath(json);
+    std::unique_ptr<IconListView> Desktop = OpenDesktop();
+    if (!std::filesystem::exists(jsonFile) || !Desktop->IsOpen()) {
+        return std::nullopt;
+    }
+    PhaseTimer timer(CommandPhase::Match); // The load and the read are charged to their own phases
+    std::optional<std::vector<IconRecord>> Saved = IconLayoutSchema::TryLoad(jsonFile);
+    if (!Saved) {
+        return std::nullopt;
+    }
+    return IconDiff::Compute(*Saved, ReadIconRecords(*Desktop));
+}
+
+int WinWinFunctions::ExecuteDesktopLayout(std::wstring json, std::optional<IconSortRule> pack, bool snap)
+{
+    TraceSpan span("ExecuteDesktopLayout", "desktop");
+    std::wstring jsonFile = DesktopLayoutPath(json);
+    if (!std::filesystem::exists(jsonFile)) { // Check if it exists
+        return 0;
+    }
+
+    std::unique_ptr<IconListView> Desktop = OpenDesktop();
+    if (!Desktop->IsOpen()) {
+        return 0;
+    }
+
+    PhaseTimer timer(CommandPhase::Match); // Reading, loading and moving are charged to their own phases below
+    std::vector<IconRecord> Records = IconLayoutSchema::Load(jsonFile); // Older files with string coordinates are migrated in memory
+    std::vector<DesktopIcon> SavedIcons; // Names are converted to wide strings here, once per saved icon
+    SavedIcons.reserve(Records.size());
+    for (size_t i = 0; i < Records.size(); i++) {
+        SavedIcons.push_back({ (int)i, ConvertToWideString(Records[i].name), Records[i].x, Records[i].y });
+    }
+    IconMatcher Matcher(std::move(SavedIcons));
+
+    std::vector<DesktopIcon> LiveIcons;
+    {
+        PhaseTimer read(CommandPhase::Enumerate);
+        TraceSpan readSpan("ReadIcons", "desktop");
+        LiveIcons = Desktop->ReadIcons();
+    }
+    std::vector<IconMove> Moves; // Icons already in place are left out
+    IconGrid grid;
+    if ((pack || snap) && Desktop->GetGrid(grid)) {
+        IconPlacer Placer(grid, snap);
+        if (pack) {
+            if (*pack != IconSortRule::Name) {
+                PhaseTimer details(CommandPhase::Enumerate);
+                TraceSpan detailSpan("ReadIconDetails", "desktop");
+                Desktop->ReadIconDetails(LiveIcons); // Only the type and date rules need the extra per-icon lookups
+            }
+            Moves = Placer.Arrange(LiveIcons, Matcher, *pack); // Saved icons go back, new icons are packed into free cells
+        }
+        else {
+            Moves = Placer.Restore(LiveIcons, Matcher);
+        }
+    }
+    else {
+        Moves = Matcher.MoveSet(LiveIcons); // Saved icons go back to their exact pixels, new icons stay where Explorer put them
+    }
+    if (CommandStats* stats = CommandStats::Current()) {
+        stats->windows = (int)LiveIcons.size();
+        stats->moved = (int)Moves.size();
+        stats->skipped = (int)(LiveIcons.size() - min(Moves.size(), LiveIcons.size())); // Already in place
+    }
+    PhaseTimer apply(CommandPhase::Apply);
+    TraceSpan applySpan("SetIconPositions", "desktop");
+    applySpan.SetValue((long long)Moves.size());
+    Desktop->SetIconPositions(Moves); // Redraw is suspended for the batch so Explorer repaints once
+    return (int)Moves.size();
+}
\ No newline at end of file
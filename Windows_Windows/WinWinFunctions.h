@@ -1,333 +1,526 @@
-//***********************************************
-// WindowsWindows
-// Copyright 2024 Michael Steuber
-//===============================================
-// WinWinFunctions.h
-// ----------------------------------------------
-// 09/03/2024 MS-24.01.07.02 Moved all WinWin base functionality here for use with the command line and UI
-// 09/03/2024 MS-24.01.07.01 created
-//-----------------------------------------------
-// Header file for WinWin base functions
-// 
-// Contains static class WinWinFunctions which performs all window operations independent of the UI.
-// These functions can be called from anywhere and provides a method GetActiveWindows that returns 
-// a vector of HWNDS for every active window. This can be passed to any of the WinWin functions allowing
-// any window operations to occur from this class.
-
-#pragma once
-
-#include <string>
-#include <iostream>
-#include <vector>
-#include <Windows.h>
-#include "resource.h"
-#include <nlohmann/json.hpp>
-#include <fstream>
-#include <locale>
-#include <codecvt>
-#include <filesystem>
-#include <commctrl.h>
-#include <sstream>
-#include <Psapi.h>
-#include <shellapi.h>
-#include <algorithm>
-
-static class WinWinFunctions {
-public:
-
-	/**
-	 * @brief Callback function to add every active window to a vector
-	 * 
-	 * Get a pointer to the WindowHwndVector from the lParam, then check the title to make sure it isn't 
-	 * Program Manager, Windows Input Experience, Windows Shell Experience Host, the Windows Windows UI, or the Visual Studio window running Windows Windows
-	 * The first 3 are always active even when their windows are closed and they disrupt core WinWin functionality by messing up the count,
-	 * WinWin is excluded to prevent it from being impacted by itself, and Visual Studio is only excluded if it is running WinWin for my own sanity during development/
-	 * After that, it pushes back the enumerated window handle to the vector pointer
-	 * 
-	 * @param hwnd The handle to the current window in the enumeration, sort of like i in a for loop
-	 * @param lParam Contains user defined parameters
-	 * @return Success code as a BOOL
-	 */
-	static BOOL CALLBACK EnumWindowsProc(HWND hwnd, LPARAM lParam);
-
-	/**
-	 * @brief Get every active window
-	 * 
-	 * Calls EnumWindowsProc callback function to add every active HWND to a vector, then sorts the vector alphabetically by window title
-	 * 
-	 * @return Every active window as a vector of HWNDs
-	 */
-	static std::vector<HWND> GetActiveWindows();
-
-	/**
-	 * @brief Utility function to compare window titles
-	 * @param a First window to compare
-	 * @param b Second window to compare
-	 * @return True if a is first alphabetically, False if b is first
-	 */
-	//bool compareHwnd(HWND a, HWND b);
-
-	/**
-	 * @brief Stack windows vertically to fill the screen 
-	 * 
-	 * Triggered by pressing the stack button or calling the "stack" command in the command line. 
-	 * Based on the number of windows in the input vector, passes the vector to the appropriate stack function
-	 * 
-	 * @param WindowVect Vector of windows to stack
-	 */
-	static void Stack(std::vector<HWND> WindowVect);
-	void StackScroll();
-
-	/**
-	 * @brief Stack four or less windows to fill the screen. Windows are stretched to screen width.
-	 * 
-	 * For each vector in the WindowVect, restore the window, set the y position to stackPosY, set the width to the screen width, and set the height to the stackFactorY.
-	 * stackFactorY is constant through the runtime of the function and is equal to the screen height divided by the number of windows. stackPosY is incremented by the stackFactorY for each window.
-	 * 
-	 * @param WindowVector Vector of windows to stack
-	 */
-	static void StackFourOrLess(std::vector<HWND> WindowVector);
-
-	/**
-	 * @brief Stack between five and eight windows to fill the screen. The screen is split in half and windows are split as evenly as possible between both halves.
-	 * 
-	 * Variables - 
-	 * stackFactorYLeft - the height of the screen divided by half of the size of the window vector rounded up
-	 * stackFactorYRight - the height of the screen divided by half of the size of the window vector rounded down
-	 * Due to these two, the left side of the screen has stacking priority for an uneven vector size. For example, if there are 7 windows, 4 go to the left and 3 go to the right.
-	 * stackPosy - Y position of the next vector to be stacked
-	 * i - window index
-	 * For each window in the vector, the window is restored and then the following is done to split the windows:
-	 * 1. If the window index i is not more than half of the size of the vector (rounded up), the x position is set to 0, the y is set to stackPosy, the length to half the screen size, and the height to stackFactorYLeft.
-	 * 2. Increment stackPosY
-	 * 3. Increment i
-	 * 4. Repeat steps 1 through 3 until i is equal to half the size of the window vector, then reset stackPosy to 0
-	 * 5. If i is more than half the size of the vector (rounded up), set the x position to half the length of the screen, the y to stackPosy, the width to half the width of the screen, and the height to stackFactorYRight. 
-	 * 6. Increment stackPosy
-	 * 7. Repeat steps 5 and 6 until the end of the vector is reached
-	 * 
-	 * @param WindowVector Vector of windows to stack
-	 */
-	static void StackFiveToEight(std::vector<HWND> WindowVector);
-	
-	/**
-	 * @brief For vectors larger than 8, create subvectors to scroll through for multilayered stacking
-	 * 
-	 * Create a subvector with a max length of 8 starting with the index determined by winFunStackIndex, then pass the subvector to the appropriate stack function. Clears the vector on completion.
-	 * @param WindowVect Vector of windows to stack
-	 */
-	static void StackWindowsCallback(std::vector<HWND> WindowVect);
-
-	/**
-	 * @brief Arranges all windows in a cascaded view 
-	 * 
-	 * Triggered by pressing cascade button or calling "cascade" in the command line. Starting ten pixels from the top left of the screen, resize each window to a 750 pixel square 
-	 * and seperate their top left coordinate by 50 pixels down and 50 pixels to the left
-	 * 
-	 * @param WindowVect Vector of windows to cascade
-	 */
-	static void Cascade(std::vector<HWND> WindowVect);
-
-	/**
-	 * @brief Minimizes all windows not moved after a cascade
-	 * 
-	 * Run through the cascade again and if any window is in the same position as specified by the cascade formula, minimize it. 
-	 * 
-	 * @param WindowVect Vector of windows to squish
-	 */
-	static void Squish(std::vector<HWND> WindowVect);
-	
-	/**
-	 * @brief Opens a dialog box that allows user to enter text
-	 * 
-	 * Using the custom DialogBox resource in resource.h, set the entered user text to the static global userInput. Return userInput. 
-	 * 
-	 * @param hInstance hInstace of calling process
-	 * @return The user entered text as a wide string. Empty wstring as default. 
-	 */
-	static std::wstring GetUserInput(HINSTANCE hInstance);
-	
-	/**
-	 * @brief Save a window layout to a JSON file
-	 * 
-	 * 1. Open a dialog box to let the  user input a name for the layout. If the dialog box is left blank, the default name is "NewLayout"
-	 * 2. Create the file at SavedLayouts/[UserEnteredName].json. If the file already exists, delete the contents. Open the file as LayFile. 
-	 * 3. Create a WINDOWPLACEMENT object that will store details about each window's placement. Then create the nlohmann::json objects to write to the JSON file.
-	 * 4. For each window in the WindowVect, set the WINDOWPLACEMENT object with details about that particular window. If the window is minimized, reset the right, left, top, and bottom values of the WINDOWPLACEMENT to the values retrieved by GetWindowRect.
-	 *    This is done to prevent the window size from being set to 0, 0, 0, 0. GetWindowPlacement does this for minimized windows, while GetWindowRect returns the size of the restored window. 
-	 * 5. Get the name of the process running the window
-	 * 6. Store the window placement data in a temporary nlohmann::json object. In addition to the values stored in the WINDOWPLACEMENT object, the json holds the name of the process running the window, a minimized flag, the window handle, and the title of the window.
-	 * 7. Add the temporary json object to the main json object and clear the temporary object
-	 * 8. When the end of the vector is reached, dump the main JSON object into the user defined JSON file.
-	 * 
-	 * @param WindowVect Vector of windows to save
-	 */
-	static void SaveWindowLayout(std::vector<HWND> WindowVect, std::wstring presetLayoutName = L"Default");
-
-	/**
-	 * @brief Executes the layout of the specified user window layout
-	 * 
-	 * NOTE: This does not reopen windows. If the window is not open, it is skipped in the JSON. Only open windows are effected.  
-	 * Triggered by pressing a window layout button in the UI or calling "ExecuteDesktop" on the command line.
-	 *  1. Open the JSON file passed in the json parameter as LayFile after checking if it exists. This is retrieved from the text of button if triggered through the UI or the first parameter of the command line command. 
-	 *  2. Create a vector of pointers to SavedWindows (see below for SavedWindow struct) and iterate through each object in the json file creating a new SavedWindow for each object.
-	 *  3. For each window in the WindowVect, retrieve the name of the process running the window. Compare to the processes of the SavedWindows in the SavedWindows vector, and when a match is found, create a WINDOWPLACEMENT object with all of the relevant data in the SavedWindow struct.
-	 *	   Set the placement of the current window to this WINDOWPLACEMENT object.
-	 * 
-	 * @param json wide string of the name of the json file WITHOUT .json at the end or the directory at the beginning. This is the same text that the user entered when creating the layout and is retrieved from the text of the button if triggered through the UI or the first parameter of the "ExecuteLayout" command on the command line. 
-	 * @param WindowVect Vector of currently open windows to execute JSON on.
-	 */
-	static void ExecuteWindowLayout(std::wstring json, std::vector<HWND> WindowVect);
-	
-	/**
-	 * @brief Saves a desktop icon layout to a JSON file
-	 * 
-	 *  1. Open a dialog box to let the  user input a name for the layout. If the dialog box is left blank, the default name is "NewLayout"
-	 *  2. Create the file at SavedLayouts/[UserEnteredName].json. If the file already exists, delete the contents. Open the file as LayFile. 
-	 *  3. Accessing the desktop -
-	 *		This step is pretty tricky. If you are determined to understand it, be my guest, but I would reccomend skipping it lest you rip your hair out over it. 
-	 *		You need drill down into the SysListView32 control and retrieve the window handle. This is the hierarchy for it:
-	 *		Progman
-	 *		   --->SHELLDLL_DefView
-	 *					  -------->SysListView32
-	 *		Use the handle of SysListView32 to get the number of desktop icons and the process id of SysListView32, open the process to read and write. 
-	 *		Then, allocate virtual memory in the SysListView32 process for 3 objects: the LPPOINT (special windows type for pointer to a point object) of the icon, 
-	 *      a pointer to the LVITEM (list view item, recieves info about the icon), and the text of the icon as a LPWSTR (pointer to a WCHAR)
-	 *		You'll also need a WCHAR for the itemName, a POINT for the icon position, and a SIZE_T object to specify the number of bytes to read from the SysListView32 process
-	 *		Got it? Good. Now we can move on; we'll be back to these very soon. 
-	 *  4. Iterate over the number of desktop icons you retrieved in step 3: 
-	 *		- Get the position of the ith icon and store it in the virtually allocated LPPOINT. This is done by sending i as a message to SysListView32 with the LPPOINT as the wParam 
-	 *		- Read the SysListView32 process memory of the LPPOINT to the the POINT iconPos so that you can access it
-	 *		- Create an LVITEM object with the pszText attribute set to the virtually allocated LPWSTR
-	 *		- Write this new LVITEM to the virtually allocated LVITEM
-	 *		- Send a message to the SysListView32 process telling it to store the item text of the ith icon in the virtually allocated LVITEM. Now, the virtually allocated LPWSTR (itemText) contains the icon's name.
-	 *		- Read itemText (from SysListView32) into our WCHAR itemName
-	 *		After all of that, the icon position is stored in a POINT iconPos and the icon name is stored in a WCHAR itemName
-	 *		That wasn't so bad now, was it? Now back to the normal stuff for human beings.
-	 *	5. Put the icon name and position in a temporary nlohmann::json object, then add that object to the main json object and clear the temp one
-	 *  6. When we get to the end of the icon list, free all of that virtual memory we allocated earlier
-	 *	7. Dump the json object into the LayFile and close it.
-	 * 
-	 * This took a VERY long time to figure out so I hope someone out there reads it someday
-	 */
-	static void SaveDesktopLayout();
-
-	/**
-	 * @brief Executes the layout of the specified user icon layout
-	 * 
-	 * 1. Check if the JSON file passed through json exists, open it if it does
-	 * 2. Create a vector of pointers to SavedIcon structs, see SavedIcon struct below
-	 * 3. Much like SaveDesktopLayout(), we start the funky windows stuff by drilling down into SysListView32 and obtaining the window handle
-	 *	  Progman
-	 *		   --->SHELLDLL_DefView
-	 *						  -------->SysListView32
-	 *	  Use this handle to get the number of desktop icons, the process id, and the handle of the process
-	 *    Virtually allocate memory for an LPPOINT, LVITEM, and LPWSTR in the SysListView32 process
-	 *	  In addition, create a WCHAR to store the icon name, a POINT to store the icon position, a SIZE_T object to store the number of bytes to read from the SysListView32 process, and anotehr POINT for the saved icon position.
-	 * 
-	 *  4. For each item in the JSON file, add a SavedIcon struct to the SavedIcons vector, assigning the json object attributes to their corresponding SavedIcon struct attributes
-	 *	5. Also similar to SaveDesktopLayout(), iterate over the number of desktop icons we retrieved in step 3
-	 *		- Get the position of the ith icon and store it in the virtually allocated LPPOINT. This is done by sending i as a message to SysListView32 with the LPPOINT as the wParam 
-	 *		- Read the SysListView32 process memory of the LPPOINT to the the POINT iconPos so that you can access it
-	 *		- Create an LVITEM object with the pszText attribute set to the virtually allocated LPWSTR
-	 *		- Write this new LVITEM to the virtually allocated LVITEM
-	 *		- Send a message to the SysListView32 process telling it to store the item text of the ith icon in the virtually allocated LVITEM. Now, the virtually allocated LPWSTR (itemText) contains the icon's name.
-	 *		- Read itemText (from SysListView32) into our WCHAR itemName
-	 *		I'm so glad windows made this simple and easy to understand. yay.  
-	 * 6. Iterate over the vector of SavedIcons and compare the saved names to the itemName. 
-	 *	  When a match is found, send a message to SysListView32 telling it to set the item at index i to the (x,y) position in the SavedIcon struct
-	 * 7. After the loop reaches the last icon, free the virtually allocated memory and close the HANDLE to the SysListView32 process 
-	      (NOT the process itself, this will cause bad things to happen. Windows will lay a curse upon your family.)
-
-	 * @param json wide string of the name of the json file WITHOUT .json at the end or the directory at the beginning. 
-	 *		  This is the same text that the user entered when creating the layout and is retrieved from the text of the button if triggered through the UI or the first parameter of the "ExecuteDesktop" command on the command line. 
-	 */
-	static void ExecuteDesktopLayout(std::wstring json);
-
-	/**
-	 * @brief Struct to store data retrieved from a JSON file to be converted to WINDOWPLACEMENT object 
-	 */
-	static struct SavedWindow {
-		SavedWindow(std::string process,
-			std::string title,
-			HWND handle,
-			UINT flags,
-			UINT showCmd,
-			POINT ptMinPosition,
-			POINT ptMaxPosition,
-			RECT rcNormalPosition) {
-			m_process = process;
-			m_title = title;
-			m_handle = handle;
-			m_flags = flags;
-			m_showCmd = showCmd;
-			m_ptMinPosition = ptMinPosition;
-			m_ptMaxPosition = ptMaxPosition;
-			m_rcNormalPosition = rcNormalPosition;
-			moved = FALSE;
-		};
-		std::string m_process;
-		std::string m_title;
-		HWND m_handle;
-		UINT m_flags;
-		UINT m_showCmd;
-		POINT m_ptMinPosition;
-		POINT m_ptMaxPosition;
-		RECT m_rcNormalPosition;
-		bool moved;
-		WINDOWPLACEMENT* getWinPlacement() {
-			WINDOWPLACEMENT placement;
-			placement.showCmd = m_showCmd;
-			placement.flags = m_flags;
-			placement.length = sizeof(WINDOWPLACEMENT);
-			placement.ptMaxPosition = m_ptMinPosition;
-			placement.ptMaxPosition = m_ptMaxPosition;
-			placement.rcNormalPosition = m_rcNormalPosition;
-			return &placement;
-		}
-	};
-
-	/**
-	 * @brief Struct to store name and position data from a JSON file to be used to match and set icon positions
-	 */
-	struct SavedIcon {
-		SavedIcon(std::string iconName,
-			POINT iconPos) {
-			m_iconName = iconName;
-			m_iconPos = iconPos;
-		};
-		std::string m_iconName;
-		POINT m_iconPos;
-	};
-
-	/**
-	 * @brief Utility to convert wide strings to narrow strings
-	 * 
-	 * Since Win32 primarily uses wide strings and nlohmann json uses almost exclusively narrow strings, this utiltity function is used as a translation between the two libraries.
-	 * Get the size needed for the new string using WideCharToMultibyte, create a string of that size, and use WideCharToMultibyte again to write the wstring to the new string.
-	 * Then remove the null terminator from the end of the new string (WideCharToMultibyte adds one)
-	 * 
-	 * @param wstr Wide string to convert
-	 * @return Converted narrow string
-	 */
-	static std::string ConvertToNarrowString(const std::wstring& wstr) {
-		if (wstr.empty()) {
-			return std::string(); // If no wstring is provided, return an empty string
-		}
-
-		int size_needed = WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), -1, NULL, 0, NULL, NULL); // Get the size needed for the new string
-		if (size_needed == 0) {
-			throw std::runtime_error("WideCharToMultiByte failed");
-		}
-
-		std::string str(size_needed - 1, 0); // Create new string
-		int result = WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), -1, &str[0], size_needed, NULL, NULL); // And write the contents of the wstring to it
-		if (result == 0) {
-			throw std::runtime_error("WideCharToMultiByte failed");
-		}
-
-	//	str.resize(size_needed - 1); // Remove the null terminator added by WideCharToMultiByte
-
-		return str;
-	}
-};
\ No newline at end of file
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// WinWinFunctions.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.25 Added ScopedProcessCache
+// 10/19/2026 MS-24.01.08.12 SaveDesktopLayout and DiffDesktopLayout report a layout or desktop they can't open
+// 10/19/2026 MS-24.01.08.19 ProcessPathCache holds a handle to each cached process, added DesktopLayoutPath
+// 10/19/2026 MS-24.01.08.25 Added AppName, windows of slow applications are scheduled through AppLatency
+// 10/19/2026 MS-24.01.08.25 The process cache is set per thread
+// 10/19/2026 MS-24.01.08.19 The process cache is keyed by process ID and creation time
+// 10/19/2026 MS-24.01.08.15 An empty preset name, not "Default", asks for the layout name
+// 10/19/2026 MS-24.01.08.24 Include Trace
+// 10/19/2026 MS-24.01.08.22 Stack, Cascade and Squish take their geometry from LayoutPlanner, added CaptureScene
+// 10/19/2026 MS-24.01.08.21 Window and desktop operations report to CommandStats
+// 10/19/2026 MS-24.01.08.19 Added WindowLayoutPath and SetProcessCache
+// 10/19/2026 MS-24.01.08.12 SaveDesktopLayout saves incrementally and takes a preset name, added DiffDesktopLayout
+// 10/19/2026 MS-24.01.08.11 ExecuteDesktopLayout packs new icons by a sort rule
+// 10/19/2026 MS-24.01.08.10 Desktop layouts use IconLayoutSchema
+// 10/19/2026 MS-24.01.08.09 Desktop icon functions pick their backend through DesktopIconBackends
+// 10/19/2026 MS-24.01.08.08 ExecuteDesktopLayout returns the number of icons moved
+// 10/19/2026 MS-24.01.08.07 Replaced SavedIcon with IconMatcher, added ConvertToWideString
+// 10/19/2026 MS-24.01.08.06 Desktop icon functions read icons through SysListViewIcons
+// 10/19/2026 MS-24.01.08.05 Saved windows carry a normalized rect which ApplyLayoutDocument rescales to the current work area
+// 10/19/2026 MS-24.01.08.04 Added ApplyLayoutDocument
+// 10/19/2026 MS-24.01.08.03 Replaced SavedWindow with lazily decoded LayoutRecord/OpenWindow matching
+// 10/19/2026 MS-24.01.08.02 Added GetExeDirectory, GetProcessPath, and WindowToJson
+// 10/19/2026 MS-24.01.08.01 Arranging operations record the previous placement in LayoutHistory for undo/redo
+// 09/03/2024 MS-24.01.07.02 Moved all WinWin base functionality here for use with the command line and UI
+// 09/03/2024 MS-24.01.07.01 created
+//-----------------------------------------------
+// Header file for WinWin base functions
+// 
+// Contains static class WinWinFunctions which performs all window operations independent of the UI.
+// These functions can be called from anywhere and provides a method GetActiveWindows that returns 
+// a vector of HWNDS for every active window. This can be passed to any of the WinWin functions allowing
+// any window operations to occur from this class.
+
+#pragma once
+
+#include <string>
+#include <iostream>
+#include <vector>
+#include <Windows.h>
+#include "resource.h"
+#include <nlohmann/json.hpp>
+#include <fstream>
+#include <locale>
+#include <codecvt>
+#include <filesystem>
+#include <commctrl.h>
+#include <sstream>
+#include <Psapi.h>
+#include <shellapi.h>
+#include <algorithm>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include "LayoutHistory.h"
+#include "LayoutSchema.h"
+#include "NormalizedLayout.h"
+#include "DesktopIconBackends.h"
+#include "IconMatcher.h"
+#include "IconLayoutSchema.h"
+#include "IconPlacer.h"
+#include "IconDiff.h"
+#include "CommandStats.h"
+#include "LayoutPlanner.h"
+#include "Trace.h"
+#include "AppLatency.h"
+
+/**
+ * @brief GetProcessPath results by process ID, see WinWinFunctions::SetProcessCache
+ *
+ * Each entry keeps a SYNCHRONIZE handle to its process. While the handle is open the process ID can't be given to a new process, so a
+ * lookup only has to check the handle isn't signaled (the process hasn't exited) - it never opens the process again.
+ */
+class ProcessPathCache {
+public:
+	ProcessPathCache() = default;
+	~ProcessPathCache() { Clear(); }
+	ProcessPathCache(const ProcessPathCache&) = delete;
+	ProcessPathCache& operator=(const ProcessPathCache&) = delete;
+
+	/**
+	 * @brief Get the cached path of a process
+	 * @return The path, NULL if the process isn't cached or has exited since (its entry is dropped)
+	 */
+	const std::wstring* Find(DWORD processId);
+
+	/**
+	 * @brief Cache a process's path
+	 * @param process SYNCHRONIZE handle to the process, owned by the cache from here on
+	 */
+	void Add(DWORD processId, HANDLE process, const std::wstring& path);
+
+	// Drop every process that isn't in Owners, along with its handle
+	void Retain(const std::unordered_set<DWORD>& Owners);
+
+	// Drop every process
+	void Clear();
+
+	size_t Size() const { return m_Entries.size(); }
+
+private:
+	struct Entry {
+		HANDLE process;
+		std::wstring path;
+	};
+	std::unordered_map<DWORD, Entry> m_Entries;
+};
+
+static class WinWinFunctions {
+public:
+
+	/**
+	 * @brief Callback function to add every active window to a vector
+	 * 
+	 * Get a pointer to the WindowHwndVector from the lParam, then check the title to make sure it isn't 
+	 * Program Manager, Windows Input Experience, Windows Shell Experience Host, the Windows Windows UI, or the Visual Studio window running Windows Windows
+	 * The first 3 are always active even when their windows are closed and they disrupt core WinWin functionality by messing up the count,
+	 * WinWin is excluded to prevent it from being impacted by itself, and Visual Studio is only excluded if it is running WinWin for my own sanity during development/
+	 * After that, it pushes back the enumerated window handle to the vector pointer
+	 * 
+	 * @param hwnd The handle to the current window in the enumeration, sort of like i in a for loop
+	 * @param lParam Contains user defined parameters
+	 * @return Success code as a BOOL
+	 */
+	static BOOL CALLBACK EnumWindowsProc(HWND hwnd, LPARAM lParam);
+
+	/**
+	 * @brief Get every active window
+	 * 
+	 * Calls EnumWindowsProc callback function to add every active HWND to a vector, then sorts the vector alphabetically by window title
+	 * 
+	 * @return Every active window as a vector of HWNDs
+	 */
+	static std::vector<HWND> GetActiveWindows();
+
+	/**
+	 * @brief Utility function to compare window titles
+	 * @param a First window to compare
+	 * @param b Second window to compare
+	 * @return True if a is first alphabetically, False if b is first
+	 */
+	//bool compareHwnd(HWND a, HWND b);
+
+	/**
+	 * @brief Stack windows vertically to fill the screen 
+	 * 
+	 * Triggered by pressing the stack button or calling the "stack" command in the command line. 
+	 * Based on the number of windows in the input vector, passes the vector to the appropriate stack function.
+	 * The previous placement of every window is recorded in LayoutHistory first so the stack can be undone.
+	 * 
+	 * @param WindowVect Vector of windows to stack
+	 */
+	static void Stack(std::vector<HWND> WindowVect);
+	void StackScroll();
+
+	/**
+	 * @brief Stack four or less windows to fill the screen. Windows are stretched to screen width.
+	 * 
+	 * The rects come from LayoutPlanner::StackRects, the same ones a --plan dry run reports.
+	 * For each vector in the WindowVect, restore the window, set the y position to stackPosY, set the width to the screen width, and set the height to the stackFactorY.
+	 * stackFactorY is constant through the runtime of the function and is equal to the screen height divided by the number of windows. stackPosY is incremented by the stackFactorY for each window.
+	 * 
+	 * @param WindowVector Vector of windows to stack
+	 */
+	static void StackFourOrLess(std::vector<HWND> WindowVector);
+
+	/**
+	 * @brief Stack between five and eight windows to fill the screen. The screen is split in half and windows are split as evenly as possible between both halves.
+	 * 
+	 * Variables - 
+	 * stackFactorYLeft - the height of the screen divided by half of the size of the window vector rounded up
+	 * stackFactorYRight - the height of the screen divided by half of the size of the window vector rounded down
+	 * Due to these two, the left side of the screen has stacking priority for an uneven vector size. For example, if there are 7 windows, 4 go to the left and 3 go to the right.
+	 * stackPosy - Y position of the next vector to be stacked
+	 * i - window index
+	 * For each window in the vector, the window is restored and then the following is done to split the windows:
+	 * 1. If the window index i is not more than half of the size of the vector (rounded up), the x position is set to 0, the y is set to stackPosy, the length to half the screen size, and the height to stackFactorYLeft.
+	 * 2. Increment stackPosY
+	 * 3. Increment i
+	 * 4. Repeat steps 1 through 3 until i is equal to half the size of the window vector, then reset stackPosy to 0
+	 * 5. If i is more than half the size of the vector (rounded up), set the x position to half the length of the screen, the y to stackPosy, the width to half the width of the screen, and the height to stackFactorYRight. 
+	 * 6. Increment stackPosy
+	 * 7. Repeat steps 5 and 6 until the end of the vector is reached
+	 * The rects come from LayoutPlanner::StackRects, the same ones a --plan dry run reports.
+	 * 
+	 * @param WindowVector Vector of windows to stack
+	 */
+	static void StackFiveToEight(std::vector<HWND> WindowVector);
+	
+	/**
+	 * @brief For vectors larger than 8, create subvectors to scroll through for multilayered stacking
+	 * 
+	 * Create a subvector with a max length of 8 starting with the index determined by winFunStackIndex, then pass the subvector to the appropriate stack function. Clears the vector on completion.
+	 * @param WindowVect Vector of windows to stack
+	 */
+	static void StackWindowsCallback(std::vector<HWND> WindowVect);
+
+	/**
+	 * @brief Arranges all windows in a cascaded view 
+	 * 
+	 * Triggered by pressing cascade button or calling "cascade" in the command line. Starting ten pixels from the top left of the screen, resize each window to a 750 pixel square 
+	 * and seperate their top left coordinate by 50 pixels down and 50 pixels to the left
+	 * The rects come from LayoutPlanner::CascadeRects, the same ones a --plan dry run reports.
+	 * 
+	 * @param WindowVect Vector of windows to cascade
+	 */
+	static void Cascade(std::vector<HWND> WindowVect);
+
+	/**
+	 * @brief Minimizes all windows not moved after a cascade
+	 * 
+	 * Run through the cascade again and if any window is in the same position as specified by the cascade formula, minimize it. 
+	 * 
+	 * @param WindowVect Vector of windows to squish
+	 */
+	static void Squish(std::vector<HWND> WindowVect);
+	
+	/**
+	 * @brief Opens a dialog box that allows user to enter text
+	 * 
+	 * Using the custom DialogBox resource in resource.h, set the entered user text to the static global userInput. Return userInput. 
+	 * 
+	 * @param hInstance hInstace of calling process
+	 * @return The user entered text as a wide string. Empty wstring as default. 
+	 */
+	static std::wstring GetUserInput(HINSTANCE hInstance);
+	
+	/**
+	 * @brief Get the directory Windows_Windows.exe is running from
+	 * 
+	 * Layout folders are always resolved relative to the executable so that command line calls work from any working directory.
+	 * 
+	 * @return Directory of the executable without a trailing slash
+	 */
+	static std::wstring GetExeDirectory();
+
+	/**
+	 * @brief Get the full path of the executable that owns a window
+	 * @param ctrl Window to look up
+	 * @return Path of the owning process, empty if the process can't be opened
+	 */
+	static std::wstring GetProcessPath(HWND ctrl);
+
+	/**
+	 * @brief Serve GetProcessPath from a cache keyed by process ID
+	 *
+	 * A process's path never changes, so a long running caller (the resident service, see WinWinService.h) can skip reading the path
+	 * of every process it has seen before. A hit is a map lookup and a zero timeout wait on the handle the entry holds, no process is
+	 * opened, and the held handle keeps a new process from reusing the ID while the entry exists. The caller owns the cache and can
+	 * drop processes whose windows are gone with ProcessPathCache::Retain.
+	 * The cache is set for the calling thread only and never leaks into GetProcessPath calls on other threads. LayoutSnapshotter sets
+	 * its own, commands and worker jobs get one for their duration through ScopedProcessCache.
+	 *
+	 * @param cache Cache to read and fill on this thread, NULL to look every process up again
+	 * @return The cache this thread had before, so a caller can put it back
+	 */
+	static ProcessPathCache* SetProcessCache(ProcessPathCache* cache);
+
+	/**
+	 * @brief Get the application a window's latency is recorded under, see AppLatency::AppName
+	 * @return Executable file name in lower case, empty if the process can't be opened
+	 */
+	static std::string AppName(HWND ctrl);
+
+	/**
+	 * @brief Record the windows and monitors a plan is worked out against
+	 * 
+	 * Reads each window's rect, title, process and min/max state, every monitor's bounds and work area, and the primary screen size.
+	 * Nothing is moved. The result is what `RecordWindows` writes to a file and what `--plan` plans against (see LayoutPlanner.h).
+	 * 
+	 * @param WindowVect Windows to record, in GetActiveWindows order
+	 * @return Scene of the current desktop
+	 */
+	static WindowScene CaptureScene(const std::vector<HWND>& WindowVect);
+
+	/**
+	 * @brief Convert the current placement of a window to a layout JSON object
+	 * 
+	 * Produces the same object SaveWindowLayout writes for each window (process, minimized, handle, title, and the WINDOWPLACEMENT fields).
+	 * If the window isn't minimized, rcNormalPosition is replaced with the GetWindowRect result, see SaveWindowLayout step 4.
+	 * rcNormalPosition is also stored as "normalized", relative to the work area of the monitor it's on (see NormalizedLayout.h).
+	 * 
+	 * @param ctrl Window to convert
+	 * @param processPath Path of the process that owns the window, see GetProcessPath
+	 * @return Layout JSON object for the window
+	 */
+	static nlohmann::json WindowToJson(HWND ctrl, const std::wstring& processPath);
+
+	/**
+	 * @brief Save a window layout to a JSON file
+	 * 
+	 * 1. If presetLayoutName is empty, open a dialog box to let the  user input a name for the layout. If the dialog box is left blank, the default name is "NewLayout"
+	 * 2. Create the file at SavedLayouts/[UserEnteredName].json. If the file already exists, delete the contents. Open the file as LayFile. 
+	 * 3. Create a WINDOWPLACEMENT object that will store details about each window's placement. Then create the nlohmann::json objects to write to the JSON file.
+	 * 4. For each window in the WindowVect, set the WINDOWPLACEMENT object with details about that particular window. If the window is minimized, reset the right, left, top, and bottom values of the WINDOWPLACEMENT to the values retrieved by GetWindowRect.
+	 *    This is done to prevent the window size from being set to 0, 0, 0, 0. GetWindowPlacement does this for minimized windows, while GetWindowRect returns the size of the restored window. 
+	 * 5. Get the name of the process running the window
+	 * 6. Store the window placement data in a temporary nlohmann::json object. In addition to the values stored in the WINDOWPLACEMENT object, the json holds the name of the process running the window, a minimized flag, the window handle, and the title of the window.
+	 * 7. Add the temporary json object to the main json object and clear the temporary object
+	 * 8. When the end of the vector is reached, dump the main JSON object into the user defined JSON file.
+	 * 
+	 * @param WindowVect Vector of windows to save
+	 * @param presetLayoutName Name of the layout, empty to ask for one. Only ask from a thread with a message loop, see SaveDesktopLayout.
+	 */
+	static void SaveWindowLayout(std::vector<HWND> WindowVect, std::wstring presetLayoutName = L"");
+
+	/**
+	 * @brief Executes the layout of the specified user window layout
+	 * 
+	 * NOTE: This does not reopen windows. If the window is not open, it is skipped in the JSON. Only open windows are effected.  
+	 * Triggered by pressing a window layout button in the UI or calling "ExecuteDesktop" on the command line.
+	 *  1. Load the JSON file passed in the json parameter through LayoutSchema::Load after checking if it exists. This migrates files saved by older versions in memory. 
+	 *     The name is retrieved from the text of button if triggered through the UI or the first parameter of the command line command. 
+	 *  2. Wrap every saved window in a LayoutRecord (see LayoutSchema.h) and every open window in an OpenWindow (see below). Neither decodes anything up front.
+	 *  3. For each saved window, look for an unclaimed open window with the same handle, then the same title, then the same process. Each pass only decodes the field it compares.
+	 *	   When a match is found, decode the saved WINDOWPLACEMENT and queue it for the open window.
+	 *  4. Apply every queued placement in one batch (see LayoutHistory::ApplyPlacements).
+	 *  The previous placement of every open window is recorded in LayoutHistory before anything is moved so the layout can be undone.
+	 * 
+	 * @param json wide string of the name of the json file WITHOUT .json at the end or the directory at the beginning. This is the same text that the user entered when creating the layout and is retrieved from the text of the button if triggered through the UI or the first parameter of the "ExecuteLayout" command on the command line. 
+	 * @param WindowVect Vector of currently open windows to execute JSON on.
+	 */
+	static void ExecuteWindowLayout(std::wstring json, std::vector<HWND> WindowVect);
+
+	/**
+	 * @brief Get the file a saved window layout is stored in
+	 * @param json Name of the layout, as passed to ExecuteWindowLayout
+	 * @return Full path of SavedLayouts/[json].json next to the executable
+	 */
+	static std::wstring WindowLayoutPath(std::wstring json);
+
+	/**
+	 * @brief Get the file a saved desktop icon layout is stored in
+	 * @param json Name of the layout, as passed to ExecuteDesktopLayout
+	 * @return Full path of SavedDesktopLayouts/[json].json next to the executable, whatever the working directory is
+	 */
+	static std::wstring DesktopLayoutPath(std::wstring json);
+
+	/**
+	 * @brief Match the windows of a loaded layout document to the open windows and move them
+	 * 
+	 * Steps 2 and 3 of ExecuteWindowLayout, for callers that already have the document (workspace profiles, snapshots).
+	 * Once matching is finished, windows saved with a normalized rect are scaled onto the work area of the monitor nearest their
+	 * saved rect in one NormalizedLayout::Rescale pass, so a layout saved at another resolution still fills the same part of the screen.
+	 * Every matched placement is then applied in a single LayoutHistory::ApplyPlacements batch.
+	 * 
+	 * @param Doc Layout document at the current schema version, see LayoutSchema::Load
+	 * @param WindowVect Vector of currently open windows to execute the layout on
+	 */
+	static void ApplyLayoutDocument(const nlohmann::json& Doc, std::vector<HWND> WindowVect);
+	
+	/**
+	 * @brief Saves a desktop icon layout to a JSON file
+	 * 
+	 *  1. If no name is given, open a dialog box to let the user input a name for the layout
+	 *  2. The layout is written to SavedDesktopLayouts/[UserEnteredName].json next to the executable, see DesktopLayoutPath
+	 *  3. Accessing the desktop -
+	 *		DesktopIconBackends::Open first tries the desktop's IFolderView (see ShellFolderViewIcons.h), which reads and moves icons over COM
+	 *		without touching Explorer's memory. If that isn't available it falls back to the list view backend below.
+	 *		The icons live in Explorer's SysListView32 control, found by drilling down the window hierarchy:
+	 *		Progman
+	 *		   --->SHELLDLL_DefView
+	 *					  -------->SysListView32
+	 *		List view messages that return data need a buffer inside Explorer, so SysListViewIcons (see SysListViewIcons.h) allocates one region
+	 *		in Explorer with a slot for every icon's position, LVITEM and name, sends the position and text messages into the slots, and reads
+	 *		every slot back with a single ReadProcessMemory.
+	 *  4. Convert each icon to an IconRecord with a UTF-8 name and integer coordinates
+	 *	5. Write the records with IconLayoutSchema::SaveIncremental (see IconLayoutSchema.h for the file format). If the layout already exists,
+	 *	   only the icons added, removed or moved since it was last saved are appended to its change journal, and nothing at all is written
+	 *	   if the desktop hasn't changed. A layout that exists but can't be loaded (written by a newer WinWin, damaged) is left as it is.
+	 * 
+	 * This took a VERY long time to figure out so I hope someone out there reads it someday
+	 * 
+	 * @param presetLayoutName Name of the layout. If it's empty, the user is asked for one with a dialog, so only pass it empty from a thread
+	 *        with a message loop; WindowsApp asks on the UI thread before posting the save to its worker.
+	 * @return False if the desktop couldn't be opened or the existing layout couldn't be loaded, in which case nothing was written
+	 */
+	static bool SaveDesktopLayout(std::wstring presetLayoutName = L"");
+
+	/**
+	 * @brief Compare the desktop to a saved icon layout without writing anything
+	 * 
+	 * @param json Name of the desktop layout, as for ExecuteDesktopLayout
+	 * @return Icons added, removed and moved since the layout was saved. Nothing if the layout doesn't exist or can't be loaded, or the
+	 *         desktop can't be opened, so a failure is never mistaken for a desktop that hasn't drifted.
+	 */
+	static std::optional<IconDiff> DiffDesktopLayout(std::wstring json);
+
+	/**
+	 * @brief Executes the layout of the specified user icon layout
+	 * 
+	 * 1. Check if the JSON file passed through json exists and load it with IconLayoutSchema::Load. Files saved with string coordinates are migrated as they load.
+	 * 2. Open the desktop through DesktopIconBackends, see SaveDesktopLayout() step 3
+	 * 3. Convert every saved icon name to a wide string once and index the saved icons by name in an IconMatcher (see IconMatcher.h)
+	 * 4. Read the name and position of every desktop icon in one bulk read
+	 * 5. Plan the moves: each desktop icon is looked up in the IconMatcher and sent back to its saved (x,y) position. Icons that aren't
+	 *	  in the layout stay where they are unless pack is given, in which case an IconPlacer (see IconPlacer.h) packs them into the
+	 *	  free grid cells of the monitors' work areas in that order. Icons with duplicate names are told apart by their saved index and
+	 *	  position. Icons already in place aren't moved.
+	 * 6. Move the collected icons as one batch (one SelectAndPositionItems call, or redraw suspended on the list view backend), so the desktop repaints once
+	 *	  and icons that are already in place aren't touched at all.
+
+	 * @param json wide string of the name of the json file WITHOUT .json at the end or the directory at the beginning. 
+	 *		  This is the same text that the user entered when creating the layout and is retrieved from the text of the button if triggered through the UI or the first parameter of the "ExecuteDesktop" command on the command line. 
+	 * @param pack Order to pack icons that aren't in the layout in, nullopt to leave them where they are
+	 * @param snap Snap restored icons to the nearest grid cell instead of their exact saved pixels
+	 * @return Number of icons that actually moved
+	 */
+	static int ExecuteDesktopLayout(std::wstring json, std::optional<IconSortRule> pack = std::nullopt, bool snap = false);
+
+	/**
+	 * @brief An open window being matched against a saved layout
+	 * 
+	 * The title and process path are only looked up the first time a matching pass asks for them, then cached for the rest of the layout.
+	 * claimed is set once a saved window has been applied to it so two saved windows can't both land on the same open window.
+	 */
+	struct OpenWindow {
+		HWND hwnd;
+		bool claimed = FALSE;
+		std::optional<std::string> title;
+		std::optional<std::string> process;
+
+		// Window title as UTF-8
+		const std::string& Title();
+
+		// Process path as UTF-8
+		const std::string& Process();
+	};
+
+	/**
+	 * @brief Queue the placement of a saved window for an open window
+	 * 
+	 * Decodes the saved WINDOWPLACEMENT (see LayoutRecord::GetPlacement), adds it to the batch for the open window, and marks both as used.
+	 * 
+	 * @param open Open window to move
+	 * @param window Saved window to take the placement from
+	 * @param Batch Placements applied together once matching is finished
+	 * @param Rescale Receives the batch index and normalized rect of the window if it was saved with one
+	 */
+	static void ApplySavedPlacement(OpenWindow& open, LayoutRecord& window, std::vector<LayoutHistory::CapturedPlacement>& Batch, NormalizedLayout::RescaleBatch& Rescale);
+
+	/**
+	 * @brief Read every desktop icon as an IconRecord with a UTF-8 name
+	 */
+	static std::vector<IconRecord> ReadIconRecords(IconListView& Desktop);
+
+	/**
+	 * @brief Utility to convert wide strings to narrow strings
+	 * 
+	 * Since Win32 primarily uses wide strings and nlohmann json uses almost exclusively narrow strings, this utiltity function is used as a translation between the two libraries.
+	 * Get the size needed for the new string using WideCharToMultibyte, create a string of that size, and use WideCharToMultibyte again to write the wstring to the new string.
+	 * Then remove the null terminator from the end of the new string (WideCharToMultibyte adds one)
+	 * 
+	 * @param wstr Wide string to convert
+	 * @return Converted narrow string
+	 */
+	static std::string ConvertToNarrowString(const std::wstring& wstr) {
+		if (wstr.empty()) {
+			return std::string(); // If no wstring is provided, return an empty string
+		}
+
+		int size_needed = WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), -1, NULL, 0, NULL, NULL); // Get the size needed for the new string
+		if (size_needed == 0) {
+			throw std::runtime_error("WideCharToMultiByte failed");
+		}
+
+		std::string str(size_needed - 1, 0); // Create new string
+		int result = WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), -1, &str[0], size_needed, NULL, NULL); // And write the contents of the wstring to it
+		if (result == 0) {
+			throw std::runtime_error("WideCharToMultiByte failed");
+		}
+
+	//	str.resize(size_needed - 1); // Remove the null terminator added by WideCharToMultiByte
+
+		return str;
+	}
+
+	/**
+	 * @brief Utility to convert UTF-8 narrow strings to wide strings, the reverse of ConvertToNarrowString
+	 * 
+	 * @param str Narrow string to convert
+	 * @return Converted wide string
+	 */
+	static std::wstring ConvertToWideString(const std::string& str) {
+		if (str.empty()) {
+			return std::wstring();
+		}
+
+		int size_needed = MultiByteToWideChar(CP_UTF8, 0, str.c_str(), (int)str.size(), NULL, 0); // Explicit length, so no null terminator to strip
+		if (size_needed == 0) {
+			throw std::runtime_error("MultiByteToWideChar failed");
+		}
+
+		std::wstring wstr(size_needed, 0);
+		MultiByteToWideChar(CP_UTF8, 0, str.c_str(), (int)str.size(), &wstr[0], size_needed);
+		return wstr;
+	}
+
+private:
+
+	// Set by SetProcessCache, per thread
+	static thread_local ProcessPathCache* s_ProcessCache;
+};
+
+/**
+ * @brief Gives the calling thread a ProcessPathCache for one scope, unless it already has one
+ *
+ * A command enumerates the windows and then arranges them, and both look up each window's application. With one cache around the
+ * whole command each process is opened once. A thread that already has a longer lived cache (the service, a snapshot) keeps it.
+ */
+class ScopedProcessCache {
+public:
+	ScopedProcessCache();
+	~ScopedProcessCache();
+	ScopedProcessCache(const ScopedProcessCache&) = delete;
+	ScopedProcessCache& operator=(const ScopedProcessCache&) = delete;
+
+private:
+	ProcessPathCache m_Cache;
+	ProcessPathCache* m_Previous;
+};
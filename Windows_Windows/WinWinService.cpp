@@ -0,0 +1,142 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// WinWinService.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.19 Processes are dropped from the path cache through ProcessPathCache::Retain, no working directory change
+// 10/19/2026 MS-24.01.08.19 Process paths are cached by process ID and creation time
+// 10/19/2026 MS-24.01.08.20 The window registry is a WindowSnapshot
+// 10/19/2026 MS-24.01.08.19 created
+//-----------------------------------------------
+// Source code for the resident WinWin service
+//
+// Defines functions for class WinWinService. See WinWinService.h for what's cached and when it's refreshed.
+
+#include "WinWinService.h"
+#include "WinWinFunctions.h"
+#include <stdio.h>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+
+WindowSnapshot WinWinService::s_Registry(SERVICE_REGISTRY_MAX_AGE_MS);
+ProcessPathCache WinWinService::s_ProcessPaths;
+std::unordered_map<std::wstring, WinWinService::CachedLayout> WinWinService::s_Layouts;
+DWORD WinWinService::s_LoopThread = 0;
+
+int WinWinService::Run() {
+    if (!CommandChannel::Listen()) {
+        printf("A WinWin service is already running\n");
+        return 1;
+    }
+    s_LoopThread = GetCurrentThreadId();
+
+    // Out of context hooks are delivered through this thread's message loop. Windows that close or hide are filtered out of the
+    // registry without an enumeration, so only windows appearing or being renamed make it stale.
+    HWINEVENTHOOK showHook = SetWinEventHook(EVENT_OBJECT_SHOW, EVENT_OBJECT_SHOW, NULL, OnWinEvent, 0, 0, WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+    HWINEVENTHOOK nameHook = SetWinEventHook(EVENT_OBJECT_NAMECHANGE, EVENT_OBJECT_NAMECHANGE, NULL, OnWinEvent, 0, 0, WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+
+    std::thread listener([] {
+        WinWinFunctions::SetProcessCache(&s_ProcessPaths);
+        for (HWND ctrl : Windows()) { // Warm everything before the first command arrives
+            WinWinFunctions::GetProcessPath(ctrl);
+        }
+        WarmLayouts();
+        CommandChannel::Serve(Handle);
+        WinWinFunctions::SetProcessCache(NULL);
+    });
+
+    MSG msg;
+    while (GetMessage(&msg, NULL, 0, 0) > 0) {
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+    }
+
+    CommandChannel::Stop(); // Already stopped if the loop ended because of `Service stop`
+    listener.join();
+    if (showHook != NULL) {
+        UnhookWinEvent(showHook);
+    }
+    if (nameHook != NULL) {
+        UnhookWinEvent(nameHook);
+    }
+    return 0;
+}
+
+CommandReply WinWinService::Handle(const std::vector<std::string>& args) {
+    CommandReply reply;
+    if (args.size() > 1 && args[0] == "Service" && args[1] == "stop") {
+        CommandChannel::Stop();
+        PostThreadMessage(s_LoopThread, WM_QUIT, 0, 0);
+        reply.output = "WinWin service stopped\n";
+        return reply;
+    }
+    std::ostringstream out;
+    reply.status = WinWinCommands::Execute(args, out, Environment());
+    if (reply.status == COMMAND_NOT_FOUND) {
+        out << "Unknown command" << (args.empty() ? std::string() : " " + args[0]) << "\n";
+        reply.status = 1;
+    }
+    reply.output = out.str();
+    return reply;
+}
+
+CommandEnvironment WinWinService::Environment() {
+    CommandEnvironment environment;
+    environment.Windows = Windows;
+    environment.LoadLayout = LoadLayout;
+    environment.Invalidate = [] { s_Registry.Invalidate(); };
+    return environment;
+}
+
+std::vector<HWND> WinWinService::Windows() {
+    size_t enumerations = s_Registry.Enumerations();
+    const std::vector<HWND>& Windows = s_Registry.Windows();
+    if (s_Registry.Enumerations() != enumerations) {
+        std::unordered_set<DWORD> Owners; // Drop the paths of processes that have no windows left, their IDs can be reused
+        DWORD processId;
+        for (HWND ctrl : Windows) {
+            GetWindowThreadProcessId(ctrl, &processId);
+            Owners.insert(processId);
+        }
+        s_ProcessPaths.Retain(Owners);
+    }
+    return Windows;
+}
+
+nlohmann::json WinWinService::LoadLayout(const std::wstring& path) {
+    std::error_code error;
+    std::filesystem::file_time_type written = std::filesystem::last_write_time(path, error);
+    uintmax_t size = (error ? 0 : std::filesystem::file_size(path, error));
+    if (error) {
+        s_Layouts.erase(path);
+        return nlohmann::json::object(); // Same as LayoutSchema::Load for a missing file
+    }
+    auto cached = s_Layouts.find(path);
+    if (cached != s_Layouts.end() && cached->second.written == written && cached->second.size == size) {
+        return cached->second.Doc;
+    }
+    nlohmann::json Doc = LayoutSchema::Load(path);
+    s_Layouts[path] = { written, size, Doc };
+    return Doc;
+}
+
+void WinWinService::WarmLayouts() {
+    std::error_code error;
+    for (const auto& file : std::filesystem::directory_iterator(WinWinFunctions::GetExeDirectory() + L"/SavedLayouts", error)) {
+        if (file.path().extension() == L".json") {
+            LoadLayout(WinWinFunctions::WindowLayoutPath(file.path().stem().wstring())); // Same key ExecuteLayout looks it up by
+        }
+    }
+}
+
+void CALLBACK WinWinService::OnWinEvent(HWINEVENTHOOK hook, DWORD event, HWND hwnd, LONG idObject, LONG idChild, DWORD thread, DWORD time) {
+    if (idObject != OBJID_WINDOW || idChild != CHILDID_SELF || hwnd == NULL) {
+        return; // Carets, cursors, menus, controls inside windows
+    }
+    if (GetAncestor(hwnd, GA_PARENT) != GetDesktopWindow()) {
+        return; // Only top level windows are in the registry
+    }
+    s_Registry.Invalidate();
+}
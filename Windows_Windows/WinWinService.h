@@ -0,0 +1,107 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// WinWinService.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.19 Cached processes are held open instead of keyed on their creation time
+// 10/19/2026 MS-24.01.08.19 Process paths are cached by process ID and creation time
+// 10/19/2026 MS-24.01.08.20 The window registry is a WindowSnapshot
+// 10/19/2026 MS-24.01.08.19 created
+//-----------------------------------------------
+// Header file for the resident WinWin service
+//
+// Contains class WinWinService, which runs `WinWin Service`: a windowless WinWin process that stays running and answers commands from
+// the command line (see WinWinCommands::Run and CommandChannel.h) out of three warm caches:
+//   Window registry - a WindowSnapshot. WinEvent hooks invalidate it whenever a top level window is shown or renamed, and it's
+//                     enumerated again on the next command that needs it. Windows that closed, hid or hung are filtered out without an
+//                     enumeration. It's also enumerated again if it's older than SERVICE_REGISTRY_MAX_AGE_MS, to pick up windows that
+//                     started responding again.
+//   Process paths   - GetProcessPath results by process ID (see WinWinFunctions::SetProcessCache). Each entry holds a handle to its
+//                     process, so a hit opens nothing and a process ID can't be reused under it. Processes that no longer own any
+//                     listed window are dropped each time the registry is enumerated.
+//   Saved layouts   - parsed, migrated window layout documents by path, reparsed when the file's size or write time changes.
+// The hooks are serviced by the message loop on the thread that called Run. Commands run one at a time on the listener thread, which
+// is the only thread that touches the caches, so nothing here needs a lock (WindowSnapshot::Invalidate is safe from the hook).
+// The service is opt in. With no service listening, the command line runs every command in its own process exactly as before.
+
+#pragma once
+
+#include <Windows.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <filesystem>
+#include <nlohmann/json.hpp>
+#include "CommandChannel.h"
+#include "WinWinCommands.h"
+#include "WindowSnapshot.h"
+#include "WinWinFunctions.h"
+
+// Longest the service trusts its window registry without enumerating again
+#define SERVICE_REGISTRY_MAX_AGE_MS 30000
+
+class WinWinService {
+public:
+
+	/**
+	 * @brief Run the service until `WinWin Service stop`
+	 * @return Exit status, 1 if another service is already running in this session
+	 */
+	static int Run();
+
+private:
+
+	/**
+	 * @brief A parsed layout and the file state it was parsed from
+	 */
+	struct CachedLayout {
+		std::filesystem::file_time_type written;
+		uintmax_t size;
+		nlohmann::json Doc;
+	};
+
+	/**
+	 * @brief Run one command from a client, on the listener thread
+	 */
+	static CommandReply Handle(const std::vector<std::string>& args);
+
+	/**
+	 * @brief Environment that answers from the caches
+	 */
+	static CommandEnvironment Environment();
+
+	/**
+	 * @brief Get the open windows from the registry, and drop cached process paths whenever it enumerates
+	 */
+	static std::vector<HWND> Windows();
+
+	/**
+	 * @brief Get a saved layout from the cache, parsing it if it's new or has changed
+	 * @param path Full path of the layout file
+	 * @return Layout document, an empty object if the file doesn't exist
+	 */
+	static nlohmann::json LoadLayout(const std::wstring& path);
+
+	/**
+	 * @brief Parse every saved window layout so the first ExecuteLayout of each is already warm
+	 */
+	static void WarmLayouts();
+
+	/**
+	 * @brief WinEvent hook, marks the registry stale when a top level window is shown or renamed
+	 */
+	static void CALLBACK OnWinEvent(HWINEVENTHOOK hook, DWORD event, HWND hwnd, LONG idObject, LONG idChild, DWORD thread, DWORD time);
+
+	// Window registry, invalidated by the hooks
+	static WindowSnapshot s_Registry;
+
+	// Process paths by process ID, handed to WinWinFunctions::SetProcessCache
+	static ProcessPathCache s_ProcessPaths;
+
+	// Parsed window layouts by path
+	static std::unordered_map<std::wstring, CachedLayout> s_Layouts;
+
+	// Thread running the message loop, told to quit by `WinWin Service stop`
+	static DWORD s_LoopThread;
+};
@@ -0,0 +1,97 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// WindowListModel.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.13 created
+//-----------------------------------------------
+// Source code for the active window list row model
+//
+// Defines functions for class WindowListModel. See WindowListModel.h.
+
+#include "WindowListModel.h"
+#include <algorithm>
+
+// Action rectangles relative to the top left of a row, same layout as the old per-window control panels
+static const ListRect TitleRect = { 10, 10, 270, 40 };
+static const ListRect MinimizeRect = { 10, 50, 80, 80 };
+static const ListRect MaximizeRect = { 85, 50, 155, 80 };
+static const ListRect CloseRect = { 160, 50, 230, 80 };
+
+void WindowListModel::SetRows(std::vector<WindowListRow> Rows) {
+    m_rows = std::move(Rows);
+    SetScroll(m_scroll); // The list may have shrunk under the current offset
+}
+
+void WindowListModel::SetViewport(int width, int height) {
+    m_width = std::max(0, width);
+    m_height = std::max(0, height);
+    SetScroll(m_scroll);
+}
+
+bool WindowListModel::SetScroll(int offset) {
+    int maxScroll = std::max(0, ContentHeight() - m_height);
+    offset = std::clamp(offset, 0, maxScroll);
+    if (offset == m_scroll) {
+        return false;
+    }
+    m_scroll = offset;
+    return true;
+}
+
+void WindowListModel::VisibleRows(size_t& first, size_t& last) const {
+    first = std::min(m_rows.size(), (size_t)(m_scroll / WINDOW_LIST_ROW_HEIGHT));
+    last = std::min(m_rows.size(), (size_t)((m_scroll + m_height + WINDOW_LIST_ROW_HEIGHT - 1) / WINDOW_LIST_ROW_HEIGHT)); // Round up to include a partly visible last row
+    if (last < first) {
+        last = first;
+    }
+}
+
+ListRect WindowListModel::RowRect(size_t row) const {
+    int top = (int)row * WINDOW_LIST_ROW_HEIGHT - m_scroll;
+    return { 0, top, m_width, top + WINDOW_LIST_ROW_HEIGHT };
+}
+
+ListRect WindowListModel::ActionRect(size_t row, WindowListAction action) const {
+    ListRect rowRect = RowRect(row);
+    ListRect local;
+    switch (action) {
+    case WindowListAction::Title:
+        local = TitleRect;
+        local.right = std::max(local.left, std::min(local.right, m_width - 10)); // Narrow lists truncate the title instead of overflowing
+        break;
+    case WindowListAction::Minimize:
+        local = MinimizeRect;
+        break;
+    case WindowListAction::Maximize:
+        local = MaximizeRect;
+        break;
+    case WindowListAction::Close:
+        local = CloseRect;
+        break;
+    default:
+        return rowRect;
+    }
+    return { rowRect.left + local.left, rowRect.top + local.top, rowRect.left + local.right, rowRect.top + local.bottom };
+}
+
+WindowListHit WindowListModel::HitTest(int x, int y) const {
+    WindowListHit hit;
+    if (x < 0 || x >= m_width || y < 0 || y >= m_height) {
+        return hit;
+    }
+    int row = (y + m_scroll) / WINDOW_LIST_ROW_HEIGHT; // Rows are a fixed height, so the row is a division away
+    if (row >= (int)m_rows.size()) {
+        return hit;
+    }
+    hit.row = row;
+    hit.action = WindowListAction::Row;
+    for (WindowListAction action : { WindowListAction::Minimize, WindowListAction::Maximize, WindowListAction::Close }) {
+        if (ActionRect(row, action).Contains(x, y)) {
+            hit.action = action;
+            break;
+        }
+    }
+    return hit;
+}
@@ -0,0 +1,132 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// WindowListModel.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.13 created
+//-----------------------------------------------
+// Header file for the active window list row model
+//
+// Contains class WindowListModel which holds the rows of the active window list and does all of its geometry: the scroll offset,
+// which rows intersect the viewport, where each row's title and minimize/maximize/close actions are, and which action a point hits.
+// WindowListView paints and clicks from it, so the list costs O(visible rows) however many windows are open.
+// Like IconListView.h, it has no Windows dependencies.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Height of one row in the window list
+#define WINDOW_LIST_ROW_HEIGHT 100
+
+/**
+ * @brief Part of a row
+ */
+enum class WindowListAction {
+	None,      // Outside every row
+	Row,       // Inside a row but not on a button
+	Title,
+	Minimize,
+	Maximize,
+	Close
+};
+
+/**
+ * @brief Rectangle in list coordinates, right and bottom exclusive
+ */
+struct ListRect {
+	int left;
+	int top;
+	int right;
+	int bottom;
+	bool Contains(int x, int y) const { return x >= left && x < right && y >= top && y < bottom; }
+};
+
+/**
+ * @brief One window in the list
+ */
+struct WindowListRow {
+	std::uintptr_t handle;  // HWND of the window
+	std::wstring title;
+};
+
+/**
+ * @brief Result of a hit test
+ */
+struct WindowListHit {
+	int row = -1;  // -1 if the point isn't on a row
+	WindowListAction action = WindowListAction::None;
+	bool operator==(const WindowListHit& other) const { return row == other.row && action == other.action; }
+};
+
+class WindowListModel {
+public:
+
+	/**
+	 * @brief Replace every row and clamp the scroll offset to the new content height
+	 * @param Rows Rows in display order
+	 */
+	void SetRows(std::vector<WindowListRow> Rows);
+
+	size_t Size() const { return m_rows.size(); }
+	const WindowListRow& Row(size_t row) const { return m_rows[row]; }
+
+	/**
+	 * @brief Set the size of the area the list is drawn in
+	 */
+	void SetViewport(int width, int height);
+
+	int ViewportWidth() const { return m_width; }
+	int ViewportHeight() const { return m_height; }
+
+	/**
+	 * @brief Scroll the list
+	 * @param offset Distance from the top of the content to the top of the viewport. Clamped to the scrollable range.
+	 * @return True if the offset changed
+	 */
+	bool SetScroll(int offset);
+
+	int Scroll() const { return m_scroll; }
+
+	// Height of every row together
+	int ContentHeight() const { return (int)m_rows.size() * WINDOW_LIST_ROW_HEIGHT; }
+
+	/**
+	 * @brief Get the rows that intersect the viewport
+	 * @param first Receives the first visible row
+	 * @param last Receives one past the last visible row. Equal to first if nothing is visible.
+	 */
+	void VisibleRows(size_t& first, size_t& last) const;
+
+	/**
+	 * @brief Get the rectangle of a row in viewport coordinates
+	 */
+	ListRect RowRect(size_t row) const;
+
+	/**
+	 * @brief Get the rectangle of part of a row in viewport coordinates
+	 * @param row Row index
+	 * @param action Title, Minimize, Maximize or Close. Row returns RowRect.
+	 */
+	ListRect ActionRect(size_t row, WindowListAction action) const;
+
+	/**
+	 * @brief Find the row and action under a point
+	 *
+	 * Only the row under the point is tested, so the cost doesn't depend on the number of rows.
+	 *
+	 * @param x X in viewport coordinates
+	 * @param y Y in viewport coordinates
+	 * @return The row and action, or row -1 and None if the point isn't on a row
+	 */
+	WindowListHit HitTest(int x, int y) const;
+
+private:
+	std::vector<WindowListRow> m_rows;
+	int m_width = 0;
+	int m_height = 0;
+	int m_scroll = 0;
+};
@@ -0,0 +1,227 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// WindowListView.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.13 SetRows keeps the pressed button on its window, WM_SIZE repaints
+// 10/19/2026 MS-24.01.08.17 Double buffered painting with the cached UI font, ScrollWindowEx scrolling
+// 10/19/2026 MS-24.01.08.13 created
+//-----------------------------------------------
+// Source code for the active window list control
+//
+// Defines functions for class WindowListView. See WindowListView.h.
+
+#include "WindowListView.h"
+#include "GdiCache.h"
+#include <windowsx.h>
+
+#define WINDOW_LIST_CLASS L"WinWinWindowList"
+
+bool WindowListView::s_Registered = false;
+
+static RECT ToRect(const ListRect& rect) {
+    return { rect.left, rect.top, rect.right, rect.bottom };
+}
+
+WindowListView::WindowListView() : m_hwnd(NULL) {}
+
+HWND WindowListView::Create(HWND parent, int x, int y, int width, int height) {
+    HINSTANCE hInstance = reinterpret_cast<HINSTANCE>(GetWindowLongPtr(parent, GWLP_HINSTANCE));
+    if (!s_Registered) { // One class for the whole list, registered once instead of once per window
+        WNDCLASS wc = { 0 };
+        wc.lpfnWndProc = WindowListProc;
+        wc.hInstance = hInstance;
+        wc.lpszClassName = WINDOW_LIST_CLASS;
+        wc.hCursor = LoadCursor(NULL, IDC_ARROW);
+        wc.hbrBackground = NULL; // Paint fills the background
+        s_Registered = RegisterClass(&wc) != 0 || GetLastError() == ERROR_CLASS_ALREADY_EXISTS;
+    }
+
+    m_hwnd = CreateWindowExW(
+        0,
+        WINDOW_LIST_CLASS,
+        L"",
+        WS_CHILD | WS_CLIPSIBLINGS,
+        x, y, width, height,
+        parent,
+        NULL,
+        hInstance,
+        this);
+    m_Model.SetViewport(width, height);
+    return m_hwnd;
+}
+
+void WindowListView::SetRows(const std::vector<WindowControl*>& Controls) {
+    std::vector<WindowListRow> Rows;
+    Rows.reserve(Controls.size());
+    for (WindowControl* ctrl : Controls) {
+        Rows.push_back({ reinterpret_cast<std::uintptr_t>(ctrl->GetInstanceHandle()), ctrl->GetInstanceTitle() });
+    }
+    std::uintptr_t pressedHandle = m_Pressed.row >= 0 ? m_Model.Row(m_Pressed.row).handle : 0;
+    m_Model.SetRows(std::move(Rows));
+    if (m_Pressed.row >= 0) { // Follow the pressed window to its new row, or let go of the mouse if it left the list
+        int row = -1;
+        for (size_t i = 0; i < m_Model.Size(); i++) {
+            if (m_Model.Row(i).handle == pressedHandle) {
+                row = (int)i;
+                break;
+            }
+        }
+        m_Pressed.row = row;
+        if (row < 0) {
+            m_Pressed = WindowListHit();
+            if (m_hwnd != NULL && GetCapture() == m_hwnd) {
+                ReleaseCapture();
+            }
+        }
+    }
+    if (m_hwnd != NULL) {
+        InvalidateRect(m_hwnd, NULL, FALSE);
+    }
+}
+
+void WindowListView::SetScroll(int offset) {
+    int previous = m_Model.Scroll();
+    if (m_Model.SetScroll(offset) && m_hwnd != NULL) {
+        ScrollWindowEx(m_hwnd, 0, previous - m_Model.Scroll(), NULL, NULL, NULL, NULL, SW_INVALIDATE); // Blit the rows still in view, only the strip scrolled in is painted
+        UpdateWindow(m_hwnd);
+    }
+}
+
+void WindowListView::Paint(HDC hdc, const RECT& dirty) {
+    FillRect(hdc, &dirty, GetSysColorBrush(COLOR_WINDOW));
+
+    HGDIOBJ oldFont = SelectObject(hdc, GdiCache::Font());
+    SetBkMode(hdc, TRANSPARENT);
+    SetTextColor(hdc, GetSysColor(COLOR_WINDOWTEXT));
+
+    size_t first, last;
+    m_Model.VisibleRows(first, last);
+    for (size_t row = first; row < last; row++) {
+        RECT rowRect = ToRect(m_Model.RowRect(row));
+        RECT overlap;
+        if (IntersectRect(&overlap, &rowRect, &dirty)) { // A pressed button only invalidates itself, so skip the rows around it
+            DrawRow(hdc, row);
+        }
+    }
+    SelectObject(hdc, oldFont);
+}
+
+void WindowListView::DrawRow(HDC hdc, size_t row) {
+    RECT rowRect = ToRect(m_Model.RowRect(row));
+    FrameRect(hdc, &rowRect, GetSysColorBrush(COLOR_WINDOWFRAME));
+
+    RECT titleRect = ToRect(m_Model.ActionRect(row, WindowListAction::Title));
+    const std::wstring& title = m_Model.Row(row).title;
+    DrawTextW(hdc, title.c_str(), (int)title.length(), &titleRect, DT_LEFT | DT_SINGLELINE | DT_END_ELLIPSIS | DT_NOPREFIX);
+
+    DrawButton(hdc, row, WindowListAction::Minimize, L"-");
+    DrawButton(hdc, row, WindowListAction::Maximize, L"+");
+    DrawButton(hdc, row, WindowListAction::Close, L"X");
+}
+
+void WindowListView::DrawButton(HDC hdc, size_t row, WindowListAction action, LPCWSTR text) {
+    RECT buttonRect = ToRect(m_Model.ActionRect(row, action));
+    bool pressed = m_Pressed.row == (int)row && m_Pressed.action == action;
+    DrawFrameControl(hdc, &buttonRect, DFC_BUTTON, DFCS_BUTTONPUSH | (pressed ? DFCS_PUSHED : 0));
+    if (pressed) {
+        OffsetRect(&buttonRect, 1, 1); // Pushed buttons draw their text one pixel down and right
+    }
+    SetTextColor(hdc, GetSysColor(COLOR_BTNTEXT));
+    DrawTextW(hdc, text, -1, &buttonRect, DT_CENTER | DT_VCENTER | DT_SINGLELINE | DT_NOPREFIX);
+    SetTextColor(hdc, GetSysColor(COLOR_WINDOWTEXT));
+}
+
+void WindowListView::InvalidateAction(const WindowListHit& hit) {
+    if (hit.row < 0 || hit.row >= (int)m_Model.Size()) {
+        return;
+    }
+    RECT rect = ToRect(m_Model.ActionRect(hit.row, hit.action));
+    InvalidateRect(m_hwnd, &rect, FALSE);
+}
+
+void WindowListView::RunAction(const WindowListHit& hit) {
+    HWND InstanceHandle = reinterpret_cast<HWND>(m_Model.Row(hit.row).handle);
+    switch (hit.action) {
+    case WindowListAction::Minimize:
+        ShowWindow(InstanceHandle, SW_MINIMIZE);
+        UpdateWindow(InstanceHandle);
+        break;
+    case WindowListAction::Maximize:
+        ShowWindow(InstanceHandle, SW_MAXIMIZE);
+        UpdateWindow(InstanceHandle);
+        break;
+    case WindowListAction::Close:
+        SendMessage(InstanceHandle, WM_CLOSE, 0, 0);
+        break;
+    default:
+        break;
+    }
+}
+
+LRESULT CALLBACK WindowListView::WindowListProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam) {
+    WindowListView* pThis;
+    if (message == WM_NCCREATE) {
+        pThis = (WindowListView*)((CREATESTRUCT*)lParam)->lpCreateParams;
+        SetWindowLongPtr(hwnd, GWLP_USERDATA, (LONG_PTR)pThis);
+        pThis->m_hwnd = hwnd;
+    }
+    else {
+        pThis = (WindowListView*)GetWindowLongPtr(hwnd, GWLP_USERDATA);
+    }
+    if (pThis == NULL) {
+        return DefWindowProc(hwnd, message, wParam, lParam);
+    }
+
+    switch (message) {
+    case WM_PAINT:
+    {
+        PAINTSTRUCT ps;
+        HDC hdc = BeginPaint(hwnd, &ps);
+        {
+            PaintBuffer buffer(hdc, ps.rcPaint); // Blits to the window when it goes out of scope, before EndPaint
+            pThis->Paint(buffer.DC(), ps.rcPaint);
+        }
+        EndPaint(hwnd, &ps);
+        return 0;
+    }
+    case WM_ERASEBKGND:
+        return 1;
+    case WM_SIZE:
+        pThis->m_Model.SetViewport(LOWORD(lParam), HIWORD(lParam));
+        InvalidateRect(hwnd, NULL, FALSE); // The scroll offset may have been clamped and the titles truncate to the new width
+        break;
+    case WM_LBUTTONDOWN:
+    {
+        WindowListHit hit = pThis->m_Model.HitTest(GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam));
+        if (hit.action == WindowListAction::Minimize || hit.action == WindowListAction::Maximize || hit.action == WindowListAction::Close) {
+            pThis->m_Pressed = hit;
+            SetCapture(hwnd);
+            pThis->InvalidateAction(hit);
+        }
+        return 0;
+    }
+    case WM_LBUTTONUP:
+    {
+        WindowListHit pressed = pThis->m_Pressed;
+        if (pressed.row < 0) {
+            return 0;
+        }
+        pThis->m_Pressed = WindowListHit();
+        ReleaseCapture();
+        pThis->InvalidateAction(pressed);
+        if (pThis->m_Model.HitTest(GET_X_LPARAM(lParam), GET_Y_LPARAM(lParam)) == pressed) { // Dragging off the button cancels the click, like a real button
+            pThis->RunAction(pressed);
+        }
+        return 0;
+    }
+    case WM_CAPTURECHANGED:
+        if (pThis->m_Pressed.row >= 0 && (HWND)lParam != hwnd) {
+            pThis->InvalidateAction(pThis->m_Pressed);
+            pThis->m_Pressed = WindowListHit();
+        }
+        break;
+    }
+    return DefWindowProc(hwnd, message, wParam, lParam);
+}
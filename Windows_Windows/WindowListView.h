@@ -0,0 +1,108 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// WindowListView.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.13 SetRows keeps the pressed button on its window, WM_SIZE repaints
+// 10/19/2026 MS-24.01.08.17 Paints through a PaintBuffer, scrolling blits the rows still in view
+// 10/19/2026 MS-24.01.08.13 created
+//-----------------------------------------------
+// Header file for the active window list control
+//
+// Contains class WindowListView, a single owner-drawn child window that shows every WindowControl in the active window list.
+// Rows have no windows of their own: the title and the minimize, maximize and close buttons are painted from a WindowListModel,
+// and clicks are hit tested against it. Painting walks only the rows that intersect the update region, so opening, scrolling and
+// repainting the list cost the same with 5 windows open as with 500.
+
+#pragma once
+
+#include <Windows.h>
+#include <vector>
+#include "WindowControl.h"
+#include "WindowListModel.h"
+
+class WindowListView {
+public:
+	WindowListView();
+
+	/**
+	 * @brief Register the window list class (once per process) and create the control, hidden
+	 *
+	 * @param parent Parent window
+	 * @param x X position in the parent
+	 * @param y Y position in the parent
+	 * @param width Width of the control
+	 * @param height Height of the control, which is also the model's viewport height
+	 * @return The control's window handle, NULL if it couldn't be created
+	 */
+	HWND Create(HWND parent, int x, int y, int width, int height);
+
+	/**
+	 * @brief Get the control's window handle
+	 */
+	HWND Handle() const { return m_hwnd; }
+
+	/**
+	 * @brief Rebuild the rows from the window controls and repaint
+	 *
+	 * A button held down stays pressed on its window's new row. If that window is gone the press is dropped and the mouse released.
+	 *
+	 * @param Controls Window controls in display order
+	 */
+	void SetRows(const std::vector<WindowControl*>& Controls);
+
+	/**
+	 * @brief Scroll the list if the offset changed
+	 *
+	 * The rows that stay in view are moved with ScrollWindowEx and only the strip that scrolled in is repainted.
+	 *
+	 * @param offset Distance from the top of the content, in pixels
+	 */
+	void SetScroll(int offset);
+
+	/**
+	 * @brief Get the row model, for the content height and scroll offset
+	 */
+	const WindowListModel& Model() const { return m_Model; }
+
+private:
+
+	/**
+	 * @brief Window procedure for the control
+	 *
+	 * WM_PAINT - Paints the visible rows (see Paint) into a PaintBuffer
+	 * WM_ERASEBKGND - Does nothing, Paint fills the background itself
+	 * WM_SIZE - Updates the model's viewport and repaints the whole list
+	 * WM_LBUTTONDOWN - Hit tests the point and, if it's on a button, captures the mouse and draws the button pressed
+	 * WM_LBUTTONUP - Releases the mouse and runs the button's action if the mouse is still on the button that was pressed:
+	 *     Minimize - ShowWindow SW_MINIMIZE
+	 *     Maximize - ShowWindow SW_MAXIMIZE
+	 *     Close - Sends WM_CLOSE
+	 */
+	static LRESULT CALLBACK WindowListProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam);
+
+	// Fill the update rectangle and draw every row that intersects it
+	void Paint(HDC hdc, const RECT& dirty);
+
+	// Draw one row: border, title and the three buttons
+	void DrawRow(HDC hdc, size_t row);
+
+	// Draw one button of a row, pressed if it's the button the mouse went down on
+	void DrawButton(HDC hdc, size_t row, WindowListAction action, LPCWSTR text);
+
+	// Repaint one button
+	void InvalidateAction(const WindowListHit& hit);
+
+	// Run the action of a button on its window
+	void RunAction(const WindowListHit& hit);
+
+	// Set once the window class is registered
+	static bool s_Registered;
+
+	HWND m_hwnd;
+	WindowListModel m_Model;
+
+	// Button the mouse went down on, row -1 if none
+	WindowListHit m_Pressed;
+};
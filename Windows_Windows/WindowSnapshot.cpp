@@ -0,0 +1,37 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// WindowSnapshot.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.20 created
+//-----------------------------------------------
+// Source code for the shared open window list
+//
+// Defines functions for class WindowSnapshot. See WindowSnapshot.h.
+
+#include "WindowSnapshot.h"
+#include "WinWinFunctions.h"
+#include <algorithm>
+
+WindowSnapshot::WindowSnapshot(ULONGLONG maxAge) : m_stale(true), m_maxAge(maxAge), m_enumeratedAt(0), m_enumerations(0) {}
+
+const std::vector<HWND>& WindowSnapshot::Windows() {
+    ULONGLONG now = GetTickCount64();
+    if (m_stale.exchange(false) || (m_maxAge != 0 && now - m_enumeratedAt > m_maxAge)) { // Cleared first, so an Invalidate during the enumeration isn't lost
+        m_windows = WinWinFunctions::GetActiveWindows();
+        m_enumeratedAt = now;
+        m_enumerations++;
+        return m_windows;
+    }
+
+    // Drop the windows that closed, hid or stopped responding since the enumeration. None of these checks send the window a message.
+    m_windows.erase(std::remove_if(m_windows.begin(), m_windows.end(), [](HWND ctrl) {
+        return !IsWindow(ctrl) || !IsWindowVisible(ctrl) || IsHungAppWindow(ctrl);
+    }), m_windows.end());
+    return m_windows;
+}
+
+void WindowSnapshot::Invalidate() {
+    m_stale = true;
+}
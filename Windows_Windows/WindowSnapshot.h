@@ -0,0 +1,53 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// WindowSnapshot.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.20 created
+//-----------------------------------------------
+// Header file for the shared open window list
+//
+// Contains class WindowSnapshot, which holds one GetActiveWindows result for several commands to share. The first command that asks
+// for the windows pays for the enumeration (and the hung window probe of every window in it). Later commands get the same list back,
+// minus any window that has closed, hidden or stopped responding since - those checks don't send the window a message - until
+// something invalidates the snapshot or it's older than its maximum age. Then the next command enumerates again.
+// A batch script (see WinWinCommands::RunScript) keeps one for the whole script, and the resident service (see WinWinService.h)
+// keeps one for as long as it runs, invalidated by its WinEvent hooks.
+
+#pragma once
+
+#include <Windows.h>
+#include <vector>
+#include <atomic>
+
+class WindowSnapshot {
+public:
+	/**
+	 * @param maxAge Longest the list is reused for, in milliseconds. 0 reuses it until Invalidate.
+	 */
+	explicit WindowSnapshot(ULONGLONG maxAge = 0);
+
+	/**
+	 * @brief Get the open windows, enumerating them if the snapshot is stale
+	 * @return Open windows, sorted like GetActiveWindows
+	 */
+	const std::vector<HWND>& Windows();
+
+	/**
+	 * @brief Make the next Windows call enumerate again
+	 *
+	 * Safe to call from any thread.
+	 */
+	void Invalidate();
+
+	// Number of times Windows has enumerated
+	size_t Enumerations() const { return m_enumerations; }
+
+private:
+	std::atomic<bool> m_stale;
+	std::vector<HWND> m_windows;
+	ULONGLONG m_maxAge;
+	ULONGLONG m_enumeratedAt;
+	size_t m_enumerations;
+};
@@ -0,0 +1,92 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// WindowWorker.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.25 Each job runs with a process cache
+// 10/19/2026 MS-24.01.08.15 Stop waits a bounded time for the running job, then leaves it behind
+// 10/19/2026 MS-24.01.08.15 created
+//-----------------------------------------------
+// Source code for the UI's background worker
+//
+// Defines functions for class WindowWorker. See WindowWorker.h for the messages it posts.
+
+#include "WindowWorker.h"
+#include "WinWinFunctions.h"
+#include <memory>
+#include <exception>
+
+std::thread WindowWorker::s_Thread;
+std::mutex WindowWorker::s_Lock;
+std::condition_variable WindowWorker::s_Wake;
+std::deque<WindowWorker::QueuedJob> WindowWorker::s_Queue;
+bool WindowWorker::s_Stopping = false;
+HWND WindowWorker::s_Notify = NULL;
+
+void WindowWorker::Start(HWND notify) {
+    if (s_Thread.joinable()) {
+        return;
+    }
+    s_Notify = notify;
+    s_Stopping = false;
+    s_Thread = std::thread(Run);
+}
+
+void WindowWorker::Stop() {
+    if (!s_Thread.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(s_Lock);
+        s_Stopping = true;
+        s_Queue.clear();
+    }
+    s_Wake.notify_one();
+    if (WaitForSingleObject(s_Thread.native_handle(), WORKER_STOP_TIMEOUT) == WAIT_OBJECT_0) {
+        s_Thread.join();
+    }
+    else {
+        s_Thread.detach(); // Hung in a window call, don't hang shutdown with it
+    }
+}
+
+void WindowWorker::Post(int command, Job job) {
+    {
+        std::lock_guard<std::mutex> lock(s_Lock);
+        s_Queue.push_back({ command, std::move(job) });
+    }
+    s_Wake.notify_one();
+}
+
+void WindowWorker::Run() {
+    for (;;) {
+        QueuedJob next;
+        size_t remaining;
+        {
+            std::unique_lock<std::mutex> lock(s_Lock);
+            s_Wake.wait(lock, [] { return s_Stopping || !s_Queue.empty(); });
+            if (s_Stopping) {
+                return;
+            }
+            next = std::move(s_Queue.front());
+            s_Queue.pop_front();
+            remaining = s_Queue.size();
+        }
+        PostMessage(s_Notify, WM_WORKER_PROGRESS, (WPARAM)next.command, (LPARAM)remaining);
+
+        std::unique_ptr<WorkerResult> Result = std::make_unique<WorkerResult>();
+        Result->command = next.command;
+        try {
+            ScopedProcessCache processes; // Enumeration and the arrangement after it share one lookup per process
+            next.job(*Result);
+        }
+        catch (const std::exception& e) { // A bad layout file shouldn't take the worker, and every job queued behind it, down
+            Result->error = e.what();
+        }
+
+        if (PostMessage(s_Notify, WM_WORKER_DONE, 0, (LPARAM)Result.get())) { // Fails once the main window is destroyed, and Result frees itself
+            Result.release(); // The main window owns it now
+        }
+    }
+}
@@ -0,0 +1,106 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// WindowWorker.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.15 Stop waits a bounded time for the running job, then leaves it behind
+// 10/19/2026 MS-24.01.08.15 created
+//-----------------------------------------------
+// Header file for the UI's background worker
+//
+// Contains class WindowWorker which runs window operations (enumeration, hung window probes, placement, desktop icon reads and moves)
+// for the UI on a single background thread. WindowsApp posts each operation as a job with a command ID. The worker runs the jobs in
+// the order they were posted, and the main window only ever receives two messages from it:
+//   WM_WORKER_PROGRESS - a job started. wParam is its command ID, lParam is the number of jobs still queued behind it.
+//   WM_WORKER_DONE     - a job finished. lParam is a WorkerResult* that the main window takes ownership of.
+// One thread keeps the operations in order (a STACK and the NEXT > after it never overlap) and means LayoutHistory is only
+// ever touched by one thread. Jobs never open dialogs: anything the user has to answer is asked on the UI thread before the job is posted.
+
+#pragma once
+
+#include <Windows.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+// Sent to the notify window when a job starts
+#define WM_WORKER_PROGRESS (WM_APP + 1)
+
+// Sent to the notify window when a job finishes, lParam is the WorkerResult*
+#define WM_WORKER_DONE (WM_APP + 2)
+
+// How long Stop waits for the running job before giving up on it, in milliseconds
+#define WORKER_STOP_TIMEOUT 2000
+
+/**
+ * @brief What a job hands back to the UI thread
+ */
+struct WorkerResult {
+	int command = 0;                                      // Command ID the job was posted with
+	bool enumerated = false;                              // True if the job enumerated the open windows into Windows
+	std::vector<std::pair<HWND, std::wstring>> Windows;   // Open windows in z order, handle and title
+	int count = 0;                                        // Command specific count, e.g. the number of icons a desktop layout moved
+	std::string error;                                    // what() of the exception that ended the job, empty if it succeeded
+};
+
+class WindowWorker {
+public:
+
+	// A window operation. Runs on the worker thread, so it must not touch UI state; anything the UI needs goes in the result.
+	typedef std::function<void(WorkerResult&)> Job;
+
+	/**
+	 * @brief Start the worker thread
+	 * @param notify Window that receives WM_WORKER_PROGRESS and WM_WORKER_DONE
+	 */
+	static void Start(HWND notify);
+
+	/**
+	 * @brief Drop the queued jobs, wait for the running one to finish, and end the thread
+	 *
+	 * A job stuck on a hung window (SetWindowPlacement, a desktop icon move) would otherwise hold WM_DESTROY forever, so the wait is
+	 * bounded by WORKER_STOP_TIMEOUT. If the job is still running after that the thread is detached: it sees s_Stopping when the job
+	 * returns and exits without running anything else, and its result is dropped once the notify window is gone.
+	 */
+	static void Stop();
+
+	/**
+	 * @brief Queue a job
+	 * @param command Command ID, passed back in the messages and the result
+	 * @param job Operation to run
+	 */
+	static void Post(int command, Job job);
+
+private:
+
+	struct QueuedJob {
+		int command;
+		Job job;
+	};
+
+	// Thread procedure. Waits for a job, runs it, and posts the result until Stop is called.
+	static void Run();
+
+	// Worker thread
+	static std::thread s_Thread;
+
+	// Guards s_Queue and s_Stopping
+	static std::mutex s_Lock;
+
+	// Signalled when a job is queued or Stop is called
+	static std::condition_variable s_Wake;
+
+	// Jobs waiting to run, oldest first
+	static std::deque<QueuedJob> s_Queue;
+
+	// Set by Stop()
+	static bool s_Stopping;
+
+	// Window the messages are posted to
+	static HWND s_Notify;
+};
@@ -1,1173 +1,1127 @@
-//***********************************************
-// WindowsWindows
-// Copyright 2024 Michael Steuber
-//===============================================
-// WindowsApp.cpp
-// ----------------------------------------------
-// 09/20/2024 MS-24.01.07.03 Fixed the scrollbar (finally)
-// 09/03/2024 MS-24.01.07.02 Moved all WinWin base functionality to WinWinFunctions for use with the command line and UI
-// 08/26/2024 MS-24.01.05.01 Reworked UI
-// 08/20/2024 MS-24.01.04.02 Added preprocessor definition for closed main window height
-// 08/19/2024 MS-24.01.04.01 Added ability to save layout configurations, fixed bugs in the stack function
-// 08/16/2024 MS-24.01.03.06 Refactored
-// 08/15/2024 MS-24.01.03.05 Fixed windows stack
-// 08/13/2024 MS-24.01.03.04 Added (currently useless) menu, added (currently useless) save Desktop Icons button
-// 08/12/2024 MS-24.01.03.03 Added Windows stack feature, renamed old stack to cascade
-// 08/12/2024 MS-24.01.03.01 Added functionality to executing saved layouts
-// 08/01/2024 MS-24.01.02.10 Added controls for viewing saved layouts, updated json folder to include multiple files for different layouts
-// 08/01/2024 MS-24.01.02.09 Added dropdown menu to hide active window list
-// 08/01/2024 MS-24.01.02.08 Added save layout button (saves current layout in a json file)
-// 08/01/2024 MS-24.01.02.07 Added stack windows button (broke scrolling again)
-// 07/25/2024 MS-24.01.02.06 Fixed scrolling, cleaned up window destruction for better memory management, updated child window size for sub control windows
-// 07/25/2024 MS-24.01.02.05 Added global oss to store active windows ostreamstring and added function to get all active windows to the create event
-// 07/25/2024 MS-24.01.02.2 Updated to be compatible with template window
-// 07/23/2024 MS-24.01.01.0 created
-//-----------------------------------------------
-// Main window UI source code
-//
-// Master code for UI functionality. Creates the main window and all child windows that aren't members of the ControlWindow class. 
-// Contains HandleMessage(), which handles all events sent to the main window. 
-// m_hwnd is the top level of the windows hierarchy, it is a parent to everything you see on screen.
-
-#include "WindowsApp.h"
-
-// Button IDs
-#define CASCADE 1
-#define SAVE_LAYOUT 2
-#define SHOW_ACTIVE_WINDOWS 3
-#define HIDE_ACTIVE_WINDOWS 4
-#define VIEW_SAVED_CONFIGS 5
-#define EXECUTE_LAYOUT 6
-#define HIDE_SAVED_CONFIGS 7
-#define STACK 8
-#define SAVE_DESKTOP_LAYOUT 9
-#define NEXT_STACK 10
-#define PREV_STACK 11
-#define EXIT_STACK 12
-#define SAVED_DESKTOP_LAYOUTS 13
-#define HIDE_SAVED_DESKTOP_CONFIGS 14
-#define EXECUTE_DESKTOP_LAYOUT 15
-#define SQUISH 16
-
-// Fixed window sizes
-#define SHOW_ACTIVE_WINDOWS_BUTTON_Y 250
-#define M_HWND_CLOSED_Y 355
-#define WINDOWS_CONTROL_CLOSED_Y 150
-#define ICON_WINDOW_CLOSED_Y 100
-
-
-INT_PTR CALLBACK DialogProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM lParam);
-
-WindowsApp::WindowsApp() {}
-
-///   GLOBALS   ///
-std::wostringstream WindowsApp::oss; //ostream string that contains window control panel titles
-HWND WindowsApp::WindowHandle; // Window handle that holds info for creation of the windows vector
-static std::wstring userInput;
-WNDPROC iconWindowProc;
-
-///   CALLBACK FUNCTIONS   ///
-
-void WindowsApp::RunMessageLoop() {
-    MSG msg;
-
-    while (GetMessage(&msg, NULL, 0, 0))
-    {
-        TranslateMessage(&msg);
-        DispatchMessage(&msg);
-    }
-}
-
-LRESULT WindowsApp::HandleMessage(UINT uMsg, WPARAM wParam, LPARAM lParam)
-{
-    LRESULT lResult = 0;
-
-    int newHeight;
-
-    switch (uMsg) {
-    case WM_CREATE:
-        HandleCreate();
-        break;
-    case WM_PAINT:
-        HandlePaint();
-        break;
-    case WM_SIZE:
-        HandleResize();
-        // Show or hide the scroll bar based on window height
-        newHeight = HIWORD(lParam);
-        if (HIWORD(lParam) > 310) {
-            ShowWindow(m_hScrollBar, SW_SHOW);
-        }
-        else {
-            ShowWindow(m_hScrollBar, SW_HIDE);
-            ShowWindow(m_hScrollBar, SW_HIDE);
-            UpdateWindow(m_hScrollBar);
-        }
-        break;
-    case WM_ERASEBKGND:
-    {
-        HDC hdc = (HDC)wParam;
-        RECT rect;
-        GetClientRect(m_hwnd, &rect);
-        HBRUSH hBrush = CreateSolidBrush(GetSysColor(COLOR_WINDOW));
-        FillRect(hdc, &rect, hBrush);
-        DeleteObject(hBrush);
-        break;
-    }
-    case WM_VSCROLL:
-       HandleScroll(wParam, lParam);
-        break;
-    case WM_COMMAND:
-        if (HIWORD(wParam) == BN_CLICKED) {
-            int id = LOWORD(wParam);   //Extract button id from the wParam and dispatch accordingly
-            int ControlY = ((WindowsVector.size() + 1) * 100) + 75;
-            switch (id) {
-            case CASCADE:
-                WindowsVector.clear();
-                PrintActiveWindows();
-                CascadeWindows();
-                break;
-            case STACK:
-                WindowsVector.clear();
-                PrintActiveWindows();
-                StackWindows();
-                break;
-            case NEXT_STACK:
-                stackIndex++;
-                StackWindowsCallback();
-                break;
-            case PREV_STACK:
-                stackIndex--;
-                StackWindowsCallback();
-                break;
-            case EXIT_STACK:
-                ExitStack();
-                break;
-            case SAVE_LAYOUT:
-                WindowsVector.clear();
-                PrintActiveWindows();
-                WinWinSaveLayout();
-                break;
-            case VIEW_SAVED_CONFIGS:
-                WinWinViewSaved();
-                TriggerResize();
-                break;
-            case HIDE_SAVED_CONFIGS:
-                WinWinHideSaved();
-                TriggerResize();
-                break;
-            case SHOW_ACTIVE_WINDOWS:
-                WinWinShowActive();
-                TriggerResize();
-                break;
-            case HIDE_ACTIVE_WINDOWS:
-                WinWinHideActive();
-                TriggerResize();
-                break;
-            case EXECUTE_LAYOUT:
-                WindowsVector.clear();
-                PrintActiveWindows();
-                wchar_t jsonFile[256];
-                GetWindowText((HWND)lParam, jsonFile, 256);
-                ExecuteSaved(jsonFile);
-                break;
-            case SAVE_DESKTOP_LAYOUT:
-                SaveDesktopLayout();
-                break;
-            case SAVED_DESKTOP_LAYOUTS:
-                ViewSavedDesktopLayouts();
-                TriggerResize();
-                break;
-            case HIDE_SAVED_DESKTOP_CONFIGS:
-                HideSavedDesktopLayouts();
-                TriggerResize();
-                break;
-            case EXECUTE_DESKTOP_LAYOUT:
-                wchar_t desktopJsonFile[256];
-                GetWindowText((HWND)lParam, desktopJsonFile, 256);
-                ExecuteSavedDesktopLayout(desktopJsonFile);
-                break;
-            case SQUISH:
-                SquishCascade();
-                break;
-}
-        RECT mainWindowRect;
-        GetWindowRect(m_hwnd, &mainWindowRect);
-        SetWindowPos(m_hwnd, HWND_TOPMOST, mainWindowRect.left, mainWindowRect.top, mainWindowRect.right - mainWindowRect.left, mainWindowRect.bottom - mainWindowRect.top, SWP_NOMOVE);
-}
-        break;  
-    case WM_CLOSE:
-        if (m_hwnd != NULL) {
-            DestroyWindow(m_hwnd);
-        }
-        break;
-    case WM_DESTROY:
-        PostQuitMessage(0);
-        break;
-    }
-    return DefWindowProc(m_hwnd, uMsg, wParam, lParam);
-}
-
-INT_PTR CALLBACK DialogProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM lParam) {
-    switch (message) {
-    case WM_INITDIALOG:
-        return TRUE;
-
-    case WM_COMMAND:
-        switch (LOWORD(wParam)) {
-        case IDOK: {
-            WCHAR text[256];
-            GetDlgItemText(hDlg, IDC_EDIT_TEXT, text, 256);
-            userInput = text; // Store the input text in the global variable
-            EndDialog(hDlg, IDOK);
-            return TRUE;
-        }
-        case IDCANCEL:
-            EndDialog(hDlg, IDCANCEL);
-            return TRUE;
-        }
-        break;
-    }
-    return FALSE;
-}
-
-LRESULT CALLBACK WindowsApp::ButtonProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
-    static int yPos = 0; // Vertical scroll position
-
-    if (uMsg == WM_COMMAND || uMsg == WM_VSCROLL) {
-        SendMessage(GetParent(hwnd), uMsg, wParam, lParam);
-        return 0; 
-    }
-    return CallWindowProcW(iconWindowProc, hwnd, uMsg, wParam, lParam);
-}
-
-
-///   INITIALIZE   ///
-
-HRESULT WindowsApp::Initialize()
-{
-    HRESULT hr;
-    // See BaseWindow.cpp
-    hr = this->Create(L"Windows Window Extension Window",
-        WS_OVERLAPPEDWINDOW | WS_CLIPCHILDREN | WS_CLIPSIBLINGS,
-        0,
-        CW_USEDEFAULT,
-        CW_USEDEFAULT,
-        315,
-        M_HWND_CLOSED_Y
-    );
-    HMENU hMenu = LoadMenu(GetModuleHandle(NULL), MAKEINTRESOURCE(IDR_MENU1));
-    if (hMenu == NULL) {
-        MessageBoxW(NULL, L"Failed to load menu.", L"Error", MB_OK | MB_ICONERROR);
-        return 0;
-    }
-    SetMenu(m_hwnd, hMenu);
-    return hr;
-}
-
-HRESULT WindowsApp::HandleCreate() {
-    HRESULT hr = S_OK;
-    if (m_hwnd && m_hwnd != 0) {
-        ShowWindow(m_hwnd, SW_SHOWNORMAL);
-        m_hActiveWindowsControlPanel = CreateWindowExW(
-            0,
-            L"STATIC",
-            L"",
-            WS_CHILD | WS_VISIBLE | WS_CLIPCHILDREN | WS_CLIPSIBLINGS, 
-            0, SHOW_ACTIVE_WINDOWS_BUTTON_Y, 280, 50,
-            m_hwnd,
-            NULL,
-            (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
-            NULL);
-        m_hScrollBar = CreateWindowEx(
-            0,
-            L"SCROLLBAR",
-            NULL,
-            WS_CHILD | WS_VISIBLE | SBS_VERT | WS_CLIPCHILDREN | WS_CLIPSIBLINGS, 
-            280, SHOW_ACTIVE_WINDOWS_BUTTON_Y, 20, 50,
-            m_hwnd, 
-            NULL, 
-            (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE), 
-            NULL
-        );
-        SCROLLINFO si;
-        si.cbSize = sizeof(si);
-        si.fMask = SIF_RANGE | SIF_PAGE;
-        si.nMin = 0;
-        si.nMax = 100;
-        si.nPage = 10;
-        SetScrollInfo(m_hScrollBar, SB_CTL, &si, TRUE);
-
-        controlWindowProc = (WNDPROC)SetWindowLongPtr(m_hActiveWindowsControlPanel, GWLP_WNDPROC, (LONG_PTR)ButtonProc);
-
-        UpdateWindow(m_hwnd);
-       
-    }
-    CreateControlOpts(); // Create control buttons that are children of m_hwnd
-    // Enumerate through active windows and create controls
-    PrintActiveWindows();
-    for (WindowControl* ctrl : WindowsVector) {
-        SetWindowPos(ctrl->m_hControlPanel, NULL, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE | SWP_HIDEWINDOW);
-    }
-    int ControlY = 400;
-//  SCROLLINFO si; // Set scroll information
-//  si.cbSize = sizeof(SCROLLINFO);
-//  si.fMask = SIF_RANGE | SIF_PAGE;
-//  si.nMin = 0;
-//  si.nMax = ControlY;
-//  si.nPage = 1000;
-//  if (m_hActiveWindowsControlPanel != 0) {
-//      SetScrollInfo(m_hActiveWindowsControlPanel, SB_VERT, &si, TRUE);
-//  }
-
-    return hr;
-}
-
-void WindowsApp::CreateControlOpts() {
-    
-    // Icon Control
-    m_hIconControlPanel = CreateWindowEx(
-        0,
-        L"STATIC",
-        L"",
-        WS_CHILD | WS_VISIBLE | WS_BORDER | WS_CLIPCHILDREN | WS_CLIPSIBLINGS, 
-        0,
-        0,
-        300,
-        100,
-        m_hwnd,
-        NULL,
-        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
-        NULL
-    );
-    iconWindowProc = (WNDPROC)SetWindowLongPtr(m_hIconControlPanel, GWLP_WNDPROC, (LONG_PTR)ButtonProc);
-
-
-     m_IconTitle = CreateWindowEx(
-        0, TEXT("STATIC"), L"Desktop Icon Manager",
-        WS_CHILD | WS_VISIBLE,
-        60, 10, 200, 30,
-         m_hIconControlPanel, NULL, GetModuleHandle(NULL), NULL);
-
-    m_hSavedDesktopConfigs = CreateWindowEx(
-        0,
-        L"BUTTON",
-        L"ICON LAYOUTS",
-        WS_TABSTOP | WS_VISIBLE | WS_CHILD | BS_DEFPUSHBUTTON,
-        150, 50, 110, 30,
-        m_hIconControlPanel,
-        (HMENU)SAVED_DESKTOP_LAYOUTS,
-        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
-        NULL);
-    m_hSaveDesktopLayout = CreateWindowEx(
-        0,
-        L"BUTTON",
-        L"SAVE ICONS",
-        WS_TABSTOP | WS_VISIBLE | WS_CHILD | BS_DEFPUSHBUTTON,
-        10, 50, 110, 30,
-        m_hIconControlPanel,
-        (HMENU)SAVE_DESKTOP_LAYOUT,
-        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
-        NULL
-    );
-    
-    // Window Control
-
-    m_hWindowsControlPanel = CreateWindowExW(
-        0,
-        L"STATIC",
-        L"",
-        WS_CHILD | WS_VISIBLE | WS_BORDER | WS_CLIPCHILDREN | WS_CLIPSIBLINGS, 
-        0,
-        100,
-        300,
-        150,
-        m_hwnd,
-        NULL,
-        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
-        NULL
-    );
-
-    windowWindowProc = (WNDPROC)SetWindowLongPtr(m_hWindowsControlPanel, GWLP_WNDPROC, (LONG_PTR)ButtonProc);
-
-    m_WindowTitle = CreateWindowEx(
-            0, TEXT("STATIC"), L"Window Manager",
-            WS_CHILD | WS_VISIBLE,
-            75, 10, 200, 30,
-        m_hWindowsControlPanel, NULL, GetModuleHandle(NULL), NULL);
-
-    m_hCascadeButton = CreateWindowEx(
-        0,
-        L"BUTTON",
-        L"CASCADE",
-        WS_TABSTOP | WS_VISIBLE | WS_CHILD | BS_DEFPUSHBUTTON,
-        10, 50, 110, 30,
-        m_hWindowsControlPanel,
-        (HMENU)CASCADE,
-        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
-        NULL);
-
-    m_hStackButton = CreateWindowEx(
-        0,
-        L"BUTTON",
-        L"STACK",
-        WS_TABSTOP | WS_VISIBLE | WS_CHILD | BS_DEFPUSHBUTTON,
-        150, 50, 110, 30,
-        m_hWindowsControlPanel,
-        (HMENU)STACK,
-        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
-        NULL);
-
-    m_hSaveWinLayout = CreateWindowEx(
-        0,
-        L"BUTTON",
-        L"SAVE LAYOUT",
-        WS_TABSTOP | WS_VISIBLE | WS_CHILD | BS_DEFPUSHBUTTON,
-        5, 110, 120, 30,
-        m_hWindowsControlPanel,
-        (HMENU)SAVE_LAYOUT,
-        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
-        NULL);
-
-    m_hSavedConfigs = CreateWindowEx(
-        0,
-        L"BUTTON",
-        L"WINDOW LAYOUTS",
-        WS_TABSTOP | WS_VISIBLE | WS_CHILD | BS_DEFPUSHBUTTON,
-        135, 110, 140, 30,
-        m_hWindowsControlPanel,
-        (HMENU)VIEW_SAVED_CONFIGS,
-        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
-        NULL);
-
-  
-    // Active Window Control
-    m_hShowWindows = CreateWindowEx(
-        0,
-        L"BUTTON",
-        L"V",
-        WS_TABSTOP | WS_VISIBLE | WS_CHILD,
-        10, 5, 270, 30,
-        m_hActiveWindowsControlPanel,
-        (HMENU)SHOW_ACTIVE_WINDOWS,
-        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
-        NULL);
-}
-
-///   UTILITIIES   ///
-
-std::vector<HWND> WindowsApp::ExtractHwnds(std::vector<WindowControl*> windowControls) {
-    std::vector<HWND> hwnds;
-    hwnds.reserve(windowControls.size()); // Reserve space to avoid reallocations
-
-    for (WindowControl* ctrl : windowControls) {
-        hwnds.push_back(ctrl->GetInstanceHandle());
-    }
-
-    return hwnds;
-}
-
-std::string WindowsApp::ConvertToNarrowString(const std::wstring& wstr) {
-    if (wstr.empty()) {
-        return std::string();
-    }
-
-    int size_needed = WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), -1, NULL, 0, NULL, NULL);
-    if (size_needed == 0) {
-        throw std::runtime_error("WideCharToMultiByte failed");
-    }
-
-    std::string str(size_needed, 0);
-    int result = WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), -1, &str[0], size_needed, NULL, NULL);
-    if (result == 0) {
-        throw std::runtime_error("WideCharToMultiByte failed");
-    }
-
-    // Remove the null terminator added by WideCharToMultiByte
-    str.resize(size_needed - 1);
-
-    return str;
-}
-
-void WindowsApp::TriggerResize() {
-    RECT rect;
-    GetClientRect(m_hwnd, &rect); // Get the current size of the client area
-    int width = rect.right - rect.left;
-    int height = rect.bottom - rect.top;
-
-    SendMessage(m_hwnd, WM_SIZE, SIZE_RESTORED, MAKELPARAM(width, height));
-}
-
-
-///   HANDLE BASIC WINDOW EVENTS   ///
-
-void WindowsApp::HandleScroll(WPARAM wParam, LPARAM lParam) {
-    int yPos = 0;
-    if ((HWND)lParam == m_hScrollBar) {
-        int yDelta = 0; // Distance to scroll
-        int yNewPos; // New position of scroll box
-
-        // Get the current scroll position
-        SCROLLINFO si;
-        si.cbSize = sizeof(si);
-        si.fMask = SIF_ALL;
-        GetScrollInfo(m_hScrollBar, SB_CTL, &si);
-        yPos = si.nPos;
-
-        switch (LOWORD(wParam)) {
-        case SB_LINEUP:
-            yDelta = -1; // Scroll up one line
-            break;
-        case SB_LINEDOWN:
-            yDelta = 1; // Scroll down one line
-            break;
-        case SB_PAGEUP:
-            yDelta = -10; // Scroll up one page
-            break;
-        case SB_PAGEDOWN:
-            yDelta = 10; // Scroll down one page
-            break;
-        case SB_THUMBTRACK:
-            yNewPos = HIWORD(wParam); // Drag scroll box to new position
-            yDelta = yNewPos - yPos;
-            break;
-        default:
-            yDelta = 0;
-        }
-
-        // V Update the scroll position V
-        yPos += yDelta;
-        yPos = max(0, min(yPos, si.nMax - (int)si.nPage + 1)); // Ensure the position is within the range
-        si.fMask = SIF_POS;
-        si.nPos = yPos;
-        SetScrollInfo(m_hScrollBar, SB_CTL, &si, TRUE);
-
-        RECT rect;
-        GetClientRect(m_hActiveWindowsControlPanel, &rect);
-      
-        ScrollWindow(m_hActiveWindowsControlPanel, 0, -yDelta, NULL, NULL);   // Scroll the window content
-        RedrawWindow(m_hwnd, NULL, NULL, RDW_INVALIDATE | RDW_UPDATENOW | RDW_ALLCHILDREN);
-
-    }
-}
-
-void WindowsApp::HandlePaint() {
-    PAINTSTRUCT ps;
-    HDC hdc = BeginPaint(m_hwnd, &ps);
-
-    RECT rect;
-    GetClientRect(m_hwnd, &rect);
-    // Double buffering
-    // In order to reduce a flickering effect from scrolling, this section draws to a back buffer before displaying it, at which point it swaps the back and front buffers, erases the back buffer, and starts drawing the next section.
-    HDC memDC = CreateCompatibleDC(hdc);
-    HBITMAP memBitmap = CreateCompatibleBitmap(hdc, rect.right - rect.left, rect.bottom - rect.top);
-    HGDIOBJ oldBitmap = SelectObject(memDC, memBitmap);
-
-    SetTextColor(hdc, RGB(0, 0, 0));
-    SetBkMode(hdc, TRANSPARENT);
-    EndPaint(m_hwnd, &ps);
-
-    BitBlt(hdc, 0, 0, rect.right - rect.left, rect.bottom - rect.top, memDC, 0, 0, SRCCOPY);
-
-    SelectObject(memDC, oldBitmap);     // Clean up
-    DeleteObject(memBitmap);
-    DeleteDC(memDC);
-
-    EndPaint(m_hwnd, &ps);
-
-}
-
-void WindowsApp::HandleResize(){
-    RECT resizeRect;
-    if (m_hwnd != NULL) {
-        GetWindowRect(m_hwnd, &resizeRect);  // Update the main window
-        UpdateWindow(m_hwnd);
-
-        RECT rect;
-        GetWindowRect(m_hActiveWindowsControlPanel, &rect);   // Get the coordinates of the active windows control panel relative to the main window
-        int pageHeight = rect.bottom - rect.top;
-        POINT pageHeightPoint;
-        pageHeightPoint.x = rect.right;
-        pageHeightPoint.y = rect.top;
-        ScreenToClient(m_hwnd, &pageHeightPoint);
-
-        int scrollBarY = (resizeRect.bottom - (resizeRect.top + 60)) - pageHeightPoint.y; // Calculate the height of the scroll bar 
-        SetWindowPos(m_hScrollBar, NULL, pageHeightPoint.x, pageHeightPoint.y, 20, scrollBarY, NULL); // And set its position
-
-        SCROLLINFO si;  // Update the scrolling info with the new scroll bar/active windows control panel size
-        si.cbSize = sizeof(si);
-        si.fMask = SIF_RANGE | SIF_PAGE;
-        si.nMin = 0;
-        si.nMax = rect.bottom - rect.top;
-        si.nPage = scrollBarY; 
-        SetScrollInfo(m_hScrollBar, SB_CTL, &si, TRUE);
-
-    }
-}
-
-///   WINDOW RESOURCES   ///
-
-std::wstring WindowsApp::GetUserInput(HINSTANCE hInstance) {
-    userInput.clear(); // Clear previous input
-    if (DialogBox(hInstance, MAKEINTRESOURCE(IDD_SIMPLE_INPUT_DIALOG), NULL, DialogProc) == IDOK) {
-        return userInput;
-    }
-    return L"";
-}
-
-///   HANDLE WINDOWS_WINDOWS EVENTS   ///
-//    PRINT ACTIVE WINDOWS   //  
-
-void WindowsApp::PrintActiveWindows() {
-    EnumWindows(EnumWindowsProc, reinterpret_cast<LPARAM>(this)); // Enumerate through the windows with this callback function. 
-                                                                  //EnumWindowsProc is a custom method, see BaseWindow.cpp
-}
-
-void WindowsApp::WinWinShowActive() {
-    // Enumerate through active windows and create controls
-    WindowsVector.clear();
-    PrintActiveWindows();
-    int ControlY = ((WindowsVector.size()) * 100) + 30;
-    RECT prevRect;
-    GetWindowRect(m_hwnd, &prevRect);
-    SetWindowPos(m_hwnd, NULL, 0, 0, prevRect.right - prevRect.left, ControlY, SWP_NOMOVE);
-    RECT ActiveWinControl;
-    GetWindowRect(m_hActiveWindowsControlPanel, &ActiveWinControl);
-    POINT ActiveWinControlBottomLeft;
-    ActiveWinControlBottomLeft.x = ActiveWinControl.left;
-    ActiveWinControlBottomLeft.y = ActiveWinControl.bottom;
-    ScreenToClient(m_hwnd, &ActiveWinControlBottomLeft);
-    SetWindowPos(m_hActiveWindowsControlPanel, NULL, ActiveWinControlBottomLeft.x, ActiveWinControlBottomLeft.y - 30, ActiveWinControl.right - ActiveWinControl.left, ControlY, SW_INVALIDATE); // resize control window
-    
-    RECT iconWindowRect;
-    GetWindowRect(m_hIconControlPanel, &iconWindowRect);
-    GetWindowRect(m_hActiveWindowsControlPanel, &ActiveWinControl);
-    int m_hwndHeight;
-    (WindowsVector.size() <= 3 ? m_hwndHeight = prevRect.bottom - prevRect.top + ControlY - 30 : m_hwndHeight = prevRect.bottom - prevRect.top + 300);
-    SetWindowPos(m_hwnd, NULL, 0, 0, prevRect.right - prevRect.left, m_hwndHeight, SWP_NOMOVE);
-
-    DestroyWindow(m_hShowWindows);
-
-    m_hHideWindows = CreateWindowExW(
-        0,
-        L"BUTTON",
-        L"^",
-        WS_TABSTOP | WS_VISIBLE | WS_CHILD | WS_CLIPCHILDREN | WS_CLIPSIBLINGS,
-        10, 0, 270, 30,
-        m_hActiveWindowsControlPanel,
-        (HMENU)HIDE_ACTIVE_WINDOWS,
-        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
-        NULL);
-
-    for (WindowControl* ctrl : WindowsVector) {
-        SetWindowPos(ctrl->m_hControlPanel, NULL, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE | SWP_SHOWWINDOW);
-    }
-}
-
-void WindowsApp::WinWinHideActive() {
-    for (WindowControl* ctrl : WindowsVector) {
-        SetWindowPos(ctrl->m_hControlPanel, NULL, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE | SWP_HIDEWINDOW);
-    }
-    UpdateWindow(m_hActiveWindowsControlPanel);
-
-    RECT prevActiveWinControl;
-    GetWindowRect(m_hActiveWindowsControlPanel, &prevActiveWinControl);
-
-    RECT winControlRect;
-    GetWindowRect(m_hWindowsControlPanel, &winControlRect);
-    POINT winBottomLeft = { winControlRect.left, winControlRect.bottom };
-    ScreenToClient(m_hwnd, &winBottomLeft);
-
-    RECT m_hwndPrevRect;
-    GetWindowRect(m_hwnd, &m_hwndPrevRect);
-
-    SetWindowPos(m_hActiveWindowsControlPanel, NULL, 0, 0, prevActiveWinControl.right - prevActiveWinControl.left, 30, SW_INVALIDATE | SWP_NOMOVE);
-
-    SetWindowPos(m_hwnd, NULL, 0, 0, m_hwndPrevRect.right - m_hwndPrevRect.left, winBottomLeft.y + 100, SWP_NOMOVE);
-
-    DestroyWindow(m_hHideWindows);
-    m_hShowWindows = CreateWindowEx(
-        0,
-        L"BUTTON",
-        L"V",
-        WS_TABSTOP | WS_VISIBLE | WS_CHILD,
-        10, 0, 270, 30,
-        m_hActiveWindowsControlPanel,
-        (HMENU)SHOW_ACTIVE_WINDOWS,
-        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
-        NULL);
-}
-
-//   STACK WINDOWS   //
-
-void WindowsApp::StackWindows()
-{
-    if (WindowsVector.size() <= 4 || WindowsVector.size() <= 8) {
-        WinWinFunctions::Stack(ExtractHwnds(WindowsVector));
-    }
-    else if (WindowsVector.size() > 8) {
-       
-        stackIndex = 0;
-        StackWindowsCallback();
-        DestroyWindow(m_hStackButton);
-        m_hExitStack = CreateWindowEx(
-            0,
-            L"BUTTON",
-            L"EXIT STACK",
-            WS_TABSTOP | WS_VISIBLE | WS_CHILD | BS_DEFPUSHBUTTON,
-            150, 50, 110, 30,
-            m_hWindowsControlPanel,
-            (HMENU)EXIT_STACK,
-            (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
-            NULL);
-        m_hNextStack = CreateWindowEx(
-            0,
-            L"BUTTON",
-            L"NEXT >",
-            WS_TABSTOP | WS_VISIBLE | WS_CHILD,
-            210, 82, 75, 25,
-            m_hWindowsControlPanel,
-            (HMENU)NEXT_STACK,
-            (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
-            NULL);
-        m_hPrevStack = CreateWindowEx(
-            0,
-            L"BUTTON",
-            L"< PREV",
-            WS_TABSTOP | WS_VISIBLE | WS_CHILD,
-            125, 82, 75, 25,
-            m_hWindowsControlPanel,
-            (HMENU)PREV_STACK,
-            (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
-            NULL);
-        EnableWindow(m_hPrevStack, FALSE);
-    }
-}
-
-void WindowsApp::StackWindowsCallback()
-{
-    int lastVector = WindowsVector.size() % 8;
-    int subVectorCount = (floor(float(WindowsVector.size()) / float(8))) + (lastVector == 0 ? 0 : 1);
-    (stackIndex == 0 ? EnableWindow(m_hPrevStack, FALSE) : EnableWindow(m_hPrevStack, TRUE));
-    (stackIndex == subVectorCount - 1 ? EnableWindow(m_hNextStack, FALSE) : EnableWindow(m_hNextStack, TRUE));
-
-    std::vector<WindowControl*> SubVector;
-    for (int i = 0; i < 8; i++) {
-        if (WindowsVector.size() <= (stackIndex * 8) + i) {
-            break;
-        }
-        SubVector.push_back(WindowsVector[(stackIndex * 8) + i]);
-    }
-    if (SubVector.size() <= 4) {
-        StackFourOrLess(SubVector);
-    }
-    else if (SubVector.size() <= 8) {
-        StackFiveToEight(SubVector);
-    }
-    SubVector.clear();
-}
-
-void WindowsApp::StackFourOrLess(std::vector<WindowControl*> SubVector) {
-    int stackFactorY;
-    int stackPosy = 0;
-    int i = 0;
-    stackFactorY = GetSystemMetrics(SM_CYSCREEN) / SubVector.size();
-    for (WindowControl* ctrl : SubVector) {
-        ShowWindow(ctrl->GetInstanceHandle(), SW_RESTORE);
-        SendMessage(ctrl->GetInstanceHandle(), WM_SYSCOMMAND, SC_RESTORE, 0);
-        SetWindowPos(ctrl->GetInstanceHandle(), HWND_TOPMOST, 0, stackPosy, GetSystemMetrics(SM_CXSCREEN), stackFactorY, NULL);
-        SetWindowPos(ctrl->GetInstanceHandle(), HWND_NOTOPMOST, 0, stackPosy, GetSystemMetrics(SM_CXSCREEN), stackFactorY, NULL);
-        stackPosy += stackFactorY;
-        i++;
-    }
-}
-
-void WindowsApp::StackFiveToEight(std::vector<WindowControl*>SubVector) {
-    int stackFactorYLeft;
-    int stackFactorYRight;
-    int stackPosy = 0;
-    int i = 0;
-    stackFactorYLeft = GetSystemMetrics(SM_CYSCREEN) / ceil(float(SubVector.size()) / float(2));
-    stackFactorYRight = GetSystemMetrics(SM_CYSCREEN) / floor(float(SubVector.size()) / float(2));
-    for (WindowControl* ctrl : SubVector) {
-        ShowWindow(ctrl->GetInstanceHandle(), SW_RESTORE);
-        SendMessage(ctrl->GetInstanceHandle(), WM_SYSCOMMAND, SC_RESTORE, 0);
-        if (i >= ceil(float(SubVector.size()) / float(2))) {
-
-            SetWindowPos(ctrl->GetInstanceHandle(), HWND_TOPMOST, GetSystemMetrics(SM_CXSCREEN) / 2, stackPosy, GetSystemMetrics(SM_CXSCREEN) / 2, stackFactorYRight, NULL);
-            SetWindowPos(ctrl->GetInstanceHandle(), HWND_NOTOPMOST, GetSystemMetrics(SM_CXSCREEN) / 2, stackPosy, GetSystemMetrics(SM_CXSCREEN) / 2, stackFactorYRight, NULL);
-
-            stackPosy += stackFactorYRight;
-        }
-
-        else {
-            SetWindowPos(ctrl->GetInstanceHandle(), HWND_TOPMOST, 0, stackPosy, GetSystemMetrics(SM_CXSCREEN) / 2, stackFactorYLeft, NULL);
-            SetWindowPos(ctrl->GetInstanceHandle(), HWND_NOTOPMOST, 0, stackPosy, GetSystemMetrics(SM_CXSCREEN) / 2, stackFactorYLeft, NULL);
-
-            stackPosy += stackFactorYLeft;
-        }
-        i++;
-        if (i == ceil(float(SubVector.size()) / float(2))) {
-            stackPosy = 0;
-        }
-    }
-}
-
-void WindowsApp::ExitStack() {
-    stackIndex = 0;
-    DestroyWindow(m_hPrevStack);
-    DestroyWindow(m_hNextStack);
-    DestroyWindow(m_hExitStack);
-    m_hStackButton = CreateWindowEx(
-        0,
-        L"BUTTON",
-        L"STACK",
-        WS_TABSTOP | WS_VISIBLE | WS_CHILD | BS_DEFPUSHBUTTON,
-        150, 50, 110, 30,
-        m_hWindowsControlPanel,
-        (HMENU)STACK,
-        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
-        NULL);
-}
-
- //   CASCADE WINDOWS   //
-
-void WindowsApp::CascadeWindows() {
-    WinWinFunctions::Cascade(ExtractHwnds(WindowsVector));
-    m_hSquish = CreateWindowEx(0,
-        L"BUTTON",
-        L"SQUISH",
-        WS_TABSTOP | WS_VISIBLE | WS_CHILD | BS_DEFPUSHBUTTON,
-        15, 82, 100, 25,
-        m_hWindowsControlPanel,
-        (HMENU)SQUISH,
-        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
-        NULL);
-}
-
-void WindowsApp::SquishCascade() {
-    WinWinFunctions::Squish(ExtractHwnds(WindowsVector));
-}
-
-  //   SAVE WINDOW LAYOUTS   //
-
-void WindowsApp::WinWinSaveLayout()
-{
-    WinWinFunctions::SaveWindowLayout(ExtractHwnds(WindowsVector));
-}
-
-void WindowsApp::WinWinViewSaved() {
-
-    wchar_t exeWcharPath[MAX_PATH];
-    GetModuleFileName(NULL, exeWcharPath, MAX_PATH);
-
-    std::wstring exePath(exeWcharPath);
-    std::wstring::size_type pos = exePath.find_last_of(L"\\/");
-    std::wstring exeDir = exePath.substr(0, pos);
-
-    SetCurrentDirectory(exeDir.c_str()); // Set the working directory to the executable's directory
-
-    std::wstring WinWinLayoutsFolder = exeDir + L"/SavedLayouts/";
-
-    std::wstring layoutName;
-    int xPos = 15;
-    int yPos = 140;
-    int i = 0;
-    
-    for (const auto& WinWinLayoutsFile : std::filesystem::directory_iterator(WinWinLayoutsFolder)) {
-        i++;
-        if (i >= 2) {
-            xPos = 15;
-            yPos += 30;
-            i = 0;
-        }
-        else {
-            xPos += 130;
-        }
-    }
-    // 1. Get the position of the old WindowsControl rect
-    // 2. Get the position of the old m_hwnd
-    // 3. Get the position of the new WindowsControl rect
-    //      a. x - 0
-    //      b. y - 0 | SWP_NOMOVE
-    //      c. cx - old WindowControlRectRight - old WindowControlRectLeft
-    //      d. cy - yPos + 40 for last button + buffer
-    // 4. set the position of the new m_hwnd
-    //      a. x - 0
-    //      b. y - 0 | SWP_NOMOVE
-    //      c. cx - old m_hwnd right - old m_hwnd left
-    //      d. cy - old m_hwnd bottom + yPos + 40
-    // 5. set the position of the new ActiveWindowsRect
-    //      a. x - 0
-    //      b. y - Bottom of new WindowsControl rect
-    //      c. cx - 0
-    //      d. cy - 0 | SWP_NOSIZE
-    // 6. Set the position of the new WindowsControl rect
-    
-
-    RECT m_WindowControlPrevRect;
-    GetWindowRect(m_hWindowsControlPanel, &m_WindowControlPrevRect);
-
-    RECT m_hwndPrevRect;
-    GetWindowRect(m_hwnd, &m_hwndPrevRect);
-
-    POINT WindowControlTopLeft = { m_WindowControlPrevRect.left, m_WindowControlPrevRect.top };
-    ScreenToClient(m_hwnd, &WindowControlTopLeft);
-
-    int newWindowControlCX = m_WindowControlPrevRect.right - m_WindowControlPrevRect.left;
-    int newWindowControlCY = yPos + 40;
-
-    int windowControlDiff = newWindowControlCY - (m_WindowControlPrevRect.bottom - m_WindowControlPrevRect.top);
-
-    SetWindowPos(m_hwnd, NULL, 0, 0, m_hwndPrevRect.right - m_hwndPrevRect.left, (m_hwndPrevRect.bottom - m_hwndPrevRect.top) + windowControlDiff, SWP_NOMOVE);
-        
-    SetWindowPos(m_hActiveWindowsControlPanel, NULL, 0, WindowControlTopLeft.y + newWindowControlCY, 0, 0, SWP_NOSIZE);
-
-    SetWindowPos(m_hWindowsControlPanel, NULL, 0, 0, newWindowControlCX, newWindowControlCY, SWP_NOMOVE);
-
-    xPos = 15;
-    yPos = 140;
-    i = 0;
-    for (const auto& WinWinLayoutsFile : std::filesystem::directory_iterator(WinWinLayoutsFolder)) {
-        layoutName = WinWinLayoutsFile.path().filename();
-        layoutButtons.push_back(CreateWindowEx(
-            0,
-            L"BUTTON",
-            layoutName.erase(layoutName.length() - 5).c_str(),
-            WS_TABSTOP | WS_VISIBLE | WS_CHILD | BS_DEFPUSHBUTTON,
-            xPos, yPos, 130, 30,
-            m_hWindowsControlPanel,
-            (HMENU)EXECUTE_LAYOUT,
-            (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
-            NULL));
-        i++;
-        if (i >= 2) {
-            xPos = 15;
-            yPos += 30;
-            i = 0;
-        }
-        else {
-            xPos += 130;
-        }
-
-    }
-    
-    DestroyWindow(m_hSavedConfigs);
-    m_hHideSavedConfigs = CreateWindowEx(
-        0,
-        L"BUTTON",
-        L"^",
-        WS_TABSTOP | WS_VISIBLE | WS_CHILD | BS_DEFPUSHBUTTON,
-        135, 110, 140, 30,
-        m_hWindowsControlPanel,
-        (HMENU)HIDE_SAVED_CONFIGS,
-        (HINSTANCE)GetWindowLongPtr(m_hWindowsControlPanel, GWLP_HINSTANCE),
-        NULL);
-}
-
-void WindowsApp::WinWinHideSaved() {
-    RECT prevRect3;
-    GetWindowRect(m_hwnd, &prevRect3);
-    for (HWND layoutButton : layoutButtons) {
-        DestroyWindow(layoutButton);
-    }
-    DestroyWindow(m_hHideSavedConfigs);
-    m_hSavedConfigs = CreateWindowExW(
-        0,
-        L"BUTTON",
-        L"WINDOW LAYOUTS",
-        WS_TABSTOP | WS_VISIBLE | WS_CHILD | BS_DEFPUSHBUTTON,
-        135, 110, 140, 30,
-        m_hWindowsControlPanel,
-        (HMENU)VIEW_SAVED_CONFIGS,
-        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
-        NULL);
-
-
-    RECT m_WindowControlPrevRect;
-    GetWindowRect(m_hWindowsControlPanel, &m_WindowControlPrevRect);
-
-    RECT m_hwndPrevRect;
-    GetWindowRect(m_hwnd, &m_hwndPrevRect);
-
-    POINT WindowControlTopLeft = { m_WindowControlPrevRect.left, m_WindowControlPrevRect.top };
-    ScreenToClient(m_hwnd, &WindowControlTopLeft);
-
-    int newWindowControlCX = m_WindowControlPrevRect.right - m_WindowControlPrevRect.left;
-    int newWindowControlCY = WINDOWS_CONTROL_CLOSED_Y;
-
-    int windowControlDiff = newWindowControlCY - (m_WindowControlPrevRect.bottom - m_WindowControlPrevRect.top);
-
-    SetWindowPos(m_hwnd, NULL, 0, 0, m_hwndPrevRect.right - m_hwndPrevRect.left, (m_hwndPrevRect.bottom - m_hwndPrevRect.top) + windowControlDiff, SWP_NOMOVE);
-
-    SetWindowPos(m_hActiveWindowsControlPanel, NULL, 0, WindowControlTopLeft.y + newWindowControlCY, 0, 0, SWP_NOSIZE);
-
-    SetWindowPos(m_hWindowsControlPanel, NULL, 0, 0, newWindowControlCX, newWindowControlCY, SWP_NOMOVE);
-}
-
-void WindowsApp::ExecuteSaved(std::wstring json) {
-    WinWinFunctions::ExecuteWindowLayout(json, ExtractHwnds(WindowsVector));
-}
-
- //   SAVE DESKTOP ICON LAYOUTS   //
-
-void WindowsApp::SaveDesktopLayout()
-{
-    WinWinFunctions::SaveDesktopLayout();
-}
-
-void WindowsApp::ViewSavedDesktopLayouts() {
-
-
-    wchar_t exeWcharPath[MAX_PATH];
-    GetModuleFileName(NULL, exeWcharPath, MAX_PATH);
-
-    std::wstring exePath(exeWcharPath);
-    std::wstring::size_type pos = exePath.find_last_of(L"\\/");
-    std::wstring exeDir = exePath.substr(0, pos);
-
-    SetCurrentDirectory(exeDir.c_str()); // Set the working directory to the executable's directory
-
-    std::wstring WinWinLayoutsFolder = exeDir + L"/SavedDesktopLayouts/";
-
-    std::wstring layoutName;
-    int xPos = 15;
-    int yPos = 100;
-    int i = 0;
-
-    for (const auto& WinWinLayoutsFile : std::filesystem::directory_iterator(WinWinLayoutsFolder)) {
-        i++;
-        if (i >= 2) {
-            xPos = 15;
-            yPos += 30;
-            i = 0;
-        }
-        else {
-            xPos += 130;
-        }
-    }
-
-    RECT m_IconControlPrevRect;
-    GetWindowRect(m_hIconControlPanel, &m_IconControlPrevRect);
-
-    int newWindowControlCX = m_IconControlPrevRect.right - m_IconControlPrevRect.left;
-    int newWindowControlCY = yPos + 40;
-
-    int windowControlDiff = newWindowControlCY - (m_IconControlPrevRect.bottom - m_IconControlPrevRect.top);
-
-    POINT IconControlTopLeft = { m_IconControlPrevRect.left, m_IconControlPrevRect.top };
-    ScreenToClient(m_hwnd, &IconControlTopLeft);
-
-    RECT ActiveWindowsPrevRect;
-    GetWindowRect(m_hActiveWindowsControlPanel, &ActiveWindowsPrevRect);
-    POINT ActiveWindowsTopLeft = { ActiveWindowsPrevRect.left, ActiveWindowsPrevRect.top };
-    ScreenToClient(m_hwnd, &ActiveWindowsTopLeft);
-
-    RECT m_WindowControlPrevRect;
-    GetWindowRect(m_hWindowsControlPanel, &m_WindowControlPrevRect);
-
-    RECT m_hwndPrevRect;
-    GetWindowRect(m_hwnd, &m_hwndPrevRect);
-
-    SetWindowPos(m_hwnd, NULL, 0, 0, m_hwndPrevRect.right - m_hwndPrevRect.left, (m_hwndPrevRect.bottom - m_hwndPrevRect.top) + windowControlDiff, SWP_NOMOVE);
-
-    SetWindowPos(m_hActiveWindowsControlPanel, NULL, 0, ActiveWindowsTopLeft.y + windowControlDiff, 0, 0, SWP_NOSIZE);
-    
-    SetWindowPos(m_hWindowsControlPanel, NULL, 0, IconControlTopLeft.y + newWindowControlCY, 0, 0, SWP_NOSIZE);
-
-    SetWindowPos(m_hIconControlPanel, NULL, 0, 0, newWindowControlCX, newWindowControlCY, SWP_NOMOVE);
-   
-
-    xPos = 15;
-    yPos = 100;
-    i = 0;
-    for (const auto& WinWinLayoutsFile : std::filesystem::directory_iterator(WinWinLayoutsFolder)) {
-        layoutName = WinWinLayoutsFile.path().filename();
-        desktopLayoutButtons.push_back(CreateWindowEx(
-            0,
-            L"BUTTON",
-            layoutName.erase(layoutName.length() - 5).c_str(),
-            WS_TABSTOP | WS_VISIBLE | WS_CHILD | BS_DEFPUSHBUTTON,
-            xPos, yPos, 130, 30,
-            m_hIconControlPanel,
-            (HMENU)EXECUTE_DESKTOP_LAYOUT,
-            (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
-            NULL));
-        i++;
-        if (i >= 2) {
-            xPos = 15;
-            yPos += 30;
-            i = 0;
-        }
-        else {
-            xPos += 130;
-        }
-    }
-    DestroyWindow(m_hSavedDesktopConfigs);
-    m_hHideSavedDesktopConfigs = CreateWindowEx(
-        0,
-        L"BUTTON",
-        L"^",
-        WS_TABSTOP | WS_VISIBLE | WS_CHILD | BS_DEFPUSHBUTTON,
-        150, 50, 110, 30,
-        m_hIconControlPanel,
-        (HMENU)HIDE_SAVED_DESKTOP_CONFIGS,
-        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
-        NULL);
-
-  
-
-    }
-
-void WindowsApp::HideSavedDesktopLayouts() {
-    RECT prevRect6;
-    GetWindowRect(m_hwnd, &prevRect6);
-    for (HWND layoutButton : desktopLayoutButtons) {
-        DestroyWindow(layoutButton);
-    }
-    DestroyWindow(m_hHideSavedDesktopConfigs);
-    m_hSavedDesktopConfigs = CreateWindowExW(
-        0,
-        L"BUTTON",
-        L"LAYOUTS",
-        WS_TABSTOP | WS_VISIBLE | WS_CHILD | BS_DEFPUSHBUTTON,
-        150, 50, 110, 30,
-        m_hwnd,
-        (HMENU)SAVED_DESKTOP_LAYOUTS,
-        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
-        NULL);
-
-    RECT m_IconControlPrevRect;
-    GetWindowRect(m_hIconControlPanel, &m_IconControlPrevRect);
-
-    int newWindowControlCX = m_IconControlPrevRect.right - m_IconControlPrevRect.left;
-    int newWindowControlCY = ICON_WINDOW_CLOSED_Y;
-
-    int windowControlDiff = newWindowControlCY - (m_IconControlPrevRect.bottom - m_IconControlPrevRect.top);
-
-    POINT IconControlTopLeft = { m_IconControlPrevRect.left, m_IconControlPrevRect.top };
-    ScreenToClient(m_hwnd, &IconControlTopLeft);
-
-    RECT ActiveWindowsPrevRect;
-    GetWindowRect(m_hActiveWindowsControlPanel, &ActiveWindowsPrevRect);
-    POINT ActiveWindowsTopLeft = { ActiveWindowsPrevRect.left, ActiveWindowsPrevRect.top };
-    ScreenToClient(m_hwnd, &ActiveWindowsTopLeft);
-
-    RECT m_WindowControlPrevRect;
-    GetWindowRect(m_hWindowsControlPanel, &m_WindowControlPrevRect);
-
-    RECT m_hwndPrevRect;
-    GetWindowRect(m_hwnd, &m_hwndPrevRect);
-
-    SetWindowPos(m_hwnd, NULL, 0, 0, m_hwndPrevRect.right - m_hwndPrevRect.left, (m_hwndPrevRect.bottom - m_hwndPrevRect.top) + windowControlDiff, SWP_NOMOVE);
-
-    SetWindowPos(m_hIconControlPanel, NULL, 0, 0, newWindowControlCX, newWindowControlCY, SWP_NOMOVE);
-
-    SetWindowPos(m_hWindowsControlPanel, NULL, 0, IconControlTopLeft.y + newWindowControlCY, 0, 0, SWP_NOSIZE);
-
-    SetWindowPos(m_hActiveWindowsControlPanel, NULL, 0, ActiveWindowsTopLeft.y + windowControlDiff, 0, 0, SWP_NOSIZE);
-}
-
-void WindowsApp::ExecuteSavedDesktopLayout(std::wstring json) {
-    WinWinFunctions::ExecuteDesktopLayout(json);
-}
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// WindowsApp.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.15 Worker progress and desktop results are shown in the panel titles, a layered stack clamps its layer to the current windows
+// 10/19/2026 MS-24.01.08.23 Nothing is enumerated at startup, the window list and layout pickers are created on first use, background services start after the first paint
+// 10/19/2026 MS-24.01.08.18 Buttons and panels are created once, toggles update a UiState and ApplyLayout makes one deferred layout pass
+// 10/19/2026 MS-24.01.08.17 Paint through GdiCache: no per-erase brushes, double buffered background, GDI counters logged after each command
+// 10/19/2026 MS-24.01.08.16 Saved layouts are listed in a searchable LayoutPicker instead of a button per layout
+// 10/19/2026 MS-24.01.08.16 Undo and redo accelerators are skipped while an edit control has the focus
+// 10/19/2026 MS-24.01.08.15 Layout names are asked for with AskLayoutName before the save is posted
+// 10/19/2026 MS-24.01.08.15 Window operations run on the WindowWorker thread, the UI only handles their progress and completion
+// 10/19/2026 MS-24.01.08.14 Refreshing the window list reconciles WindowControls by handle instead of leaking and recreating them
+// 10/19/2026 MS-24.01.08.13 The active window list is one owner-drawn WindowListView instead of a panel per window
+// 10/19/2026 MS-24.01.08.08 Log the number of icons moved by a desktop layout
+// 10/19/2026 MS-24.01.08.04 Switch workspace profiles on display changes
+// 10/19/2026 MS-24.01.08.02 Start the automatic layout snapshotter with the UI
+// 10/19/2026 MS-24.01.08.01 Added undo/redo of arranging operations to the Edit menu
+// 09/20/2024 MS-24.01.07.03 Fixed the scrollbar (finally)
+// 09/03/2024 MS-24.01.07.02 Moved all WinWin base functionality to WinWinFunctions for use with the command line and UI
+// 08/26/2024 MS-24.01.05.01 Reworked UI
+// 08/20/2024 MS-24.01.04.02 Added preprocessor definition for closed main window height
+// 08/19/2024 MS-24.01.04.01 Added ability to save layout configurations, fixed bugs in the stack function
+// 08/16/2024 MS-24.01.03.06 Refactored
+// 08/15/2024 MS-24.01.03.05 Fixed windows stack
+// 08/13/2024 MS-24.01.03.04 Added (currently useless) menu, added (currently useless) save Desktop Icons button
+// 08/12/2024 MS-24.01.03.03 Added Windows stack feature, renamed old stack to cascade
+// 08/12/2024 MS-24.01.03.01 Added functionality to executing saved layouts
+// 08/01/2024 MS-24.01.02.10 Added controls for viewing saved layouts, updated json folder to include multiple files for different layouts
+// 08/01/2024 MS-24.01.02.09 Added dropdown menu to hide active window list
+// 08/01/2024 MS-24.01.02.08 Added save layout button (saves current layout in a json file)
+// 08/01/2024 MS-24.01.02.07 Added stack windows button (broke scrolling again)
+// 07/25/2024 MS-24.01.02.06 Fixed scrolling, cleaned up window destruction for better memory management, updated child window size for sub control windows
+// 07/25/2024 MS-24.01.02.05 Added global oss to store active windows ostreamstring and added function to get all active windows to the create event
+// 07/25/2024 MS-24.01.02.2 Updated to be compatible with template window
+// 07/23/2024 MS-24.01.01.0 created
+//-----------------------------------------------
+// Main window UI source code
+//
+// Master code for UI functionality. Creates the main window and all child windows that aren't members of the ControlWindow class. 
+// Contains HandleMessage(), which handles all events sent to the main window. 
+// m_hwnd is the top level of the windows hierarchy, it is a parent to everything you see on screen.
+
+#include "WindowsApp.h"
+#include "StartupBench.h"
+#include <stdio.h>
+
+// Button IDs
+#define CASCADE 1
+#define SAVE_LAYOUT 2
+#define SHOW_ACTIVE_WINDOWS 3
+#define HIDE_ACTIVE_WINDOWS 4
+#define VIEW_SAVED_CONFIGS 5
+#define EXECUTE_LAYOUT 6
+#define HIDE_SAVED_CONFIGS 7
+#define STACK 8
+#define SAVE_DESKTOP_LAYOUT 9
+#define NEXT_STACK 10
+#define PREV_STACK 11
+#define EXIT_STACK 12
+#define SAVED_DESKTOP_LAYOUTS 13
+#define HIDE_SAVED_DESKTOP_CONFIGS 14
+#define EXECUTE_DESKTOP_LAYOUT 15
+#define SQUISH 16
+
+// Worker command IDs that don't come from a button
+#define REFRESH_WINDOWS 17
+#define APPLY_PROFILE 18
+
+// Posted by RequestLayout, handled by ApplyLayout
+#define WM_APPLY_LAYOUT (WM_APP + 3)
+
+// Posted after the first paint, handled by DeferredStart
+#define WM_DEFERRED_START (WM_APP + 4)
+
+// Timer IDs
+#define PROFILE_SWITCH_TIMER 1
+#define STATUS_TIMER 2
+
+// How long a command's result stays in a panel title before the title comes back
+#define STATUS_CLEAR_MS 4000
+
+// Panel titles, replaced by ShowStatus while commands run
+#define ICON_PANEL_TITLE L"Desktop Icon Manager"
+#define WINDOW_PANEL_TITLE L"Window Manager"
+
+// Time to wait for a burst of WM_DISPLAYCHANGE messages to settle before switching profiles
+#define PROFILE_SWITCH_DELAY_MS 2000
+
+
+INT_PTR CALLBACK DialogProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM lParam);
+
+WindowsApp::WindowsApp() : m_pendingCommands(0), m_layoutPending(false), m_firstPaintDone(false), m_exitAfterFirstPaint(false) {}
+
+///   GLOBALS   ///
+static std::wstring userInput;
+WNDPROC iconWindowProc;
+
+///   CALLBACK FUNCTIONS   ///
+
+static bool IsEditFocused() {
+    WCHAR className[16];
+    HWND focus = GetFocus();
+    return focus != NULL && GetClassName(focus, className, sizeof(className) / sizeof(className[0])) != 0 && lstrcmpi(className, L"Edit") == 0;
+}
+
+void WindowsApp::RunMessageLoop() {
+    MSG msg;
+    HACCEL hAccel = LoadAccelerators(GetModuleHandle(NULL), MAKEINTRESOURCE(IDR_ACCELERATOR1)); // Ctrl+Z / Ctrl+Y for undo and redo
+
+    while (GetMessage(&msg, NULL, 0, 0))
+    {
+        if (hAccel != NULL && !IsEditFocused() && TranslateAccelerator(m_hwnd, hAccel, &msg)) { // Ctrl+Z / Ctrl+Y in a text box edit the text
+            continue;
+        }
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+    }
+}
+
+LRESULT WindowsApp::HandleMessage(UINT uMsg, WPARAM wParam, LPARAM lParam)
+{
+    LRESULT lResult = 0;
+
+    switch (uMsg) {
+    case WM_CREATE:
+        HandleCreate();
+        break;
+    case WM_PAINT:
+        HandlePaint();
+        break;
+    case WM_SIZE:
+        HandleResize();
+        break;
+    case WM_ERASEBKGND:
+        return 1; // HandlePaint fills the background in its back buffer
+    case WM_VSCROLL:
+       HandleScroll(wParam, lParam);
+        break;
+    case WM_DISPLAYCHANGE:
+        SetTimer(m_hwnd, PROFILE_SWITCH_TIMER, PROFILE_SWITCH_DELAY_MS, NULL); // Docking sends several of these, restarting the timer waits for the last one
+        break;
+    case WM_TIMER:
+        if (wParam == PROFILE_SWITCH_TIMER) {
+            KillTimer(m_hwnd, PROFILE_SWITCH_TIMER);
+            // The switch enumerates and probes every window, up to a second per hung one, so it runs on the worker and never here
+            PostCommand(APPLY_PROFILE, [](WorkerResult&) { WorkspaceProfiles::OnDisplayChange(); });
+        }
+        else if (wParam == STATUS_TIMER) {
+            KillTimer(m_hwnd, STATUS_TIMER);
+            if (m_pendingCommands == 0) { // Otherwise the next WM_WORKER_PROGRESS replaces it
+                ClearStatus();
+            }
+        }
+        break;
+    case WM_SETCURSOR:
+        if (m_pendingCommands > 0 && LOWORD(lParam) == HTCLIENT) {
+            SetCursor(LoadCursor(NULL, IDC_APPSTARTING)); // The window still works, the cursor just shows that operations are running
+            return TRUE;
+        }
+        break;
+    case WM_WORKER_PROGRESS:
+        KillTimer(m_hwnd, STATUS_TIMER); // A new job replaces the last result
+        ShowStatus((int)wParam, lParam > 0 ? L"Working... (" + std::to_wstring((int)lParam) + L" queued)" : std::wstring(L"Working..."));
+        return 0;
+    case WM_WORKER_DONE:
+        HandleWorkerDone(reinterpret_cast<WorkerResult*>(lParam));
+        return 0;
+    case WM_APPLY_LAYOUT:
+        ApplyLayout();
+        return 0;
+    case WM_DEFERRED_START:
+        DeferredStart();
+        return 0;
+    case WM_INITMENUPOPUP:
+        EnableMenuItem((HMENU)wParam, ID_EDIT_UNDOARRANGE, MF_BYCOMMAND | (LayoutHistory::CanUndo() ? MF_ENABLED : MF_GRAYED));
+        EnableMenuItem((HMENU)wParam, ID_EDIT_REDOARRANGE, MF_BYCOMMAND | (LayoutHistory::CanRedo() ? MF_ENABLED : MF_GRAYED));
+        break;
+    case WM_COMMAND:
+        if (HIWORD(wParam) == BN_CLICKED || HIWORD(wParam) == 1) { // Buttons and menu items send BN_CLICKED (0), accelerators send 1
+            int id = LOWORD(wParam);   //Extract button id from the wParam and dispatch accordingly
+            int ControlY = ((WindowsVector.size() + 1) * 100) + 75;
+            switch (id) {
+            case CASCADE:
+                CascadeWindows();
+                break;
+            case STACK:
+                StackWindows();
+                break;
+            case NEXT_STACK:
+                stackIndex++;
+                StackWindowsCallback();
+                break;
+            case PREV_STACK:
+                stackIndex--;
+                StackWindowsCallback();
+                break;
+            case EXIT_STACK:
+                ExitStack();
+                break;
+            case SAVE_LAYOUT:
+                WinWinSaveLayout();
+                break;
+            case VIEW_SAVED_CONFIGS:
+                WinWinViewSaved();
+                break;
+            case HIDE_SAVED_CONFIGS:
+                WinWinHideSaved();
+                break;
+            case SHOW_ACTIVE_WINDOWS:
+                PostCommand(SHOW_ACTIVE_WINDOWS, EnumerateWindows); // The list opens when the enumeration comes back, see HandleWorkerDone
+                break;
+            case HIDE_ACTIVE_WINDOWS:
+                WinWinHideActive();
+                break;
+            case EXECUTE_LAYOUT:
+                ExecuteSaved(m_WindowLayoutPicker.SelectedName());
+                break;
+            case SAVE_DESKTOP_LAYOUT:
+                SaveDesktopLayout();
+                break;
+            case SAVED_DESKTOP_LAYOUTS:
+                ViewSavedDesktopLayouts();
+                break;
+            case HIDE_SAVED_DESKTOP_CONFIGS:
+                HideSavedDesktopLayouts();
+                break;
+            case EXECUTE_DESKTOP_LAYOUT:
+                ExecuteSavedDesktopLayout(m_DesktopLayoutPicker.SelectedName());
+                break;
+            case SQUISH:
+                SquishCascade();
+                break;
+            case ID_EDIT_UNDOARRANGE:
+                PostCommand(ID_EDIT_UNDOARRANGE, [](WorkerResult&) { LayoutHistory::Undo(); });
+                break;
+            case ID_EDIT_REDOARRANGE:
+                PostCommand(ID_EDIT_REDOARRANGE, [](WorkerResult&) { LayoutHistory::Redo(); });
+                break;
+}
+        RECT mainWindowRect;
+        GetWindowRect(m_hwnd, &mainWindowRect);
+        SetWindowPos(m_hwnd, HWND_TOPMOST, mainWindowRect.left, mainWindowRect.top, mainWindowRect.right - mainWindowRect.left, mainWindowRect.bottom - mainWindowRect.top, SWP_NOMOVE);
+}
+        break;  
+    case WM_CLOSE:
+        if (m_hwnd != NULL) {
+            DestroyWindow(m_hwnd);
+        }
+        break;
+    case WM_DESTROY:
+        WindowWorker::Stop();
+        LayoutSnapshotter::Stop();
+        PostQuitMessage(0);
+        break;
+    }
+    return DefWindowProc(m_hwnd, uMsg, wParam, lParam);
+}
+
+INT_PTR CALLBACK DialogProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM lParam) {
+    switch (message) {
+    case WM_INITDIALOG:
+        return TRUE;
+
+    case WM_COMMAND:
+        switch (LOWORD(wParam)) {
+        case IDOK: {
+            WCHAR text[256];
+            GetDlgItemText(hDlg, IDC_EDIT_TEXT, text, 256);
+            userInput = text; // Store the input text in the global variable
+            EndDialog(hDlg, IDOK);
+            return TRUE;
+        }
+        case IDCANCEL:
+            EndDialog(hDlg, IDCANCEL);
+            return TRUE;
+        }
+        break;
+    }
+    return FALSE;
+}
+
+LRESULT CALLBACK WindowsApp::ButtonProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam) {
+    static int yPos = 0; // Vertical scroll position
+
+    if (uMsg == WM_COMMAND || uMsg == WM_VSCROLL) {
+        SendMessage(GetParent(hwnd), uMsg, wParam, lParam);
+        return 0; 
+    }
+    return CallWindowProcW(iconWindowProc, hwnd, uMsg, wParam, lParam);
+}
+
+
+///   INITIALIZE   ///
+
+HRESULT WindowsApp::Initialize()
+{
+    HRESULT hr;
+    // See BaseWindow.cpp
+    hr = this->Create(L"Windows Window Extension Window",
+        WS_OVERLAPPEDWINDOW | WS_CLIPCHILDREN | WS_CLIPSIBLINGS,
+        0,
+        CW_USEDEFAULT,
+        CW_USEDEFAULT,
+        315,
+        M_HWND_CLOSED_Y
+    );
+    HMENU hMenu = LoadMenu(GetModuleHandle(NULL), MAKEINTRESOURCE(IDR_MENU1));
+    if (hMenu == NULL) {
+        MessageBoxW(NULL, L"Failed to load menu.", L"Error", MB_OK | MB_ICONERROR);
+        return 0;
+    }
+    SetMenu(m_hwnd, hMenu);
+    return hr;
+}
+
+HRESULT WindowsApp::HandleCreate() {
+    HRESULT hr = S_OK;
+    if (m_hwnd && m_hwnd != 0) { // WinMain shows the window once everything below exists, so the first frame is a complete one
+        m_hActiveWindowsControlPanel = CreateWindowExW(
+            0,
+            L"STATIC",
+            L"",
+            WS_CHILD | WS_VISIBLE | WS_CLIPCHILDREN | WS_CLIPSIBLINGS, 
+            0, SHOW_ACTIVE_WINDOWS_BUTTON_Y, 280, ACTIVE_WINDOWS_BUTTON_HEIGHT,
+            m_hwnd,
+            NULL,
+            (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
+            NULL);
+        m_hScrollBar = CreateWindowEx(
+            0,
+            L"SCROLLBAR",
+            NULL,
+            WS_CHILD | SBS_VERT | WS_CLIPCHILDREN | WS_CLIPSIBLINGS, // Shown with the active window list, see HandleResize
+            280, SHOW_ACTIVE_WINDOWS_BUTTON_Y, 20, 50,
+            m_hwnd, 
+            NULL, 
+            (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE), 
+            NULL
+        );
+        SCROLLINFO si;
+        si.cbSize = sizeof(si);
+        si.fMask = SIF_RANGE | SIF_PAGE;
+        si.nMin = 0;
+        si.nMax = 100;
+        si.nPage = 10;
+        SetScrollInfo(m_hScrollBar, SB_CTL, &si, TRUE);
+
+        controlWindowProc = (WNDPROC)SetWindowLongPtr(m_hActiveWindowsControlPanel, GWLP_WNDPROC, (LONG_PTR)ButtonProc);
+    }
+    CreateControlOpts(); // Create control buttons that are children of m_hwnd
+    WindowWorker::Start(m_hwnd); // Every window operation from here on runs on the worker
+    // The open windows aren't enumerated here. Every button that works on them enumerates on the worker, and the list enumerates when it's opened.
+    int ControlY = 400;
+//  SCROLLINFO si; // Set scroll information
+//  si.cbSize = sizeof(SCROLLINFO);
+//  si.fMask = SIF_RANGE | SIF_PAGE;
+//  si.nMin = 0;
+//  si.nMax = ControlY;
+//  si.nPage = 1000;
+//  if (m_hActiveWindowsControlPanel != 0) {
+//      SetScrollInfo(m_hActiveWindowsControlPanel, SB_VERT, &si, TRUE);
+//  }
+
+    return hr;
+}
+
+void WindowsApp::DeferredStart() {
+    WorkspaceProfiles::Activate(); // The windows are arranged for the monitors WinWin started with
+    LayoutSnapshotter::Start(); // Snapshot the arrangement in the background whenever it changes
+}
+
+void WindowsApp::ExitAfterFirstPaint() {
+    m_exitAfterFirstPaint = true;
+}
+
+void WindowsApp::CreateControlOpts() {
+    
+    // Icon Control
+    m_hIconControlPanel = CreateWindowEx(
+        0,
+        L"STATIC",
+        L"",
+        WS_CHILD | WS_VISIBLE | WS_BORDER | WS_CLIPCHILDREN | WS_CLIPSIBLINGS, 
+        0,
+        0,
+        300,
+        100,
+        m_hwnd,
+        NULL,
+        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
+        NULL
+    );
+    iconWindowProc = (WNDPROC)SetWindowLongPtr(m_hIconControlPanel, GWLP_WNDPROC, (LONG_PTR)ButtonProc);
+
+
+     m_IconTitle = CreateWindowEx(
+        0, TEXT("STATIC"), ICON_PANEL_TITLE,
+        WS_CHILD | WS_VISIBLE,
+        60, 10, 200, 30,
+         m_hIconControlPanel, NULL, GetModuleHandle(NULL), NULL);
+
+    m_hSavedDesktopConfigs = CreateWindowEx(
+        0,
+        L"BUTTON",
+        L"ICON LAYOUTS",
+        WS_TABSTOP | WS_VISIBLE | WS_CHILD | BS_DEFPUSHBUTTON,
+        150, 50, 110, 30,
+        m_hIconControlPanel,
+        (HMENU)SAVED_DESKTOP_LAYOUTS,
+        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
+        NULL);
+    m_hSaveDesktopLayout = CreateWindowEx(
+        0,
+        L"BUTTON",
+        L"SAVE ICONS",
+        WS_TABSTOP | WS_VISIBLE | WS_CHILD | BS_DEFPUSHBUTTON,
+        10, 50, 110, 30,
+        m_hIconControlPanel,
+        (HMENU)SAVE_DESKTOP_LAYOUT,
+        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
+        NULL
+    );
+    
+    // Window Control
+
+    m_hWindowsControlPanel = CreateWindowExW(
+        0,
+        L"STATIC",
+        L"",
+        WS_CHILD | WS_VISIBLE | WS_BORDER | WS_CLIPCHILDREN | WS_CLIPSIBLINGS, 
+        0,
+        100,
+        300,
+        150,
+        m_hwnd,
+        NULL,
+        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
+        NULL
+    );
+
+    windowWindowProc = (WNDPROC)SetWindowLongPtr(m_hWindowsControlPanel, GWLP_WNDPROC, (LONG_PTR)ButtonProc);
+
+    m_WindowTitle = CreateWindowEx(
+            0, TEXT("STATIC"), WINDOW_PANEL_TITLE,
+            WS_CHILD | WS_VISIBLE,
+            75, 10, 200, 30,
+        m_hWindowsControlPanel, NULL, GetModuleHandle(NULL), NULL);
+
+    m_hCascadeButton = CreateWindowEx(
+        0,
+        L"BUTTON",
+        L"CASCADE",
+        WS_TABSTOP | WS_VISIBLE | WS_CHILD | BS_DEFPUSHBUTTON,
+        10, 50, 110, 30,
+        m_hWindowsControlPanel,
+        (HMENU)CASCADE,
+        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
+        NULL);
+
+    m_hStackButton = CreateWindowEx(
+        0,
+        L"BUTTON",
+        L"STACK",
+        WS_TABSTOP | WS_VISIBLE | WS_CHILD | BS_DEFPUSHBUTTON,
+        150, 50, 110, 30,
+        m_hWindowsControlPanel,
+        (HMENU)STACK,
+        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
+        NULL);
+
+    m_hNextStack = CreateWindowEx( // Shown during a multilayered stack
+        0,
+        L"BUTTON",
+        L"NEXT >",
+        WS_TABSTOP | WS_CHILD,
+        210, 82, 75, 25,
+        m_hWindowsControlPanel,
+        (HMENU)NEXT_STACK,
+        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
+        NULL);
+
+    m_hPrevStack = CreateWindowEx( // Shown during a multilayered stack
+        0,
+        L"BUTTON",
+        L"< PREV",
+        WS_TABSTOP | WS_CHILD,
+        125, 82, 75, 25,
+        m_hWindowsControlPanel,
+        (HMENU)PREV_STACK,
+        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
+        NULL);
+
+    m_hSquish = CreateWindowEx( // Shown once a cascade has run
+        0,
+        L"BUTTON",
+        L"SQUISH",
+        WS_TABSTOP | WS_CHILD | BS_DEFPUSHBUTTON,
+        15, 82, 100, 25,
+        m_hWindowsControlPanel,
+        (HMENU)SQUISH,
+        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
+        NULL);
+
+    m_hSaveWinLayout = CreateWindowEx(
+        0,
+        L"BUTTON",
+        L"SAVE LAYOUT",
+        WS_TABSTOP | WS_VISIBLE | WS_CHILD | BS_DEFPUSHBUTTON,
+        5, 110, 120, 30,
+        m_hWindowsControlPanel,
+        (HMENU)SAVE_LAYOUT,
+        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
+        NULL);
+
+    m_hSavedConfigs = CreateWindowEx(
+        0,
+        L"BUTTON",
+        L"WINDOW LAYOUTS",
+        WS_TABSTOP | WS_VISIBLE | WS_CHILD | BS_DEFPUSHBUTTON,
+        135, 110, 140, 30,
+        m_hWindowsControlPanel,
+        (HMENU)VIEW_SAVED_CONFIGS,
+        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
+        NULL);
+
+  
+    // Active Window Control
+    m_hShowWindows = CreateWindowEx(
+        0,
+        L"BUTTON",
+        L"V",
+        WS_TABSTOP | WS_VISIBLE | WS_CHILD,
+        10, 0, 270, ACTIVE_WINDOWS_BUTTON_HEIGHT,
+        m_hActiveWindowsControlPanel,
+        (HMENU)SHOW_ACTIVE_WINDOWS,
+        (HINSTANCE)GetWindowLongPtr(m_hwnd, GWLP_HINSTANCE),
+        NULL);
+}
+
+///   UTILITIIES   ///
+
+std::vector<HWND> WindowsApp::ExtractHwnds(std::vector<WindowControl*> windowControls) {
+    std::vector<HWND> hwnds;
+    hwnds.reserve(windowControls.size()); // Reserve space to avoid reallocations
+
+    for (WindowControl* ctrl : windowControls) {
+        hwnds.push_back(ctrl->GetInstanceHandle());
+    }
+
+    return hwnds;
+}
+
+std::vector<HWND> WindowsApp::ExtractHwnds(const std::vector<std::pair<HWND, std::wstring>>& Windows) {
+    std::vector<HWND> hwnds;
+    hwnds.reserve(Windows.size());
+
+    for (const auto& window : Windows) {
+        hwnds.push_back(window.first);
+    }
+
+    return hwnds;
+}
+
+std::vector<std::wstring> WindowsApp::ListLayoutNames(const std::wstring& folder) {
+    std::vector<std::wstring> Names;
+    std::error_code ec;
+    for (const auto& LayoutFile : std::filesystem::directory_iterator(folder, ec)) {
+        if (LayoutFile.path().extension() == L".json") { // Skips the .json.changes journals saved next to desktop layouts
+            Names.push_back(LayoutFile.path().stem().wstring());
+        }
+    }
+    return Names;
+}
+
+void WindowsApp::PostCommand(int command, WindowWorker::Job job) {
+    m_pendingCommands++;
+    WindowWorker::Post(command, std::move(job));
+}
+
+std::string WindowsApp::ConvertToNarrowString(const std::wstring& wstr) {
+    if (wstr.empty()) {
+        return std::string();
+    }
+
+    int size_needed = WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), -1, NULL, 0, NULL, NULL);
+    if (size_needed == 0) {
+        throw std::runtime_error("WideCharToMultiByte failed");
+    }
+
+    std::string str(size_needed, 0);
+    int result = WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), -1, &str[0], size_needed, NULL, NULL);
+    if (result == 0) {
+        throw std::runtime_error("WideCharToMultiByte failed");
+    }
+
+    // Remove the null terminator added by WideCharToMultiByte
+    str.resize(size_needed - 1);
+
+    return str;
+}
+
+void WindowsApp::RequestLayout() {
+    if (m_layoutPending) {
+        return; // Toggles handled before the pass runs share it
+    }
+    m_layoutPending = true;
+    PostMessage(m_hwnd, WM_APPLY_LAYOUT, 0, 0);
+}
+
+static void SetToggle(HWND button, bool on, int onId, LPCWSTR onText, int offId, LPCWSTR offText) {
+    int id = on ? onId : offId;
+    if (GetWindowLongPtr(button, GWLP_ID) != id) { // Only a toggle that changed is retitled and repainted
+        SetWindowLongPtr(button, GWLP_ID, id);
+        SetWindowText(button, on ? onText : offText);
+    }
+}
+
+static void SetShown(HWND hwnd, bool shown) {
+    if ((IsWindowVisible(hwnd) != FALSE) != shown) {
+        ShowWindow(hwnd, shown ? SW_SHOWNA : SW_HIDE);
+    }
+}
+
+void WindowsApp::ApplyLayout() {
+    m_layoutPending = false;
+
+    // Buttons
+    SetToggle(m_hShowWindows, m_UiState.activeListOpen, HIDE_ACTIVE_WINDOWS, L"^", SHOW_ACTIVE_WINDOWS, L"V");
+    SetToggle(m_hSavedConfigs, m_UiState.windowLayoutsOpen, HIDE_SAVED_CONFIGS, L"^", VIEW_SAVED_CONFIGS, L"WINDOW LAYOUTS");
+    SetToggle(m_hSavedDesktopConfigs, m_UiState.desktopLayoutsOpen, HIDE_SAVED_DESKTOP_CONFIGS, L"^", SAVED_DESKTOP_LAYOUTS, L"ICON LAYOUTS");
+    SetToggle(m_hStackButton, m_UiState.layeredStack, EXIT_STACK, L"EXIT STACK", STACK, L"STACK");
+    SetShown(m_hPrevStack, m_UiState.layeredStack);
+    SetShown(m_hNextStack, m_UiState.layeredStack);
+    EnableWindow(m_hPrevStack, m_UiState.stackHasPrev);
+    EnableWindow(m_hNextStack, m_UiState.stackHasNext);
+    SetShown(m_hSquish, m_UiState.squishAvailable);
+
+    // Dropdowns
+    if (m_UiState.windowLayoutsOpen != (IsWindowVisible(m_WindowLayoutPicker.Handle()) != FALSE)) {
+        m_UiState.windowLayoutsOpen ? m_WindowLayoutPicker.Show() : m_WindowLayoutPicker.Hide();
+    }
+    if (m_UiState.desktopLayoutsOpen != (IsWindowVisible(m_DesktopLayoutPicker.Handle()) != FALSE)) {
+        m_UiState.desktopLayoutsOpen ? m_DesktopLayoutPicker.Show() : m_DesktopLayoutPicker.Hide();
+    }
+    SetShown(m_WindowList.Handle(), m_UiState.activeListOpen);
+
+    // Panels, moved together
+    UiLayout layout = m_UiState.Layout(LAYOUT_PICKER_HEIGHT);
+    HDWP batch = BeginDeferWindowPos(2);
+    batch = DeferWindowPos(batch, m_hIconControlPanel, NULL, 0, 0, CONTROL_PANEL_WIDTH, layout.iconPanelHeight, SWP_NOZORDER | SWP_NOACTIVATE);
+    batch = DeferWindowPos(batch, m_hWindowsControlPanel, NULL, 0, layout.windowsPanelY, CONTROL_PANEL_WIDTH, layout.windowsPanelHeight, SWP_NOZORDER | SWP_NOACTIVATE);
+    EndDeferWindowPos(batch);
+
+    // The main window last. A new height sends WM_SIZE, which places the active windows panel; otherwise place it here.
+    RECT windowRect;
+    GetWindowRect(m_hwnd, &windowRect);
+    if (windowRect.bottom - windowRect.top != layout.windowHeight) {
+        SetWindowPos(m_hwnd, NULL, 0, 0, windowRect.right - windowRect.left, layout.windowHeight, SWP_NOMOVE | SWP_NOZORDER | SWP_NOACTIVATE);
+    }
+    else {
+        HandleResize();
+    }
+}
+
+///   HANDLE BASIC WINDOW EVENTS   ///
+
+void WindowsApp::HandleScroll(WPARAM wParam, LPARAM lParam) {
+    int yPos = 0;
+    if ((HWND)lParam == m_hScrollBar) {
+        int yDelta = 0; // Distance to scroll
+        int yNewPos; // New position of scroll box
+
+        // Get the current scroll position
+        SCROLLINFO si;
+        si.cbSize = sizeof(si);
+        si.fMask = SIF_ALL;
+        GetScrollInfo(m_hScrollBar, SB_CTL, &si);
+        yPos = si.nPos;
+
+        switch (LOWORD(wParam)) {
+        case SB_LINEUP:
+            yDelta = -1; // Scroll up one line
+            break;
+        case SB_LINEDOWN:
+            yDelta = 1; // Scroll down one line
+            break;
+        case SB_PAGEUP:
+            yDelta = -10; // Scroll up one page
+            break;
+        case SB_PAGEDOWN:
+            yDelta = 10; // Scroll down one page
+            break;
+        case SB_THUMBTRACK:
+            yNewPos = HIWORD(wParam); // Drag scroll box to new position
+            yDelta = yNewPos - yPos;
+            break;
+        default:
+            yDelta = 0;
+        }
+
+        // V Update the scroll position V
+        yPos += yDelta;
+        yPos = max(0, min(yPos, si.nMax - (int)si.nPage + 1)); // Ensure the position is within the range
+        si.fMask = SIF_POS;
+        si.nPos = yPos;
+        SetScrollInfo(m_hScrollBar, SB_CTL, &si, TRUE);
+
+        m_WindowList.SetScroll(yPos);   // The list repaints its visible rows at the new offset
+
+    }
+}
+
+void WindowsApp::HandlePaint() {
+    PAINTSTRUCT ps;
+    HDC hdc = BeginPaint(m_hwnd, &ps);
+    {
+        // Double buffering
+        // In order to reduce a flickering effect from scrolling and resizing, the background is drawn to GdiCache's back buffer and blitted
+        // to the window in one go. The back buffer and brush are reused on every paint instead of being created and deleted each time.
+        PaintBuffer buffer(hdc, ps.rcPaint);
+        FillRect(buffer.DC(), &ps.rcPaint, GdiCache::Brush(GetSysColor(COLOR_WINDOW)));
+    }
+    EndPaint(m_hwnd, &ps);
+
+    if (!m_firstPaintDone) { // Cold start ends with the first complete frame
+        m_firstPaintDone = true;
+        RedrawWindow(m_hwnd, NULL, NULL, RDW_UPDATENOW | RDW_ALLCHILDREN); // The buttons paint now rather than after this message
+        double firstPaint = StartupBench::SinceProcessStart();
+        OutputDebugStringW((L"WinWin: first paint " + std::to_wstring(firstPaint) + L" ms after start\n").c_str());
+        if (m_exitAfterFirstPaint) { // Under StartupBench, report and leave without starting anything else
+            printf("%.3f\n", firstPaint);
+            fflush(stdout);
+            PostMessage(m_hwnd, WM_CLOSE, 0, 0);
+        }
+        else {
+            PostMessage(m_hwnd, WM_DEFERRED_START, 0, 0);
+        }
+    }
+}
+
+void WindowsApp::HandleResize(){
+    if (m_hwnd == NULL || m_hActiveWindowsControlPanel == NULL) {
+        return; // WM_SIZE arrives during WM_CREATE, before the panels exist
+    }
+    RECT client;
+    GetClientRect(m_hwnd, &client);
+    int activePanelY = m_UiState.Layout(LAYOUT_PICKER_HEIGHT).activePanelY;
+
+    int panelHeight = ACTIVE_WINDOWS_BUTTON_HEIGHT;
+    if (m_UiState.activeListOpen) {
+        panelHeight = max(panelHeight, (int)client.bottom - activePanelY); // The open list fills the rest of the window
+    }
+    int listHeight = panelHeight - ACTIVE_WINDOWS_BUTTON_HEIGHT;
+
+    HDWP batch = BeginDeferWindowPos(2);
+    batch = DeferWindowPos(batch, m_hActiveWindowsControlPanel, NULL, 0, activePanelY, 280, panelHeight, SWP_NOZORDER | SWP_NOACTIVATE);
+    batch = DeferWindowPos(batch, m_hScrollBar, NULL, 280, activePanelY, 20, panelHeight,
+        SWP_NOZORDER | SWP_NOACTIVATE | (m_UiState.activeListOpen ? SWP_SHOWWINDOW : SWP_HIDEWINDOW));
+    EndDeferWindowPos(batch);
+    if (m_WindowList.Handle() != NULL) { // Not created until the list is first opened
+        SetWindowPos(m_WindowList.Handle(), NULL, 0, ACTIVE_WINDOWS_BUTTON_HEIGHT, 280, listHeight, SWP_NOZORDER | SWP_NOACTIVATE); // A child of the panel, so not in the batch
+    }
+
+    SCROLLINFO si;  // Update the scrolling info with the new list size
+    si.cbSize = sizeof(si);
+    si.fMask = SIF_RANGE | SIF_PAGE | SIF_POS;
+    si.nMin = 0;
+    si.nMax = max(0, m_WindowList.Model().ContentHeight() - 1);
+    si.nPage = max(1, listHeight);
+    si.nPos = m_WindowList.Model().Scroll(); // Resizing can clamp the list's offset
+    SetScrollInfo(m_hScrollBar, SB_CTL, &si, TRUE);
+}
+
+///   WINDOW RESOURCES   ///
+
+std::wstring WindowsApp::GetUserInput(HINSTANCE hInstance) {
+    userInput.clear(); // Clear previous input
+    if (DialogBox(hInstance, MAKEINTRESOURCE(IDD_SIMPLE_INPUT_DIALOG), NULL, DialogProc) == IDOK) {
+        return userInput;
+    }
+    return L"";
+}
+
+std::wstring WindowsApp::AskLayoutName() {
+    std::wstring layoutName = GetUserInput(GetModuleHandle(NULL));
+    if (!layoutName.empty() && layoutName.back() == L'\0') layoutName.pop_back();
+    if (layoutName.empty()) { layoutName = L"NewLayout"; } // An empty name would make WinWinFunctions ask again, on the worker thread
+    return layoutName;
+}
+
+///   HANDLE WINDOWS_WINDOWS EVENTS   ///
+//    WORKER RESULTS   //
+
+void WindowsApp::HandleWorkerDone(WorkerResult* Done) {
+    std::unique_ptr<WorkerResult> Result(Done);
+    m_pendingCommands--;
+    if (!Result->error.empty()) {
+        OutputDebugStringA(("WinWin: command " + std::to_string(Result->command) + " failed: " + Result->error + "\n").c_str());
+    }
+    GdiCounters gdi = GdiCache::Counters(); // A GDI object count that keeps climbing across commands is a leak
+    OutputDebugStringW((L"WinWin: GDI objects " + std::to_wstring(gdi.gdiObjects) + L" (peak " + std::to_wstring(gdi.peakGdiObjects) + L"), cache "
+        + std::to_wstring(gdi.brushes) + L" brushes " + std::to_wstring(gdi.fonts) + L" fonts, " + std::to_wstring(gdi.created) + L" created "
+        + std::to_wstring(gdi.hits) + L" hits\n").c_str());
+    if (Result->enumerated) {
+        ReconcileWindows(Result->Windows);
+    }
+
+    switch (Result->command) {
+    case SHOW_ACTIVE_WINDOWS:
+        if (!m_UiState.activeListOpen) { // A second click while the first was queued only refreshes the open list
+            WinWinShowActive();
+        }
+        break;
+    case CASCADE:
+        if (Result->error.empty() && !m_UiState.squishAvailable) {
+            m_UiState.squishAvailable = true;
+            RequestLayout();
+        }
+        break;
+    case STACK:
+        if (Result->count > 8) {
+            StartLayeredStack();
+        }
+        break;
+    }
+
+    if (!Result->error.empty()) {
+        ShowStatus(Result->command, L"Failed");
+    }
+    else if (Result->command == EXECUTE_DESKTOP_LAYOUT) {
+        ShowStatus(Result->command, std::to_wstring(Result->count) + (Result->count == 1 ? L" icon moved" : L" icons moved"));
+    }
+    else if (Result->command == SAVE_DESKTOP_LAYOUT) {
+        ShowStatus(Result->command, Result->count > 0 ? L"Icons saved" : L"Icons not saved");
+    }
+    else {
+        if (m_pendingCommands == 0) {
+            ClearStatus();
+        }
+        return;
+    }
+    SetTimer(m_hwnd, STATUS_TIMER, STATUS_CLEAR_MS, NULL); // The result stays up for a while, then the title comes back
+}
+
+void WindowsApp::ShowStatus(int command, const std::wstring& text) {
+    bool desktop = command == SAVE_DESKTOP_LAYOUT || command == EXECUTE_DESKTOP_LAYOUT;
+    SetWindowText(desktop ? m_IconTitle : m_WindowTitle, text.c_str());
+    SetWindowText(desktop ? m_WindowTitle : m_IconTitle, desktop ? WINDOW_PANEL_TITLE : ICON_PANEL_TITLE); // Only one status at a time
+}
+
+void WindowsApp::ClearStatus() {
+    SetWindowText(m_IconTitle, ICON_PANEL_TITLE);
+    SetWindowText(m_WindowTitle, WINDOW_PANEL_TITLE);
+}
+
+//    PRINT ACTIVE WINDOWS   //  
+
+void WindowsApp::PrintActiveWindows() {
+    PostCommand(REFRESH_WINDOWS, EnumerateWindows);
+}
+
+void WindowsApp::EnumerateWindows(WorkerResult& Result) {
+    EnumWindows(EnumWindowsProc, reinterpret_cast<LPARAM>(&Result.Windows)); // Enumerate through the windows with this callback function. 
+                                                                             //EnumWindowsProc is a custom method, see BaseWindow.cpp
+    Result.enumerated = true;
+}
+
+void WindowsApp::ReconcileWindows(std::vector<std::pair<HWND, std::wstring>>& Windows) {
+    std::unordered_map<HWND, WindowControl*> Existing; // Current controls keyed by the window they represent
+    Existing.reserve(WindowsVector.size());
+    for (WindowControl* ctrl : WindowsVector) {
+        Existing.emplace(ctrl->GetInstanceHandle(), ctrl);
+    }
+
+    bool changed = Windows.size() != WindowsVector.size();
+    std::vector<WindowControl*> Reconciled;
+    Reconciled.reserve(Windows.size());
+    for (auto& [hwnd, title] : Windows) {
+        WindowControl* ctrl;
+        auto found = Existing.find(hwnd);
+        if (found == Existing.end()) { // New window
+            ctrl = new WindowControl(hwnd, std::move(title));
+            changed = true;
+        }
+        else { // Same window, keep its control and update the title in place
+            ctrl = found->second;
+            Existing.erase(found);
+            changed |= ctrl->SetInstanceTitle(std::move(title));
+        }
+        if (!changed && WindowsVector[Reconciled.size()] != ctrl) { // Same windows, different z order
+            changed = true;
+        }
+        Reconciled.push_back(ctrl);
+    }
+    for (auto& [hwnd, ctrl] : Existing) { // Whatever wasn't claimed belongs to a window that's gone
+        delete ctrl;
+    }
+    WindowsVector.swap(Reconciled);
+
+    if (changed && m_UiState.activeListOpen) { // An open list follows refreshes from the other buttons
+        m_WindowList.SetRows(WindowsVector);
+        HandleResize(); // New scroll range, the window keeps its size
+    }
+}
+
+void WindowsApp::WinWinShowActive() {
+    if (m_WindowList.Handle() == NULL) {
+        m_WindowList.Create(m_hActiveWindowsControlPanel, 0, ACTIVE_WINDOWS_BUTTON_HEIGHT, 280, 0); // Hidden until the layout pass shows it, HandleResize sizes it
+    }
+    m_UiState.activeListOpen = true;
+    m_UiState.listRows = WindowsVector.size();
+    m_WindowList.SetRows(WindowsVector);
+    RequestLayout();
+}
+
+void WindowsApp::WinWinHideActive() {
+    m_UiState.activeListOpen = false;
+    RequestLayout();
+}
+
+//   STACK WINDOWS   //
+
+void WindowsApp::StackWindows()
+{
+    PostCommand(STACK, [](WorkerResult& Result) {
+        EnumerateWindows(Result);
+        Result.count = (int)Result.Windows.size();
+        if (Result.Windows.size() <= 8) {
+            WinWinFunctions::Stack(ExtractHwnds(Result.Windows));
+        }
+    });
+}
+
+void WindowsApp::StartLayeredStack()
+{
+    stackIndex = 0;
+    m_UiState.layeredStack = true;
+    StackWindowsCallback();
+}
+
+void WindowsApp::StackWindowsCallback()
+{
+    int lastVector = WindowsVector.size() % 8;
+    int subVectorCount = (floor(float(WindowsVector.size()) / float(8))) + (lastVector == 0 ? 0 : 1);
+    if (subVectorCount == 0) { // Every window closed since the stack started, there's no layer left to show
+        ExitStack();
+        return;
+    }
+    stackIndex = max(0, min(stackIndex, subVectorCount - 1)); // The list is reconciled between layers, so it may have lost a layer
+    m_UiState.stackHasPrev = stackIndex != 0;
+    m_UiState.stackHasNext = stackIndex != subVectorCount - 1;
+    RequestLayout();
+
+    std::vector<HWND> SubVector; // Handles, not controls, so a refresh on the UI thread can't delete them under the worker
+    for (int i = 0; i < 8; i++) {
+        if (WindowsVector.size() <= (stackIndex * 8) + i) {
+            break;
+        }
+        SubVector.push_back(WindowsVector[(stackIndex * 8) + i]->GetInstanceHandle());
+    }
+    if (SubVector.empty()) {
+        return;
+    }
+    PostCommand(NEXT_STACK, [SubVector](WorkerResult&) {
+        LayoutHistory::Capture(SubVector); // Each layer is its own arranging operation, so each can be undone
+        if (SubVector.size() <= 4) {
+            StackFourOrLess(SubVector);
+        }
+        else if (SubVector.size() <= 8) {
+            StackFiveToEight(SubVector);
+        }
+    });
+}
+
+void WindowsApp::StackFourOrLess(std::vector<HWND> SubVector) {
+    if (SubVector.empty()) {
+        return;
+    }
+    int stackFactorY;
+    int stackPosy = 0;
+    int i = 0;
+    stackFactorY = GetSystemMetrics(SM_CYSCREEN) / SubVector.size();
+    for (HWND hwnd : SubVector) {
+        ShowWindow(hwnd, SW_RESTORE);
+        SendMessage(hwnd, WM_SYSCOMMAND, SC_RESTORE, 0);
+        SetWindowPos(hwnd, HWND_TOPMOST, 0, stackPosy, GetSystemMetrics(SM_CXSCREEN), stackFactorY, NULL);
+        SetWindowPos(hwnd, HWND_NOTOPMOST, 0, stackPosy, GetSystemMetrics(SM_CXSCREEN), stackFactorY, NULL);
+        stackPosy += stackFactorY;
+        i++;
+    }
+}
+
+void WindowsApp::StackFiveToEight(std::vector<HWND> SubVector) {
+    int stackFactorYLeft;
+    int stackFactorYRight;
+    int stackPosy = 0;
+    int i = 0;
+    stackFactorYLeft = GetSystemMetrics(SM_CYSCREEN) / ceil(float(SubVector.size()) / float(2));
+    stackFactorYRight = GetSystemMetrics(SM_CYSCREEN) / floor(float(SubVector.size()) / float(2));
+    for (HWND hwnd : SubVector) {
+        ShowWindow(hwnd, SW_RESTORE);
+        SendMessage(hwnd, WM_SYSCOMMAND, SC_RESTORE, 0);
+        if (i >= ceil(float(SubVector.size()) / float(2))) {
+
+            SetWindowPos(hwnd, HWND_TOPMOST, GetSystemMetrics(SM_CXSCREEN) / 2, stackPosy, GetSystemMetrics(SM_CXSCREEN) / 2, stackFactorYRight, NULL);
+            SetWindowPos(hwnd, HWND_NOTOPMOST, GetSystemMetrics(SM_CXSCREEN) / 2, stackPosy, GetSystemMetrics(SM_CXSCREEN) / 2, stackFactorYRight, NULL);
+
+            stackPosy += stackFactorYRight;
+        }
+
+        else {
+            SetWindowPos(hwnd, HWND_TOPMOST, 0, stackPosy, GetSystemMetrics(SM_CXSCREEN) / 2, stackFactorYLeft, NULL);
+            SetWindowPos(hwnd, HWND_NOTOPMOST, 0, stackPosy, GetSystemMetrics(SM_CXSCREEN) / 2, stackFactorYLeft, NULL);
+
+            stackPosy += stackFactorYLeft;
+        }
+        i++;
+        if (i == ceil(float(SubVector.size()) / float(2))) {
+            stackPosy = 0;
+        }
+    }
+}
+
+void WindowsApp::ExitStack() {
+    stackIndex = 0;
+    m_UiState.layeredStack = false;
+    RequestLayout();
+}
+
+ //   CASCADE WINDOWS   //
+
+void WindowsApp::CascadeWindows() {
+    PostCommand(CASCADE, [](WorkerResult& Result) {
+        EnumerateWindows(Result);
+        WinWinFunctions::Cascade(ExtractHwnds(Result.Windows));
+    });
+}
+
+void WindowsApp::SquishCascade() {
+    std::vector<HWND> Windows = ExtractHwnds(WindowsVector); // The windows of the cascade, refreshed when it ran
+    PostCommand(SQUISH, [Windows](WorkerResult&) { WinWinFunctions::Squish(Windows); });
+}
+
+  //   SAVE WINDOW LAYOUTS   //
+
+void WindowsApp::WinWinSaveLayout()
+{
+    std::wstring layoutName = AskLayoutName(); // Ask on the UI thread, the worker only saves
+    PostCommand(SAVE_LAYOUT, [layoutName](WorkerResult& Result) {
+        EnumerateWindows(Result);
+        WinWinFunctions::SaveWindowLayout(ExtractHwnds(Result.Windows), layoutName);
+    });
+}
+
+void WindowsApp::WinWinViewSaved() {
+
+    wchar_t exeWcharPath[MAX_PATH];
+    GetModuleFileName(NULL, exeWcharPath, MAX_PATH);
+
+    std::wstring exePath(exeWcharPath);
+    std::wstring::size_type pos = exePath.find_last_of(L"\\/");
+    std::wstring exeDir = exePath.substr(0, pos);
+
+    SetCurrentDirectory(exeDir.c_str()); // Set the working directory to the executable's directory
+
+    std::wstring WinWinLayoutsFolder = exeDir + L"/SavedLayouts/";
+
+    if (m_WindowLayoutPicker.Handle() == NULL) {
+        m_WindowLayoutPicker.Create(m_hWindowsControlPanel, 15, 140, 260, LAYOUT_PICKER_HEIGHT, EXECUTE_LAYOUT); // Hidden until the layout pass shows it
+    }
+    m_WindowLayoutPicker.SetLayouts(ListLayoutNames(WinWinLayoutsFolder));
+    m_UiState.windowLayoutsOpen = true;
+    RequestLayout();
+}
+
+void WindowsApp::WinWinHideSaved() {
+    m_UiState.windowLayoutsOpen = false;
+    RequestLayout();
+}
+
+void WindowsApp::ExecuteSaved(std::wstring json) {
+    PostCommand(EXECUTE_LAYOUT, [json](WorkerResult& Result) {
+        EnumerateWindows(Result);
+        WinWinFunctions::ExecuteWindowLayout(json, ExtractHwnds(Result.Windows));
+    });
+}
+
+ //   SAVE DESKTOP ICON LAYOUTS   //
+
+void WindowsApp::SaveDesktopLayout()
+{
+    std::wstring layoutName = AskLayoutName(); // Ask on the UI thread, a dialog on the worker would have no message loop behind it
+    PostCommand(SAVE_DESKTOP_LAYOUT, [layoutName](WorkerResult& Result) { Result.count = WinWinFunctions::SaveDesktopLayout(layoutName) ? 1 : 0; });
+}
+
+void WindowsApp::ViewSavedDesktopLayouts() {
+
+    wchar_t exeWcharPath[MAX_PATH];
+    GetModuleFileName(NULL, exeWcharPath, MAX_PATH);
+
+    std::wstring exePath(exeWcharPath);
+    std::wstring::size_type pos = exePath.find_last_of(L"\\/");
+    std::wstring exeDir = exePath.substr(0, pos);
+
+    SetCurrentDirectory(exeDir.c_str()); // Set the working directory to the executable's directory
+
+    std::wstring WinWinLayoutsFolder = exeDir + L"/SavedDesktopLayouts/";
+
+    if (m_DesktopLayoutPicker.Handle() == NULL) {
+        m_DesktopLayoutPicker.Create(m_hIconControlPanel, 15, 100, 260, LAYOUT_PICKER_HEIGHT, EXECUTE_DESKTOP_LAYOUT); // Hidden until the layout pass shows it
+    }
+    m_DesktopLayoutPicker.SetLayouts(ListLayoutNames(WinWinLayoutsFolder));
+    m_UiState.desktopLayoutsOpen = true;
+    RequestLayout();
+}
+
+void WindowsApp::HideSavedDesktopLayouts() {
+    m_UiState.desktopLayoutsOpen = false;
+    RequestLayout();
+}
+
+void WindowsApp::ExecuteSavedDesktopLayout(std::wstring json) {
+    PostCommand(EXECUTE_DESKTOP_LAYOUT, [json](WorkerResult& Result) { Result.count = WinWinFunctions::ExecuteDesktopLayout(json); });
+}
@@ -1,515 +1,630 @@
-//***********************************************
-// WindowsWindows
-// Copyright 2024 Michael Steuber
-//===============================================
-// WindowsApp.h
-// ----------------------------------------------
-// 09/03/2024 MS-24.01.07.03 Updated documentation
-// 07/25/2024 MS-24.01.02.06 Added PrintActiveWindows() 
-// 07/25/2024 MS-24.01.02.01 Updated to be compatible with template window
-// 07/23/2024 MS-24.01.01.00 created
-//-----------------------------------------------
-// Main window header code
-//
-// Master code for UI functionality. Creates the main window and all child windows that aren't members of the ControlWindow class. 
-// Contains HandleMessage(), which handles all events sent to the main window. 
-// m_hwnd is the top level of the windows hierarchy, it is a parent to everything you see on screen.
-
-
-#pragma once
-#include <iostream>
-#include <Windows.h>
-#include <vector>
-#include "BaseWindow.cpp"
-#include "WindowControl.h"
-#include <shellapi.h>
-#include <nlohmann/json.hpp>
-#include <fstream>
-#include <locale>
-#include <codecvt>
-#include <filesystem>
-#include <commctrl.h>
-#include <string>
-#include <sstream>
-#include <Psapi.h>
-#include "resource.h"
-#include "WinWinFunctions.h"
-
-class WindowsApp : public BaseWindow<WindowsApp> {
-
-public:
-    WindowsApp();
-
-
-    ///   GLOBALS   ///
-    //Index for the StackWindows() multilayered stack function
-    int stackIndex;
-    
-    // Vector of saved window layout buttons
-    std::vector<HWND> layoutButtons;
-    // Vector of saved desktop icon layout buttons
-    std::vector<HWND> desktopLayoutButtons;
-
-    // Main window class name
-    PCWSTR ClassName() const { return L"Windows Window Extension"; }
-    
-    // Window procedure for the Window Control window
-    WNDPROC windowWindowProc;
-    // Window procedure for the active windows control panel 
-    WNDPROC controlWindowProc;
-
-    WNDPROC scrollBarProc;
-
-    
-    ///   STRUCTS   ///
-
-    // Struct representation of a JSON saved window
-    struct SavedWindow {
-        SavedWindow(std::string process,
-            UINT flags,
-            UINT showCmd,
-            POINT ptMinPosition,
-            POINT ptMaxPosition,
-            RECT rcNormalPosition) {
-            m_process = process;
-            m_flags = flags;
-            m_showCmd = showCmd;
-            m_ptMinPosition = ptMinPosition;
-            m_ptMaxPosition = ptMaxPosition;
-            m_rcNormalPosition = rcNormalPosition;
-        };
-        std::string m_process;
-        UINT m_flags;
-        UINT m_showCmd;
-        POINT m_ptMinPosition;
-        POINT m_ptMaxPosition;
-        RECT m_rcNormalPosition;
-        WINDOWPLACEMENT* getWinPlacement() {
-            WINDOWPLACEMENT placement;
-            placement.showCmd = m_showCmd;
-            placement.flags = m_flags;
-            placement.length = sizeof(WINDOWPLACEMENT);
-            placement.ptMaxPosition = m_ptMinPosition;
-            placement.ptMaxPosition = m_ptMaxPosition;
-            placement.rcNormalPosition = m_rcNormalPosition;
-            return &placement;
-        }
-    };
-
-    // Struct representation of a JSON saved desktop icon
-    struct SavedIcon {
-        SavedIcon(std::string iconName,
-            POINT iconPos) {
-            m_iconName = iconName;
-            m_iconPos = iconPos;
-        };
-        std::string m_iconName;
-        POINT m_iconPos;
-    };
-    
-
-    ///   CALLBACK FUNCTIONS   ///
-    
-    /**
-    * @brief Starts the loop that process and dispatches main window messages 
-    *
-    * This function is called after initializing the app. Anytime the window receives a message, this function
-    * gets it, translates it, and dispatches it to the appropriate procedure
-    */
-    void RunMessageLoop();
-
-    /**
-    * @brief Processes messages sent to the main window 
-    * 
-    * Recieves all messages sent to the main window through the WindowProc callback function and calls the corresponding 
-    * message based on a switch statement. Handles the basic window commands CREATE, PAINT, SIZE, SCROLL, CLOSE, and DESTROY
-    * as well as button messages through the WM_COMMAND message. If the HIWORD of the wParam is BN_CLICKED, it gets the button id
-    * and through a switch statement matches it to one of 16 preprocessor defined messages. All of these call their corresponding
-    * method, but the following have additional functionality:
-    * NEXT_STACK: increments the global stackIndex by one
-    * PREV_STACK: decrements the global stackIndex by one
-    * EXECUTE_LAYOUT: Gets the text of the pressed button through its HWND (passed through the lParam) and passes it as a wchar_t to ExecuteSaved
-    * EXECUTE_DESKTOP_LAYOUT:  Gets the text of the pressed button through its HWND (passed through the lParam) and passes it as a wchar_t to ExecuteSavedDesktopLayout
-    * For the preprocessor definitions of command IDs, see the top of WindowsApp.cpp
-    */
-    LRESULT HandleMessage(UINT uMsg, WPARAM wParam, LPARAM lParam);
-
-    /**
-     * @brief Procedure that sends button clicked events to the main WindowProc
-     * 
-     * Callback method that receives all messages sent by buttons that are children of m_hwnd. If the message is WM_COMMAND, it relays that 
-     * message to the main WindowProc
-     */
-    static LRESULT CALLBACK ButtonProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
-
-
-    ///   INITIALIZE   ///
-
-    /**
-    * @brief Creates the main window
-    * 
-    * Creates the main window through the Create method of BaseWindow.cpp, then loads the menu and assigns it to m_hwnd.
-    * If m_hwnd fails to Create, returns HRESULT S_FAIL
-    */
-    HRESULT Initialize();
-
-    // Called upon window creation. Creates all child windows of m_hwnd
-    /**
-    * @brief Creates the active windows control panel, calls CreateControlOpts, and sets the initial WindowControl vector
-    * 
-    * Creates m_hActiveWindowsControlPanel which contains the UI control panel elements for each WindowControl in WindowsVector.
-    * Next calls CreateControlOpts (see below), populates the WindowsVector, and sets each control panel to hidden.
-    * Also sets the scroll info for the main window, but this doesn't do anything yet.
-    * Returns S_OK 
-    */
-    HRESULT HandleCreate();
- 
-    /**
-    * @brief Creates the child windows and buttons of m_hwnd
-    * 
-    * Creates the initial hierarchy of m_hwnd child windows, visualized below:
-    * 
-    *            m_hIconControlPanel                                             m_hWindowsControlPanel
-    *             (iconWindowProc)                                                 (windowWindowProc)
-    *                     |                                                                 |
-    *            _________|________                            _____________________________|___________________________
-    *            |        |        |                           |                 |          |        |                 |
-    *            |   m_IconTitle   |                           |                 |    m_WindowTitle  |                 |
-    *            |      (text)     |                           |                 |        (text)     |                 |        
-    * m_hSavedDesktopConfigs  m_hSaveDesktopLayout       m_hCascadeButton  m_hStackButton    m_hSaveWinLayout   m_hSavedConfigs             
-    *        (button)           (button)                     (button)         (button)            (button)          (button) 
-    *                                          
-    *                                     m_hActiveWindowsControlPanel
-    *                                          (controlWindowProc)
-    *                                                  |
-    *                                            m_hShowWindows 
-    *                                               (button)
-    * 
-    * Each top level window has a control proc that sends messages to ButtonProc
-    */
-    void CreateControlOpts();
-
-
-    ///   UTILITIIES   ///
-    /**
-    * @brief Returns a vector of HWNDS from a vector of WindowsControls
-    * 
-    * For each WindowControl in the windowControls vector, add the HWND returned by GetInstanceHandle() of the control to the vector hwnd
-    * and return hwnd.
-    * 
-    * @param windowControls - The WindowControls vector to convert
-    * @return The corresponding vector of HWNDS 
-    */
-    std::vector<HWND> ExtractHwnds(std::vector<WindowControl*> windowControls);
-
-    /**
-     * @brief Converts an std::wstring to an std::string
-     * 
-     * Checks if wstr is empty, gets the size needed for the new string, creates a string of size size_needed, assigns the characters of the 
-     * wstring to the string, and removes the null terminator from the end of the new string.
-     * 
-     * @param wstr The wide string to convert
-     * @return The converted narrow string
-     */
-    std::string ConvertToNarrowString(const std::wstring& wstr);
-
-
-    /**
-     * @brief Manually triggers the WM_SIZE event without changing the window size
-     */
-    void TriggerResize();
-        
-
-    ///   WINDOW RESOURCES   ///
-
-    /**
-     * @brief Creates a dialog box to get user input
-     * 
-     * Creates a dialog box and assigns the user's input to the global userInput and returns userInput
-     * 
-     * @param hInstance hInstance of the calling process
-     * @return The user's input as an std::wstring
-     */
-    std::wstring GetUserInput(HINSTANCE hInstance);
-
-
-    ///   HANDLE WINDOWS_WINDOWS EVENTS   ///
-    //    PRINT ACTIVE WINDOWS   //  
-
-    /**
-    * @brief Enumerate through the windows open on the machine and create a control panel for each of them
-    * 
-    * Using EnumWindows, calls the EnumWindowsProc callback from BaseWindow.cpp
-    */
-    void PrintActiveWindows();
-
-    /**
-     * @brief Shows a dropdown list of control panels for each open window
-     * 
-     * Clears the WindowsVector and repopulates it, then resizes m_hwnd (the main window) and m_hActiveWindowsControlPanel (the control window)
-     * according to the number of control panels to display. m_hwnd is set to the same width as before but the height of the size of 
-     * ((WindowsVector + 1) * 100) + 102 and m_hActiveWindowsControlPanel is set to the previous position, previous width, and the same height as m_hwnd
-     * Then it destroys the m_hShowWindows button and creates an equally sized m_hHideWindows button. After that, it sets all control panels to visible.
-     */
-    void WinWinShowActive();
-    
-    /**
-     * @brief Hides the active windows control panel dropdown
-     * 
-     * Sets each window control to hiden, and then sets the height of m_hActiveWindowsControlPanel to 30 and the height of m_hwnd to the client coordinate of
-     * the m_hWindowsControlPanel + 100. Afterwards, it destroys the m_hHideWindows button and recreates the m_hShowWindows button 
-     */
-    void WinWinHideActive();
-
-
-    //   STACK WINDOWS   //
-
-        /**
-    * @brief Stacks all active window
-    * 
-    * Called when STACK is clicked. If there are 8 or fewer windows open, it delegates the stacking to the static WinWinFunctions Stack() function. If there are more than 8, it initializes 
-    * a multi layered stack by setting the stackIndex to 0, calling StackWindowsCallback, destroying the m_hStackButton button, and creating m_hExitStack, m_hNextStack,
-    * and (a disabled) m_hPrevStack. 
-    */
-    void StackWindows();
-
-    /**
-     * @brief Handles multilayered stacking
-     * 
-     * Called when STACK is clicked and there are more than 8 windows open. First, determines the size of the final stack layer and uses this to determine how many layers there are.
-     * If the global stackIndex is 0, m_hPrevStack is disabled. If stackIndex is equal to one less than the number of layers in the stack, m_hNextStack is disabled.
-     * Next, it adds the next 8 WindowControls from WindowsVector to a SubVector (or the final number of WindowsControls if it's the last layer) and passes the subvector to 
-     * StackFourOrLess or StackFiveToEight.
-     */
-    void StackWindowsCallback();
-
-    /**
-     * @brief Stacks four or less windows vertically on the screen
-     * 
-     * Based on the number of WindowControls in the SubVector, sets stackFactorY that is equal to the height of the screen - the size of the SubVector.
-     * It then makes sure the window is not minimized or maximized, sets the window to TOPMOST, and sets the x coordinate to 0, the y coordinate equal to the stack position based on the stackFactor, 
-     * the length to the length of the screen, and the height to the stackFactorY.
-     * It then removes the TOPMOST flag and increments the stackPosition by the stackFactorY.
-     * @param SubVector The vector of Windows to stack
-     */
-    void StackFourOrLess(std::vector<WindowControl*> SubVector);
-    
-    /**
-     * @brief Stacks five to eight windows vertically and horizontally on the screen 
-     * 
-     * Based on the number of WindowControls in the SubVector, sets stackFactorY that is equal to the height of the screen minus the size of the SubVector.
-     * It then makes sure the window is not minimized or maximized, sets the window to TOPMOST, sets the x coordinate to 0 or half of the length of the screen if it is the fifth or more window to be stacked,
-     * the y coordinate equal to the stack position based on the stackFactor, the length to half length of the screen, and the height to the stackFactorY.
-     * It then removes the TOPMOST flag and increments the stackPosition by the stackFactorY.
-     * After the 4th window is stacked, the stackFactorY is reset and revaluated based on the remaining number of windows to stack and the x position of the remaining windows is set to half the length of the screen.
-     * @param SubVector The vector of Windows to stack
-     */
-    void StackFiveToEight(std::vector<WindowControl*> SubVector);
-
-    /**
-     * @brief Removes the Prev Stack, Next Stack, and Exit stack buttons
-     * 
-     * Called when EXIT STACK is clicked. Destroys m_hPrevStack, m_hNextStack, and m_hExitStack, replacing m_hExitStack with a new m_hStackButton.
-     */
-    void ExitStack();
-
-
-    //   CASCADE WINDOWS   //
-
-    /**
-    * @brief Arranges all windows in a cascaded view
-    * 
-    * Called when CASCADE is clicked. Calls the WinWinFunctions function Cascade and creates the squish button.
-    */
-    void CascadeWindows();
-
-    /**
-     * @brief Minimizes all windows not moved after a cascade
-     * 
-     * Called when SQUISH is clicked. Calls the WinWinFunctions function Squish.
-     */
-    void SquishCascade();
-
-
-    //   SAVE WINDOW LAYOUTS   //
-
-    /**
-    * @brief Saves the current window layout to a JSON file
-    * 
-    * Called when SAVE LAYOUT button is pressed. Calls the WinWinFunctions function SaveWindowLayout.
-    */
-    void WinWinSaveLayout();
-
-    /**
-     * @brief Displays a dropdown of buttons that activate window layouts
-     * 
-     * Opens the SavedLayouts folder and creates a button for each JSON file inside. It then rearranges the control windows in the following order: 
-
-     * 1. Get the position of the old WindowsControl rect   
-     * 
-     * 2. Get the position of the old m_hwnd  
-     * 
-     * 3. Get the position of the new WindowsControl rect  
-     *      a. x - 0  
-     *      b. y - 0 | SWP_NOMOVE  
-     *      c. cx - old WindowControlRectRight - old WindowControlRectLeft  
-     *      d. cy - yPos + 40 for last button + buffer  
-     * 
-     * 4. set the position of the new m_hwnd  
-     *      a. x - 0  
-     *      b. y - 0 | SWP_NOMOVE  
-     *      c. cx - old m_hwnd right - old m_hwnd left  
-     *      d. cy - old m_hwnd bottom + yPos + 40 
-
-     * 5. set the position of the new ActiveWindowsRect  
-     *      a. x - 0  
-     *      b. y - Bottom of new WindowsControl rect  
-     *      c. cx - 0  
-     *      d. cy - 0 | SWP_NOSIZE  
-     * 
-     * 6. Set the position of the new WindowsControl rect  
-     * 
-     * After the windows are resized, it generates the buttons by iterating over the directory and places three buttons next to each other every thirty pixels 
-     * before moving to the next line and repeating the process until it reaches the end of the directory.
-     * It then destroys the m_hSavedConfigs and creates a m_hHideSavedConfigs in its place.
-     */
-    void WinWinViewSaved();
-
-    /**
-     * @brief Hides the saved window layout buttons 
-     * 
-     * Destroys each of the layout buttons by iterating through the layout buttons vector, destroys them_hHideSavedConfigs button, and recreates the m_hSavedConfigs button. 
-     * Then, it resets the control panels to their previous states. 
-     */
-    void WinWinHideSaved();
-
-    /**
-     * @brief Moves Windows to the position saved in the specified JSON file
-     * 
-     * Called when a Saved Window Layout button is pressed. Calls the WinWinFunctions function ExecuteWindowLayout.
-     * @param json The name of the JSON file to execute
-     */
-    void ExecuteSaved(std::wstring json);
-    
-    
-    //   SAVE DESKTOP ICON LAYOUTS   //
-
-   /**
-    * @brief Saves the current desktop icon layout to a JSON file
-    *
-    * Called when SAVE ICONS button is pressed. Calls the WinWinFunctions function SaveDesktopLayout.
-    */
-    void SaveDesktopLayout();
-
-    /**
-     * @brief Creates a dropdown of buttons that activate different desktop icon layouts
-     *
-     * Rearranges the control windows in the following order:
-     * m_hwnd : 
-     *  length - same as before
-     *  height - previous height + the difference in height of the new icon control panel
-     * m_hActiveWindowsControlPanel :
-     *  y coordinate - previous y coordinate + the difference in height of the new icon control panel
-     * m_hWindowsControlPanel : 
-     *  y coordinate - previous y coordinate + the difference in height of the new icon control panel
-     * m_hIconControlPanel :
-     *  length - same as before
-     *  height - the y position of the last icon button + 40
-     * 
-     * It then iterates through the SavedDesktopLayouts directory and places three buttons horizontally spaced 30 pixels apart
-     * on each row until it gets to the end of the directory
-     */
-    void ViewSavedDesktopLayouts();
-
-    /**
-     * @brief Hides each of the saved icon buttons 
-     * 
-     * Destroys every saved icon button by iterating through the desktopLayoutButtons vector, destroys m_hHideSavedDesktopConfigs, and recreates m_hSavedDesktopConfigs.
-     * It then restores each control panel to its previous position.
-     */
-    void HideSavedDesktopLayouts();
-
-  /**
-   * @brief Moves desktop icons to the position saved in the specified JSON file
-   *
-   * Called when a Saved Icon Layout button is pressed. Calls the WinWinFunctions function ExecuteDesktopLayout.
-   * @param json The name of the JSON file to execute
-   */
-    void ExecuteSavedDesktopLayout(std::wstring json);
-
-
-private:
-
-    ///   HANDLE BASIC WINDOW EVENTS   ///
-
-    // Called when the paint event is hit
-    void HandlePaint();
-
-    // Called on window resize
-    void HandleResize();
-
-    // Called on window scroll
-    void HandleScroll(WPARAM wParam, LPARAM lParam);
-
-
-    ///   CHILD WINDOW HANDLES   ///
-
-    // Main control panel window handle
-    HWND m_hControlOptions;
-
-    // Cascade button window handle
-    HWND m_hCascadeButton;
-
-    // Stack button window handle
-    HWND m_hStackButton;
-
-    // Next Stack button window handle
-    HWND m_hNextStack;
-
-    // Previous Stack button window handle
-    HWND m_hPrevStack;
-
-    // Exit multilayered stack mode button window handle
-    HWND m_hExitStack;
-
-    // Save layout button window handle
-    HWND m_hSaveWinLayout;
-
-    // Show active windows button window handle
-    HWND m_hShowWindows;
-
-    // Hide active windows button window handle
-    HWND m_hHideWindows;
-
-    // Show saved window configurations button window handle
-    HWND m_hSavedConfigs;
-
-    // Hide saved window configurations button window handle
-    HWND m_hHideSavedConfigs;
-
-    // Save desktop icons button window handle
-    HWND m_hSaveDesktopLayout;
-
-    // Show saved desktop icons button window handle
-    HWND m_hSavedDesktopConfigs;
-
-    // Hide saved desktop icons button window handle
-    HWND m_hHideSavedDesktopConfigs;
-
-    // Squish button window handle
-    HWND m_hSquish;
-
-    // Title text for the Windows control panel
-    HWND m_WindowTitle;
-
-    // Title text for the Icon control panel
-    HWND m_IconTitle;
-
-    // Icon control Window handle
-    HWND m_hIconControlPanel;
-
-    // Windows control window handle
-    HWND m_hWindowsControlPanel;
-
-    HWND m_hScrollBar;
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// WindowsApp.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.15 Added ShowStatus and ClearStatus
+// 10/19/2026 MS-24.01.08.23 Added DeferredStart and ExitAfterFirstPaint for a faster cold start
+// 10/19/2026 MS-24.01.08.18 Panels are driven by a UiState, replaced TriggerResize with RequestLayout and ApplyLayout
+// 10/19/2026 MS-24.01.08.17 Include GdiCache
+// 10/19/2026 MS-24.01.08.16 Saved layouts are picked from LayoutPickers instead of a button per layout
+// 10/19/2026 MS-24.01.08.15 Window operations are posted to WindowWorker, added HandleWorkerDone
+// 10/19/2026 MS-24.01.08.14 PrintActiveWindows reconciles the WindowsVector instead of appending to it
+// 10/19/2026 MS-24.01.08.13 Added the WindowListView that draws the active window list
+// 10/19/2026 MS-24.01.08.04 Include WorkspaceProfiles
+// 10/19/2026 MS-24.01.08.02 Include LayoutSnapshotter
+// 10/19/2026 MS-24.01.08.01 Added accelerator handling for undo/redo
+// 09/03/2024 MS-24.01.07.03 Updated documentation
+// 07/25/2024 MS-24.01.02.06 Added PrintActiveWindows() 
+// 07/25/2024 MS-24.01.02.01 Updated to be compatible with template window
+// 07/23/2024 MS-24.01.01.00 created
+//-----------------------------------------------
+// Main window header code
+//
+// Master code for UI functionality. Creates the main window and all child windows that aren't members of the ControlWindow class. 
+// Contains HandleMessage(), which handles all events sent to the main window. 
+// m_hwnd is the top level of the windows hierarchy, it is a parent to everything you see on screen.
+
+
+#pragma once
+#include <iostream>
+#include <Windows.h>
+#include <vector>
+#include "BaseWindow.cpp"
+#include "WindowControl.h"
+#include "WindowListView.h"
+#include "LayoutPicker.h"
+#include "GdiCache.h"
+#include "UiState.h"
+#include <shellapi.h>
+#include <nlohmann/json.hpp>
+#include <fstream>
+#include <locale>
+#include <codecvt>
+#include <filesystem>
+#include <commctrl.h>
+#include <string>
+#include <unordered_map>
+#include <memory>
+#include <sstream>
+#include <Psapi.h>
+#include "resource.h"
+#include "WinWinFunctions.h"
+#include "LayoutSnapshotter.h"
+#include "WorkspaceProfiles.h"
+#include "WindowWorker.h"
+
+class WindowsApp : public BaseWindow<WindowsApp> {
+
+public:
+    WindowsApp();
+
+
+    ///   GLOBALS   ///
+    //Index for the StackWindows() multilayered stack function
+    int stackIndex;
+
+    // Main window class name
+    PCWSTR ClassName() const { return L"Windows Window Extension"; }
+    
+    // Window procedure for the Window Control window
+    WNDPROC windowWindowProc;
+    // Window procedure for the active windows control panel 
+    WNDPROC controlWindowProc;
+
+    WNDPROC scrollBarProc;
+
+    
+    ///   STRUCTS   ///
+
+    // Struct representation of a JSON saved window
+    struct SavedWindow {
+        SavedWindow(std::string process,
+            UINT flags,
+            UINT showCmd,
+            POINT ptMinPosition,
+            POINT ptMaxPosition,
+            RECT rcNormalPosition) {
+            m_process = process;
+            m_flags = flags;
+            m_showCmd = showCmd;
+            m_ptMinPosition = ptMinPosition;
+            m_ptMaxPosition = ptMaxPosition;
+            m_rcNormalPosition = rcNormalPosition;
+        };
+        std::string m_process;
+        UINT m_flags;
+        UINT m_showCmd;
+        POINT m_ptMinPosition;
+        POINT m_ptMaxPosition;
+        RECT m_rcNormalPosition;
+        WINDOWPLACEMENT* getWinPlacement() {
+            WINDOWPLACEMENT placement;
+            placement.showCmd = m_showCmd;
+            placement.flags = m_flags;
+            placement.length = sizeof(WINDOWPLACEMENT);
+            placement.ptMaxPosition = m_ptMinPosition;
+            placement.ptMaxPosition = m_ptMaxPosition;
+            placement.rcNormalPosition = m_rcNormalPosition;
+            return &placement;
+        }
+    };
+
+    // Struct representation of a JSON saved desktop icon
+    struct SavedIcon {
+        SavedIcon(std::string iconName,
+            POINT iconPos) {
+            m_iconName = iconName;
+            m_iconPos = iconPos;
+        };
+        std::string m_iconName;
+        POINT m_iconPos;
+    };
+    
+
+    ///   CALLBACK FUNCTIONS   ///
+    
+    /**
+    * @brief Starts the loop that process and dispatches main window messages 
+    *
+    * This function is called after initializing the app. Anytime the window receives a message, this function
+    * gets it, translates it, and dispatches it to the appropriate procedure. Keyboard shortcuts from IDR_ACCELERATOR1 (Ctrl+Z undo, Ctrl+Y redo)
+    * are translated into WM_COMMAND messages before dispatch, except while an edit control (the layout picker filter) has the focus,
+    * so the shortcuts undo and redo its text instead.
+    */
+    void RunMessageLoop();
+
+    /**
+    * @brief Processes messages sent to the main window 
+    * 
+    * Recieves all messages sent to the main window through the WindowProc callback function and calls the corresponding 
+    * message based on a switch statement. Handles the basic window commands CREATE, PAINT, SIZE, SCROLL, CLOSE, DESTROY, DISPLAYCHANGE and TIMER
+    * (a display change restarts PROFILE_SWITCH_TIMER, and when it fires the workspace profile for the new monitors is applied on the worker; STATUS_TIMER clears a
+    * finished command's status) as well as button messages through the WM_COMMAND message.
+    * WM_DEFERRED_START, posted by the first paint, runs DeferredStart.
+    * Window operations never run here: the buttons post them to WindowWorker, WM_WORKER_PROGRESS shows "Working..." in a panel title (see ShowStatus), WM_WORKER_DONE is passed to HandleWorkerDone,
+    * and WM_SETCURSOR shows the busy cursor while any operation is queued or running. If the HIWORD of the wParam is BN_CLICKED, it gets the button id
+    * and through a switch statement matches it to one of 16 preprocessor defined messages. All of these call their corresponding
+    * method, but the following have additional functionality:
+    * NEXT_STACK: increments the global stackIndex by one
+    * PREV_STACK: decrements the global stackIndex by one
+    * EXECUTE_LAYOUT: Sent by m_WindowLayoutPicker, passes its SelectedName() to ExecuteSaved
+    * EXECUTE_DESKTOP_LAYOUT: Sent by m_DesktopLayoutPicker, passes its SelectedName() to ExecuteSavedDesktopLayout
+    * For the preprocessor definitions of command IDs, see the top of WindowsApp.cpp
+    */
+    LRESULT HandleMessage(UINT uMsg, WPARAM wParam, LPARAM lParam);
+
+    /**
+     * @brief Procedure that sends button clicked events to the main WindowProc
+     * 
+     * Callback method that receives all messages sent by buttons that are children of m_hwnd. If the message is WM_COMMAND, it relays that 
+     * message to the main WindowProc
+     */
+    static LRESULT CALLBACK ButtonProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
+
+
+    ///   INITIALIZE   ///
+
+    /**
+    * @brief Creates the main window
+    * 
+    * Creates the main window through the Create method of BaseWindow.cpp, then loads the menu and assigns it to m_hwnd.
+    * If m_hwnd fails to Create, returns HRESULT S_FAIL
+    */
+    HRESULT Initialize();
+
+    /**
+    * @brief Close the UI as soon as it has painted its first frame, printing how long that took
+    * 
+    * Set by WinMain for `--first-paint`, the switch StartupBench launches the UI with. Call before Initialize.
+    */
+    void ExitAfterFirstPaint();
+
+    // Called upon window creation. Creates all child windows of m_hwnd
+    /**
+    * @brief Creates the active windows control panel, calls CreateControlOpts, and sets the initial WindowControl vector
+    * 
+    * Creates m_hActiveWindowsControlPanel, which holds m_WindowList, the owner-drawn list of every WindowControl in WindowsVector, once the list is first opened.
+    * Next calls CreateControlOpts (see below) and starts the WindowWorker thread. Only what the first frame shows is created here: the open windows aren't
+    * enumerated until a button needs them, m_WindowList and the layout pickers are created the first time they're opened, and everything else waits for DeferredStart.
+    * Also sets the scroll info for the main window, but this doesn't do anything yet.
+    * Returns S_OK 
+    */
+    HRESULT HandleCreate();
+
+    /**
+    * @brief Starts what the UI needs but the first frame doesn't
+    * 
+    * Runs once, after the first paint: records the monitors WinWin started with for WorkspaceProfiles and starts the LayoutSnapshotter thread, whose
+    * first snapshot enumerates every window.
+    */
+    void DeferredStart();
+ 
+    /**
+    * @brief Creates the child windows and buttons of m_hwnd
+    * 
+    * Creates the initial hierarchy of m_hwnd child windows, visualized below:
+    * 
+    *            m_hIconControlPanel                                             m_hWindowsControlPanel
+    *             (iconWindowProc)                                                 (windowWindowProc)
+    *                     |                                                                 |
+    *            _________|________                            _____________________________|___________________________
+    *            |        |        |                           |                 |          |        |                 |
+    *            |   m_IconTitle   |                           |                 |    m_WindowTitle  |                 |
+    *            |      (text)     |                           |                 |        (text)     |                 |        
+    * m_hSavedDesktopConfigs  m_hSaveDesktopLayout       m_hCascadeButton  m_hStackButton    m_hSaveWinLayout   m_hSavedConfigs             
+    *        (button)           (button)                     (button)         (button)            (button)          (button) 
+    *
+    * m_hNextStack, m_hPrevStack and m_hSquish are created hidden in the windows control panel. The saved layout pickers are created hidden in their panels
+    * the first time they're opened. Nothing is destroyed or recreated afterwards; ApplyLayout shows, hides, retitles and enables them from m_UiState.
+    *                                          
+    *                                     m_hActiveWindowsControlPanel
+    *                                          (controlWindowProc)
+    *                                                  |
+    *                                            m_hShowWindows 
+    *                                               (button)
+    * 
+    * Each top level window has a control proc that sends messages to ButtonProc
+    */
+    void CreateControlOpts();
+
+
+    ///   UTILITIIES   ///
+    /**
+    * @brief Returns a vector of HWNDS from a vector of WindowsControls
+    * 
+    * For each WindowControl in the windowControls vector, add the HWND returned by GetInstanceHandle() of the control to the vector hwnd
+    * and return hwnd.
+    * 
+    * @param windowControls - The WindowControls vector to convert
+    * @return The corresponding vector of HWNDS 
+    */
+    std::vector<HWND> ExtractHwnds(std::vector<WindowControl*> windowControls);
+
+    /**
+     * @brief Returns the HWNDs of an enumeration result
+     * @param Windows Handle and title pairs from EnumerateWindows
+     * @return The handles in the same order
+     */
+    static std::vector<HWND> ExtractHwnds(const std::vector<std::pair<HWND, std::wstring>>& Windows);
+
+    /**
+     * @brief Returns the names of the saved layouts in a folder
+     * @param folder Folder to list
+     * @return The stem of every .json file, other files (like the .json.changes journals) are skipped. Empty if the folder can't be read.
+     */
+    static std::vector<std::wstring> ListLayoutNames(const std::wstring& folder);
+
+    /**
+     * @brief Queue a window operation on WindowWorker and count it as pending for the busy cursor
+     * @param command Command ID, HandleWorkerDone uses it to pick the UI follow up
+     * @param job Operation to run on the worker thread
+     */
+    void PostCommand(int command, WindowWorker::Job job);
+
+    /**
+     * @brief Converts an std::wstring to an std::string
+     * 
+     * Checks if wstr is empty, gets the size needed for the new string, creates a string of size size_needed, assigns the characters of the 
+     * wstring to the string, and removes the null terminator from the end of the new string.
+     * 
+     * @param wstr The wide string to convert
+     * @return The converted narrow string
+     */
+    std::string ConvertToNarrowString(const std::wstring& wstr);
+
+
+    /**
+     * @brief Schedule a layout pass
+     *
+     * Posts WM_APPLY_LAYOUT unless one is already posted, so any number of m_UiState changes in a burst of messages are laid out once.
+     */
+    void RequestLayout();
+
+    /**
+     * @brief Bring the window up to date with m_UiState
+     *
+     * The toggle buttons get the text and command ID of their state (e.g. m_hShowWindows is "V"/SHOW_ACTIVE_WINDOWS or "^"/HIDE_ACTIVE_WINDOWS),
+     * the stack and squish buttons are shown, hidden and enabled, and the pickers and window list are shown or hidden. Only what changed is touched.
+     * Then the control panels are moved in one DeferWindowPos batch and the main window is given the height from UiState::Layout; its WM_SIZE
+     * places the active windows panel (see HandleResize).
+     */
+    void ApplyLayout();
+        
+
+    ///   WINDOW RESOURCES   ///
+
+    /**
+     * @brief Creates a dialog box to get user input
+     * 
+     * Creates a dialog box and assigns the user's input to the global userInput and returns userInput
+     * 
+     * @param hInstance hInstance of the calling process
+     * @return The user's input as an std::wstring
+     */
+    std::wstring GetUserInput(HINSTANCE hInstance);
+
+    /**
+     * @brief Ask for a layout name before a save is posted to the worker
+     *
+     * Never returns an empty name, so WinWinFunctions always has a name and never opens the dialog on the worker thread.
+     * A cancelled dialog saves as "NewLayout", like SaveWindowLayout always has.
+     *
+     * @return The name the user entered, or "NewLayout"
+     */
+    std::wstring AskLayoutName();
+
+
+    ///   HANDLE WINDOWS_WINDOWS EVENTS   ///
+    //    WORKER RESULTS   //
+
+    /**
+    * @brief Apply the result of a finished worker job to the UI
+    * 
+    * Takes ownership of the result and deletes it. Failed jobs are logged to the debugger output. If the job enumerated the open windows, the
+    * WindowsVector is reconciled with them first (see ReconcileWindows), then the command's UI follow up runs:
+    * SHOW_ACTIVE_WINDOWS: opens the list (WinWinShowActive) unless it's already open
+    * CASCADE: shows the squish button
+    * STACK: starts a multilayered stack (StartLayeredStack) if there were more than 8 windows
+    * Failures, the number of icons EXECUTE_DESKTOP_LAYOUT moved and whether SAVE_DESKTOP_LAYOUT saved are then shown with ShowStatus for
+    * STATUS_CLEAR_MS. Any other result clears the status once nothing else is queued.
+    * Every result also logs the GdiCache counters, so GDI objects that leak or get allocated per paint show up as a growing count.
+    * 
+    * @param Done Result posted with WM_WORKER_DONE
+    */
+    void HandleWorkerDone(WorkerResult* Done);
+
+    /**
+    * @brief Show a command's progress or result in place of a panel title
+    *
+    * Desktop icon commands use m_IconTitle, everything else m_WindowTitle. The other title is put back, so only one status shows at a time.
+    * The main window's own title can't be used, the window enumeration recognizes WinWin by it.
+    *
+    * @param command Command ID the job was posted with
+    * @param text Status to show
+    */
+    void ShowStatus(int command, const std::wstring& text);
+
+    // Put both panel titles back
+    void ClearStatus();
+
+    //    PRINT ACTIVE WINDOWS   //  
+
+    /**
+    * @brief Refresh the WindowsVector in the background
+    * 
+    * Posts EnumerateWindows to the worker. The WindowsVector is reconciled when the result comes back.
+    */
+    void PrintActiveWindows();
+
+    /**
+    * @brief Enumerate through the windows open on the machine
+    * 
+    * Using EnumWindows, calls the EnumWindowsProc callback from BaseWindow.cpp. Runs on the worker thread.
+    * @param Result Receives the windows in z order and is marked as enumerated
+    */
+    static void EnumerateWindows(WorkerResult& Result);
+
+    /**
+    * @brief Bring the WindowsVector up to date with an enumeration
+    * 
+    * Reconciles the windows with the WindowsVector by handle: windows that already have a WindowControl keep it and have their title updated in place,
+    * new windows get a new WindowControl, and the controls of windows that are gone are deleted. The WindowsVector ends up in the enumeration's z order.
+    * If anything changed and m_WindowList is showing, it's given the new rows.
+    * @param Windows Handle and title pairs from EnumerateWindows. Titles are moved out.
+    */
+    void ReconcileWindows(std::vector<std::pair<HWND, std::wstring>>& Windows);
+
+    /**
+     * @brief Shows a dropdown list of control panels for each open window
+     * 
+     * Called by HandleWorkerDone once the SHOW_ACTIVE_WINDOWS enumeration has refreshed the WindowsVector. Creates m_WindowList the first time, hands it the WindowsVector,
+     * marks the list open in m_UiState and requests a layout, which grows m_hwnd by up to ACTIVE_WINDOWS_MAX_GROWTH to fit the rows and turns
+     * m_hShowWindows into the hide button.
+     */
+    void WinWinShowActive();
+    
+    /**
+     * @brief Hides the active windows control panel dropdown
+     * 
+     * Marks the list closed in m_UiState and requests a layout, which hides m_WindowList, shrinks m_hwnd back and turns m_hShowWindows back into the show button.
+     */
+    void WinWinHideActive();
+
+
+    //   STACK WINDOWS   //
+
+        /**
+    * @brief Stacks all active window
+    * 
+    * Called when STACK is clicked. Posts a job that enumerates the windows and, if there are 8 or fewer, delegates the stacking to the static WinWinFunctions Stack() function.
+    * If there are more than 8, HandleWorkerDone starts a multi layered stack with StartLayeredStack.
+    */
+    void StackWindows();
+
+    /**
+    * @brief Initializes a multi layered stack
+    * 
+    * Sets the stackIndex to 0, puts m_UiState in layered stack mode (m_hStackButton becomes EXIT STACK, m_hNextStack and m_hPrevStack are shown) and calls StackWindowsCallback. 
+    */
+    void StartLayeredStack();
+
+    /**
+     * @brief Handles multilayered stacking
+     * 
+     * Called when STACK is clicked and there are more than 8 windows open. First, determines the size of the final stack layer and uses this to determine how many layers there are.
+     * The WindowsVector is reconciled between layers, so stackIndex is clamped to the layers there are now, and the stack exits if no windows are left.
+     * If the global stackIndex is 0, m_hPrevStack is disabled. If stackIndex is equal to one less than the number of layers in the stack, m_hNextStack is disabled.
+     * Both go through m_UiState and the next layout pass.
+     * Next, it adds the handles of the next 8 WindowControls from WindowsVector to a SubVector (or the final number of WindowsControls if it's the last layer) and posts a job
+     * that captures the layer for undo and passes the subvector to StackFourOrLess or StackFiveToEight.
+     */
+    void StackWindowsCallback();
+
+    /**
+     * @brief Stacks four or less windows vertically on the screen
+     * 
+     * Based on the number of WindowControls in the SubVector, sets stackFactorY that is equal to the height of the screen - the size of the SubVector.
+     * It then makes sure the window is not minimized or maximized, sets the window to TOPMOST, and sets the x coordinate to 0, the y coordinate equal to the stack position based on the stackFactor, 
+     * the length to the length of the screen, and the height to the stackFactorY.
+     * It then removes the TOPMOST flag and increments the stackPosition by the stackFactorY.
+     * @param SubVector The vector of Windows to stack
+     */
+    static void StackFourOrLess(std::vector<HWND> SubVector);
+    
+    /**
+     * @brief Stacks five to eight windows vertically and horizontally on the screen 
+     * 
+     * Based on the number of WindowControls in the SubVector, sets stackFactorY that is equal to the height of the screen minus the size of the SubVector.
+     * It then makes sure the window is not minimized or maximized, sets the window to TOPMOST, sets the x coordinate to 0 or half of the length of the screen if it is the fifth or more window to be stacked,
+     * the y coordinate equal to the stack position based on the stackFactor, the length to half length of the screen, and the height to the stackFactorY.
+     * It then removes the TOPMOST flag and increments the stackPosition by the stackFactorY.
+     * After the 4th window is stacked, the stackFactorY is reset and revaluated based on the remaining number of windows to stack and the x position of the remaining windows is set to half the length of the screen.
+     * @param SubVector The vector of Windows to stack
+     */
+    static void StackFiveToEight(std::vector<HWND> SubVector);
+
+    /**
+     * @brief Removes the Prev Stack, Next Stack, and Exit stack buttons
+     * 
+     * Called when EXIT STACK is clicked. Takes m_UiState out of layered stack mode, so the layout pass hides m_hPrevStack and m_hNextStack and turns m_hStackButton back into STACK.
+     */
+    void ExitStack();
+
+
+    //   CASCADE WINDOWS   //
+
+    /**
+    * @brief Arranges all windows in a cascaded view
+    * 
+    * Called when CASCADE is clicked. Posts a job that enumerates the windows and calls the WinWinFunctions function Cascade. HandleWorkerDone shows the squish button.
+    */
+    void CascadeWindows();
+
+    /**
+     * @brief Minimizes all windows not moved after a cascade
+     * 
+     * Called when SQUISH is clicked. Posts the WinWinFunctions function Squish on the windows of the last refresh.
+     */
+    void SquishCascade();
+
+
+    //   SAVE WINDOW LAYOUTS   //
+
+    /**
+    * @brief Saves the current window layout to a JSON file
+    * 
+    * Called when SAVE LAYOUT button is pressed. Asks for the layout name, then posts a job that enumerates the windows and calls the WinWinFunctions function SaveWindowLayout.
+    */
+    void WinWinSaveLayout();
+
+    /**
+     * @brief Displays the picker of saved window layouts
+     * 
+     * Creates m_WindowLayoutPicker the first time, fills it with the layouts in the SavedLayouts folder, marks it open in m_UiState and requests a layout. The layout pass grows
+     * the window control panel to fit the picker, which is the same height however many layouts are saved, moves the active windows panel down,
+     * and turns m_hSavedConfigs into the hide button.
+     */
+    void WinWinViewSaved();
+
+    /**
+     * @brief Hides the saved window layout picker 
+     * 
+     * Marks m_WindowLayoutPicker closed in m_UiState and requests a layout, which hides it, turns m_hSavedConfigs back into WINDOW LAYOUTS,
+     * and returns the control panels to their closed sizes.
+     */
+    void WinWinHideSaved();
+
+    /**
+     * @brief Moves Windows to the position saved in the specified JSON file
+     * 
+     * Called when a layout is picked in m_WindowLayoutPicker. Posts a job that enumerates the windows and calls the WinWinFunctions function ExecuteWindowLayout.
+     * @param json The name of the JSON file to execute
+     */
+    void ExecuteSaved(std::wstring json);
+    
+    
+    //   SAVE DESKTOP ICON LAYOUTS   //
+
+   /**
+    * @brief Saves the current desktop icon layout to a JSON file
+    *
+    * Called when SAVE ICONS button is pressed. Asks for the layout name, then posts the WinWinFunctions function SaveDesktopLayout.
+    */
+    void SaveDesktopLayout();
+
+    /**
+     * @brief Displays the picker of saved desktop icon layouts
+     *
+     * Creates m_DesktopLayoutPicker the first time, fills it with the layouts in the SavedDesktopLayouts directory, marks it open in m_UiState and requests a layout. The layout
+     * pass grows m_hIconControlPanel to fit the picker, moves the panels below it down by the same amount, and turns m_hSavedDesktopConfigs into the hide button.
+     */
+    void ViewSavedDesktopLayouts();
+
+    /**
+     * @brief Hides the saved icon layout picker 
+     * 
+     * Marks m_DesktopLayoutPicker closed in m_UiState and requests a layout, which hides it, turns m_hSavedDesktopConfigs back into ICON LAYOUTS,
+     * and returns each control panel to its closed position.
+     */
+    void HideSavedDesktopLayouts();
+
+  /**
+   * @brief Moves desktop icons to the position saved in the specified JSON file
+   *
+   * Called when a layout is picked in m_DesktopLayoutPicker. Posts the WinWinFunctions function ExecuteDesktopLayout, HandleWorkerDone logs the number of icons moved.
+   * @param json The name of the JSON file to execute
+   */
+    void ExecuteSavedDesktopLayout(std::wstring json);
+
+
+private:
+
+    ///   HANDLE BASIC WINDOW EVENTS   ///
+
+    // Called when the paint event is hit. Fills the background through a PaintBuffer, WM_ERASEBKGND does nothing so it isn't painted twice.
+    // The first paint also paints the buttons, logs the time since the process started (see StartupBench.h) and posts WM_DEFERRED_START.
+    void HandlePaint();
+
+    // Called on window resize. Places m_hActiveWindowsControlPanel below the control panels; while the list is open it fills the rest of the window.
+    // Sizes m_WindowList and the scroll bar to match and sets the scroll range to the list's content height.
+    void HandleResize();
+
+    // Called on window scroll. Scrolls m_WindowList, which blits the rows still in view and repaints only the ones that scrolled in.
+    void HandleScroll(WPARAM wParam, LPARAM lParam);
+
+
+    ///   CHILD WINDOW HANDLES   ///
+
+    // Main control panel window handle
+    HWND m_hControlOptions;
+
+    // Cascade button window handle
+    HWND m_hCascadeButton;
+
+    // Stack button window handle, EXIT STACK during a multilayered stack
+    HWND m_hStackButton;
+
+    // Next Stack button window handle
+    HWND m_hNextStack;
+
+    // Previous Stack button window handle
+    HWND m_hPrevStack;
+
+    // Save layout button window handle
+    HWND m_hSaveWinLayout;
+
+    // Show/hide active windows button window handle
+    HWND m_hShowWindows;
+
+    // Show/hide saved window configurations button window handle
+    HWND m_hSavedConfigs;
+
+    // Save desktop icons button window handle
+    HWND m_hSaveDesktopLayout;
+
+    // Show/hide saved desktop icons button window handle
+    HWND m_hSavedDesktopConfigs;
+
+    // Squish button window handle
+    HWND m_hSquish;
+
+    // Title text for the Windows control panel
+    HWND m_WindowTitle;
+
+    // Title text for the Icon control panel
+    HWND m_IconTitle;
+
+    // Icon control Window handle
+    HWND m_hIconControlPanel;
+
+    // Windows control window handle
+    HWND m_hWindowsControlPanel;
+
+    HWND m_hScrollBar;
+
+    // Owner-drawn list of the active windows, child of m_hActiveWindowsControlPanel. Created when the list is first opened.
+    WindowListView m_WindowList;
+
+    // Searchable list of the saved window layouts, child of m_hWindowsControlPanel. Created when WINDOW LAYOUTS is first pressed.
+    LayoutPicker m_WindowLayoutPicker;
+
+    // Searchable list of the saved desktop icon layouts, child of m_hIconControlPanel. Created when ICON LAYOUTS is first pressed.
+    LayoutPicker m_DesktopLayoutPicker;
+
+    // Jobs posted to WindowWorker that haven't finished yet
+    int m_pendingCommands;
+
+    // What the window is showing. Change it, then call RequestLayout.
+    UiState m_UiState;
+
+    // Set while a WM_APPLY_LAYOUT is posted and not yet handled
+    bool m_layoutPending;
+
+    // Set once the first frame has been painted
+    bool m_firstPaintDone;
+
+    // Close after the first frame, see ExitAfterFirstPaint
+    bool m_exitAfterFirstPaint;
 };
\ No newline at end of file
@@ -0,0 +1,133 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// WorkspaceProfiles.cpp
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.04 created
+//-----------------------------------------------
+// Source code for monitor topology workspace profiles
+//
+// Defines functions for class WorkspaceProfiles. See WorkspaceProfiles.h for how profiles are keyed and stored.
+
+#include "WorkspaceProfiles.h"
+#include "WinWinFunctions.h"
+
+std::string WorkspaceProfiles::s_ActiveSignature;
+std::mutex WorkspaceProfiles::s_Lock;
+
+static BOOL CALLBACK MonitorEnumProc(HMONITOR hMonitor, HDC hdc, LPRECT lprcMonitor, LPARAM lParam) {
+    std::vector<WorkspaceProfiles::MonitorInfo>* Monitors = reinterpret_cast<std::vector<WorkspaceProfiles::MonitorInfo>*>(lParam);
+    MONITORINFO info;
+    info.cbSize = sizeof(MONITORINFO);
+    if (GetMonitorInfo(hMonitor, &info)) {
+        Monitors->push_back({ info.rcMonitor, info.rcWork, (info.dwFlags & MONITORINFOF_PRIMARY) != 0 });
+    }
+    return TRUE;
+}
+
+std::vector<WorkspaceProfiles::MonitorInfo> WorkspaceProfiles::GetMonitors() {
+    std::vector<MonitorInfo> Monitors;
+    EnumDisplayMonitors(NULL, NULL, MonitorEnumProc, reinterpret_cast<LPARAM>(&Monitors));
+    std::sort(Monitors.begin(), Monitors.end(), [](const MonitorInfo& a, const MonitorInfo& b) {
+        return (a.rcMonitor.left != b.rcMonitor.left ? a.rcMonitor.left < b.rcMonitor.left : a.rcMonitor.top < b.rcMonitor.top);
+    });
+    return Monitors;
+}
+
+std::string WorkspaceProfiles::Signature(const std::vector<MonitorInfo>& Monitors) {
+    std::ostringstream signature;
+    for (const MonitorInfo& monitor : Monitors) {
+        signature << monitor.rcMonitor.left << "," << monitor.rcMonitor.top << "," << monitor.rcMonitor.right << "," << monitor.rcMonitor.bottom << "/"
+            << monitor.rcWork.left << "," << monitor.rcWork.top << "," << monitor.rcWork.right << "," << monitor.rcWork.bottom
+            << (monitor.primary ? "P" : "") << ";";
+    }
+    return signature.str();
+}
+
+std::string WorkspaceProfiles::CurrentSignature() {
+    return Signature(GetMonitors());
+}
+
+std::wstring WorkspaceProfiles::ProfilePath(const std::string& signature) {
+    // The signature itself has characters that aren't allowed in file names, so the file is named after its FNV-1a hash
+    unsigned long long hash = 14695981039346656037ULL;
+    for (unsigned char c : signature) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    wchar_t name[17];
+    swprintf_s(name, L"%016llx", hash);
+    return WinWinFunctions::GetExeDirectory() + L"/SavedProfiles/" + name + L".json";
+}
+
+void WorkspaceProfiles::WriteProfile(const std::string& signature, const std::vector<MonitorInfo>& Monitors, const nlohmann::json& windows) {
+    std::filesystem::create_directories(WinWinFunctions::GetExeDirectory() + L"/SavedProfiles");
+
+    nlohmann::json Doc = LayoutSchema::Wrap(windows);
+    nlohmann::json monitors = nlohmann::json::array();
+    for (const MonitorInfo& monitor : Monitors) {
+        monitors.push_back({
+            {"rcMonitor", { {"left", monitor.rcMonitor.left}, {"top", monitor.rcMonitor.top}, {"right", monitor.rcMonitor.right}, {"bottom", monitor.rcMonitor.bottom} } },
+            {"rcWork", { {"left", monitor.rcWork.left}, {"top", monitor.rcWork.top}, {"right", monitor.rcWork.right}, {"bottom", monitor.rcWork.bottom} } },
+            {"primary", monitor.primary} });
+    }
+    Doc["topology"] = { {"signature", signature}, {"monitors", monitors} };
+
+    std::ofstream ProfileFile(ProfilePath(signature), std::ios::trunc);
+    ProfileFile << Doc;
+    ProfileFile.close();
+}
+
+void WorkspaceProfiles::Activate() {
+    std::string signature = CurrentSignature();
+    std::lock_guard<std::mutex> lock(s_Lock);
+    s_ActiveSignature = signature;
+}
+
+void WorkspaceProfiles::SaveProfile(std::vector<HWND> WindowVect) {
+    std::vector<MonitorInfo> Monitors = GetMonitors();
+    nlohmann::json windows = nlohmann::json::array();
+    for (HWND ctrl : WindowVect) {
+        windows.push_back(WinWinFunctions::WindowToJson(ctrl, WinWinFunctions::GetProcessPath(ctrl)));
+    }
+    WriteProfile(Signature(Monitors), Monitors, windows);
+    Activate();
+}
+
+void WorkspaceProfiles::UpdateProfile(const nlohmann::json& windows) {
+    std::vector<MonitorInfo> Monitors = GetMonitors();
+    std::string signature = Signature(Monitors);
+    {
+        std::lock_guard<std::mutex> lock(s_Lock);
+        if (signature != s_ActiveSignature) {
+            return; // The monitors changed and the UI hasn't restored the new profile yet
+        }
+    }
+    WriteProfile(signature, Monitors, windows);
+}
+
+bool WorkspaceProfiles::ApplyCurrentProfile() {
+    nlohmann::json Doc = LayoutSchema::Load(ProfilePath(CurrentSignature()));
+    if (Doc.empty() || Doc["windows"].empty()) {
+        return false;
+    }
+    WinWinFunctions::ApplyLayoutDocument(Doc, WinWinFunctions::GetActiveWindows());
+    Activate();
+    return true;
+}
+
+bool WorkspaceProfiles::OnDisplayChange() {
+    std::string signature = CurrentSignature();
+    {
+        std::lock_guard<std::mutex> lock(s_Lock);
+        if (signature == s_ActiveSignature) {
+            return false; // Resolution flicker or a change that ended where it started
+        }
+    }
+    if (ApplyCurrentProfile()) {
+        return true;
+    }
+    Activate();
+    return false;
+}
@@ -0,0 +1,120 @@
+//***********************************************
+// WindowsWindows
+// Copyright 2024 Michael Steuber
+//===============================================
+// WorkspaceProfiles.h
+// ----------------------------------------------
+// 10/19/2026 MS-24.01.08.04 created
+//-----------------------------------------------
+// Header file for monitor topology workspace profiles
+//
+// Contains class WorkspaceProfiles which keeps one window layout per monitor configuration. A monitor configuration is identified by
+// its topology signature - the position, size and work area of every monitor plus which one is primary - so docking a laptop to a
+// three monitor dock and undocking it again are two different profiles.
+//
+// Profiles are stored in SavedProfiles/<signature hash>.json as a normal layout document (see LayoutSchema.h) with an extra "topology"
+// object describing the monitors. They're kept up to date by LayoutSnapshotter and by the SaveProfile command, and the UI switches to
+// the matching profile on WM_DISPLAYCHANGE.
+
+#pragma once
+
+#include <Windows.h>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <nlohmann/json.hpp>
+
+class WorkspaceProfiles {
+public:
+
+	/**
+	 * @brief Monitor as seen by the topology signature
+	 */
+	struct MonitorInfo {
+		RECT rcMonitor;
+		RECT rcWork;
+		bool primary;
+	};
+
+	/**
+	 * @brief Get the monitors that are currently connected
+	 *
+	 * Uses EnumDisplayMonitors and GetMonitorInfo. Monitors are sorted by position so the same configuration always produces
+	 * the same order regardless of enumeration order.
+	 *
+	 * @return The connected monitors
+	 */
+	static std::vector<MonitorInfo> GetMonitors();
+
+	/**
+	 * @brief Build the topology signature of a monitor configuration
+	 * @param Monitors Monitors from GetMonitors
+	 * @return Signature string, one "left,top,right,bottom/workLeft,workTop,workRight,workBottom[P]" entry per monitor separated by ";"
+	 */
+	static std::string Signature(const std::vector<MonitorInfo>& Monitors);
+
+	/**
+	 * @brief Get the signature of the monitors that are connected right now
+	 */
+	static std::string CurrentSignature();
+
+	/**
+	 * @brief Mark the current topology as the one the open windows are arranged for
+	 *
+	 * Called at startup and after a profile has been applied. Until this matches the current topology, UpdateProfile refuses to write,
+	 * so windows that Windows shuffled around during a display change can't overwrite the profile they're about to be restored from.
+	 */
+	static void Activate();
+
+	/**
+	 * @brief Save the current arrangement as the profile for the current topology
+	 * @param WindowVect Vector of windows to save
+	 */
+	static void SaveProfile(std::vector<HWND> WindowVect);
+
+	/**
+	 * @brief Replace the profile of the active topology with an already built window list
+	 *
+	 * Called by LayoutSnapshotter (on its own thread) whenever it writes a snapshot. Does nothing if the monitors have changed since
+	 * the last Activate(), see above.
+	 *
+	 * @param windows JSON array of window objects (see WinWinFunctions::WindowToJson)
+	 */
+	static void UpdateProfile(const nlohmann::json& windows);
+
+	/**
+	 * @brief Apply the profile for the current topology if there is one
+	 *
+	 * Loads the profile and applies it to every open window as a single batch through WinWinFunctions::ApplyLayoutDocument,
+	 * then activates the topology.
+	 *
+	 * @return True if a profile was found and applied
+	 */
+	static bool ApplyCurrentProfile();
+
+	/**
+	 * @brief Switch profiles after a display change
+	 *
+	 * Called once the WM_DISPLAYCHANGE burst has settled. If the topology differs from the active one, applies the matching profile.
+	 * If there is no profile for the new topology, it's activated as is so the snapshotter starts filling one in.
+	 * Applying a profile enumerates the windows, hung window probes included, so this must not run on a thread that paints: the UI
+	 * posts it to WindowWorker from its PROFILE_SWITCH_TIMER.
+	 *
+	 * @return True if a profile was applied
+	 */
+	static bool OnDisplayChange();
+
+private:
+
+	// Full path of the profile file for a topology signature
+	static std::wstring ProfilePath(const std::string& signature);
+
+	// Write a window list as the profile for a topology
+	static void WriteProfile(const std::string& signature, const std::vector<MonitorInfo>& Monitors, const nlohmann::json& windows);
+
+	// Signature of the topology the open windows are arranged for
+	static std::string s_ActiveSignature;
+
+	// Guards s_ActiveSignature, which is read by the snapshot thread
+	static std::mutex s_Lock;
+};